@@ -59,267 +59,696 @@ KeywordToken *reserved_keywords[] = {
         {NULL, -1},
     },
 };
-#define start_type 1000
-#define statements_type 1001
-#define statement_type 1002
-#define simple_stmt_type 1003
-#define small_stmt_type 1004
-#define compound_stmt_type 1005
-#define assignment_type 1006
-#define augassign_type 1007
-#define global_stmt_type 1008
-#define nonlocal_stmt_type 1009
-#define yield_stmt_type 1010
-#define assert_stmt_type 1011
-#define del_stmt_type 1012
-#define import_stmt_type 1013
-#define import_name_type 1014
-#define import_from_type 1015
-#define import_from_targets_type 1016
-#define import_from_as_names_type 1017
-#define import_from_as_name_type 1018
-#define dotted_as_names_type 1019
-#define dotted_as_name_type 1020
-#define dotted_name_type 1021  // Left-recursive
-#define if_stmt_type 1022
-#define elif_stmt_type 1023
-#define else_block_type 1024
-#define while_stmt_type 1025
-#define for_stmt_type 1026
-#define with_stmt_type 1027
-#define with_item_type 1028
-#define try_stmt_type 1029
-#define except_block_type 1030
-#define finally_block_type 1031
-#define return_stmt_type 1032
-#define raise_stmt_type 1033
-#define function_def_type 1034
-#define function_def_raw_type 1035
-#define parameters_type 1036
-#define slash_without_default_type 1037
-#define slash_with_default_type 1038
-#define star_etc_type 1039
-#define name_with_optional_default_type 1040
-#define names_with_default_type 1041
-#define name_with_default_type 1042
-#define plain_names_type 1043
-#define plain_name_type 1044
-#define kwds_type 1045
-#define annotation_type 1046
-#define decorators_type 1047
-#define class_def_type 1048
-#define class_def_raw_type 1049
-#define block_type 1050
-#define expressions_list_type 1051
-#define expressions_type 1052
-#define star_expression_type 1053
-#define star_named_expressions_type 1054
-#define star_named_expression_type 1055
-#define named_expression_type 1056
-#define annotated_rhs_type 1057
-#define expression_type 1058
-#define lambdef_type 1059
-#define lambda_parameters_type 1060
-#define lambda_slash_without_default_type 1061
-#define lambda_slash_with_default_type 1062
-#define lambda_star_etc_type 1063
-#define lambda_name_with_optional_default_type 1064
-#define lambda_names_with_default_type 1065
-#define lambda_name_with_default_type 1066
-#define lambda_plain_names_type 1067
-#define lambda_plain_name_type 1068
-#define lambda_kwds_type 1069
-#define disjunction_type 1070
-#define conjunction_type 1071
-#define inversion_type 1072
-#define comparison_type 1073
-#define compare_op_bitwise_or_pair_type 1074
-#define eq_bitwise_or_type 1075
-#define noteq_bitwise_or_type 1076
-#define lte_bitwise_or_type 1077
-#define lt_bitwise_or_type 1078
-#define gte_bitwise_or_type 1079
-#define gt_bitwise_or_type 1080
-#define notin_bitwise_or_type 1081
-#define in_bitwise_or_type 1082
-#define isnot_bitwise_or_type 1083
-#define is_bitwise_or_type 1084
-#define bitwise_or_type 1085  // Left-recursive
-#define bitwise_xor_type 1086  // Left-recursive
-#define bitwise_and_type 1087  // Left-recursive
-#define shift_expr_type 1088  // Left-recursive
-#define sum_type 1089  // Left-recursive
-#define term_type 1090  // Left-recursive
-#define factor_type 1091
-#define power_type 1092
-#define await_primary_type 1093
-#define primary_type 1094  // Left-recursive
-#define slicing_type 1095
-#define slice_expressions_type 1096
-#define slices_type 1097
-#define slice_type 1098
-#define atom_type 1099
-#define list_type 1100
-#define listcomp_type 1101
-#define tuple_type 1102
-#define group_type 1103
-#define genexp_type 1104
-#define set_type 1105
-#define setcomp_type 1106
-#define dict_type 1107
-#define dictcomp_type 1108
-#define kvpairs_type 1109
-#define kvpair_type 1110
-#define for_if_clauses_type 1111
-#define yield_expr_type 1112
-#define arguments_type 1113
-#define args_type 1114
-#define kwargs_type 1115
-#define starred_expression_type 1116
-#define kwarg_type 1117
-#define star_targets_type 1118
-#define star_targets_seq_type 1119
-#define star_target_type 1120
-#define star_atom_type 1121
-#define inside_paren_ann_assign_target_type 1122
-#define ann_assign_subscript_attribute_target_type 1123
-#define del_targets_type 1124
-#define del_target_type 1125
-#define del_t_atom_type 1126
-#define targets_type 1127
-#define target_type 1128
-#define t_primary_type 1129  // Left-recursive
-#define t_lookahead_type 1130
-#define t_atom_type 1131
-#define _loop1_1_type 1132
-#define _loop0_3_type 1133
-#define _gather_2_type 1134
-#define _tmp_4_type 1135
-#define _tmp_5_type 1136
-#define _tmp_6_type 1137
-#define _tmp_7_type 1138
-#define _tmp_8_type 1139
-#define _tmp_9_type 1140
-#define _tmp_10_type 1141
-#define _tmp_11_type 1142
-#define _loop1_12_type 1143
-#define _tmp_13_type 1144
-#define _tmp_14_type 1145
-#define _loop0_16_type 1146
-#define _gather_15_type 1147
-#define _loop0_18_type 1148
+static int
+classify_keyword(const char *s, int len)
+{
+    switch (len) {
+        case 2:
+            switch (s[0]) {
+                case 'a':
+                    if (memcmp(s + 1, "s", 1) == 0) {
+                        return 530;
+                    }
+                    break;
+                case 'i':
+                    switch (s[1]) {
+                        case 'f':
+                            return 510;
+                        case 'n':
+                            return 518;
+                        case 's':
+                            return 526;
+                    }
+                    break;
+                case 'o':
+                    if (memcmp(s + 1, "r", 1) == 0) {
+                        return 531;
+                    }
+                    break;
+            }
+            break;
+        case 3:
+            switch (s[0]) {
+                case 'a':
+                    if (memcmp(s + 1, "nd", 2) == 0) {
+                        return 532;
+                    }
+                    break;
+                case 'd':
+                    switch (s[1]) {
+                        case 'e':
+                            switch (s[2]) {
+                                case 'f':
+                                    return 522;
+                                case 'l':
+                                    return 503;
+                            }
+                            break;
+                    }
+                    break;
+                case 'f':
+                    if (memcmp(s + 1, "or", 2) == 0) {
+                        return 517;
+                    }
+                    break;
+                case 'n':
+                    if (memcmp(s + 1, "ot", 2) == 0) {
+                        return 525;
+                    }
+                    break;
+                case 't':
+                    if (memcmp(s + 1, "ry", 2) == 0) {
+                        return 511;
+                    }
+                    break;
+            }
+            break;
+        case 4:
+            switch (s[0]) {
+                case 'N':
+                    if (memcmp(s + 1, "one", 3) == 0) {
+                        return 529;
+                    }
+                    break;
+                case 'T':
+                    if (memcmp(s + 1, "rue", 3) == 0) {
+                        return 527;
+                    }
+                    break;
+                case 'e':
+                    switch (s[1]) {
+                        case 'l':
+                            switch (s[2]) {
+                                case 'i':
+                                    if (memcmp(s + 3, "f", 1) == 0) {
+                                        return 515;
+                                    }
+                                    break;
+                                case 's':
+                                    if (memcmp(s + 3, "e", 1) == 0) {
+                                        return 516;
+                                    }
+                                    break;
+                            }
+                            break;
+                    }
+                    break;
+                case 'f':
+                    if (memcmp(s + 1, "rom", 3) == 0) {
+                        return 514;
+                    }
+                    break;
+                case 'p':
+                    if (memcmp(s + 1, "ass", 3) == 0) {
+                        return 502;
+                    }
+                    break;
+                case 'w':
+                    if (memcmp(s + 1, "ith", 3) == 0) {
+                        return 519;
+                    }
+                    break;
+            }
+            break;
+        case 5:
+            switch (s[0]) {
+                case 'F':
+                    if (memcmp(s + 1, "alse", 4) == 0) {
+                        return 528;
+                    }
+                    break;
+                case 'b':
+                    if (memcmp(s + 1, "reak", 4) == 0) {
+                        return 506;
+                    }
+                    break;
+                case 'c':
+                    if (memcmp(s + 1, "lass", 4) == 0) {
+                        return 523;
+                    }
+                    break;
+                case 'r':
+                    if (memcmp(s + 1, "aise", 4) == 0) {
+                        return 501;
+                    }
+                    break;
+                case 'w':
+                    if (memcmp(s + 1, "hile", 4) == 0) {
+                        return 512;
+                    }
+                    break;
+                case 'y':
+                    if (memcmp(s + 1, "ield", 4) == 0) {
+                        return 504;
+                    }
+                    break;
+            }
+            break;
+        case 6:
+            switch (s[0]) {
+                case 'a':
+                    if (memcmp(s + 1, "ssert", 5) == 0) {
+                        return 505;
+                    }
+                    break;
+                case 'e':
+                    if (memcmp(s + 1, "xcept", 5) == 0) {
+                        return 520;
+                    }
+                    break;
+                case 'g':
+                    if (memcmp(s + 1, "lobal", 5) == 0) {
+                        return 508;
+                    }
+                    break;
+                case 'i':
+                    if (memcmp(s + 1, "mport", 5) == 0) {
+                        return 513;
+                    }
+                    break;
+                case 'l':
+                    if (memcmp(s + 1, "ambda", 5) == 0) {
+                        return 524;
+                    }
+                    break;
+                case 'r':
+                    if (memcmp(s + 1, "eturn", 5) == 0) {
+                        return 500;
+                    }
+                    break;
+            }
+            break;
+        case 7:
+            if (memcmp(s + 0, "finally", 7) == 0) {
+                return 521;
+            }
+            break;
+        case 8:
+            switch (s[0]) {
+                case 'c':
+                    if (memcmp(s + 1, "ontinue", 7) == 0) {
+                        return 507;
+                    }
+                    break;
+                case 'n':
+                    if (memcmp(s + 1, "onlocal", 7) == 0) {
+                        return 509;
+                    }
+                    break;
+            }
+            break;
+    }
+    return NAME;
+}
+const int n_memo_rules = 22;
+const MEMO_BACKEND memo_backend = MEMO_LIST;
+#define small_stmt_type 1000
+#define dotted_name_type 1001  // Left-recursive
+#define plain_names_type 1002
+#define block_type 1003
+#define star_expression_type 1004
+#define expression_type 1005
+#define lambda_plain_names_type 1006
+#define disjunction_type 1007
+#define conjunction_type 1008
+#define inversion_type 1009
+#define bitwise_or_type 1010  // Left-recursive
+#define bitwise_xor_type 1011  // Left-recursive
+#define bitwise_and_type 1012  // Left-recursive
+#define shift_expr_type 1013  // Left-recursive
+#define sum_type 1014  // Left-recursive
+#define term_type 1015  // Left-recursive
+#define factor_type 1016
+#define primary_type 1017  // Left-recursive
+#define slice_expressions_type 1018
+#define atom_type 1019
+#define arguments_type 1020
+#define t_primary_type 1021  // Left-recursive
+#define start_type 1022
+#define statements_type 1023
+#define eval_type 1024
+#define statement_type 1025
+#define simple_stmt_type 1026
+#define compound_stmt_type 1027
+#define assignment_type 1028
+#define augassign_type 1029
+#define global_stmt_type 1030
+#define nonlocal_stmt_type 1031
+#define yield_stmt_type 1032
+#define assert_stmt_type 1033
+#define del_stmt_type 1034
+#define import_stmt_type 1035
+#define import_name_type 1036
+#define import_from_type 1037
+#define import_from_targets_type 1038
+#define import_from_as_names_type 1039
+#define import_from_as_name_type 1040
+#define dotted_as_names_type 1041
+#define dotted_as_name_type 1042
+#define if_stmt_type 1043
+#define elif_stmt_type 1044
+#define else_block_type 1045
+#define while_stmt_type 1046
+#define for_stmt_type 1047
+#define with_stmt_type 1048
+#define with_item_type 1049
+#define try_stmt_type 1050
+#define except_block_type 1051
+#define finally_block_type 1052
+#define return_stmt_type 1053
+#define raise_stmt_type 1054
+#define function_def_type 1055
+#define function_def_raw_type 1056
+#define parameters_type 1057
+#define slash_without_default_type 1058
+#define slash_with_default_type 1059
+#define star_etc_type 1060
+#define name_with_optional_default_type 1061
+#define names_with_default_type 1062
+#define name_with_default_type 1063
+#define plain_name_type 1064
+#define kwds_type 1065
+#define annotation_type 1066
+#define decorators_type 1067
+#define class_def_type 1068
+#define class_def_raw_type 1069
+#define expressions_list_type 1070
+#define expressions_type 1071
+#define star_named_expressions_type 1072
+#define star_named_expression_type 1073
+#define named_expression_type 1074
+#define annotated_rhs_type 1075
+#define lambdef_type 1076
+#define lambda_parameters_type 1077
+#define lambda_slash_without_default_type 1078
+#define lambda_slash_with_default_type 1079
+#define lambda_star_etc_type 1080
+#define lambda_name_with_optional_default_type 1081
+#define lambda_names_with_default_type 1082
+#define lambda_name_with_default_type 1083
+#define lambda_plain_name_type 1084
+#define lambda_kwds_type 1085
+#define comparison_type 1086
+#define compare_op_bitwise_or_pair_type 1087
+#define eq_bitwise_or_type 1088
+#define noteq_bitwise_or_type 1089
+#define lte_bitwise_or_type 1090
+#define lt_bitwise_or_type 1091
+#define gte_bitwise_or_type 1092
+#define gt_bitwise_or_type 1093
+#define notin_bitwise_or_type 1094
+#define in_bitwise_or_type 1095
+#define isnot_bitwise_or_type 1096
+#define is_bitwise_or_type 1097
+#define power_type 1098
+#define await_primary_type 1099
+#define slicing_type 1100
+#define slices_type 1101
+#define slice_type 1102
+#define list_type 1103
+#define listcomp_type 1104
+#define tuple_type 1105
+#define group_type 1106
+#define genexp_type 1107
+#define set_type 1108
+#define setcomp_type 1109
+#define dict_type 1110
+#define dictcomp_type 1111
+#define kvpairs_type 1112
+#define kvpair_type 1113
+#define for_if_clauses_type 1114
+#define yield_expr_type 1115
+#define args_type 1116
+#define kwargs_type 1117
+#define starred_expression_type 1118
+#define kwarg_type 1119
+#define star_targets_type 1120
+#define star_targets_seq_type 1121
+#define star_target_type 1122
+#define star_atom_type 1123
+#define inside_paren_ann_assign_target_type 1124
+#define ann_assign_subscript_attribute_target_type 1125
+#define del_targets_type 1126
+#define del_target_type 1127
+#define del_t_atom_type 1128
+#define targets_type 1129
+#define target_type 1130
+#define t_lookahead_type 1131
+#define t_atom_type 1132
+#define _loop0_1_type 1133
+#define _loop1_2_type 1134
+#define _loop0_3_type 1135
+#define _gather_4_type 1136
+#define _tmp_5_type 1137
+#define _tmp_6_type 1138
+#define _tmp_7_type 1139
+#define _tmp_8_type 1140
+#define _tmp_9_type 1141
+#define _tmp_10_type 1142
+#define _tmp_11_type 1143
+#define _tmp_12_type 1144
+#define _loop1_13_type 1145
+#define _tmp_14_type 1146
+#define _tmp_15_type 1147
+#define _gather_16_type 1148
 #define _gather_17_type 1149
-#define _tmp_19_type 1150
-#define _loop0_20_type 1151
-#define _loop1_21_type 1152
-#define _loop0_23_type 1153
-#define _gather_22_type 1154
-#define _tmp_24_type 1155
-#define _loop0_26_type 1156
+#define _tmp_18_type 1150
+#define _loop0_19_type 1151
+#define _loop1_20_type 1152
+#define _gather_21_type 1153
+#define _tmp_22_type 1154
+#define _gather_23_type 1155
+#define _tmp_24_type 1156
 #define _gather_25_type 1157
-#define _tmp_27_type 1158
-#define _loop0_29_type 1159
+#define _gather_26_type 1158
+#define _gather_27_type 1159
 #define _gather_28_type 1160
-#define _loop0_31_type 1161
-#define _gather_30_type 1162
-#define _loop0_33_type 1163
-#define _gather_32_type 1164
-#define _loop0_35_type 1165
-#define _gather_34_type 1166
-#define _tmp_36_type 1167
-#define _loop1_37_type 1168
-#define _tmp_38_type 1169
-#define _tmp_39_type 1170
-#define _tmp_40_type 1171
-#define _tmp_41_type 1172
-#define _tmp_42_type 1173
-#define _tmp_43_type 1174
-#define _tmp_44_type 1175
-#define _tmp_45_type 1176
-#define _tmp_46_type 1177
-#define _tmp_47_type 1178
-#define _tmp_48_type 1179
-#define _tmp_49_type 1180
-#define _tmp_50_type 1181
-#define _loop0_51_type 1182
-#define _tmp_52_type 1183
-#define _loop1_53_type 1184
-#define _tmp_54_type 1185
-#define _tmp_55_type 1186
-#define _loop0_57_type 1187
-#define _gather_56_type 1188
-#define _loop0_59_type 1189
-#define _gather_58_type 1190
-#define _tmp_60_type 1191
-#define _loop1_61_type 1192
-#define _tmp_62_type 1193
-#define _loop0_64_type 1194
-#define _gather_63_type 1195
-#define _loop1_65_type 1196
-#define _loop0_67_type 1197
-#define _gather_66_type 1198
-#define _tmp_68_type 1199
-#define _tmp_69_type 1200
-#define _tmp_70_type 1201
-#define _tmp_71_type 1202
-#define _tmp_72_type 1203
-#define _tmp_73_type 1204
-#define _tmp_74_type 1205
-#define _tmp_75_type 1206
-#define _tmp_76_type 1207
-#define _loop0_77_type 1208
-#define _tmp_78_type 1209
-#define _loop1_79_type 1210
-#define _tmp_80_type 1211
-#define _tmp_81_type 1212
-#define _loop0_83_type 1213
-#define _gather_82_type 1214
-#define _loop0_85_type 1215
-#define _gather_84_type 1216
-#define _loop1_86_type 1217
-#define _loop1_87_type 1218
-#define _loop1_88_type 1219
-#define _loop0_90_type 1220
-#define _gather_89_type 1221
-#define _loop0_92_type 1222
+#define _tmp_29_type 1161
+#define _loop1_30_type 1162
+#define _tmp_31_type 1163
+#define _tmp_32_type 1164
+#define _tmp_33_type 1165
+#define _tmp_34_type 1166
+#define _tmp_35_type 1167
+#define _tmp_36_type 1168
+#define _tmp_37_type 1169
+#define _tmp_38_type 1170
+#define _tmp_39_type 1171
+#define _tmp_40_type 1172
+#define _tmp_41_type 1173
+#define _tmp_42_type 1174
+#define _tmp_43_type 1175
+#define _loop0_44_type 1176
+#define _tmp_45_type 1177
+#define _loop1_46_type 1178
+#define _tmp_47_type 1179
+#define _tmp_48_type 1180
+#define _gather_49_type 1181
+#define _gather_50_type 1182
+#define _tmp_51_type 1183
+#define _tmp_52_type 1184
+#define _loop1_53_type 1185
+#define _tmp_54_type 1186
+#define _gather_55_type 1187
+#define _loop1_56_type 1188
+#define _gather_57_type 1189
+#define _tmp_58_type 1190
+#define _tmp_59_type 1191
+#define _tmp_60_type 1192
+#define _tmp_61_type 1193
+#define _tmp_62_type 1194
+#define _tmp_63_type 1195
+#define _tmp_64_type 1196
+#define _tmp_65_type 1197
+#define _tmp_66_type 1198
+#define _loop0_67_type 1199
+#define _tmp_68_type 1200
+#define _loop1_69_type 1201
+#define _tmp_70_type 1202
+#define _tmp_71_type 1203
+#define _gather_72_type 1204
+#define _gather_73_type 1205
+#define _tmp_74_type 1206
+#define _loop1_75_type 1207
+#define _loop1_76_type 1208
+#define _loop1_77_type 1209
+#define _gather_78_type 1210
+#define _gather_79_type 1211
+#define _tmp_80_type 1212
+#define _loop1_81_type 1213
+#define _tmp_82_type 1214
+#define _tmp_83_type 1215
+#define _tmp_84_type 1216
+#define _tmp_85_type 1217
+#define _tmp_86_type 1218
+#define _gather_87_type 1219
+#define _loop1_88_type 1220
+#define _tmp_89_type 1221
+#define _tmp_90_type 1222
 #define _gather_91_type 1223
-#define _tmp_93_type 1224
-#define _loop1_94_type 1225
-#define _tmp_95_type 1226
-#define _tmp_96_type 1227
-#define _tmp_97_type 1228
-#define _tmp_98_type 1229
-#define _tmp_99_type 1230
-#define _loop0_101_type 1231
-#define _gather_100_type 1232
-#define _loop1_102_type 1233
-#define _tmp_103_type 1234
-#define _tmp_104_type 1235
-#define _loop0_106_type 1236
-#define _gather_105_type 1237
-#define _loop0_107_type 1238
-#define _loop0_109_type 1239
-#define _gather_108_type 1240
-#define _loop0_111_type 1241
-#define _gather_110_type 1242
-#define _loop0_113_type 1243
-#define _gather_112_type 1244
-#define _tmp_114_type 1245
-#define _tmp_115_type 1246
-#define _tmp_116_type 1247
-#define _tmp_117_type 1248
-#define _tmp_118_type 1249
-#define _tmp_119_type 1250
-#define _tmp_120_type 1251
-#define _tmp_121_type 1252
-#define _tmp_122_type 1253
-#define _tmp_123_type 1254
-#define _tmp_124_type 1255
-#define _loop0_125_type 1256
-#define _tmp_126_type 1257
+#define _loop0_92_type 1224
+#define _gather_93_type 1225
+#define _gather_94_type 1226
+#define _gather_95_type 1227
+#define _tmp_96_type 1228
+#define _tmp_97_type 1229
+#define _tmp_98_type 1230
+#define _tmp_99_type 1231
+#define _tmp_100_type 1232
+#define _tmp_101_type 1233
+#define _tmp_102_type 1234
+#define _tmp_103_type 1235
+#define _tmp_104_type 1236
+#define _loop0_105_type 1237
+#define _tmp_106_type 1238
+
+const int n_rules = 239;
+const int counts_rule_calls = 0;
+const char *const rule_names[] = {
+    "small_stmt",
+    "dotted_name",
+    "plain_names",
+    "block",
+    "star_expression",
+    "expression",
+    "lambda_plain_names",
+    "disjunction",
+    "conjunction",
+    "inversion",
+    "bitwise_or",
+    "bitwise_xor",
+    "bitwise_and",
+    "shift_expr",
+    "sum",
+    "term",
+    "factor",
+    "primary",
+    "slice_expressions",
+    "atom",
+    "arguments",
+    "t_primary",
+    "start",
+    "statements",
+    "eval",
+    "statement",
+    "simple_stmt",
+    "compound_stmt",
+    "assignment",
+    "augassign",
+    "global_stmt",
+    "nonlocal_stmt",
+    "yield_stmt",
+    "assert_stmt",
+    "del_stmt",
+    "import_stmt",
+    "import_name",
+    "import_from",
+    "import_from_targets",
+    "import_from_as_names",
+    "import_from_as_name",
+    "dotted_as_names",
+    "dotted_as_name",
+    "if_stmt",
+    "elif_stmt",
+    "else_block",
+    "while_stmt",
+    "for_stmt",
+    "with_stmt",
+    "with_item",
+    "try_stmt",
+    "except_block",
+    "finally_block",
+    "return_stmt",
+    "raise_stmt",
+    "function_def",
+    "function_def_raw",
+    "parameters",
+    "slash_without_default",
+    "slash_with_default",
+    "star_etc",
+    "name_with_optional_default",
+    "names_with_default",
+    "name_with_default",
+    "plain_name",
+    "kwds",
+    "annotation",
+    "decorators",
+    "class_def",
+    "class_def_raw",
+    "expressions_list",
+    "expressions",
+    "star_named_expressions",
+    "star_named_expression",
+    "named_expression",
+    "annotated_rhs",
+    "lambdef",
+    "lambda_parameters",
+    "lambda_slash_without_default",
+    "lambda_slash_with_default",
+    "lambda_star_etc",
+    "lambda_name_with_optional_default",
+    "lambda_names_with_default",
+    "lambda_name_with_default",
+    "lambda_plain_name",
+    "lambda_kwds",
+    "comparison",
+    "compare_op_bitwise_or_pair",
+    "eq_bitwise_or",
+    "noteq_bitwise_or",
+    "lte_bitwise_or",
+    "lt_bitwise_or",
+    "gte_bitwise_or",
+    "gt_bitwise_or",
+    "notin_bitwise_or",
+    "in_bitwise_or",
+    "isnot_bitwise_or",
+    "is_bitwise_or",
+    "power",
+    "await_primary",
+    "slicing",
+    "slices",
+    "slice",
+    "list",
+    "listcomp",
+    "tuple",
+    "group",
+    "genexp",
+    "set",
+    "setcomp",
+    "dict",
+    "dictcomp",
+    "kvpairs",
+    "kvpair",
+    "for_if_clauses",
+    "yield_expr",
+    "args",
+    "kwargs",
+    "starred_expression",
+    "kwarg",
+    "star_targets",
+    "star_targets_seq",
+    "star_target",
+    "star_atom",
+    "inside_paren_ann_assign_target",
+    "ann_assign_subscript_attribute_target",
+    "del_targets",
+    "del_target",
+    "del_t_atom",
+    "targets",
+    "target",
+    "t_lookahead",
+    "t_atom",
+    "_loop0_1",
+    "_loop1_2",
+    "_loop0_3",
+    "_gather_4",
+    "_tmp_5",
+    "_tmp_6",
+    "_tmp_7",
+    "_tmp_8",
+    "_tmp_9",
+    "_tmp_10",
+    "_tmp_11",
+    "_tmp_12",
+    "_loop1_13",
+    "_tmp_14",
+    "_tmp_15",
+    "_gather_16",
+    "_gather_17",
+    "_tmp_18",
+    "_loop0_19",
+    "_loop1_20",
+    "_gather_21",
+    "_tmp_22",
+    "_gather_23",
+    "_tmp_24",
+    "_gather_25",
+    "_gather_26",
+    "_gather_27",
+    "_gather_28",
+    "_tmp_29",
+    "_loop1_30",
+    "_tmp_31",
+    "_tmp_32",
+    "_tmp_33",
+    "_tmp_34",
+    "_tmp_35",
+    "_tmp_36",
+    "_tmp_37",
+    "_tmp_38",
+    "_tmp_39",
+    "_tmp_40",
+    "_tmp_41",
+    "_tmp_42",
+    "_tmp_43",
+    "_loop0_44",
+    "_tmp_45",
+    "_loop1_46",
+    "_tmp_47",
+    "_tmp_48",
+    "_gather_49",
+    "_gather_50",
+    "_tmp_51",
+    "_tmp_52",
+    "_loop1_53",
+    "_tmp_54",
+    "_gather_55",
+    "_loop1_56",
+    "_gather_57",
+    "_tmp_58",
+    "_tmp_59",
+    "_tmp_60",
+    "_tmp_61",
+    "_tmp_62",
+    "_tmp_63",
+    "_tmp_64",
+    "_tmp_65",
+    "_tmp_66",
+    "_loop0_67",
+    "_tmp_68",
+    "_loop1_69",
+    "_tmp_70",
+    "_tmp_71",
+    "_gather_72",
+    "_gather_73",
+    "_tmp_74",
+    "_loop1_75",
+    "_loop1_76",
+    "_loop1_77",
+    "_gather_78",
+    "_gather_79",
+    "_tmp_80",
+    "_loop1_81",
+    "_tmp_82",
+    "_tmp_83",
+    "_tmp_84",
+    "_tmp_85",
+    "_tmp_86",
+    "_gather_87",
+    "_loop1_88",
+    "_tmp_89",
+    "_tmp_90",
+    "_gather_91",
+    "_loop0_92",
+    "_gather_93",
+    "_gather_94",
+    "_gather_95",
+    "_tmp_96",
+    "_tmp_97",
+    "_tmp_98",
+    "_tmp_99",
+    "_tmp_100",
+    "_tmp_101",
+    "_tmp_102",
+    "_tmp_103",
+    "_tmp_104",
+    "_loop0_105",
+    "_tmp_106",
+};
 
 static mod_ty start_rule(Parser *p);
 static asdl_seq* statements_rule(Parser *p);
+static mod_ty eval_rule(Parser *p);
 static asdl_seq* statement_rule(Parser *p);
 static asdl_seq* simple_stmt_rule(Parser *p);
 static stmt_ty small_stmt_rule(Parser *p);
@@ -450,10 +879,10 @@ static expr_ty target_rule(Parser *p);
 static expr_ty t_primary_rule(Parser *p);
 static void *t_lookahead_rule(Parser *p);
 static expr_ty t_atom_rule(Parser *p);
-static asdl_seq *_loop1_1_rule(Parser *p);
+static asdl_seq *_loop0_1_rule(Parser *p);
+static asdl_seq *_loop1_2_rule(Parser *p);
 static asdl_seq *_loop0_3_rule(Parser *p);
-static asdl_seq *_gather_2_rule(Parser *p);
-static void *_tmp_4_rule(Parser *p);
+static asdl_seq *_gather_4_rule(Parser *p);
 static void *_tmp_5_rule(Parser *p);
 static void *_tmp_6_rule(Parser *p);
 static void *_tmp_7_rule(Parser *p);
@@ -461,141 +890,126 @@ static void *_tmp_8_rule(Parser *p);
 static void *_tmp_9_rule(Parser *p);
 static void *_tmp_10_rule(Parser *p);
 static void *_tmp_11_rule(Parser *p);
-static asdl_seq *_loop1_12_rule(Parser *p);
-static void *_tmp_13_rule(Parser *p);
+static void *_tmp_12_rule(Parser *p);
+static asdl_seq *_loop1_13_rule(Parser *p);
 static void *_tmp_14_rule(Parser *p);
-static asdl_seq *_loop0_16_rule(Parser *p);
-static asdl_seq *_gather_15_rule(Parser *p);
-static asdl_seq *_loop0_18_rule(Parser *p);
+static void *_tmp_15_rule(Parser *p);
+static asdl_seq *_gather_16_rule(Parser *p);
 static asdl_seq *_gather_17_rule(Parser *p);
-static void *_tmp_19_rule(Parser *p);
-static asdl_seq *_loop0_20_rule(Parser *p);
-static asdl_seq *_loop1_21_rule(Parser *p);
-static asdl_seq *_loop0_23_rule(Parser *p);
-static asdl_seq *_gather_22_rule(Parser *p);
+static void *_tmp_18_rule(Parser *p);
+static asdl_seq *_loop0_19_rule(Parser *p);
+static asdl_seq *_loop1_20_rule(Parser *p);
+static asdl_seq *_gather_21_rule(Parser *p);
+static void *_tmp_22_rule(Parser *p);
+static asdl_seq *_gather_23_rule(Parser *p);
 static void *_tmp_24_rule(Parser *p);
-static asdl_seq *_loop0_26_rule(Parser *p);
 static asdl_seq *_gather_25_rule(Parser *p);
-static void *_tmp_27_rule(Parser *p);
-static asdl_seq *_loop0_29_rule(Parser *p);
+static asdl_seq *_gather_26_rule(Parser *p);
+static asdl_seq *_gather_27_rule(Parser *p);
 static asdl_seq *_gather_28_rule(Parser *p);
-static asdl_seq *_loop0_31_rule(Parser *p);
-static asdl_seq *_gather_30_rule(Parser *p);
-static asdl_seq *_loop0_33_rule(Parser *p);
-static asdl_seq *_gather_32_rule(Parser *p);
-static asdl_seq *_loop0_35_rule(Parser *p);
-static asdl_seq *_gather_34_rule(Parser *p);
+static void *_tmp_29_rule(Parser *p);
+static asdl_seq *_loop1_30_rule(Parser *p);
+static void *_tmp_31_rule(Parser *p);
+static void *_tmp_32_rule(Parser *p);
+static void *_tmp_33_rule(Parser *p);
+static void *_tmp_34_rule(Parser *p);
+static void *_tmp_35_rule(Parser *p);
 static void *_tmp_36_rule(Parser *p);
-static asdl_seq *_loop1_37_rule(Parser *p);
+static void *_tmp_37_rule(Parser *p);
 static void *_tmp_38_rule(Parser *p);
 static void *_tmp_39_rule(Parser *p);
 static void *_tmp_40_rule(Parser *p);
 static void *_tmp_41_rule(Parser *p);
 static void *_tmp_42_rule(Parser *p);
 static void *_tmp_43_rule(Parser *p);
-static void *_tmp_44_rule(Parser *p);
+static asdl_seq *_loop0_44_rule(Parser *p);
 static void *_tmp_45_rule(Parser *p);
-static void *_tmp_46_rule(Parser *p);
+static asdl_seq *_loop1_46_rule(Parser *p);
 static void *_tmp_47_rule(Parser *p);
 static void *_tmp_48_rule(Parser *p);
-static void *_tmp_49_rule(Parser *p);
-static void *_tmp_50_rule(Parser *p);
-static asdl_seq *_loop0_51_rule(Parser *p);
+static asdl_seq *_gather_49_rule(Parser *p);
+static asdl_seq *_gather_50_rule(Parser *p);
+static void *_tmp_51_rule(Parser *p);
 static void *_tmp_52_rule(Parser *p);
 static asdl_seq *_loop1_53_rule(Parser *p);
 static void *_tmp_54_rule(Parser *p);
-static void *_tmp_55_rule(Parser *p);
-static asdl_seq *_loop0_57_rule(Parser *p);
-static asdl_seq *_gather_56_rule(Parser *p);
-static asdl_seq *_loop0_59_rule(Parser *p);
-static asdl_seq *_gather_58_rule(Parser *p);
+static asdl_seq *_gather_55_rule(Parser *p);
+static asdl_seq *_loop1_56_rule(Parser *p);
+static asdl_seq *_gather_57_rule(Parser *p);
+static void *_tmp_58_rule(Parser *p);
+static void *_tmp_59_rule(Parser *p);
 static void *_tmp_60_rule(Parser *p);
-static asdl_seq *_loop1_61_rule(Parser *p);
+static void *_tmp_61_rule(Parser *p);
 static void *_tmp_62_rule(Parser *p);
-static asdl_seq *_loop0_64_rule(Parser *p);
-static asdl_seq *_gather_63_rule(Parser *p);
-static asdl_seq *_loop1_65_rule(Parser *p);
+static void *_tmp_63_rule(Parser *p);
+static void *_tmp_64_rule(Parser *p);
+static void *_tmp_65_rule(Parser *p);
+static void *_tmp_66_rule(Parser *p);
 static asdl_seq *_loop0_67_rule(Parser *p);
-static asdl_seq *_gather_66_rule(Parser *p);
 static void *_tmp_68_rule(Parser *p);
-static void *_tmp_69_rule(Parser *p);
+static asdl_seq *_loop1_69_rule(Parser *p);
 static void *_tmp_70_rule(Parser *p);
 static void *_tmp_71_rule(Parser *p);
-static void *_tmp_72_rule(Parser *p);
-static void *_tmp_73_rule(Parser *p);
+static asdl_seq *_gather_72_rule(Parser *p);
+static asdl_seq *_gather_73_rule(Parser *p);
 static void *_tmp_74_rule(Parser *p);
-static void *_tmp_75_rule(Parser *p);
-static void *_tmp_76_rule(Parser *p);
-static asdl_seq *_loop0_77_rule(Parser *p);
-static void *_tmp_78_rule(Parser *p);
-static asdl_seq *_loop1_79_rule(Parser *p);
+static asdl_seq *_loop1_75_rule(Parser *p);
+static asdl_seq *_loop1_76_rule(Parser *p);
+static asdl_seq *_loop1_77_rule(Parser *p);
+static asdl_seq *_gather_78_rule(Parser *p);
+static asdl_seq *_gather_79_rule(Parser *p);
 static void *_tmp_80_rule(Parser *p);
-static void *_tmp_81_rule(Parser *p);
-static asdl_seq *_loop0_83_rule(Parser *p);
-static asdl_seq *_gather_82_rule(Parser *p);
-static asdl_seq *_loop0_85_rule(Parser *p);
-static asdl_seq *_gather_84_rule(Parser *p);
-static asdl_seq *_loop1_86_rule(Parser *p);
-static asdl_seq *_loop1_87_rule(Parser *p);
+static asdl_seq *_loop1_81_rule(Parser *p);
+static void *_tmp_82_rule(Parser *p);
+static void *_tmp_83_rule(Parser *p);
+static void *_tmp_84_rule(Parser *p);
+static void *_tmp_85_rule(Parser *p);
+static void *_tmp_86_rule(Parser *p);
+static asdl_seq *_gather_87_rule(Parser *p);
 static asdl_seq *_loop1_88_rule(Parser *p);
-static asdl_seq *_loop0_90_rule(Parser *p);
-static asdl_seq *_gather_89_rule(Parser *p);
-static asdl_seq *_loop0_92_rule(Parser *p);
+static void *_tmp_89_rule(Parser *p);
+static void *_tmp_90_rule(Parser *p);
 static asdl_seq *_gather_91_rule(Parser *p);
-static void *_tmp_93_rule(Parser *p);
-static asdl_seq *_loop1_94_rule(Parser *p);
-static void *_tmp_95_rule(Parser *p);
+static asdl_seq *_loop0_92_rule(Parser *p);
+static asdl_seq *_gather_93_rule(Parser *p);
+static asdl_seq *_gather_94_rule(Parser *p);
+static asdl_seq *_gather_95_rule(Parser *p);
 static void *_tmp_96_rule(Parser *p);
 static void *_tmp_97_rule(Parser *p);
 static void *_tmp_98_rule(Parser *p);
 static void *_tmp_99_rule(Parser *p);
-static asdl_seq *_loop0_101_rule(Parser *p);
-static asdl_seq *_gather_100_rule(Parser *p);
-static asdl_seq *_loop1_102_rule(Parser *p);
+static void *_tmp_100_rule(Parser *p);
+static void *_tmp_101_rule(Parser *p);
+static void *_tmp_102_rule(Parser *p);
 static void *_tmp_103_rule(Parser *p);
 static void *_tmp_104_rule(Parser *p);
-static asdl_seq *_loop0_106_rule(Parser *p);
-static asdl_seq *_gather_105_rule(Parser *p);
-static asdl_seq *_loop0_107_rule(Parser *p);
-static asdl_seq *_loop0_109_rule(Parser *p);
-static asdl_seq *_gather_108_rule(Parser *p);
-static asdl_seq *_loop0_111_rule(Parser *p);
-static asdl_seq *_gather_110_rule(Parser *p);
-static asdl_seq *_loop0_113_rule(Parser *p);
-static asdl_seq *_gather_112_rule(Parser *p);
-static void *_tmp_114_rule(Parser *p);
-static void *_tmp_115_rule(Parser *p);
-static void *_tmp_116_rule(Parser *p);
-static void *_tmp_117_rule(Parser *p);
-static void *_tmp_118_rule(Parser *p);
-static void *_tmp_119_rule(Parser *p);
-static void *_tmp_120_rule(Parser *p);
-static void *_tmp_121_rule(Parser *p);
-static void *_tmp_122_rule(Parser *p);
-static void *_tmp_123_rule(Parser *p);
-static void *_tmp_124_rule(Parser *p);
-static asdl_seq *_loop0_125_rule(Parser *p);
-static void *_tmp_126_rule(Parser *p);
-
-
-// start: statements? $
+static asdl_seq *_loop0_105_rule(Parser *p);
+static void *_tmp_106_rule(Parser *p);
+
+
+// start: statement* $
 static mod_ty
 start_rule(Parser *p)
 {
     mod_ty res = NULL;
     int mark = p->mark;
-    { // statements? $
-        void *a;
+    { // statement* $
+        asdl_seq * a;
         void *endmarker_var;
         if (
-            (a = statements_rule(p), 1)
+            (a = _loop0_1_rule(p))
             &&
             (endmarker_var = endmarker_token(p))
         )
         {
-            res = Module ( a , NULL , p -> arena );
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
+            }
+            else {
+                res = Module ( CHECK ( seq_flatten ( p , a ) ) , NULL , p -> arena );
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -615,12 +1029,53 @@ statements_rule(Parser *p)
     { // statement+
         asdl_seq * a;
         if (
-            (a = _loop1_1_rule(p))
+            (a = _loop1_2_rule(p))
         )
         {
-            res = seq_flatten ( p , a );
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
+            }
+            else {
+                res = seq_flatten ( p , a );
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
+            }
+            goto done;
+        }
+        p->mark = mark;
+    }
+    res = NULL;
+  done:
+    return res;
+}
+
+// eval: expressions NEWLINE* $
+static mod_ty
+eval_rule(Parser *p)
+{
+    mod_ty res = NULL;
+    int mark = p->mark;
+    { // expressions NEWLINE* $
+        asdl_seq * _loop0_3_var;
+        expr_ty a;
+        void *endmarker_var;
+        if (
+            (a = expressions_rule(p))
+            &&
+            (_loop0_3_var = _loop0_3_rule(p))
+            &&
+            (endmarker_var = endmarker_token(p))
+        )
+        {
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
+            }
+            else {
+                res = Expression ( a , p -> arena );
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -631,39 +1086,68 @@ statements_rule(Parser *p)
     return res;
 }
 
-// statement: compound_stmt | simple_stmt
+// statement: compound_stmt ~ | simple_stmt ~
 static asdl_seq*
 statement_rule(Parser *p)
 {
     asdl_seq* res = NULL;
     int mark = p->mark;
-    { // compound_stmt
+    int choice_mark = enter_choice(p, mark);
+    { // compound_stmt ~
         stmt_ty a;
+        int cut_var = 0;
         if (
             (a = compound_stmt_rule(p))
+            &&
+            (cut_var = cut(p, p->choice_mark))
         )
         {
-            res = singleton_seq ( p , a );
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
+            }
+            else {
+                res = singleton_seq ( p , a );
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
         p->mark = mark;
+        if (cut_var) {
+            res = NULL;
+            goto done;
+        }
     }
-    { // simple_stmt
-        asdl_seq* simple_stmt_var;
+    { // simple_stmt ~
+        asdl_seq* a;
+        int cut_var = 0;
         if (
-            (simple_stmt_var = simple_stmt_rule(p))
+            (a = simple_stmt_rule(p))
+            &&
+            (cut_var = cut(p, p->choice_mark))
         )
         {
-            res = simple_stmt_var;
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
+            }
+            else {
+                res = a;
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
+            }
             goto done;
         }
         p->mark = mark;
+        if (cut_var) {
+            res = NULL;
+            goto done;
+        }
     }
     res = NULL;
   done:
+    p->choice_mark = choice_mark;
     return res;
 }
 
@@ -684,9 +1168,14 @@ simple_stmt_rule(Parser *p)
             (newline_var = newline_token(p))
         )
         {
-            res = singleton_seq ( p , a );
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
+            }
+            else {
+                res = singleton_seq ( p , a );
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -697,16 +1186,21 @@ simple_stmt_rule(Parser *p)
         void *newline_var;
         void *opt_var;
         if (
-            (a = _gather_2_rule(p))
+            (a = _gather_4_rule(p))
             &&
             (opt_var = expect_token(p, 13), 1)
             &&
             (newline_var = newline_token(p))
         )
         {
-            res = a;
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
+            }
+            else {
+                res = a;
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -741,9 +1235,9 @@ small_stmt_rule(Parser *p)
     if (p->mark == p->fill && fill_token(p) < 0) {
         return NULL;
     }
-    int start_lineno = p->tokens[mark]->lineno;
+    int start_lineno = get_token(p, mark)->lineno;
     UNUSED(start_lineno); // Only used by EXTRA macro
-    int start_col_offset = p->tokens[mark]->col_offset;
+    int start_col_offset = get_token(p, mark)->col_offset;
     UNUSED(start_col_offset); // Only used by EXTRA macro
     { // assignment
         void *assignment_var;
@@ -762,17 +1256,22 @@ small_stmt_rule(Parser *p)
             (e = expressions_rule(p))
         )
         {
-            Token *token = get_last_nonnwhitespace_token(p);
-            if (token == NULL) {
-                return NULL;
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
             }
-            int end_lineno = token->end_lineno;
-            UNUSED(end_lineno); // Only used by EXTRA macro
-            int end_col_offset = token->end_col_offset;
-            UNUSED(end_col_offset); // Only used by EXTRA macro
-            res = _Py_Expr ( e , EXTRA );
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            else {
+                Token *token = get_last_nonnwhitespace_token(p);
+                if (token == NULL) {
+                    return NULL;
+                }
+                int end_lineno = token->end_lineno;
+                UNUSED(end_lineno); // Only used by EXTRA macro
+                int end_col_offset = token->end_col_offset;
+                UNUSED(end_col_offset); // Only used by EXTRA macro
+                res = _Py_Expr ( e , EXTRA );
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -794,7 +1293,7 @@ small_stmt_rule(Parser *p)
     { // &('import' | 'from') import_stmt
         stmt_ty import_stmt_var;
         if (
-            lookahead(1, _tmp_4_rule, p)
+            lookahead(1, _tmp_5_rule, p)
             &&
             (import_stmt_var = import_stmt_rule(p))
         )
@@ -823,17 +1322,22 @@ small_stmt_rule(Parser *p)
             (keyword = expect_token(p, 502))
         )
         {
-            Token *token = get_last_nonnwhitespace_token(p);
-            if (token == NULL) {
-                return NULL;
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
             }
-            int end_lineno = token->end_lineno;
-            UNUSED(end_lineno); // Only used by EXTRA macro
-            int end_col_offset = token->end_col_offset;
-            UNUSED(end_col_offset); // Only used by EXTRA macro
-            res = _Py_Pass ( EXTRA );
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            else {
+                Token *token = get_last_nonnwhitespace_token(p);
+                if (token == NULL) {
+                    return NULL;
+                }
+                int end_lineno = token->end_lineno;
+                UNUSED(end_lineno); // Only used by EXTRA macro
+                int end_col_offset = token->end_col_offset;
+                UNUSED(end_col_offset); // Only used by EXTRA macro
+                res = _Py_Pass ( EXTRA );
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -884,17 +1388,22 @@ small_stmt_rule(Parser *p)
             (keyword = expect_token(p, 506))
         )
         {
-            Token *token = get_last_nonnwhitespace_token(p);
-            if (token == NULL) {
-                return NULL;
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
             }
-            int end_lineno = token->end_lineno;
-            UNUSED(end_lineno); // Only used by EXTRA macro
-            int end_col_offset = token->end_col_offset;
-            UNUSED(end_col_offset); // Only used by EXTRA macro
-            res = _Py_Break ( EXTRA );
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            else {
+                Token *token = get_last_nonnwhitespace_token(p);
+                if (token == NULL) {
+                    return NULL;
+                }
+                int end_lineno = token->end_lineno;
+                UNUSED(end_lineno); // Only used by EXTRA macro
+                int end_col_offset = token->end_col_offset;
+                UNUSED(end_col_offset); // Only used by EXTRA macro
+                res = _Py_Break ( EXTRA );
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -906,17 +1415,22 @@ small_stmt_rule(Parser *p)
             (keyword = expect_token(p, 507))
         )
         {
-            Token *token = get_last_nonnwhitespace_token(p);
-            if (token == NULL) {
-                return NULL;
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
             }
-            int end_lineno = token->end_lineno;
-            UNUSED(end_lineno); // Only used by EXTRA macro
-            int end_col_offset = token->end_col_offset;
-            UNUSED(end_col_offset); // Only used by EXTRA macro
-            res = _Py_Continue ( EXTRA );
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            else {
+                Token *token = get_last_nonnwhitespace_token(p);
+                if (token == NULL) {
+                    return NULL;
+                }
+                int end_lineno = token->end_lineno;
+                UNUSED(end_lineno); // Only used by EXTRA macro
+                int end_col_offset = token->end_col_offset;
+                UNUSED(end_col_offset); // Only used by EXTRA macro
+                res = _Py_Continue ( EXTRA );
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -967,10 +1481,11 @@ compound_stmt_rule(Parser *p)
 {
     stmt_ty res = NULL;
     int mark = p->mark;
+    int choice_mark = enter_choice(p, mark);
     { // &('def' | '@' | ASYNC) function_def
         stmt_ty function_def_var;
         if (
-            lookahead(1, _tmp_5_rule, p)
+            lookahead(1, _tmp_6_rule, p)
             &&
             (function_def_var = function_def_rule(p))
         )
@@ -996,7 +1511,7 @@ compound_stmt_rule(Parser *p)
     { // &('class' | '@') class_def
         stmt_ty class_def_var;
         if (
-            lookahead(1, _tmp_6_rule, p)
+            lookahead(1, _tmp_7_rule, p)
             &&
             (class_def_var = class_def_rule(p))
         )
@@ -1009,7 +1524,7 @@ compound_stmt_rule(Parser *p)
     { // &('with' | ASYNC) with_stmt
         stmt_ty with_stmt_var;
         if (
-            lookahead(1, _tmp_7_rule, p)
+            lookahead(1, _tmp_8_rule, p)
             &&
             (with_stmt_var = with_stmt_rule(p))
         )
@@ -1022,7 +1537,7 @@ compound_stmt_rule(Parser *p)
     { // &('for' | ASYNC) for_stmt
         stmt_ty for_stmt_var;
         if (
-            lookahead(1, _tmp_8_rule, p)
+            lookahead(1, _tmp_9_rule, p)
             &&
             (for_stmt_var = for_stmt_rule(p))
         )
@@ -1045,6 +1560,7 @@ compound_stmt_rule(Parser *p)
         }
         p->mark = mark;
     }
+    p->choice_mark = choice_mark;
     { // &'while' while_stmt
         stmt_ty while_stmt_var;
         if (
@@ -1060,6 +1576,7 @@ compound_stmt_rule(Parser *p)
     }
     res = NULL;
   done:
+    p->choice_mark = choice_mark;
     return res;
 }
 
@@ -1076,9 +1593,9 @@ assignment_rule(Parser *p)
     if (p->mark == p->fill && fill_token(p) < 0) {
         return NULL;
     }
-    int start_lineno = p->tokens[mark]->lineno;
+    int start_lineno = get_token(p, mark)->lineno;
     UNUSED(start_lineno); // Only used by EXTRA macro
-    int start_col_offset = p->tokens[mark]->col_offset;
+    int start_col_offset = get_token(p, mark)->col_offset;
     UNUSED(start_col_offset); // Only used by EXTRA macro
     { // NAME ':' expression ['=' annotated_rhs]
         expr_ty a;
@@ -1092,20 +1609,25 @@ assignment_rule(Parser *p)
             &&
             (b = expression_rule(p))
             &&
-            (c = _tmp_9_rule(p), 1)
+            (c = _tmp_10_rule(p), 1)
         )
         {
-            Token *token = get_last_nonnwhitespace_token(p);
-            if (token == NULL) {
-                return NULL;
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
             }
-            int end_lineno = token->end_lineno;
-            UNUSED(end_lineno); // Only used by EXTRA macro
-            int end_col_offset = token->end_col_offset;
-            UNUSED(end_col_offset); // Only used by EXTRA macro
-            res = _Py_AnnAssign ( CHECK ( set_expr_context ( p , a , Store ) ) , b , c , 1 , EXTRA );
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            else {
+                Token *token = get_last_nonnwhitespace_token(p);
+                if (token == NULL) {
+                    return NULL;
+                }
+                int end_lineno = token->end_lineno;
+                UNUSED(end_lineno); // Only used by EXTRA macro
+                int end_col_offset = token->end_col_offset;
+                UNUSED(end_col_offset); // Only used by EXTRA macro
+                res = _Py_AnnAssign ( CHECK ( set_expr_context ( p , a , Store ) ) , b , c , 1 , EXTRA );
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -1117,26 +1639,31 @@ assignment_rule(Parser *p)
         void *c;
         void *literal;
         if (
-            (a = _tmp_10_rule(p))
+            (a = _tmp_11_rule(p))
             &&
             (literal = expect_token(p, 11))
             &&
             (b = expression_rule(p))
             &&
-            (c = _tmp_11_rule(p), 1)
+            (c = _tmp_12_rule(p), 1)
         )
         {
-            Token *token = get_last_nonnwhitespace_token(p);
-            if (token == NULL) {
-                return NULL;
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
             }
-            int end_lineno = token->end_lineno;
-            UNUSED(end_lineno); // Only used by EXTRA macro
-            int end_col_offset = token->end_col_offset;
-            UNUSED(end_col_offset); // Only used by EXTRA macro
-            res = _Py_AnnAssign ( a , b , c , 0 , EXTRA );
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            else {
+                Token *token = get_last_nonnwhitespace_token(p);
+                if (token == NULL) {
+                    return NULL;
+                }
+                int end_lineno = token->end_lineno;
+                UNUSED(end_lineno); // Only used by EXTRA macro
+                int end_col_offset = token->end_col_offset;
+                UNUSED(end_col_offset); // Only used by EXTRA macro
+                res = _Py_AnnAssign ( a , b , c , 0 , EXTRA );
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -1146,22 +1673,27 @@ assignment_rule(Parser *p)
         asdl_seq * a;
         void *b;
         if (
-            (a = _loop1_12_rule(p))
+            (a = _loop1_13_rule(p))
             &&
-            (b = _tmp_13_rule(p))
+            (b = _tmp_14_rule(p))
         )
         {
-            Token *token = get_last_nonnwhitespace_token(p);
-            if (token == NULL) {
-                return NULL;
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
             }
-            int end_lineno = token->end_lineno;
-            UNUSED(end_lineno); // Only used by EXTRA macro
-            int end_col_offset = token->end_col_offset;
-            UNUSED(end_col_offset); // Only used by EXTRA macro
-            res = _Py_Assign ( a , b , NULL , EXTRA );
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            else {
+                Token *token = get_last_nonnwhitespace_token(p);
+                if (token == NULL) {
+                    return NULL;
+                }
+                int end_lineno = token->end_lineno;
+                UNUSED(end_lineno); // Only used by EXTRA macro
+                int end_col_offset = token->end_col_offset;
+                UNUSED(end_col_offset); // Only used by EXTRA macro
+                res = _Py_Assign ( a , b , NULL , EXTRA );
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -1176,20 +1708,25 @@ assignment_rule(Parser *p)
             &&
             (b = augassign_rule(p))
             &&
-            (c = _tmp_14_rule(p))
+            (c = _tmp_15_rule(p))
         )
         {
-            Token *token = get_last_nonnwhitespace_token(p);
-            if (token == NULL) {
-                return NULL;
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
             }
-            int end_lineno = token->end_lineno;
-            UNUSED(end_lineno); // Only used by EXTRA macro
-            int end_col_offset = token->end_col_offset;
-            UNUSED(end_col_offset); // Only used by EXTRA macro
-            res = _Py_AugAssign ( a , b -> kind , c , EXTRA );
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            else {
+                Token *token = get_last_nonnwhitespace_token(p);
+                if (token == NULL) {
+                    return NULL;
+                }
+                int end_lineno = token->end_lineno;
+                UNUSED(end_lineno); // Only used by EXTRA macro
+                int end_col_offset = token->end_col_offset;
+                UNUSED(end_col_offset); // Only used by EXTRA macro
+                res = _Py_AugAssign ( a , b -> kind , c , EXTRA );
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -1225,9 +1762,14 @@ augassign_rule(Parser *p)
             (literal = expect_token(p, 36))
         )
         {
-            res = augoperator ( p , Add );
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
+            }
+            else {
+                res = augoperator ( p , Add );
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -1239,9 +1781,14 @@ augassign_rule(Parser *p)
             (literal = expect_token(p, 37))
         )
         {
-            res = augoperator ( p , Sub );
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
+            }
+            else {
+                res = augoperator ( p , Sub );
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -1253,9 +1800,14 @@ augassign_rule(Parser *p)
             (literal = expect_token(p, 38))
         )
         {
-            res = augoperator ( p , Mult );
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
+            }
+            else {
+                res = augoperator ( p , Mult );
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -1267,9 +1819,14 @@ augassign_rule(Parser *p)
             (literal = expect_token(p, 50))
         )
         {
-            res = augoperator ( p , MatMult );
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
+            }
+            else {
+                res = augoperator ( p , MatMult );
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -1281,9 +1838,14 @@ augassign_rule(Parser *p)
             (literal = expect_token(p, 39))
         )
         {
-            res = augoperator ( p , Div );
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
+            }
+            else {
+                res = augoperator ( p , Div );
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -1295,9 +1857,14 @@ augassign_rule(Parser *p)
             (literal = expect_token(p, 40))
         )
         {
-            res = augoperator ( p , Mod );
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
+            }
+            else {
+                res = augoperator ( p , Mod );
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -1309,9 +1876,14 @@ augassign_rule(Parser *p)
             (literal = expect_token(p, 41))
         )
         {
-            res = augoperator ( p , BitAnd );
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
+            }
+            else {
+                res = augoperator ( p , BitAnd );
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -1323,9 +1895,14 @@ augassign_rule(Parser *p)
             (literal = expect_token(p, 42))
         )
         {
-            res = augoperator ( p , BitOr );
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
+            }
+            else {
+                res = augoperator ( p , BitOr );
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -1337,9 +1914,14 @@ augassign_rule(Parser *p)
             (literal = expect_token(p, 43))
         )
         {
-            res = augoperator ( p , BitXor );
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
+            }
+            else {
+                res = augoperator ( p , BitXor );
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -1351,9 +1933,14 @@ augassign_rule(Parser *p)
             (literal = expect_token(p, 44))
         )
         {
-            res = augoperator ( p , LShift );
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
+            }
+            else {
+                res = augoperator ( p , LShift );
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -1365,9 +1952,14 @@ augassign_rule(Parser *p)
             (literal = expect_token(p, 45))
         )
         {
-            res = augoperator ( p , RShift );
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
+            }
+            else {
+                res = augoperator ( p , RShift );
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -1379,9 +1971,14 @@ augassign_rule(Parser *p)
             (literal = expect_token(p, 46))
         )
         {
-            res = augoperator ( p , Pow );
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
+            }
+            else {
+                res = augoperator ( p , Pow );
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -1393,9 +1990,14 @@ augassign_rule(Parser *p)
             (literal = expect_token(p, 48))
         )
         {
-            res = augoperator ( p , FloorDiv );
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
+            }
+            else {
+                res = augoperator ( p , FloorDiv );
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -1415,9 +2017,9 @@ global_stmt_rule(Parser *p)
     if (p->mark == p->fill && fill_token(p) < 0) {
         return NULL;
     }
-    int start_lineno = p->tokens[mark]->lineno;
+    int start_lineno = get_token(p, mark)->lineno;
     UNUSED(start_lineno); // Only used by EXTRA macro
-    int start_col_offset = p->tokens[mark]->col_offset;
+    int start_col_offset = get_token(p, mark)->col_offset;
     UNUSED(start_col_offset); // Only used by EXTRA macro
     { // 'global' ','.NAME+
         asdl_seq * a;
@@ -1425,20 +2027,25 @@ global_stmt_rule(Parser *p)
         if (
             (keyword = expect_token(p, 508))
             &&
-            (a = _gather_15_rule(p))
+            (a = _gather_16_rule(p))
         )
         {
-            Token *token = get_last_nonnwhitespace_token(p);
-            if (token == NULL) {
-                return NULL;
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
             }
-            int end_lineno = token->end_lineno;
-            UNUSED(end_lineno); // Only used by EXTRA macro
-            int end_col_offset = token->end_col_offset;
-            UNUSED(end_col_offset); // Only used by EXTRA macro
-            res = _Py_Global ( CHECK ( map_names_to_ids ( p , a ) ) , EXTRA );
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            else {
+                Token *token = get_last_nonnwhitespace_token(p);
+                if (token == NULL) {
+                    return NULL;
+                }
+                int end_lineno = token->end_lineno;
+                UNUSED(end_lineno); // Only used by EXTRA macro
+                int end_col_offset = token->end_col_offset;
+                UNUSED(end_col_offset); // Only used by EXTRA macro
+                res = _Py_Global ( CHECK ( map_names_to_ids ( p , a ) ) , EXTRA );
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -1458,9 +2065,9 @@ nonlocal_stmt_rule(Parser *p)
     if (p->mark == p->fill && fill_token(p) < 0) {
         return NULL;
     }
-    int start_lineno = p->tokens[mark]->lineno;
+    int start_lineno = get_token(p, mark)->lineno;
     UNUSED(start_lineno); // Only used by EXTRA macro
-    int start_col_offset = p->tokens[mark]->col_offset;
+    int start_col_offset = get_token(p, mark)->col_offset;
     UNUSED(start_col_offset); // Only used by EXTRA macro
     { // 'nonlocal' ','.NAME+
         asdl_seq * a;
@@ -1471,17 +2078,22 @@ nonlocal_stmt_rule(Parser *p)
             (a = _gather_17_rule(p))
         )
         {
-            Token *token = get_last_nonnwhitespace_token(p);
-            if (token == NULL) {
-                return NULL;
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
             }
-            int end_lineno = token->end_lineno;
-            UNUSED(end_lineno); // Only used by EXTRA macro
-            int end_col_offset = token->end_col_offset;
-            UNUSED(end_col_offset); // Only used by EXTRA macro
-            res = _Py_Nonlocal ( CHECK ( map_names_to_ids ( p , a ) ) , EXTRA );
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            else {
+                Token *token = get_last_nonnwhitespace_token(p);
+                if (token == NULL) {
+                    return NULL;
+                }
+                int end_lineno = token->end_lineno;
+                UNUSED(end_lineno); // Only used by EXTRA macro
+                int end_col_offset = token->end_col_offset;
+                UNUSED(end_col_offset); // Only used by EXTRA macro
+                res = _Py_Nonlocal ( CHECK ( map_names_to_ids ( p , a ) ) , EXTRA );
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -1501,9 +2113,9 @@ yield_stmt_rule(Parser *p)
     if (p->mark == p->fill && fill_token(p) < 0) {
         return NULL;
     }
-    int start_lineno = p->tokens[mark]->lineno;
+    int start_lineno = get_token(p, mark)->lineno;
     UNUSED(start_lineno); // Only used by EXTRA macro
-    int start_col_offset = p->tokens[mark]->col_offset;
+    int start_col_offset = get_token(p, mark)->col_offset;
     UNUSED(start_col_offset); // Only used by EXTRA macro
     { // yield_expr
         expr_ty y;
@@ -1511,17 +2123,22 @@ yield_stmt_rule(Parser *p)
             (y = yield_expr_rule(p))
         )
         {
-            Token *token = get_last_nonnwhitespace_token(p);
-            if (token == NULL) {
-                return NULL;
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
             }
-            int end_lineno = token->end_lineno;
-            UNUSED(end_lineno); // Only used by EXTRA macro
-            int end_col_offset = token->end_col_offset;
-            UNUSED(end_col_offset); // Only used by EXTRA macro
-            res = _Py_Expr ( y , EXTRA );
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            else {
+                Token *token = get_last_nonnwhitespace_token(p);
+                if (token == NULL) {
+                    return NULL;
+                }
+                int end_lineno = token->end_lineno;
+                UNUSED(end_lineno); // Only used by EXTRA macro
+                int end_col_offset = token->end_col_offset;
+                UNUSED(end_col_offset); // Only used by EXTRA macro
+                res = _Py_Expr ( y , EXTRA );
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -1541,9 +2158,9 @@ assert_stmt_rule(Parser *p)
     if (p->mark == p->fill && fill_token(p) < 0) {
         return NULL;
     }
-    int start_lineno = p->tokens[mark]->lineno;
+    int start_lineno = get_token(p, mark)->lineno;
     UNUSED(start_lineno); // Only used by EXTRA macro
-    int start_col_offset = p->tokens[mark]->col_offset;
+    int start_col_offset = get_token(p, mark)->col_offset;
     UNUSED(start_col_offset); // Only used by EXTRA macro
     { // 'assert' expression [',' expression]
         expr_ty a;
@@ -1554,20 +2171,25 @@ assert_stmt_rule(Parser *p)
             &&
             (a = expression_rule(p))
             &&
-            (b = _tmp_19_rule(p), 1)
+            (b = _tmp_18_rule(p), 1)
         )
         {
-            Token *token = get_last_nonnwhitespace_token(p);
-            if (token == NULL) {
-                return NULL;
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
             }
-            int end_lineno = token->end_lineno;
-            UNUSED(end_lineno); // Only used by EXTRA macro
-            int end_col_offset = token->end_col_offset;
-            UNUSED(end_col_offset); // Only used by EXTRA macro
-            res = _Py_Assert ( a , b , EXTRA );
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            else {
+                Token *token = get_last_nonnwhitespace_token(p);
+                if (token == NULL) {
+                    return NULL;
+                }
+                int end_lineno = token->end_lineno;
+                UNUSED(end_lineno); // Only used by EXTRA macro
+                int end_col_offset = token->end_col_offset;
+                UNUSED(end_col_offset); // Only used by EXTRA macro
+                res = _Py_Assert ( a , b , EXTRA );
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -1587,9 +2209,9 @@ del_stmt_rule(Parser *p)
     if (p->mark == p->fill && fill_token(p) < 0) {
         return NULL;
     }
-    int start_lineno = p->tokens[mark]->lineno;
+    int start_lineno = get_token(p, mark)->lineno;
     UNUSED(start_lineno); // Only used by EXTRA macro
-    int start_col_offset = p->tokens[mark]->col_offset;
+    int start_col_offset = get_token(p, mark)->col_offset;
     UNUSED(start_col_offset); // Only used by EXTRA macro
     { // 'del' del_targets
         asdl_seq* a;
@@ -1600,17 +2222,22 @@ del_stmt_rule(Parser *p)
             (a = del_targets_rule(p))
         )
         {
-            Token *token = get_last_nonnwhitespace_token(p);
-            if (token == NULL) {
-                return NULL;
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
             }
-            int end_lineno = token->end_lineno;
-            UNUSED(end_lineno); // Only used by EXTRA macro
-            int end_col_offset = token->end_col_offset;
-            UNUSED(end_col_offset); // Only used by EXTRA macro
-            res = _Py_Delete ( a , EXTRA );
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            else {
+                Token *token = get_last_nonnwhitespace_token(p);
+                if (token == NULL) {
+                    return NULL;
+                }
+                int end_lineno = token->end_lineno;
+                UNUSED(end_lineno); // Only used by EXTRA macro
+                int end_col_offset = token->end_col_offset;
+                UNUSED(end_col_offset); // Only used by EXTRA macro
+                res = _Py_Delete ( a , EXTRA );
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -1663,9 +2290,9 @@ import_name_rule(Parser *p)
     if (p->mark == p->fill && fill_token(p) < 0) {
         return NULL;
     }
-    int start_lineno = p->tokens[mark]->lineno;
+    int start_lineno = get_token(p, mark)->lineno;
     UNUSED(start_lineno); // Only used by EXTRA macro
-    int start_col_offset = p->tokens[mark]->col_offset;
+    int start_col_offset = get_token(p, mark)->col_offset;
     UNUSED(start_col_offset); // Only used by EXTRA macro
     { // 'import' dotted_as_names
         asdl_seq* a;
@@ -1676,17 +2303,22 @@ import_name_rule(Parser *p)
             (a = dotted_as_names_rule(p))
         )
         {
-            Token *token = get_last_nonnwhitespace_token(p);
-            if (token == NULL) {
-                return NULL;
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
             }
-            int end_lineno = token->end_lineno;
-            UNUSED(end_lineno); // Only used by EXTRA macro
-            int end_col_offset = token->end_col_offset;
-            UNUSED(end_col_offset); // Only used by EXTRA macro
-            res = _Py_Import ( a , EXTRA );
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            else {
+                Token *token = get_last_nonnwhitespace_token(p);
+                if (token == NULL) {
+                    return NULL;
+                }
+                int end_lineno = token->end_lineno;
+                UNUSED(end_lineno); // Only used by EXTRA macro
+                int end_col_offset = token->end_col_offset;
+                UNUSED(end_col_offset); // Only used by EXTRA macro
+                res = _Py_Import ( a , EXTRA );
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -1708,9 +2340,9 @@ import_from_rule(Parser *p)
     if (p->mark == p->fill && fill_token(p) < 0) {
         return NULL;
     }
-    int start_lineno = p->tokens[mark]->lineno;
+    int start_lineno = get_token(p, mark)->lineno;
     UNUSED(start_lineno); // Only used by EXTRA macro
-    int start_col_offset = p->tokens[mark]->col_offset;
+    int start_col_offset = get_token(p, mark)->col_offset;
     UNUSED(start_col_offset); // Only used by EXTRA macro
     { // 'from' (('.' | '...'))* dotted_name 'import' import_from_targets
         asdl_seq * a;
@@ -1721,7 +2353,7 @@ import_from_rule(Parser *p)
         if (
             (keyword = expect_token(p, 514))
             &&
-            (a = _loop0_20_rule(p))
+            (a = _loop0_19_rule(p))
             &&
             (b = dotted_name_rule(p))
             &&
@@ -1730,17 +2362,22 @@ import_from_rule(Parser *p)
             (c = import_from_targets_rule(p))
         )
         {
-            Token *token = get_last_nonnwhitespace_token(p);
-            if (token == NULL) {
-                return NULL;
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
             }
-            int end_lineno = token->end_lineno;
-            UNUSED(end_lineno); // Only used by EXTRA macro
-            int end_col_offset = token->end_col_offset;
-            UNUSED(end_col_offset); // Only used by EXTRA macro
-            res = _Py_ImportFrom ( b -> v . Name . id , c , seq_count_dots ( a ) , EXTRA );
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            else {
+                Token *token = get_last_nonnwhitespace_token(p);
+                if (token == NULL) {
+                    return NULL;
+                }
+                int end_lineno = token->end_lineno;
+                UNUSED(end_lineno); // Only used by EXTRA macro
+                int end_col_offset = token->end_col_offset;
+                UNUSED(end_col_offset); // Only used by EXTRA macro
+                res = _Py_ImportFrom ( b -> v . Name . id , c , seq_count_dots ( a ) , EXTRA );
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -1754,24 +2391,29 @@ import_from_rule(Parser *p)
         if (
             (keyword = expect_token(p, 514))
             &&
-            (a = _loop1_21_rule(p))
+            (a = _loop1_20_rule(p))
             &&
             (keyword_1 = expect_token(p, 513))
             &&
             (b = import_from_targets_rule(p))
         )
         {
-            Token *token = get_last_nonnwhitespace_token(p);
-            if (token == NULL) {
-                return NULL;
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
             }
-            int end_lineno = token->end_lineno;
-            UNUSED(end_lineno); // Only used by EXTRA macro
-            int end_col_offset = token->end_col_offset;
-            UNUSED(end_col_offset); // Only used by EXTRA macro
-            res = _Py_ImportFrom ( NULL , b , seq_count_dots ( a ) , EXTRA );
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            else {
+                Token *token = get_last_nonnwhitespace_token(p);
+                if (token == NULL) {
+                    return NULL;
+                }
+                int end_lineno = token->end_lineno;
+                UNUSED(end_lineno); // Only used by EXTRA macro
+                int end_col_offset = token->end_col_offset;
+                UNUSED(end_col_offset); // Only used by EXTRA macro
+                res = _Py_ImportFrom ( NULL , b , seq_count_dots ( a ) , EXTRA );
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -1800,9 +2442,14 @@ import_from_targets_rule(Parser *p)
             (literal_1 = expect_token(p, 8))
         )
         {
-            res = a;
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
+            }
+            else {
+                res = a;
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -1825,9 +2472,14 @@ import_from_targets_rule(Parser *p)
             (literal = expect_token(p, 16))
         )
         {
-            res = singleton_seq ( p , CHECK ( alias_for_star ( p ) ) );
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
+            }
+            else {
+                res = singleton_seq ( p , CHECK ( alias_for_star ( p ) ) );
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -1848,14 +2500,19 @@ import_from_as_names_rule(Parser *p)
         asdl_seq * a;
         void *opt_var;
         if (
-            (a = _gather_22_rule(p))
+            (a = _gather_21_rule(p))
             &&
             (opt_var = expect_token(p, 12), 1)
         )
         {
-            res = a;
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
+            }
+            else {
+                res = a;
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -1878,12 +2535,17 @@ import_from_as_name_rule(Parser *p)
         if (
             (a = name_token(p))
             &&
-            (b = _tmp_24_rule(p), 1)
+            (b = _tmp_22_rule(p), 1)
         )
         {
-            res = _Py_alias ( a -> v . Name . id , ( b ) ? ( ( expr_ty ) b ) -> v . Name . id : NULL , p -> arena );
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
+            }
+            else {
+                res = _Py_alias ( a -> v . Name . id , ( b ) ? ( ( expr_ty ) b ) -> v . Name . id : NULL , p -> arena );
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -1903,12 +2565,17 @@ dotted_as_names_rule(Parser *p)
     { // ','.dotted_as_name+
         asdl_seq * a;
         if (
-            (a = _gather_25_rule(p))
+            (a = _gather_23_rule(p))
         )
         {
-            res = a;
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
+            }
+            else {
+                res = a;
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -1931,12 +2598,17 @@ dotted_as_name_rule(Parser *p)
         if (
             (a = dotted_name_rule(p))
             &&
-            (b = _tmp_27_rule(p), 1)
+            (b = _tmp_24_rule(p), 1)
         )
         {
-            res = _Py_alias ( a -> v . Name . id , ( b ) ? ( ( expr_ty ) b ) -> v . Name . id : NULL , p -> arena );
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
+            }
+            else {
+                res = _Py_alias ( a -> v . Name . id , ( b ) ? ( ( expr_ty ) b ) -> v . Name . id : NULL , p -> arena );
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -1990,9 +2662,14 @@ dotted_name_raw(Parser *p)
             (b = name_token(p))
         )
         {
-            res = join_names_with_dot ( p , a , b );
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
+            }
+            else {
+                res = join_names_with_dot ( p , a , b );
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -2022,12 +2699,13 @@ if_stmt_rule(Parser *p)
 {
     stmt_ty res = NULL;
     int mark = p->mark;
+    int choice_mark = enter_choice(p, mark);
     if (p->mark == p->fill && fill_token(p) < 0) {
         return NULL;
     }
-    int start_lineno = p->tokens[mark]->lineno;
+    int start_lineno = get_token(p, mark)->lineno;
     UNUSED(start_lineno); // Only used by EXTRA macro
-    int start_col_offset = p->tokens[mark]->col_offset;
+    int start_col_offset = get_token(p, mark)->col_offset;
     UNUSED(start_col_offset); // Only used by EXTRA macro
     { // 'if' named_expression ':' block elif_stmt
         expr_ty a;
@@ -2047,17 +2725,22 @@ if_stmt_rule(Parser *p)
             (c = elif_stmt_rule(p))
         )
         {
-            Token *token = get_last_nonnwhitespace_token(p);
-            if (token == NULL) {
-                return NULL;
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
             }
-            int end_lineno = token->end_lineno;
-            UNUSED(end_lineno); // Only used by EXTRA macro
-            int end_col_offset = token->end_col_offset;
-            UNUSED(end_col_offset); // Only used by EXTRA macro
-            res = _Py_If ( a , b , CHECK ( singleton_seq ( p , c ) ) , EXTRA );
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            else {
+                Token *token = get_last_nonnwhitespace_token(p);
+                if (token == NULL) {
+                    return NULL;
+                }
+                int end_lineno = token->end_lineno;
+                UNUSED(end_lineno); // Only used by EXTRA macro
+                int end_col_offset = token->end_col_offset;
+                UNUSED(end_col_offset); // Only used by EXTRA macro
+                res = _Py_If ( a , b , CHECK ( singleton_seq ( p , c ) ) , EXTRA );
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -2069,6 +2752,7 @@ if_stmt_rule(Parser *p)
         void *c;
         void *keyword;
         void *literal;
+        int opt_choice_mark;
         if (
             (keyword = expect_token(p, 510))
             &&
@@ -2078,20 +2762,25 @@ if_stmt_rule(Parser *p)
             &&
             (b = block_rule(p))
             &&
-            (c = else_block_rule(p), 1)
+            (opt_choice_mark = enter_choice(p, p->mark), c = else_block_rule(p), p->choice_mark = opt_choice_mark, 1)
         )
         {
-            Token *token = get_last_nonnwhitespace_token(p);
-            if (token == NULL) {
-                return NULL;
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
             }
-            int end_lineno = token->end_lineno;
-            UNUSED(end_lineno); // Only used by EXTRA macro
-            int end_col_offset = token->end_col_offset;
-            UNUSED(end_col_offset); // Only used by EXTRA macro
-            res = _Py_If ( a , b , c , EXTRA );
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            else {
+                Token *token = get_last_nonnwhitespace_token(p);
+                if (token == NULL) {
+                    return NULL;
+                }
+                int end_lineno = token->end_lineno;
+                UNUSED(end_lineno); // Only used by EXTRA macro
+                int end_col_offset = token->end_col_offset;
+                UNUSED(end_col_offset); // Only used by EXTRA macro
+                res = _Py_If ( a , b , c , EXTRA );
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -2099,6 +2788,7 @@ if_stmt_rule(Parser *p)
     }
     res = NULL;
   done:
+    p->choice_mark = choice_mark;
     return res;
 }
 
@@ -2110,12 +2800,13 @@ elif_stmt_rule(Parser *p)
 {
     stmt_ty res = NULL;
     int mark = p->mark;
+    int choice_mark = enter_choice(p, mark);
     if (p->mark == p->fill && fill_token(p) < 0) {
         return NULL;
     }
-    int start_lineno = p->tokens[mark]->lineno;
+    int start_lineno = get_token(p, mark)->lineno;
     UNUSED(start_lineno); // Only used by EXTRA macro
-    int start_col_offset = p->tokens[mark]->col_offset;
+    int start_col_offset = get_token(p, mark)->col_offset;
     UNUSED(start_col_offset); // Only used by EXTRA macro
     { // 'elif' named_expression ':' block elif_stmt
         expr_ty a;
@@ -2135,17 +2826,22 @@ elif_stmt_rule(Parser *p)
             (c = elif_stmt_rule(p))
         )
         {
-            Token *token = get_last_nonnwhitespace_token(p);
-            if (token == NULL) {
-                return NULL;
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
             }
-            int end_lineno = token->end_lineno;
-            UNUSED(end_lineno); // Only used by EXTRA macro
-            int end_col_offset = token->end_col_offset;
-            UNUSED(end_col_offset); // Only used by EXTRA macro
-            res = _Py_If ( a , b , CHECK ( singleton_seq ( p , c ) ) , EXTRA );
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            else {
+                Token *token = get_last_nonnwhitespace_token(p);
+                if (token == NULL) {
+                    return NULL;
+                }
+                int end_lineno = token->end_lineno;
+                UNUSED(end_lineno); // Only used by EXTRA macro
+                int end_col_offset = token->end_col_offset;
+                UNUSED(end_col_offset); // Only used by EXTRA macro
+                res = _Py_If ( a , b , CHECK ( singleton_seq ( p , c ) ) , EXTRA );
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -2157,6 +2853,7 @@ elif_stmt_rule(Parser *p)
         void *c;
         void *keyword;
         void *literal;
+        int opt_choice_mark;
         if (
             (keyword = expect_token(p, 515))
             &&
@@ -2166,20 +2863,25 @@ elif_stmt_rule(Parser *p)
             &&
             (b = block_rule(p))
             &&
-            (c = else_block_rule(p), 1)
+            (opt_choice_mark = enter_choice(p, p->mark), c = else_block_rule(p), p->choice_mark = opt_choice_mark, 1)
         )
         {
-            Token *token = get_last_nonnwhitespace_token(p);
-            if (token == NULL) {
-                return NULL;
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
             }
-            int end_lineno = token->end_lineno;
-            UNUSED(end_lineno); // Only used by EXTRA macro
-            int end_col_offset = token->end_col_offset;
-            UNUSED(end_col_offset); // Only used by EXTRA macro
-            res = _Py_If ( a , b , c , EXTRA );
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            else {
+                Token *token = get_last_nonnwhitespace_token(p);
+                if (token == NULL) {
+                    return NULL;
+                }
+                int end_lineno = token->end_lineno;
+                UNUSED(end_lineno); // Only used by EXTRA macro
+                int end_col_offset = token->end_col_offset;
+                UNUSED(end_col_offset); // Only used by EXTRA macro
+                res = _Py_If ( a , b , c , EXTRA );
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -2187,6 +2889,7 @@ elif_stmt_rule(Parser *p)
     }
     res = NULL;
   done:
+    p->choice_mark = choice_mark;
     return res;
 }
 
@@ -2208,9 +2911,14 @@ else_block_rule(Parser *p)
             (b = block_rule(p))
         )
         {
-            res = b;
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
+            }
+            else {
+                res = b;
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -2227,12 +2935,13 @@ while_stmt_rule(Parser *p)
 {
     stmt_ty res = NULL;
     int mark = p->mark;
+    int choice_mark = enter_choice(p, mark);
     if (p->mark == p->fill && fill_token(p) < 0) {
         return NULL;
     }
-    int start_lineno = p->tokens[mark]->lineno;
+    int start_lineno = get_token(p, mark)->lineno;
     UNUSED(start_lineno); // Only used by EXTRA macro
-    int start_col_offset = p->tokens[mark]->col_offset;
+    int start_col_offset = get_token(p, mark)->col_offset;
     UNUSED(start_col_offset); // Only used by EXTRA macro
     { // 'while' named_expression ':' block else_block?
         expr_ty a;
@@ -2240,6 +2949,7 @@ while_stmt_rule(Parser *p)
         void *c;
         void *keyword;
         void *literal;
+        int opt_choice_mark;
         if (
             (keyword = expect_token(p, 512))
             &&
@@ -2249,20 +2959,25 @@ while_stmt_rule(Parser *p)
             &&
             (b = block_rule(p))
             &&
-            (c = else_block_rule(p), 1)
+            (opt_choice_mark = enter_choice(p, p->mark), c = else_block_rule(p), p->choice_mark = opt_choice_mark, 1)
         )
         {
-            Token *token = get_last_nonnwhitespace_token(p);
-            if (token == NULL) {
-                return NULL;
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
             }
-            int end_lineno = token->end_lineno;
-            UNUSED(end_lineno); // Only used by EXTRA macro
-            int end_col_offset = token->end_col_offset;
-            UNUSED(end_col_offset); // Only used by EXTRA macro
-            res = _Py_While ( a , b , c , EXTRA );
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            else {
+                Token *token = get_last_nonnwhitespace_token(p);
+                if (token == NULL) {
+                    return NULL;
+                }
+                int end_lineno = token->end_lineno;
+                UNUSED(end_lineno); // Only used by EXTRA macro
+                int end_col_offset = token->end_col_offset;
+                UNUSED(end_col_offset); // Only used by EXTRA macro
+                res = _Py_While ( a , b , c , EXTRA );
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -2270,6 +2985,7 @@ while_stmt_rule(Parser *p)
     }
     res = NULL;
   done:
+    p->choice_mark = choice_mark;
     return res;
 }
 
@@ -2281,12 +2997,13 @@ for_stmt_rule(Parser *p)
 {
     stmt_ty res = NULL;
     int mark = p->mark;
+    int choice_mark = enter_choice(p, mark);
     if (p->mark == p->fill && fill_token(p) < 0) {
         return NULL;
     }
-    int start_lineno = p->tokens[mark]->lineno;
+    int start_lineno = get_token(p, mark)->lineno;
     UNUSED(start_lineno); // Only used by EXTRA macro
-    int start_col_offset = p->tokens[mark]->col_offset;
+    int start_col_offset = get_token(p, mark)->col_offset;
     UNUSED(start_col_offset); // Only used by EXTRA macro
     { // ASYNC 'for' star_targets 'in' expressions ':' block else_block?
         void *async_var;
@@ -2297,6 +3014,7 @@ for_stmt_rule(Parser *p)
         void *keyword_1;
         void *literal;
         expr_ty t;
+        int opt_choice_mark;
         if (
             (async_var = async_token(p))
             &&
@@ -2312,20 +3030,25 @@ for_stmt_rule(Parser *p)
             &&
             (b = block_rule(p))
             &&
-            (el = else_block_rule(p), 1)
+            (opt_choice_mark = enter_choice(p, p->mark), el = else_block_rule(p), p->choice_mark = opt_choice_mark, 1)
         )
         {
-            Token *token = get_last_nonnwhitespace_token(p);
-            if (token == NULL) {
-                return NULL;
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
             }
-            int end_lineno = token->end_lineno;
-            UNUSED(end_lineno); // Only used by EXTRA macro
-            int end_col_offset = token->end_col_offset;
-            UNUSED(end_col_offset); // Only used by EXTRA macro
-            res = _Py_AsyncFor ( t , ex , b , el , NULL , EXTRA );
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            else {
+                Token *token = get_last_nonnwhitespace_token(p);
+                if (token == NULL) {
+                    return NULL;
+                }
+                int end_lineno = token->end_lineno;
+                UNUSED(end_lineno); // Only used by EXTRA macro
+                int end_col_offset = token->end_col_offset;
+                UNUSED(end_col_offset); // Only used by EXTRA macro
+                res = _Py_AsyncFor ( t , ex , b , el , NULL , EXTRA );
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -2339,6 +3062,7 @@ for_stmt_rule(Parser *p)
         void *keyword_1;
         void *literal;
         expr_ty t;
+        int opt_choice_mark;
         if (
             (keyword = expect_token(p, 517))
             &&
@@ -2352,20 +3076,25 @@ for_stmt_rule(Parser *p)
             &&
             (b = block_rule(p))
             &&
-            (el = else_block_rule(p), 1)
+            (opt_choice_mark = enter_choice(p, p->mark), el = else_block_rule(p), p->choice_mark = opt_choice_mark, 1)
         )
         {
-            Token *token = get_last_nonnwhitespace_token(p);
-            if (token == NULL) {
-                return NULL;
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
             }
-            int end_lineno = token->end_lineno;
-            UNUSED(end_lineno); // Only used by EXTRA macro
-            int end_col_offset = token->end_col_offset;
-            UNUSED(end_col_offset); // Only used by EXTRA macro
-            res = _Py_For ( t , ex , b , el , NULL , EXTRA );
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            else {
+                Token *token = get_last_nonnwhitespace_token(p);
+                if (token == NULL) {
+                    return NULL;
+                }
+                int end_lineno = token->end_lineno;
+                UNUSED(end_lineno); // Only used by EXTRA macro
+                int end_col_offset = token->end_col_offset;
+                UNUSED(end_col_offset); // Only used by EXTRA macro
+                res = _Py_For ( t , ex , b , el , NULL , EXTRA );
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -2373,6 +3102,7 @@ for_stmt_rule(Parser *p)
     }
     res = NULL;
   done:
+    p->choice_mark = choice_mark;
     return res;
 }
 
@@ -2386,12 +3116,13 @@ with_stmt_rule(Parser *p)
 {
     stmt_ty res = NULL;
     int mark = p->mark;
+    int choice_mark = enter_choice(p, mark);
     if (p->mark == p->fill && fill_token(p) < 0) {
         return NULL;
     }
-    int start_lineno = p->tokens[mark]->lineno;
+    int start_lineno = get_token(p, mark)->lineno;
     UNUSED(start_lineno); // Only used by EXTRA macro
-    int start_col_offset = p->tokens[mark]->col_offset;
+    int start_col_offset = get_token(p, mark)->col_offset;
     UNUSED(start_col_offset); // Only used by EXTRA macro
     { // ASYNC 'with' '(' ','.with_item+ ')' ':' block
         asdl_seq * a;
@@ -2408,7 +3139,7 @@ with_stmt_rule(Parser *p)
             &&
             (literal = expect_token(p, 7))
             &&
-            (a = _gather_28_rule(p))
+            (a = _gather_25_rule(p))
             &&
             (literal_1 = expect_token(p, 8))
             &&
@@ -2417,17 +3148,22 @@ with_stmt_rule(Parser *p)
             (b = block_rule(p))
         )
         {
-            Token *token = get_last_nonnwhitespace_token(p);
-            if (token == NULL) {
-                return NULL;
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
             }
-            int end_lineno = token->end_lineno;
-            UNUSED(end_lineno); // Only used by EXTRA macro
-            int end_col_offset = token->end_col_offset;
-            UNUSED(end_col_offset); // Only used by EXTRA macro
-            res = _Py_AsyncWith ( a , b , NULL , EXTRA );
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            else {
+                Token *token = get_last_nonnwhitespace_token(p);
+                if (token == NULL) {
+                    return NULL;
+                }
+                int end_lineno = token->end_lineno;
+                UNUSED(end_lineno); // Only used by EXTRA macro
+                int end_col_offset = token->end_col_offset;
+                UNUSED(end_col_offset); // Only used by EXTRA macro
+                res = _Py_AsyncWith ( a , b , NULL , EXTRA );
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -2444,24 +3180,29 @@ with_stmt_rule(Parser *p)
             &&
             (keyword = expect_token(p, 519))
             &&
-            (a = _gather_30_rule(p))
+            (a = _gather_26_rule(p))
             &&
             (literal = expect_token(p, 11))
             &&
             (b = block_rule(p))
         )
         {
-            Token *token = get_last_nonnwhitespace_token(p);
-            if (token == NULL) {
-                return NULL;
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
             }
-            int end_lineno = token->end_lineno;
-            UNUSED(end_lineno); // Only used by EXTRA macro
-            int end_col_offset = token->end_col_offset;
-            UNUSED(end_col_offset); // Only used by EXTRA macro
-            res = _Py_AsyncWith ( a , b , NULL , EXTRA );
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            else {
+                Token *token = get_last_nonnwhitespace_token(p);
+                if (token == NULL) {
+                    return NULL;
+                }
+                int end_lineno = token->end_lineno;
+                UNUSED(end_lineno); // Only used by EXTRA macro
+                int end_col_offset = token->end_col_offset;
+                UNUSED(end_col_offset); // Only used by EXTRA macro
+                res = _Py_AsyncWith ( a , b , NULL , EXTRA );
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -2479,7 +3220,7 @@ with_stmt_rule(Parser *p)
             &&
             (literal = expect_token(p, 7))
             &&
-            (a = _gather_32_rule(p))
+            (a = _gather_27_rule(p))
             &&
             (literal_1 = expect_token(p, 8))
             &&
@@ -2488,17 +3229,22 @@ with_stmt_rule(Parser *p)
             (b = block_rule(p))
         )
         {
-            Token *token = get_last_nonnwhitespace_token(p);
-            if (token == NULL) {
-                return NULL;
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
             }
-            int end_lineno = token->end_lineno;
-            UNUSED(end_lineno); // Only used by EXTRA macro
-            int end_col_offset = token->end_col_offset;
-            UNUSED(end_col_offset); // Only used by EXTRA macro
-            res = _Py_With ( a , b , NULL , EXTRA );
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            else {
+                Token *token = get_last_nonnwhitespace_token(p);
+                if (token == NULL) {
+                    return NULL;
+                }
+                int end_lineno = token->end_lineno;
+                UNUSED(end_lineno); // Only used by EXTRA macro
+                int end_col_offset = token->end_col_offset;
+                UNUSED(end_col_offset); // Only used by EXTRA macro
+                res = _Py_With ( a , b , NULL , EXTRA );
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -2512,24 +3258,29 @@ with_stmt_rule(Parser *p)
         if (
             (keyword = expect_token(p, 519))
             &&
-            (a = _gather_34_rule(p))
+            (a = _gather_28_rule(p))
             &&
             (literal = expect_token(p, 11))
             &&
             (b = block_rule(p))
         )
         {
-            Token *token = get_last_nonnwhitespace_token(p);
-            if (token == NULL) {
-                return NULL;
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
             }
-            int end_lineno = token->end_lineno;
-            UNUSED(end_lineno); // Only used by EXTRA macro
-            int end_col_offset = token->end_col_offset;
-            UNUSED(end_col_offset); // Only used by EXTRA macro
-            res = _Py_With ( a , b , NULL , EXTRA );
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            else {
+                Token *token = get_last_nonnwhitespace_token(p);
+                if (token == NULL) {
+                    return NULL;
+                }
+                int end_lineno = token->end_lineno;
+                UNUSED(end_lineno); // Only used by EXTRA macro
+                int end_col_offset = token->end_col_offset;
+                UNUSED(end_col_offset); // Only used by EXTRA macro
+                res = _Py_With ( a , b , NULL , EXTRA );
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -2537,6 +3288,7 @@ with_stmt_rule(Parser *p)
     }
     res = NULL;
   done:
+    p->choice_mark = choice_mark;
     return res;
 }
 
@@ -2552,12 +3304,17 @@ with_item_rule(Parser *p)
         if (
             (e = expression_rule(p))
             &&
-            (o = _tmp_36_rule(p), 1)
+            (o = _tmp_29_rule(p), 1)
         )
         {
-            res = _Py_withitem ( e , o , p -> arena );
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
+            }
+            else {
+                res = _Py_withitem ( e , o , p -> arena );
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -2576,12 +3333,13 @@ try_stmt_rule(Parser *p)
 {
     stmt_ty res = NULL;
     int mark = p->mark;
+    int choice_mark = enter_choice(p, mark);
     if (p->mark == p->fill && fill_token(p) < 0) {
         return NULL;
     }
-    int start_lineno = p->tokens[mark]->lineno;
+    int start_lineno = get_token(p, mark)->lineno;
     UNUSED(start_lineno); // Only used by EXTRA macro
-    int start_col_offset = p->tokens[mark]->col_offset;
+    int start_col_offset = get_token(p, mark)->col_offset;
     UNUSED(start_col_offset); // Only used by EXTRA macro
     { // 'try' ':' block finally_block
         asdl_seq* b;
@@ -2598,17 +3356,22 @@ try_stmt_rule(Parser *p)
             (f = finally_block_rule(p))
         )
         {
-            Token *token = get_last_nonnwhitespace_token(p);
-            if (token == NULL) {
-                return NULL;
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
             }
-            int end_lineno = token->end_lineno;
-            UNUSED(end_lineno); // Only used by EXTRA macro
-            int end_col_offset = token->end_col_offset;
-            UNUSED(end_col_offset); // Only used by EXTRA macro
-            res = _Py_Try ( b , NULL , NULL , f , EXTRA );
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            else {
+                Token *token = get_last_nonnwhitespace_token(p);
+                if (token == NULL) {
+                    return NULL;
+                }
+                int end_lineno = token->end_lineno;
+                UNUSED(end_lineno); // Only used by EXTRA macro
+                int end_col_offset = token->end_col_offset;
+                UNUSED(end_col_offset); // Only used by EXTRA macro
+                res = _Py_Try ( b , NULL , NULL , f , EXTRA );
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -2621,6 +3384,7 @@ try_stmt_rule(Parser *p)
         void *f;
         void *keyword;
         void *literal;
+        int opt_choice_mark;
         if (
             (keyword = expect_token(p, 511))
             &&
@@ -2628,24 +3392,29 @@ try_stmt_rule(Parser *p)
             &&
             (b = block_rule(p))
             &&
-            (ex = _loop1_37_rule(p))
+            (ex = _loop1_30_rule(p))
             &&
-            (el = else_block_rule(p), 1)
+            (opt_choice_mark = enter_choice(p, p->mark), el = else_block_rule(p), p->choice_mark = opt_choice_mark, 1)
             &&
-            (f = finally_block_rule(p), 1)
+            (opt_choice_mark = enter_choice(p, p->mark), f = finally_block_rule(p), p->choice_mark = opt_choice_mark, 1)
         )
         {
-            Token *token = get_last_nonnwhitespace_token(p);
-            if (token == NULL) {
-                return NULL;
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
             }
-            int end_lineno = token->end_lineno;
-            UNUSED(end_lineno); // Only used by EXTRA macro
-            int end_col_offset = token->end_col_offset;
-            UNUSED(end_col_offset); // Only used by EXTRA macro
-            res = _Py_Try ( b , ex , el , f , EXTRA );
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            else {
+                Token *token = get_last_nonnwhitespace_token(p);
+                if (token == NULL) {
+                    return NULL;
+                }
+                int end_lineno = token->end_lineno;
+                UNUSED(end_lineno); // Only used by EXTRA macro
+                int end_col_offset = token->end_col_offset;
+                UNUSED(end_col_offset); // Only used by EXTRA macro
+                res = _Py_Try ( b , ex , el , f , EXTRA );
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -2653,6 +3422,7 @@ try_stmt_rule(Parser *p)
     }
     res = NULL;
   done:
+    p->choice_mark = choice_mark;
     return res;
 }
 
@@ -2662,12 +3432,13 @@ except_block_rule(Parser *p)
 {
     excepthandler_ty res = NULL;
     int mark = p->mark;
+    int choice_mark = enter_choice(p, mark);
     if (p->mark == p->fill && fill_token(p) < 0) {
         return NULL;
     }
-    int start_lineno = p->tokens[mark]->lineno;
+    int start_lineno = get_token(p, mark)->lineno;
     UNUSED(start_lineno); // Only used by EXTRA macro
-    int start_col_offset = p->tokens[mark]->col_offset;
+    int start_col_offset = get_token(p, mark)->col_offset;
     UNUSED(start_col_offset); // Only used by EXTRA macro
     { // 'except' expression ['as' target] ':' block
         asdl_seq* b;
@@ -2680,24 +3451,29 @@ except_block_rule(Parser *p)
             &&
             (e = expression_rule(p))
             &&
-            (t = _tmp_38_rule(p), 1)
+            (t = _tmp_31_rule(p), 1)
             &&
             (literal = expect_token(p, 11))
             &&
             (b = block_rule(p))
         )
         {
-            Token *token = get_last_nonnwhitespace_token(p);
-            if (token == NULL) {
-                return NULL;
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
             }
-            int end_lineno = token->end_lineno;
-            UNUSED(end_lineno); // Only used by EXTRA macro
-            int end_col_offset = token->end_col_offset;
-            UNUSED(end_col_offset); // Only used by EXTRA macro
-            res = _Py_ExceptHandler ( e , ( t ) ? ( ( expr_ty ) t ) -> v . Name . id : NULL , b , EXTRA );
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            else {
+                Token *token = get_last_nonnwhitespace_token(p);
+                if (token == NULL) {
+                    return NULL;
+                }
+                int end_lineno = token->end_lineno;
+                UNUSED(end_lineno); // Only used by EXTRA macro
+                int end_col_offset = token->end_col_offset;
+                UNUSED(end_col_offset); // Only used by EXTRA macro
+                res = _Py_ExceptHandler ( e , ( t ) ? ( ( expr_ty ) t ) -> v . Name . id : NULL , b , EXTRA );
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -2715,17 +3491,22 @@ except_block_rule(Parser *p)
             (b = block_rule(p))
         )
         {
-            Token *token = get_last_nonnwhitespace_token(p);
-            if (token == NULL) {
-                return NULL;
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
             }
-            int end_lineno = token->end_lineno;
-            UNUSED(end_lineno); // Only used by EXTRA macro
-            int end_col_offset = token->end_col_offset;
-            UNUSED(end_col_offset); // Only used by EXTRA macro
-            res = _Py_ExceptHandler ( NULL , NULL , b , EXTRA );
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            else {
+                Token *token = get_last_nonnwhitespace_token(p);
+                if (token == NULL) {
+                    return NULL;
+                }
+                int end_lineno = token->end_lineno;
+                UNUSED(end_lineno); // Only used by EXTRA macro
+                int end_col_offset = token->end_col_offset;
+                UNUSED(end_col_offset); // Only used by EXTRA macro
+                res = _Py_ExceptHandler ( NULL , NULL , b , EXTRA );
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -2733,6 +3514,7 @@ except_block_rule(Parser *p)
     }
     res = NULL;
   done:
+    p->choice_mark = choice_mark;
     return res;
 }
 
@@ -2754,9 +3536,14 @@ finally_block_rule(Parser *p)
             (a = block_rule(p))
         )
         {
-            res = a;
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
+            }
+            else {
+                res = a;
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -2776,9 +3563,9 @@ return_stmt_rule(Parser *p)
     if (p->mark == p->fill && fill_token(p) < 0) {
         return NULL;
     }
-    int start_lineno = p->tokens[mark]->lineno;
+    int start_lineno = get_token(p, mark)->lineno;
     UNUSED(start_lineno); // Only used by EXTRA macro
-    int start_col_offset = p->tokens[mark]->col_offset;
+    int start_col_offset = get_token(p, mark)->col_offset;
     UNUSED(start_col_offset); // Only used by EXTRA macro
     { // 'return' expressions?
         void *a;
@@ -2789,17 +3576,22 @@ return_stmt_rule(Parser *p)
             (a = expressions_rule(p), 1)
         )
         {
-            Token *token = get_last_nonnwhitespace_token(p);
-            if (token == NULL) {
-                return NULL;
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
             }
-            int end_lineno = token->end_lineno;
-            UNUSED(end_lineno); // Only used by EXTRA macro
-            int end_col_offset = token->end_col_offset;
-            UNUSED(end_col_offset); // Only used by EXTRA macro
-            res = _Py_Return ( a , EXTRA );
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            else {
+                Token *token = get_last_nonnwhitespace_token(p);
+                if (token == NULL) {
+                    return NULL;
+                }
+                int end_lineno = token->end_lineno;
+                UNUSED(end_lineno); // Only used by EXTRA macro
+                int end_col_offset = token->end_col_offset;
+                UNUSED(end_col_offset); // Only used by EXTRA macro
+                res = _Py_Return ( a , EXTRA );
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -2819,9 +3611,9 @@ raise_stmt_rule(Parser *p)
     if (p->mark == p->fill && fill_token(p) < 0) {
         return NULL;
     }
-    int start_lineno = p->tokens[mark]->lineno;
+    int start_lineno = get_token(p, mark)->lineno;
     UNUSED(start_lineno); // Only used by EXTRA macro
-    int start_col_offset = p->tokens[mark]->col_offset;
+    int start_col_offset = get_token(p, mark)->col_offset;
     UNUSED(start_col_offset); // Only used by EXTRA macro
     { // 'raise' expression ['from' expression]
         expr_ty a;
@@ -2832,20 +3624,25 @@ raise_stmt_rule(Parser *p)
             &&
             (a = expression_rule(p))
             &&
-            (b = _tmp_39_rule(p), 1)
+            (b = _tmp_32_rule(p), 1)
         )
         {
-            Token *token = get_last_nonnwhitespace_token(p);
-            if (token == NULL) {
-                return NULL;
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
             }
-            int end_lineno = token->end_lineno;
-            UNUSED(end_lineno); // Only used by EXTRA macro
-            int end_col_offset = token->end_col_offset;
-            UNUSED(end_col_offset); // Only used by EXTRA macro
-            res = _Py_Raise ( a , b , EXTRA );
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            else {
+                Token *token = get_last_nonnwhitespace_token(p);
+                if (token == NULL) {
+                    return NULL;
+                }
+                int end_lineno = token->end_lineno;
+                UNUSED(end_lineno); // Only used by EXTRA macro
+                int end_col_offset = token->end_col_offset;
+                UNUSED(end_col_offset); // Only used by EXTRA macro
+                res = _Py_Raise ( a , b , EXTRA );
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -2857,17 +3654,22 @@ raise_stmt_rule(Parser *p)
             (keyword = expect_token(p, 501))
         )
         {
-            Token *token = get_last_nonnwhitespace_token(p);
-            if (token == NULL) {
-                return NULL;
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
             }
-            int end_lineno = token->end_lineno;
-            UNUSED(end_lineno); // Only used by EXTRA macro
-            int end_col_offset = token->end_col_offset;
-            UNUSED(end_col_offset); // Only used by EXTRA macro
-            res = _Py_Raise ( NULL , NULL , EXTRA );
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            else {
+                Token *token = get_last_nonnwhitespace_token(p);
+                if (token == NULL) {
+                    return NULL;
+                }
+                int end_lineno = token->end_lineno;
+                UNUSED(end_lineno); // Only used by EXTRA macro
+                int end_col_offset = token->end_col_offset;
+                UNUSED(end_col_offset); // Only used by EXTRA macro
+                res = _Py_Raise ( NULL , NULL , EXTRA );
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -2884,6 +3686,7 @@ function_def_rule(Parser *p)
 {
     stmt_ty res = NULL;
     int mark = p->mark;
+    int choice_mark = enter_choice(p, mark);
     { // decorators function_def_raw
         asdl_seq* d;
         stmt_ty f;
@@ -2893,9 +3696,14 @@ function_def_rule(Parser *p)
             (f = function_def_raw_rule(p))
         )
         {
-            res = function_def_decorators ( p , d , f );
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
+            }
+            else {
+                res = function_def_decorators ( p , d , f );
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -2914,6 +3722,7 @@ function_def_rule(Parser *p)
     }
     res = NULL;
   done:
+    p->choice_mark = choice_mark;
     return res;
 }
 
@@ -2925,12 +3734,13 @@ function_def_raw_rule(Parser *p)
 {
     stmt_ty res = NULL;
     int mark = p->mark;
+    int choice_mark = enter_choice(p, mark);
     if (p->mark == p->fill && fill_token(p) < 0) {
         return NULL;
     }
-    int start_lineno = p->tokens[mark]->lineno;
+    int start_lineno = get_token(p, mark)->lineno;
     UNUSED(start_lineno); // Only used by EXTRA macro
-    int start_col_offset = p->tokens[mark]->col_offset;
+    int start_col_offset = get_token(p, mark)->col_offset;
     UNUSED(start_col_offset); // Only used by EXTRA macro
     { // ASYNC 'def' NAME '(' parameters? ')' ['->' annotation] ':' block
         void *a;
@@ -2955,24 +3765,29 @@ function_def_raw_rule(Parser *p)
             &&
             (literal_1 = expect_token(p, 8))
             &&
-            (a = _tmp_40_rule(p), 1)
+            (a = _tmp_33_rule(p), 1)
             &&
             (literal_2 = expect_token(p, 11))
             &&
             (b = block_rule(p))
         )
         {
-            Token *token = get_last_nonnwhitespace_token(p);
-            if (token == NULL) {
-                return NULL;
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
             }
-            int end_lineno = token->end_lineno;
-            UNUSED(end_lineno); // Only used by EXTRA macro
-            int end_col_offset = token->end_col_offset;
-            UNUSED(end_col_offset); // Only used by EXTRA macro
-            res = _Py_AsyncFunctionDef ( n -> v . Name . id , ( params ) ? params : CHECK ( empty_arguments ( p ) ) , b , NULL , a , NULL , EXTRA );
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            else {
+                Token *token = get_last_nonnwhitespace_token(p);
+                if (token == NULL) {
+                    return NULL;
+                }
+                int end_lineno = token->end_lineno;
+                UNUSED(end_lineno); // Only used by EXTRA macro
+                int end_col_offset = token->end_col_offset;
+                UNUSED(end_col_offset); // Only used by EXTRA macro
+                res = _Py_AsyncFunctionDef ( n -> v . Name . id , ( params ) ? params : CHECK ( empty_arguments ( p ) ) , b , NULL , a , NULL , EXTRA );
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -2998,24 +3813,29 @@ function_def_raw_rule(Parser *p)
             &&
             (literal_1 = expect_token(p, 8))
             &&
-            (a = _tmp_41_rule(p), 1)
+            (a = _tmp_34_rule(p), 1)
             &&
             (literal_2 = expect_token(p, 11))
             &&
             (b = block_rule(p))
         )
         {
-            Token *token = get_last_nonnwhitespace_token(p);
-            if (token == NULL) {
-                return NULL;
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
             }
-            int end_lineno = token->end_lineno;
-            UNUSED(end_lineno); // Only used by EXTRA macro
-            int end_col_offset = token->end_col_offset;
-            UNUSED(end_col_offset); // Only used by EXTRA macro
-            res = _Py_FunctionDef ( n -> v . Name . id , ( params ) ? params : CHECK ( empty_arguments ( p ) ) , b , NULL , a , NULL , EXTRA );
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            else {
+                Token *token = get_last_nonnwhitespace_token(p);
+                if (token == NULL) {
+                    return NULL;
+                }
+                int end_lineno = token->end_lineno;
+                UNUSED(end_lineno); // Only used by EXTRA macro
+                int end_col_offset = token->end_col_offset;
+                UNUSED(end_col_offset); // Only used by EXTRA macro
+                res = _Py_FunctionDef ( n -> v . Name . id , ( params ) ? params : CHECK ( empty_arguments ( p ) ) , b , NULL , a , NULL , EXTRA );
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -3023,6 +3843,7 @@ function_def_raw_rule(Parser *p)
     }
     res = NULL;
   done:
+    p->choice_mark = choice_mark;
     return res;
 }
 
@@ -3045,16 +3866,21 @@ parameters_rule(Parser *p)
         if (
             (a = slash_without_default_rule(p))
             &&
-            (b = _tmp_42_rule(p), 1)
+            (b = _tmp_35_rule(p), 1)
             &&
-            (c = _tmp_43_rule(p), 1)
+            (c = _tmp_36_rule(p), 1)
             &&
-            (d = _tmp_44_rule(p), 1)
+            (d = _tmp_37_rule(p), 1)
         )
         {
-            res = make_arguments ( p , a , NULL , b , c , d );
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
+            }
+            else {
+                res = make_arguments ( p , a , NULL , b , c , d );
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -3067,14 +3893,19 @@ parameters_rule(Parser *p)
         if (
             (a = slash_with_default_rule(p))
             &&
-            (b = _tmp_45_rule(p), 1)
+            (b = _tmp_38_rule(p), 1)
             &&
-            (c = _tmp_46_rule(p), 1)
+            (c = _tmp_39_rule(p), 1)
         )
         {
-            res = make_arguments ( p , NULL , a , NULL , b , c );
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
+            }
+            else {
+                res = make_arguments ( p , NULL , a , NULL , b , c );
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -3087,14 +3918,19 @@ parameters_rule(Parser *p)
         if (
             (a = plain_names_rule(p))
             &&
-            (b = _tmp_47_rule(p), 1)
+            (b = _tmp_40_rule(p), 1)
             &&
-            (c = _tmp_48_rule(p), 1)
+            (c = _tmp_41_rule(p), 1)
         )
         {
-            res = make_arguments ( p , NULL , NULL , a , b , c );
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
+            }
+            else {
+                res = make_arguments ( p , NULL , NULL , a , b , c );
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -3106,12 +3942,17 @@ parameters_rule(Parser *p)
         if (
             (a = names_with_default_rule(p))
             &&
-            (b = _tmp_49_rule(p), 1)
+            (b = _tmp_42_rule(p), 1)
         )
         {
-            res = make_arguments ( p , NULL , NULL , NULL , a , b );
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
+            }
+            else {
+                res = make_arguments ( p , NULL , NULL , NULL , a , b );
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -3123,9 +3964,14 @@ parameters_rule(Parser *p)
             (a = star_etc_rule(p))
         )
         {
-            res = make_arguments ( p , NULL , NULL , NULL , NULL , a );
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
+            }
+            else {
+                res = make_arguments ( p , NULL , NULL , NULL , NULL , a );
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -3154,9 +4000,14 @@ slash_without_default_rule(Parser *p)
             (literal_1 = expect_token(p, 17))
         )
         {
-            res = a;
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
+            }
+            else {
+                res = a;
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -3179,7 +4030,7 @@ slash_with_default_rule(Parser *p)
         void *literal;
         void *literal_1;
         if (
-            (a = _tmp_50_rule(p), 1)
+            (a = _tmp_43_rule(p), 1)
             &&
             (b = names_with_default_rule(p))
             &&
@@ -3188,9 +4039,14 @@ slash_with_default_rule(Parser *p)
             (literal_1 = expect_token(p, 17))
         )
         {
-            res = slash_with_default ( p , a , b );
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
+            }
+            else {
+                res = slash_with_default ( p , a , b );
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -3221,16 +4077,21 @@ star_etc_rule(Parser *p)
             &&
             (a = plain_name_rule(p))
             &&
-            (b = _loop0_51_rule(p))
+            (b = _loop0_44_rule(p))
             &&
-            (c = _tmp_52_rule(p), 1)
+            (c = _tmp_45_rule(p), 1)
             &&
             (opt_var = expect_token(p, 12), 1)
         )
         {
-            res = star_etc ( p , a , b , c );
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
+            }
+            else {
+                res = star_etc ( p , a , b , c );
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -3244,16 +4105,21 @@ star_etc_rule(Parser *p)
         if (
             (literal = expect_token(p, 16))
             &&
-            (b = _loop1_53_rule(p))
+            (b = _loop1_46_rule(p))
             &&
-            (c = _tmp_54_rule(p), 1)
+            (c = _tmp_47_rule(p), 1)
             &&
             (opt_var = expect_token(p, 12), 1)
         )
         {
-            res = star_etc ( p , NULL , b , c );
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
+            }
+            else {
+                res = star_etc ( p , NULL , b , c );
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -3268,9 +4134,14 @@ star_etc_rule(Parser *p)
             (opt_var = expect_token(p, 12), 1)
         )
         {
-            res = star_etc ( p , NULL , NULL , a );
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
+            }
+            else {
+                res = star_etc ( p , NULL , NULL , a );
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -3296,12 +4167,17 @@ name_with_optional_default_rule(Parser *p)
             &&
             (a = plain_name_rule(p))
             &&
-            (b = _tmp_55_rule(p), 1)
+            (b = _tmp_48_rule(p), 1)
         )
         {
-            res = name_default_pair ( p , a , b );
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
+            }
+            else {
+                res = name_default_pair ( p , a , b );
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -3321,12 +4197,17 @@ names_with_default_rule(Parser *p)
     { // ','.name_with_default+
         asdl_seq * a;
         if (
-            (a = _gather_56_rule(p))
+            (a = _gather_49_rule(p))
         )
         {
-            res = a;
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
+            }
+            else {
+                res = a;
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -3355,9 +4236,14 @@ name_with_default_rule(Parser *p)
             (e = expression_rule(p))
         )
         {
-            res = name_default_pair ( p , n , e );
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
+            }
+            else {
+                res = name_default_pair ( p , n , e );
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -3379,12 +4265,17 @@ plain_names_rule(Parser *p)
     { // ','.(plain_name !'=')+
         asdl_seq * a;
         if (
-            (a = _gather_58_rule(p))
+            (a = _gather_50_rule(p))
         )
         {
-            res = a;
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
+            }
+            else {
+                res = a;
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -3405,9 +4296,9 @@ plain_name_rule(Parser *p)
     if (p->mark == p->fill && fill_token(p) < 0) {
         return NULL;
     }
-    int start_lineno = p->tokens[mark]->lineno;
+    int start_lineno = get_token(p, mark)->lineno;
     UNUSED(start_lineno); // Only used by EXTRA macro
-    int start_col_offset = p->tokens[mark]->col_offset;
+    int start_col_offset = get_token(p, mark)->col_offset;
     UNUSED(start_col_offset); // Only used by EXTRA macro
     { // NAME [':' annotation]
         expr_ty a;
@@ -3415,20 +4306,25 @@ plain_name_rule(Parser *p)
         if (
             (a = name_token(p))
             &&
-            (b = _tmp_60_rule(p), 1)
+            (b = _tmp_52_rule(p), 1)
         )
         {
-            Token *token = get_last_nonnwhitespace_token(p);
-            if (token == NULL) {
-                return NULL;
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
             }
-            int end_lineno = token->end_lineno;
-            UNUSED(end_lineno); // Only used by EXTRA macro
-            int end_col_offset = token->end_col_offset;
-            UNUSED(end_col_offset); // Only used by EXTRA macro
-            res = _Py_arg ( a -> v . Name . id , b , NULL , EXTRA );
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            else {
+                Token *token = get_last_nonnwhitespace_token(p);
+                if (token == NULL) {
+                    return NULL;
+                }
+                int end_lineno = token->end_lineno;
+                UNUSED(end_lineno); // Only used by EXTRA macro
+                int end_col_offset = token->end_col_offset;
+                UNUSED(end_col_offset); // Only used by EXTRA macro
+                res = _Py_arg ( a -> v . Name . id , b , NULL , EXTRA );
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -3454,9 +4350,14 @@ kwds_rule(Parser *p)
             (a = plain_name_rule(p))
         )
         {
-            res = a;
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
+            }
+            else {
+                res = a;
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -3498,12 +4399,17 @@ decorators_rule(Parser *p)
     { // (('@' factor NEWLINE))+
         asdl_seq * a;
         if (
-            (a = _loop1_61_rule(p))
+            (a = _loop1_53_rule(p))
         )
         {
-            res = a;
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
+            }
+            else {
+                res = a;
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -3520,6 +4426,7 @@ class_def_rule(Parser *p)
 {
     stmt_ty res = NULL;
     int mark = p->mark;
+    int choice_mark = enter_choice(p, mark);
     { // decorators class_def_raw
         asdl_seq* a;
         stmt_ty b;
@@ -3529,9 +4436,14 @@ class_def_rule(Parser *p)
             (b = class_def_raw_rule(p))
         )
         {
-            res = class_def_decorators ( p , a , b );
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
+            }
+            else {
+                res = class_def_decorators ( p , a , b );
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -3550,6 +4462,7 @@ class_def_rule(Parser *p)
     }
     res = NULL;
   done:
+    p->choice_mark = choice_mark;
     return res;
 }
 
@@ -3559,12 +4472,13 @@ class_def_raw_rule(Parser *p)
 {
     stmt_ty res = NULL;
     int mark = p->mark;
+    int choice_mark = enter_choice(p, mark);
     if (p->mark == p->fill && fill_token(p) < 0) {
         return NULL;
     }
-    int start_lineno = p->tokens[mark]->lineno;
+    int start_lineno = get_token(p, mark)->lineno;
     UNUSED(start_lineno); // Only used by EXTRA macro
-    int start_col_offset = p->tokens[mark]->col_offset;
+    int start_col_offset = get_token(p, mark)->col_offset;
     UNUSED(start_col_offset); // Only used by EXTRA macro
     { // 'class' NAME ['(' arguments? ')'] ':' block
         expr_ty a;
@@ -3577,24 +4491,29 @@ class_def_raw_rule(Parser *p)
             &&
             (a = name_token(p))
             &&
-            (b = _tmp_62_rule(p), 1)
+            (b = _tmp_54_rule(p), 1)
             &&
             (literal = expect_token(p, 11))
             &&
             (c = block_rule(p))
         )
         {
-            Token *token = get_last_nonnwhitespace_token(p);
-            if (token == NULL) {
-                return NULL;
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
             }
-            int end_lineno = token->end_lineno;
-            UNUSED(end_lineno); // Only used by EXTRA macro
-            int end_col_offset = token->end_col_offset;
-            UNUSED(end_col_offset); // Only used by EXTRA macro
-            res = _Py_ClassDef ( a -> v . Name . id , ( b ) ? ( ( expr_ty ) b ) -> v . Call . args : NULL , ( b ) ? ( ( expr_ty ) b ) -> v . Call . keywords : NULL , c , NULL , EXTRA );
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            else {
+                Token *token = get_last_nonnwhitespace_token(p);
+                if (token == NULL) {
+                    return NULL;
+                }
+                int end_lineno = token->end_lineno;
+                UNUSED(end_lineno); // Only used by EXTRA macro
+                int end_col_offset = token->end_col_offset;
+                UNUSED(end_col_offset); // Only used by EXTRA macro
+                res = _Py_ClassDef ( a -> v . Name . id , ( b ) ? ( ( expr_ty ) b ) -> v . Call . args : NULL , ( b ) ? ( ( expr_ty ) b ) -> v . Call . keywords : NULL , c , NULL , EXTRA );
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -3602,6 +4521,7 @@ class_def_raw_rule(Parser *p)
     }
     res = NULL;
   done:
+    p->choice_mark = choice_mark;
     return res;
 }
 
@@ -3613,6 +4533,7 @@ block_rule(Parser *p)
     if (is_memoized(p, block_type, &res))
         return res;
     int mark = p->mark;
+    int choice_mark = enter_choice(p, mark);
     { // NEWLINE INDENT statements DEDENT
         asdl_seq* a;
         void *dedent_var;
@@ -3628,9 +4549,14 @@ block_rule(Parser *p)
             (dedent_var = dedent_token(p))
         )
         {
-            res = a;
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
+            }
+            else {
+                res = a;
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -3649,6 +4575,7 @@ block_rule(Parser *p)
     }
     res = NULL;
   done:
+    p->choice_mark = choice_mark;
     insert_memo(p, mark, block_type, res);
     return res;
 }
@@ -3663,14 +4590,19 @@ expressions_list_rule(Parser *p)
         asdl_seq * a;
         void *opt_var;
         if (
-            (a = _gather_63_rule(p))
+            (a = _gather_55_rule(p))
             &&
             (opt_var = expect_token(p, 12), 1)
         )
         {
-            res = a;
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
+            }
+            else {
+                res = a;
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -3693,9 +4625,9 @@ expressions_rule(Parser *p)
     if (p->mark == p->fill && fill_token(p) < 0) {
         return NULL;
     }
-    int start_lineno = p->tokens[mark]->lineno;
+    int start_lineno = get_token(p, mark)->lineno;
     UNUSED(start_lineno); // Only used by EXTRA macro
-    int start_col_offset = p->tokens[mark]->col_offset;
+    int start_col_offset = get_token(p, mark)->col_offset;
     UNUSED(start_col_offset); // Only used by EXTRA macro
     { // star_expression ((',' star_expression))+ ','?
         expr_ty a;
@@ -3704,22 +4636,27 @@ expressions_rule(Parser *p)
         if (
             (a = star_expression_rule(p))
             &&
-            (b = _loop1_65_rule(p))
+            (b = _loop1_56_rule(p))
             &&
             (opt_var = expect_token(p, 12), 1)
         )
         {
-            Token *token = get_last_nonnwhitespace_token(p);
-            if (token == NULL) {
-                return NULL;
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
             }
-            int end_lineno = token->end_lineno;
-            UNUSED(end_lineno); // Only used by EXTRA macro
-            int end_col_offset = token->end_col_offset;
-            UNUSED(end_col_offset); // Only used by EXTRA macro
-            res = _Py_Tuple ( CHECK ( seq_insert_in_front ( p , a , b ) ) , Load , EXTRA );
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            else {
+                Token *token = get_last_nonnwhitespace_token(p);
+                if (token == NULL) {
+                    return NULL;
+                }
+                int end_lineno = token->end_lineno;
+                UNUSED(end_lineno); // Only used by EXTRA macro
+                int end_col_offset = token->end_col_offset;
+                UNUSED(end_col_offset); // Only used by EXTRA macro
+                res = _Py_Tuple ( CHECK ( seq_insert_in_front ( p , a , b ) ) , Load , EXTRA );
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -3734,17 +4671,22 @@ expressions_rule(Parser *p)
             (literal = expect_token(p, 12))
         )
         {
-            Token *token = get_last_nonnwhitespace_token(p);
-            if (token == NULL) {
-                return NULL;
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
             }
-            int end_lineno = token->end_lineno;
-            UNUSED(end_lineno); // Only used by EXTRA macro
-            int end_col_offset = token->end_col_offset;
-            UNUSED(end_col_offset); // Only used by EXTRA macro
-            res = _Py_Tuple ( CHECK ( singleton_seq ( p , a ) ) , Load , EXTRA );
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            else {
+                Token *token = get_last_nonnwhitespace_token(p);
+                if (token == NULL) {
+                    return NULL;
+                }
+                int end_lineno = token->end_lineno;
+                UNUSED(end_lineno); // Only used by EXTRA macro
+                int end_col_offset = token->end_col_offset;
+                UNUSED(end_col_offset); // Only used by EXTRA macro
+                res = _Py_Tuple ( CHECK ( singleton_seq ( p , a ) ) , Load , EXTRA );
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -3777,9 +4719,9 @@ star_expression_rule(Parser *p)
     if (p->mark == p->fill && fill_token(p) < 0) {
         return NULL;
     }
-    int start_lineno = p->tokens[mark]->lineno;
+    int start_lineno = get_token(p, mark)->lineno;
     UNUSED(start_lineno); // Only used by EXTRA macro
-    int start_col_offset = p->tokens[mark]->col_offset;
+    int start_col_offset = get_token(p, mark)->col_offset;
     UNUSED(start_col_offset); // Only used by EXTRA macro
     { // '*' bitwise_or
         expr_ty a;
@@ -3790,17 +4732,22 @@ star_expression_rule(Parser *p)
             (a = bitwise_or_rule(p))
         )
         {
-            Token *token = get_last_nonnwhitespace_token(p);
-            if (token == NULL) {
-                return NULL;
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
             }
-            int end_lineno = token->end_lineno;
-            UNUSED(end_lineno); // Only used by EXTRA macro
-            int end_col_offset = token->end_col_offset;
-            UNUSED(end_col_offset); // Only used by EXTRA macro
-            res = _Py_Starred ( a , Load , EXTRA );
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            else {
+                Token *token = get_last_nonnwhitespace_token(p);
+                if (token == NULL) {
+                    return NULL;
+                }
+                int end_lineno = token->end_lineno;
+                UNUSED(end_lineno); // Only used by EXTRA macro
+                int end_col_offset = token->end_col_offset;
+                UNUSED(end_col_offset); // Only used by EXTRA macro
+                res = _Py_Starred ( a , Load , EXTRA );
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -3833,14 +4780,19 @@ star_named_expressions_rule(Parser *p)
         asdl_seq * a;
         void *opt_var;
         if (
-            (a = _gather_66_rule(p))
+            (a = _gather_57_rule(p))
             &&
             (opt_var = expect_token(p, 12), 1)
         )
         {
-            res = a;
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
+            }
+            else {
+                res = a;
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -3860,9 +4812,9 @@ star_named_expression_rule(Parser *p)
     if (p->mark == p->fill && fill_token(p) < 0) {
         return NULL;
     }
-    int start_lineno = p->tokens[mark]->lineno;
+    int start_lineno = get_token(p, mark)->lineno;
     UNUSED(start_lineno); // Only used by EXTRA macro
-    int start_col_offset = p->tokens[mark]->col_offset;
+    int start_col_offset = get_token(p, mark)->col_offset;
     UNUSED(start_col_offset); // Only used by EXTRA macro
     { // '*' bitwise_or
         expr_ty a;
@@ -3873,17 +4825,22 @@ star_named_expression_rule(Parser *p)
             (a = bitwise_or_rule(p))
         )
         {
-            Token *token = get_last_nonnwhitespace_token(p);
-            if (token == NULL) {
-                return NULL;
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
             }
-            int end_lineno = token->end_lineno;
-            UNUSED(end_lineno); // Only used by EXTRA macro
-            int end_col_offset = token->end_col_offset;
-            UNUSED(end_col_offset); // Only used by EXTRA macro
-            res = _Py_Starred ( a , Load , EXTRA );
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            else {
+                Token *token = get_last_nonnwhitespace_token(p);
+                if (token == NULL) {
+                    return NULL;
+                }
+                int end_lineno = token->end_lineno;
+                UNUSED(end_lineno); // Only used by EXTRA macro
+                int end_col_offset = token->end_col_offset;
+                UNUSED(end_col_offset); // Only used by EXTRA macro
+                res = _Py_Starred ( a , Load , EXTRA );
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -3914,9 +4871,9 @@ named_expression_rule(Parser *p)
     if (p->mark == p->fill && fill_token(p) < 0) {
         return NULL;
     }
-    int start_lineno = p->tokens[mark]->lineno;
+    int start_lineno = get_token(p, mark)->lineno;
     UNUSED(start_lineno); // Only used by EXTRA macro
-    int start_col_offset = p->tokens[mark]->col_offset;
+    int start_col_offset = get_token(p, mark)->col_offset;
     UNUSED(start_col_offset); // Only used by EXTRA macro
     { // NAME ':=' expression
         expr_ty a;
@@ -3930,17 +4887,22 @@ named_expression_rule(Parser *p)
             (b = expression_rule(p))
         )
         {
-            Token *token = get_last_nonnwhitespace_token(p);
-            if (token == NULL) {
-                return NULL;
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
             }
-            int end_lineno = token->end_lineno;
-            UNUSED(end_lineno); // Only used by EXTRA macro
-            int end_col_offset = token->end_col_offset;
-            UNUSED(end_col_offset); // Only used by EXTRA macro
-            res = _Py_NamedExpr ( CHECK ( set_expr_context ( p , a , Store ) ) , b , EXTRA );
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            else {
+                Token *token = get_last_nonnwhitespace_token(p);
+                if (token == NULL) {
+                    return NULL;
+                }
+                int end_lineno = token->end_lineno;
+                UNUSED(end_lineno); // Only used by EXTRA macro
+                int end_col_offset = token->end_col_offset;
+                UNUSED(end_col_offset); // Only used by EXTRA macro
+                res = _Py_NamedExpr ( CHECK ( set_expr_context ( p , a , Store ) ) , b , EXTRA );
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -4006,9 +4968,9 @@ expression_rule(Parser *p)
     if (p->mark == p->fill && fill_token(p) < 0) {
         return NULL;
     }
-    int start_lineno = p->tokens[mark]->lineno;
+    int start_lineno = get_token(p, mark)->lineno;
     UNUSED(start_lineno); // Only used by EXTRA macro
-    int start_col_offset = p->tokens[mark]->col_offset;
+    int start_col_offset = get_token(p, mark)->col_offset;
     UNUSED(start_col_offset); // Only used by EXTRA macro
     { // disjunction 'if' disjunction 'else' expression
         expr_ty a;
@@ -4028,17 +4990,22 @@ expression_rule(Parser *p)
             (c = expression_rule(p))
         )
         {
-            Token *token = get_last_nonnwhitespace_token(p);
-            if (token == NULL) {
-                return NULL;
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
             }
-            int end_lineno = token->end_lineno;
-            UNUSED(end_lineno); // Only used by EXTRA macro
-            int end_col_offset = token->end_col_offset;
-            UNUSED(end_col_offset); // Only used by EXTRA macro
-            res = _Py_IfExp ( b , a , c , EXTRA );
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            else {
+                Token *token = get_last_nonnwhitespace_token(p);
+                if (token == NULL) {
+                    return NULL;
+                }
+                int end_lineno = token->end_lineno;
+                UNUSED(end_lineno); // Only used by EXTRA macro
+                int end_col_offset = token->end_col_offset;
+                UNUSED(end_col_offset); // Only used by EXTRA macro
+                res = _Py_IfExp ( b , a , c , EXTRA );
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -4081,9 +5048,9 @@ lambdef_rule(Parser *p)
     if (p->mark == p->fill && fill_token(p) < 0) {
         return NULL;
     }
-    int start_lineno = p->tokens[mark]->lineno;
+    int start_lineno = get_token(p, mark)->lineno;
     UNUSED(start_lineno); // Only used by EXTRA macro
-    int start_col_offset = p->tokens[mark]->col_offset;
+    int start_col_offset = get_token(p, mark)->col_offset;
     UNUSED(start_col_offset); // Only used by EXTRA macro
     { // 'lambda' lambda_parameters? ':' expression
         void *a;
@@ -4100,17 +5067,22 @@ lambdef_rule(Parser *p)
             (b = expression_rule(p))
         )
         {
-            Token *token = get_last_nonnwhitespace_token(p);
-            if (token == NULL) {
-                return NULL;
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
             }
-            int end_lineno = token->end_lineno;
-            UNUSED(end_lineno); // Only used by EXTRA macro
-            int end_col_offset = token->end_col_offset;
-            UNUSED(end_col_offset); // Only used by EXTRA macro
-            res = _Py_Lambda ( ( a ) ? a : CHECK ( empty_arguments ( p ) ) , b , EXTRA );
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            else {
+                Token *token = get_last_nonnwhitespace_token(p);
+                if (token == NULL) {
+                    return NULL;
+                }
+                int end_lineno = token->end_lineno;
+                UNUSED(end_lineno); // Only used by EXTRA macro
+                int end_col_offset = token->end_col_offset;
+                UNUSED(end_col_offset); // Only used by EXTRA macro
+                res = _Py_Lambda ( ( a ) ? a : CHECK ( empty_arguments ( p ) ) , b , EXTRA );
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -4140,16 +5112,21 @@ lambda_parameters_rule(Parser *p)
         if (
             (a = lambda_slash_without_default_rule(p))
             &&
-            (b = _tmp_68_rule(p), 1)
+            (b = _tmp_58_rule(p), 1)
             &&
-            (c = _tmp_69_rule(p), 1)
+            (c = _tmp_59_rule(p), 1)
             &&
-            (d = _tmp_70_rule(p), 1)
+            (d = _tmp_60_rule(p), 1)
         )
         {
-            res = make_arguments ( p , a , NULL , b , c , d );
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
+            }
+            else {
+                res = make_arguments ( p , a , NULL , b , c , d );
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -4162,14 +5139,19 @@ lambda_parameters_rule(Parser *p)
         if (
             (a = lambda_slash_with_default_rule(p))
             &&
-            (b = _tmp_71_rule(p), 1)
+            (b = _tmp_61_rule(p), 1)
             &&
-            (c = _tmp_72_rule(p), 1)
+            (c = _tmp_62_rule(p), 1)
         )
         {
-            res = make_arguments ( p , NULL , a , NULL , b , c );
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
+            }
+            else {
+                res = make_arguments ( p , NULL , a , NULL , b , c );
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -4182,14 +5164,19 @@ lambda_parameters_rule(Parser *p)
         if (
             (a = lambda_plain_names_rule(p))
             &&
-            (b = _tmp_73_rule(p), 1)
+            (b = _tmp_63_rule(p), 1)
             &&
-            (c = _tmp_74_rule(p), 1)
+            (c = _tmp_64_rule(p), 1)
         )
         {
-            res = make_arguments ( p , NULL , NULL , a , b , c );
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
+            }
+            else {
+                res = make_arguments ( p , NULL , NULL , a , b , c );
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -4201,12 +5188,17 @@ lambda_parameters_rule(Parser *p)
         if (
             (a = lambda_names_with_default_rule(p))
             &&
-            (b = _tmp_75_rule(p), 1)
+            (b = _tmp_65_rule(p), 1)
         )
         {
-            res = make_arguments ( p , NULL , NULL , NULL , a , b );
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
+            }
+            else {
+                res = make_arguments ( p , NULL , NULL , NULL , a , b );
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -4218,9 +5210,14 @@ lambda_parameters_rule(Parser *p)
             (a = lambda_star_etc_rule(p))
         )
         {
-            res = make_arguments ( p , NULL , NULL , NULL , NULL , a );
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
+            }
+            else {
+                res = make_arguments ( p , NULL , NULL , NULL , NULL , a );
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -4249,9 +5246,14 @@ lambda_slash_without_default_rule(Parser *p)
             (literal_1 = expect_token(p, 17))
         )
         {
-            res = a;
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
+            }
+            else {
+                res = a;
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -4274,7 +5276,7 @@ lambda_slash_with_default_rule(Parser *p)
         void *literal;
         void *literal_1;
         if (
-            (a = _tmp_76_rule(p), 1)
+            (a = _tmp_66_rule(p), 1)
             &&
             (b = lambda_names_with_default_rule(p))
             &&
@@ -4283,9 +5285,14 @@ lambda_slash_with_default_rule(Parser *p)
             (literal_1 = expect_token(p, 17))
         )
         {
-            res = slash_with_default ( p , a , b );
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
+            }
+            else {
+                res = slash_with_default ( p , a , b );
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -4316,16 +5323,21 @@ lambda_star_etc_rule(Parser *p)
             &&
             (a = lambda_plain_name_rule(p))
             &&
-            (b = _loop0_77_rule(p))
+            (b = _loop0_67_rule(p))
             &&
-            (c = _tmp_78_rule(p), 1)
+            (c = _tmp_68_rule(p), 1)
             &&
             (opt_var = expect_token(p, 12), 1)
         )
         {
-            res = star_etc ( p , a , b , c );
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
+            }
+            else {
+                res = star_etc ( p , a , b , c );
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -4339,16 +5351,21 @@ lambda_star_etc_rule(Parser *p)
         if (
             (literal = expect_token(p, 16))
             &&
-            (b = _loop1_79_rule(p))
+            (b = _loop1_69_rule(p))
             &&
-            (c = _tmp_80_rule(p), 1)
+            (c = _tmp_70_rule(p), 1)
             &&
             (opt_var = expect_token(p, 12), 1)
         )
         {
-            res = star_etc ( p , NULL , b , c );
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
+            }
+            else {
+                res = star_etc ( p , NULL , b , c );
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -4363,9 +5380,14 @@ lambda_star_etc_rule(Parser *p)
             (opt_var = expect_token(p, 12), 1)
         )
         {
-            res = star_etc ( p , NULL , NULL , a );
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
+            }
+            else {
+                res = star_etc ( p , NULL , NULL , a );
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -4391,12 +5413,17 @@ lambda_name_with_optional_default_rule(Parser *p)
             &&
             (a = lambda_plain_name_rule(p))
             &&
-            (b = _tmp_81_rule(p), 1)
+            (b = _tmp_71_rule(p), 1)
         )
         {
-            res = name_default_pair ( p , a , b );
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
+            }
+            else {
+                res = name_default_pair ( p , a , b );
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -4416,12 +5443,17 @@ lambda_names_with_default_rule(Parser *p)
     { // ','.lambda_name_with_default+
         asdl_seq * a;
         if (
-            (a = _gather_82_rule(p))
+            (a = _gather_72_rule(p))
         )
         {
-            res = a;
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
+            }
+            else {
+                res = a;
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -4450,9 +5482,14 @@ lambda_name_with_default_rule(Parser *p)
             (e = expression_rule(p))
         )
         {
-            res = name_default_pair ( p , n , e );
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
+            }
+            else {
+                res = name_default_pair ( p , n , e );
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -4468,16 +5505,23 @@ static asdl_seq*
 lambda_plain_names_rule(Parser *p)
 {
     asdl_seq* res = NULL;
+    if (is_memoized(p, lambda_plain_names_type, &res))
+        return res;
     int mark = p->mark;
     { // ','.(lambda_plain_name !'=')+
         asdl_seq * a;
         if (
-            (a = _gather_84_rule(p))
+            (a = _gather_73_rule(p))
         )
         {
-            res = a;
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
+            }
+            else {
+                res = a;
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -4485,6 +5529,7 @@ lambda_plain_names_rule(Parser *p)
     }
     res = NULL;
   done:
+    insert_memo(p, mark, lambda_plain_names_type, res);
     return res;
 }
 
@@ -4497,9 +5542,9 @@ lambda_plain_name_rule(Parser *p)
     if (p->mark == p->fill && fill_token(p) < 0) {
         return NULL;
     }
-    int start_lineno = p->tokens[mark]->lineno;
+    int start_lineno = get_token(p, mark)->lineno;
     UNUSED(start_lineno); // Only used by EXTRA macro
-    int start_col_offset = p->tokens[mark]->col_offset;
+    int start_col_offset = get_token(p, mark)->col_offset;
     UNUSED(start_col_offset); // Only used by EXTRA macro
     { // NAME
         expr_ty a;
@@ -4507,17 +5552,22 @@ lambda_plain_name_rule(Parser *p)
             (a = name_token(p))
         )
         {
-            Token *token = get_last_nonnwhitespace_token(p);
-            if (token == NULL) {
-                return NULL;
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
             }
-            int end_lineno = token->end_lineno;
-            UNUSED(end_lineno); // Only used by EXTRA macro
-            int end_col_offset = token->end_col_offset;
-            UNUSED(end_col_offset); // Only used by EXTRA macro
-            res = _Py_arg ( a -> v . Name . id , NULL , NULL , EXTRA );
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            else {
+                Token *token = get_last_nonnwhitespace_token(p);
+                if (token == NULL) {
+                    return NULL;
+                }
+                int end_lineno = token->end_lineno;
+                UNUSED(end_lineno); // Only used by EXTRA macro
+                int end_col_offset = token->end_col_offset;
+                UNUSED(end_col_offset); // Only used by EXTRA macro
+                res = _Py_arg ( a -> v . Name . id , NULL , NULL , EXTRA );
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -4543,9 +5593,14 @@ lambda_kwds_rule(Parser *p)
             (a = lambda_plain_name_rule(p))
         )
         {
-            res = a;
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
+            }
+            else {
+                res = a;
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -4567,9 +5622,9 @@ disjunction_rule(Parser *p)
     if (p->mark == p->fill && fill_token(p) < 0) {
         return NULL;
     }
-    int start_lineno = p->tokens[mark]->lineno;
+    int start_lineno = get_token(p, mark)->lineno;
     UNUSED(start_lineno); // Only used by EXTRA macro
-    int start_col_offset = p->tokens[mark]->col_offset;
+    int start_col_offset = get_token(p, mark)->col_offset;
     UNUSED(start_col_offset); // Only used by EXTRA macro
     { // conjunction (('or' conjunction))+
         expr_ty a;
@@ -4577,20 +5632,25 @@ disjunction_rule(Parser *p)
         if (
             (a = conjunction_rule(p))
             &&
-            (b = _loop1_86_rule(p))
+            (b = _loop1_75_rule(p))
         )
         {
-            Token *token = get_last_nonnwhitespace_token(p);
-            if (token == NULL) {
-                return NULL;
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
             }
-            int end_lineno = token->end_lineno;
-            UNUSED(end_lineno); // Only used by EXTRA macro
-            int end_col_offset = token->end_col_offset;
-            UNUSED(end_col_offset); // Only used by EXTRA macro
-            res = _Py_BoolOp ( Or , CHECK ( seq_insert_in_front ( p , a , b ) ) , EXTRA );
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            else {
+                Token *token = get_last_nonnwhitespace_token(p);
+                if (token == NULL) {
+                    return NULL;
+                }
+                int end_lineno = token->end_lineno;
+                UNUSED(end_lineno); // Only used by EXTRA macro
+                int end_col_offset = token->end_col_offset;
+                UNUSED(end_col_offset); // Only used by EXTRA macro
+                res = _Py_BoolOp ( Or , CHECK ( seq_insert_in_front ( p , a , b ) ) , EXTRA );
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -4624,9 +5684,9 @@ conjunction_rule(Parser *p)
     if (p->mark == p->fill && fill_token(p) < 0) {
         return NULL;
     }
-    int start_lineno = p->tokens[mark]->lineno;
+    int start_lineno = get_token(p, mark)->lineno;
     UNUSED(start_lineno); // Only used by EXTRA macro
-    int start_col_offset = p->tokens[mark]->col_offset;
+    int start_col_offset = get_token(p, mark)->col_offset;
     UNUSED(start_col_offset); // Only used by EXTRA macro
     { // inversion (('and' inversion))+
         expr_ty a;
@@ -4634,20 +5694,25 @@ conjunction_rule(Parser *p)
         if (
             (a = inversion_rule(p))
             &&
-            (b = _loop1_87_rule(p))
+            (b = _loop1_76_rule(p))
         )
         {
-            Token *token = get_last_nonnwhitespace_token(p);
-            if (token == NULL) {
-                return NULL;
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
             }
-            int end_lineno = token->end_lineno;
-            UNUSED(end_lineno); // Only used by EXTRA macro
-            int end_col_offset = token->end_col_offset;
-            UNUSED(end_col_offset); // Only used by EXTRA macro
-            res = _Py_BoolOp ( And , CHECK ( seq_insert_in_front ( p , a , b ) ) , EXTRA );
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            else {
+                Token *token = get_last_nonnwhitespace_token(p);
+                if (token == NULL) {
+                    return NULL;
+                }
+                int end_lineno = token->end_lineno;
+                UNUSED(end_lineno); // Only used by EXTRA macro
+                int end_col_offset = token->end_col_offset;
+                UNUSED(end_col_offset); // Only used by EXTRA macro
+                res = _Py_BoolOp ( And , CHECK ( seq_insert_in_front ( p , a , b ) ) , EXTRA );
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -4681,9 +5746,9 @@ inversion_rule(Parser *p)
     if (p->mark == p->fill && fill_token(p) < 0) {
         return NULL;
     }
-    int start_lineno = p->tokens[mark]->lineno;
+    int start_lineno = get_token(p, mark)->lineno;
     UNUSED(start_lineno); // Only used by EXTRA macro
-    int start_col_offset = p->tokens[mark]->col_offset;
+    int start_col_offset = get_token(p, mark)->col_offset;
     UNUSED(start_col_offset); // Only used by EXTRA macro
     { // 'not' inversion
         expr_ty a;
@@ -4694,17 +5759,22 @@ inversion_rule(Parser *p)
             (a = inversion_rule(p))
         )
         {
-            Token *token = get_last_nonnwhitespace_token(p);
-            if (token == NULL) {
-                return NULL;
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
             }
-            int end_lineno = token->end_lineno;
-            UNUSED(end_lineno); // Only used by EXTRA macro
-            int end_col_offset = token->end_col_offset;
-            UNUSED(end_col_offset); // Only used by EXTRA macro
-            res = _Py_UnaryOp ( Not , a , EXTRA );
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            else {
+                Token *token = get_last_nonnwhitespace_token(p);
+                if (token == NULL) {
+                    return NULL;
+                }
+                int end_lineno = token->end_lineno;
+                UNUSED(end_lineno); // Only used by EXTRA macro
+                int end_col_offset = token->end_col_offset;
+                UNUSED(end_col_offset); // Only used by EXTRA macro
+                res = _Py_UnaryOp ( Not , a , EXTRA );
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -4736,9 +5806,9 @@ comparison_rule(Parser *p)
     if (p->mark == p->fill && fill_token(p) < 0) {
         return NULL;
     }
-    int start_lineno = p->tokens[mark]->lineno;
+    int start_lineno = get_token(p, mark)->lineno;
     UNUSED(start_lineno); // Only used by EXTRA macro
-    int start_col_offset = p->tokens[mark]->col_offset;
+    int start_col_offset = get_token(p, mark)->col_offset;
     UNUSED(start_col_offset); // Only used by EXTRA macro
     { // bitwise_or compare_op_bitwise_or_pair+
         expr_ty a;
@@ -4746,20 +5816,25 @@ comparison_rule(Parser *p)
         if (
             (a = bitwise_or_rule(p))
             &&
-            (b = _loop1_88_rule(p))
+            (b = _loop1_77_rule(p))
         )
         {
-            Token *token = get_last_nonnwhitespace_token(p);
-            if (token == NULL) {
-                return NULL;
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
             }
-            int end_lineno = token->end_lineno;
-            UNUSED(end_lineno); // Only used by EXTRA macro
-            int end_col_offset = token->end_col_offset;
-            UNUSED(end_col_offset); // Only used by EXTRA macro
-            res = _Py_Compare ( a , CHECK ( get_cmpops ( p , b ) ) , CHECK ( get_exprs ( p , b ) ) , EXTRA );
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            else {
+                Token *token = get_last_nonnwhitespace_token(p);
+                if (token == NULL) {
+                    return NULL;
+                }
+                int end_lineno = token->end_lineno;
+                UNUSED(end_lineno); // Only used by EXTRA macro
+                int end_col_offset = token->end_col_offset;
+                UNUSED(end_col_offset); // Only used by EXTRA macro
+                res = _Py_Compare ( a , CHECK ( get_cmpops ( p , b ) ) , CHECK ( get_exprs ( p , b ) ) , EXTRA );
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -4927,9 +6002,14 @@ eq_bitwise_or_rule(Parser *p)
             (a = bitwise_or_rule(p))
         )
         {
-            res = cmpop_expr_pair ( p , Eq , a );
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
+            }
+            else {
+                res = cmpop_expr_pair ( p , Eq , a );
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -4955,9 +6035,14 @@ noteq_bitwise_or_rule(Parser *p)
             (a = bitwise_or_rule(p))
         )
         {
-            res = cmpop_expr_pair ( p , NotEq , a );
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
+            }
+            else {
+                res = cmpop_expr_pair ( p , NotEq , a );
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -4983,9 +6068,14 @@ lte_bitwise_or_rule(Parser *p)
             (a = bitwise_or_rule(p))
         )
         {
-            res = cmpop_expr_pair ( p , LtE , a );
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
+            }
+            else {
+                res = cmpop_expr_pair ( p , LtE , a );
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -5011,9 +6101,14 @@ lt_bitwise_or_rule(Parser *p)
             (a = bitwise_or_rule(p))
         )
         {
-            res = cmpop_expr_pair ( p , Lt , a );
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
+            }
+            else {
+                res = cmpop_expr_pair ( p , Lt , a );
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -5039,9 +6134,14 @@ gte_bitwise_or_rule(Parser *p)
             (a = bitwise_or_rule(p))
         )
         {
-            res = cmpop_expr_pair ( p , GtE , a );
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
+            }
+            else {
+                res = cmpop_expr_pair ( p , GtE , a );
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -5067,9 +6167,14 @@ gt_bitwise_or_rule(Parser *p)
             (a = bitwise_or_rule(p))
         )
         {
-            res = cmpop_expr_pair ( p , Gt , a );
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
+            }
+            else {
+                res = cmpop_expr_pair ( p , Gt , a );
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -5098,9 +6203,14 @@ notin_bitwise_or_rule(Parser *p)
             (a = bitwise_or_rule(p))
         )
         {
-            res = cmpop_expr_pair ( p , NotIn , a );
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
+            }
+            else {
+                res = cmpop_expr_pair ( p , NotIn , a );
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -5126,9 +6236,14 @@ in_bitwise_or_rule(Parser *p)
             (a = bitwise_or_rule(p))
         )
         {
-            res = cmpop_expr_pair ( p , In , a );
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
+            }
+            else {
+                res = cmpop_expr_pair ( p , In , a );
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -5157,9 +6272,14 @@ isnot_bitwise_or_rule(Parser *p)
             (a = bitwise_or_rule(p))
         )
         {
-            res = cmpop_expr_pair ( p , IsNot , a );
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
+            }
+            else {
+                res = cmpop_expr_pair ( p , IsNot , a );
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -5185,9 +6305,14 @@ is_bitwise_or_rule(Parser *p)
             (a = bitwise_or_rule(p))
         )
         {
-            res = cmpop_expr_pair ( p , Is , a );
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
+            }
+            else {
+                res = cmpop_expr_pair ( p , Is , a );
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -5232,9 +6357,9 @@ bitwise_or_raw(Parser *p)
     if (p->mark == p->fill && fill_token(p) < 0) {
         return NULL;
     }
-    int start_lineno = p->tokens[mark]->lineno;
+    int start_lineno = get_token(p, mark)->lineno;
     UNUSED(start_lineno); // Only used by EXTRA macro
-    int start_col_offset = p->tokens[mark]->col_offset;
+    int start_col_offset = get_token(p, mark)->col_offset;
     UNUSED(start_col_offset); // Only used by EXTRA macro
     { // bitwise_or '|' bitwise_xor
         expr_ty a;
@@ -5248,17 +6373,22 @@ bitwise_or_raw(Parser *p)
             (b = bitwise_xor_rule(p))
         )
         {
-            Token *token = get_last_nonnwhitespace_token(p);
-            if (token == NULL) {
-                return NULL;
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
             }
-            int end_lineno = token->end_lineno;
-            UNUSED(end_lineno); // Only used by EXTRA macro
-            int end_col_offset = token->end_col_offset;
-            UNUSED(end_col_offset); // Only used by EXTRA macro
-            res = _Py_BinOp ( a , BitOr , b , EXTRA );
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            else {
+                Token *token = get_last_nonnwhitespace_token(p);
+                if (token == NULL) {
+                    return NULL;
+                }
+                int end_lineno = token->end_lineno;
+                UNUSED(end_lineno); // Only used by EXTRA macro
+                int end_col_offset = token->end_col_offset;
+                UNUSED(end_col_offset); // Only used by EXTRA macro
+                res = _Py_BinOp ( a , BitOr , b , EXTRA );
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -5314,9 +6444,9 @@ bitwise_xor_raw(Parser *p)
     if (p->mark == p->fill && fill_token(p) < 0) {
         return NULL;
     }
-    int start_lineno = p->tokens[mark]->lineno;
+    int start_lineno = get_token(p, mark)->lineno;
     UNUSED(start_lineno); // Only used by EXTRA macro
-    int start_col_offset = p->tokens[mark]->col_offset;
+    int start_col_offset = get_token(p, mark)->col_offset;
     UNUSED(start_col_offset); // Only used by EXTRA macro
     { // bitwise_xor '^' bitwise_and
         expr_ty a;
@@ -5330,17 +6460,22 @@ bitwise_xor_raw(Parser *p)
             (b = bitwise_and_rule(p))
         )
         {
-            Token *token = get_last_nonnwhitespace_token(p);
-            if (token == NULL) {
-                return NULL;
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
             }
-            int end_lineno = token->end_lineno;
-            UNUSED(end_lineno); // Only used by EXTRA macro
-            int end_col_offset = token->end_col_offset;
-            UNUSED(end_col_offset); // Only used by EXTRA macro
-            res = _Py_BinOp ( a , BitXor , b , EXTRA );
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            else {
+                Token *token = get_last_nonnwhitespace_token(p);
+                if (token == NULL) {
+                    return NULL;
+                }
+                int end_lineno = token->end_lineno;
+                UNUSED(end_lineno); // Only used by EXTRA macro
+                int end_col_offset = token->end_col_offset;
+                UNUSED(end_col_offset); // Only used by EXTRA macro
+                res = _Py_BinOp ( a , BitXor , b , EXTRA );
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -5396,9 +6531,9 @@ bitwise_and_raw(Parser *p)
     if (p->mark == p->fill && fill_token(p) < 0) {
         return NULL;
     }
-    int start_lineno = p->tokens[mark]->lineno;
+    int start_lineno = get_token(p, mark)->lineno;
     UNUSED(start_lineno); // Only used by EXTRA macro
-    int start_col_offset = p->tokens[mark]->col_offset;
+    int start_col_offset = get_token(p, mark)->col_offset;
     UNUSED(start_col_offset); // Only used by EXTRA macro
     { // bitwise_and '&' shift_expr
         expr_ty a;
@@ -5412,17 +6547,22 @@ bitwise_and_raw(Parser *p)
             (b = shift_expr_rule(p))
         )
         {
-            Token *token = get_last_nonnwhitespace_token(p);
-            if (token == NULL) {
-                return NULL;
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
             }
-            int end_lineno = token->end_lineno;
-            UNUSED(end_lineno); // Only used by EXTRA macro
-            int end_col_offset = token->end_col_offset;
-            UNUSED(end_col_offset); // Only used by EXTRA macro
-            res = _Py_BinOp ( a , BitAnd , b , EXTRA );
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            else {
+                Token *token = get_last_nonnwhitespace_token(p);
+                if (token == NULL) {
+                    return NULL;
+                }
+                int end_lineno = token->end_lineno;
+                UNUSED(end_lineno); // Only used by EXTRA macro
+                int end_col_offset = token->end_col_offset;
+                UNUSED(end_col_offset); // Only used by EXTRA macro
+                res = _Py_BinOp ( a , BitAnd , b , EXTRA );
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -5478,9 +6618,9 @@ shift_expr_raw(Parser *p)
     if (p->mark == p->fill && fill_token(p) < 0) {
         return NULL;
     }
-    int start_lineno = p->tokens[mark]->lineno;
+    int start_lineno = get_token(p, mark)->lineno;
     UNUSED(start_lineno); // Only used by EXTRA macro
-    int start_col_offset = p->tokens[mark]->col_offset;
+    int start_col_offset = get_token(p, mark)->col_offset;
     UNUSED(start_col_offset); // Only used by EXTRA macro
     { // shift_expr '<<' sum
         expr_ty a;
@@ -5494,17 +6634,22 @@ shift_expr_raw(Parser *p)
             (b = sum_rule(p))
         )
         {
-            Token *token = get_last_nonnwhitespace_token(p);
-            if (token == NULL) {
-                return NULL;
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
             }
-            int end_lineno = token->end_lineno;
-            UNUSED(end_lineno); // Only used by EXTRA macro
-            int end_col_offset = token->end_col_offset;
-            UNUSED(end_col_offset); // Only used by EXTRA macro
-            res = _Py_BinOp ( a , LShift , b , EXTRA );
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            else {
+                Token *token = get_last_nonnwhitespace_token(p);
+                if (token == NULL) {
+                    return NULL;
+                }
+                int end_lineno = token->end_lineno;
+                UNUSED(end_lineno); // Only used by EXTRA macro
+                int end_col_offset = token->end_col_offset;
+                UNUSED(end_col_offset); // Only used by EXTRA macro
+                res = _Py_BinOp ( a , LShift , b , EXTRA );
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -5522,17 +6667,22 @@ shift_expr_raw(Parser *p)
             (b = sum_rule(p))
         )
         {
-            Token *token = get_last_nonnwhitespace_token(p);
-            if (token == NULL) {
-                return NULL;
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
             }
-            int end_lineno = token->end_lineno;
-            UNUSED(end_lineno); // Only used by EXTRA macro
-            int end_col_offset = token->end_col_offset;
-            UNUSED(end_col_offset); // Only used by EXTRA macro
-            res = _Py_BinOp ( a , RShift , b , EXTRA );
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            else {
+                Token *token = get_last_nonnwhitespace_token(p);
+                if (token == NULL) {
+                    return NULL;
+                }
+                int end_lineno = token->end_lineno;
+                UNUSED(end_lineno); // Only used by EXTRA macro
+                int end_col_offset = token->end_col_offset;
+                UNUSED(end_col_offset); // Only used by EXTRA macro
+                res = _Py_BinOp ( a , RShift , b , EXTRA );
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -5588,9 +6738,9 @@ sum_raw(Parser *p)
     if (p->mark == p->fill && fill_token(p) < 0) {
         return NULL;
     }
-    int start_lineno = p->tokens[mark]->lineno;
+    int start_lineno = get_token(p, mark)->lineno;
     UNUSED(start_lineno); // Only used by EXTRA macro
-    int start_col_offset = p->tokens[mark]->col_offset;
+    int start_col_offset = get_token(p, mark)->col_offset;
     UNUSED(start_col_offset); // Only used by EXTRA macro
     { // sum '+' term
         expr_ty a;
@@ -5604,17 +6754,22 @@ sum_raw(Parser *p)
             (b = term_rule(p))
         )
         {
-            Token *token = get_last_nonnwhitespace_token(p);
-            if (token == NULL) {
-                return NULL;
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
             }
-            int end_lineno = token->end_lineno;
-            UNUSED(end_lineno); // Only used by EXTRA macro
-            int end_col_offset = token->end_col_offset;
-            UNUSED(end_col_offset); // Only used by EXTRA macro
-            res = _Py_BinOp ( a , Add , b , EXTRA );
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            else {
+                Token *token = get_last_nonnwhitespace_token(p);
+                if (token == NULL) {
+                    return NULL;
+                }
+                int end_lineno = token->end_lineno;
+                UNUSED(end_lineno); // Only used by EXTRA macro
+                int end_col_offset = token->end_col_offset;
+                UNUSED(end_col_offset); // Only used by EXTRA macro
+                res = _Py_BinOp ( a , Add , b , EXTRA );
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -5632,17 +6787,22 @@ sum_raw(Parser *p)
             (b = term_rule(p))
         )
         {
-            Token *token = get_last_nonnwhitespace_token(p);
-            if (token == NULL) {
-                return NULL;
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
             }
-            int end_lineno = token->end_lineno;
-            UNUSED(end_lineno); // Only used by EXTRA macro
-            int end_col_offset = token->end_col_offset;
-            UNUSED(end_col_offset); // Only used by EXTRA macro
-            res = _Py_BinOp ( a , Sub , b , EXTRA );
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            else {
+                Token *token = get_last_nonnwhitespace_token(p);
+                if (token == NULL) {
+                    return NULL;
+                }
+                int end_lineno = token->end_lineno;
+                UNUSED(end_lineno); // Only used by EXTRA macro
+                int end_col_offset = token->end_col_offset;
+                UNUSED(end_col_offset); // Only used by EXTRA macro
+                res = _Py_BinOp ( a , Sub , b , EXTRA );
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -5704,9 +6864,9 @@ term_raw(Parser *p)
     if (p->mark == p->fill && fill_token(p) < 0) {
         return NULL;
     }
-    int start_lineno = p->tokens[mark]->lineno;
+    int start_lineno = get_token(p, mark)->lineno;
     UNUSED(start_lineno); // Only used by EXTRA macro
-    int start_col_offset = p->tokens[mark]->col_offset;
+    int start_col_offset = get_token(p, mark)->col_offset;
     UNUSED(start_col_offset); // Only used by EXTRA macro
     { // term '*' factor
         expr_ty a;
@@ -5720,17 +6880,22 @@ term_raw(Parser *p)
             (b = factor_rule(p))
         )
         {
-            Token *token = get_last_nonnwhitespace_token(p);
-            if (token == NULL) {
-                return NULL;
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
             }
-            int end_lineno = token->end_lineno;
-            UNUSED(end_lineno); // Only used by EXTRA macro
-            int end_col_offset = token->end_col_offset;
-            UNUSED(end_col_offset); // Only used by EXTRA macro
-            res = _Py_BinOp ( a , Mult , b , EXTRA );
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            else {
+                Token *token = get_last_nonnwhitespace_token(p);
+                if (token == NULL) {
+                    return NULL;
+                }
+                int end_lineno = token->end_lineno;
+                UNUSED(end_lineno); // Only used by EXTRA macro
+                int end_col_offset = token->end_col_offset;
+                UNUSED(end_col_offset); // Only used by EXTRA macro
+                res = _Py_BinOp ( a , Mult , b , EXTRA );
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -5748,17 +6913,22 @@ term_raw(Parser *p)
             (b = factor_rule(p))
         )
         {
-            Token *token = get_last_nonnwhitespace_token(p);
-            if (token == NULL) {
-                return NULL;
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
             }
-            int end_lineno = token->end_lineno;
-            UNUSED(end_lineno); // Only used by EXTRA macro
-            int end_col_offset = token->end_col_offset;
-            UNUSED(end_col_offset); // Only used by EXTRA macro
-            res = _Py_BinOp ( a , Div , b , EXTRA );
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            else {
+                Token *token = get_last_nonnwhitespace_token(p);
+                if (token == NULL) {
+                    return NULL;
+                }
+                int end_lineno = token->end_lineno;
+                UNUSED(end_lineno); // Only used by EXTRA macro
+                int end_col_offset = token->end_col_offset;
+                UNUSED(end_col_offset); // Only used by EXTRA macro
+                res = _Py_BinOp ( a , Div , b , EXTRA );
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -5776,17 +6946,22 @@ term_raw(Parser *p)
             (b = factor_rule(p))
         )
         {
-            Token *token = get_last_nonnwhitespace_token(p);
-            if (token == NULL) {
-                return NULL;
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
             }
-            int end_lineno = token->end_lineno;
-            UNUSED(end_lineno); // Only used by EXTRA macro
-            int end_col_offset = token->end_col_offset;
-            UNUSED(end_col_offset); // Only used by EXTRA macro
-            res = _Py_BinOp ( a , FloorDiv , b , EXTRA );
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            else {
+                Token *token = get_last_nonnwhitespace_token(p);
+                if (token == NULL) {
+                    return NULL;
+                }
+                int end_lineno = token->end_lineno;
+                UNUSED(end_lineno); // Only used by EXTRA macro
+                int end_col_offset = token->end_col_offset;
+                UNUSED(end_col_offset); // Only used by EXTRA macro
+                res = _Py_BinOp ( a , FloorDiv , b , EXTRA );
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -5804,17 +6979,22 @@ term_raw(Parser *p)
             (b = factor_rule(p))
         )
         {
-            Token *token = get_last_nonnwhitespace_token(p);
-            if (token == NULL) {
-                return NULL;
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
             }
-            int end_lineno = token->end_lineno;
-            UNUSED(end_lineno); // Only used by EXTRA macro
-            int end_col_offset = token->end_col_offset;
-            UNUSED(end_col_offset); // Only used by EXTRA macro
-            res = _Py_BinOp ( a , Mod , b , EXTRA );
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            else {
+                Token *token = get_last_nonnwhitespace_token(p);
+                if (token == NULL) {
+                    return NULL;
+                }
+                int end_lineno = token->end_lineno;
+                UNUSED(end_lineno); // Only used by EXTRA macro
+                int end_col_offset = token->end_col_offset;
+                UNUSED(end_col_offset); // Only used by EXTRA macro
+                res = _Py_BinOp ( a , Mod , b , EXTRA );
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -5832,17 +7012,22 @@ term_raw(Parser *p)
             (b = factor_rule(p))
         )
         {
-            Token *token = get_last_nonnwhitespace_token(p);
-            if (token == NULL) {
-                return NULL;
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
             }
-            int end_lineno = token->end_lineno;
-            UNUSED(end_lineno); // Only used by EXTRA macro
-            int end_col_offset = token->end_col_offset;
-            UNUSED(end_col_offset); // Only used by EXTRA macro
-            res = _Py_BinOp ( a , MatMult , b , EXTRA );
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            else {
+                Token *token = get_last_nonnwhitespace_token(p);
+                if (token == NULL) {
+                    return NULL;
+                }
+                int end_lineno = token->end_lineno;
+                UNUSED(end_lineno); // Only used by EXTRA macro
+                int end_col_offset = token->end_col_offset;
+                UNUSED(end_col_offset); // Only used by EXTRA macro
+                res = _Py_BinOp ( a , MatMult , b , EXTRA );
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -5875,9 +7060,9 @@ factor_rule(Parser *p)
     if (p->mark == p->fill && fill_token(p) < 0) {
         return NULL;
     }
-    int start_lineno = p->tokens[mark]->lineno;
+    int start_lineno = get_token(p, mark)->lineno;
     UNUSED(start_lineno); // Only used by EXTRA macro
-    int start_col_offset = p->tokens[mark]->col_offset;
+    int start_col_offset = get_token(p, mark)->col_offset;
     UNUSED(start_col_offset); // Only used by EXTRA macro
     { // '+' factor
         expr_ty a;
@@ -5888,17 +7073,22 @@ factor_rule(Parser *p)
             (a = factor_rule(p))
         )
         {
-            Token *token = get_last_nonnwhitespace_token(p);
-            if (token == NULL) {
-                return NULL;
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
             }
-            int end_lineno = token->end_lineno;
-            UNUSED(end_lineno); // Only used by EXTRA macro
-            int end_col_offset = token->end_col_offset;
-            UNUSED(end_col_offset); // Only used by EXTRA macro
-            res = _Py_UnaryOp ( UAdd , a , EXTRA );
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            else {
+                Token *token = get_last_nonnwhitespace_token(p);
+                if (token == NULL) {
+                    return NULL;
+                }
+                int end_lineno = token->end_lineno;
+                UNUSED(end_lineno); // Only used by EXTRA macro
+                int end_col_offset = token->end_col_offset;
+                UNUSED(end_col_offset); // Only used by EXTRA macro
+                res = _Py_UnaryOp ( UAdd , a , EXTRA );
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -5913,17 +7103,22 @@ factor_rule(Parser *p)
             (a = factor_rule(p))
         )
         {
-            Token *token = get_last_nonnwhitespace_token(p);
-            if (token == NULL) {
-                return NULL;
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
             }
-            int end_lineno = token->end_lineno;
-            UNUSED(end_lineno); // Only used by EXTRA macro
-            int end_col_offset = token->end_col_offset;
-            UNUSED(end_col_offset); // Only used by EXTRA macro
-            res = _Py_UnaryOp ( USub , a , EXTRA );
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            else {
+                Token *token = get_last_nonnwhitespace_token(p);
+                if (token == NULL) {
+                    return NULL;
+                }
+                int end_lineno = token->end_lineno;
+                UNUSED(end_lineno); // Only used by EXTRA macro
+                int end_col_offset = token->end_col_offset;
+                UNUSED(end_col_offset); // Only used by EXTRA macro
+                res = _Py_UnaryOp ( USub , a , EXTRA );
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -5938,17 +7133,22 @@ factor_rule(Parser *p)
             (a = factor_rule(p))
         )
         {
-            Token *token = get_last_nonnwhitespace_token(p);
-            if (token == NULL) {
-                return NULL;
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
             }
-            int end_lineno = token->end_lineno;
-            UNUSED(end_lineno); // Only used by EXTRA macro
-            int end_col_offset = token->end_col_offset;
-            UNUSED(end_col_offset); // Only used by EXTRA macro
-            res = _Py_UnaryOp ( Invert , a , EXTRA );
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            else {
+                Token *token = get_last_nonnwhitespace_token(p);
+                if (token == NULL) {
+                    return NULL;
+                }
+                int end_lineno = token->end_lineno;
+                UNUSED(end_lineno); // Only used by EXTRA macro
+                int end_col_offset = token->end_col_offset;
+                UNUSED(end_col_offset); // Only used by EXTRA macro
+                res = _Py_UnaryOp ( Invert , a , EXTRA );
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -5980,9 +7180,9 @@ power_rule(Parser *p)
     if (p->mark == p->fill && fill_token(p) < 0) {
         return NULL;
     }
-    int start_lineno = p->tokens[mark]->lineno;
+    int start_lineno = get_token(p, mark)->lineno;
     UNUSED(start_lineno); // Only used by EXTRA macro
-    int start_col_offset = p->tokens[mark]->col_offset;
+    int start_col_offset = get_token(p, mark)->col_offset;
     UNUSED(start_col_offset); // Only used by EXTRA macro
     { // await_primary '**' factor
         expr_ty a;
@@ -5996,17 +7196,22 @@ power_rule(Parser *p)
             (b = factor_rule(p))
         )
         {
-            Token *token = get_last_nonnwhitespace_token(p);
-            if (token == NULL) {
-                return NULL;
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
             }
-            int end_lineno = token->end_lineno;
-            UNUSED(end_lineno); // Only used by EXTRA macro
-            int end_col_offset = token->end_col_offset;
-            UNUSED(end_col_offset); // Only used by EXTRA macro
-            res = _Py_BinOp ( a , Pow , b , EXTRA );
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            else {
+                Token *token = get_last_nonnwhitespace_token(p);
+                if (token == NULL) {
+                    return NULL;
+                }
+                int end_lineno = token->end_lineno;
+                UNUSED(end_lineno); // Only used by EXTRA macro
+                int end_col_offset = token->end_col_offset;
+                UNUSED(end_col_offset); // Only used by EXTRA macro
+                res = _Py_BinOp ( a , Pow , b , EXTRA );
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -6033,15 +7238,13 @@ static expr_ty
 await_primary_rule(Parser *p)
 {
     expr_ty res = NULL;
-    if (is_memoized(p, await_primary_type, &res))
-        return res;
     int mark = p->mark;
     if (p->mark == p->fill && fill_token(p) < 0) {
         return NULL;
     }
-    int start_lineno = p->tokens[mark]->lineno;
+    int start_lineno = get_token(p, mark)->lineno;
     UNUSED(start_lineno); // Only used by EXTRA macro
-    int start_col_offset = p->tokens[mark]->col_offset;
+    int start_col_offset = get_token(p, mark)->col_offset;
     UNUSED(start_col_offset); // Only used by EXTRA macro
     { // AWAIT primary
         expr_ty a;
@@ -6052,17 +7255,22 @@ await_primary_rule(Parser *p)
             (a = primary_rule(p))
         )
         {
-            Token *token = get_last_nonnwhitespace_token(p);
-            if (token == NULL) {
-                return NULL;
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
             }
-            int end_lineno = token->end_lineno;
-            UNUSED(end_lineno); // Only used by EXTRA macro
-            int end_col_offset = token->end_col_offset;
-            UNUSED(end_col_offset); // Only used by EXTRA macro
-            res = _Py_Await ( a , EXTRA );
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            else {
+                Token *token = get_last_nonnwhitespace_token(p);
+                if (token == NULL) {
+                    return NULL;
+                }
+                int end_lineno = token->end_lineno;
+                UNUSED(end_lineno); // Only used by EXTRA macro
+                int end_col_offset = token->end_col_offset;
+                UNUSED(end_col_offset); // Only used by EXTRA macro
+                res = _Py_Await ( a , EXTRA );
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -6081,7 +7289,6 @@ await_primary_rule(Parser *p)
     }
     res = NULL;
   done:
-    insert_memo(p, mark, await_primary_type, res);
     return res;
 }
 
@@ -6124,9 +7331,9 @@ primary_raw(Parser *p)
     if (p->mark == p->fill && fill_token(p) < 0) {
         return NULL;
     }
-    int start_lineno = p->tokens[mark]->lineno;
+    int start_lineno = get_token(p, mark)->lineno;
     UNUSED(start_lineno); // Only used by EXTRA macro
-    int start_col_offset = p->tokens[mark]->col_offset;
+    int start_col_offset = get_token(p, mark)->col_offset;
     UNUSED(start_col_offset); // Only used by EXTRA macro
     { // primary '.' NAME
         expr_ty a;
@@ -6140,17 +7347,22 @@ primary_raw(Parser *p)
             (b = name_token(p))
         )
         {
-            Token *token = get_last_nonnwhitespace_token(p);
-            if (token == NULL) {
-                return NULL;
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
             }
-            int end_lineno = token->end_lineno;
-            UNUSED(end_lineno); // Only used by EXTRA macro
-            int end_col_offset = token->end_col_offset;
-            UNUSED(end_col_offset); // Only used by EXTRA macro
-            res = _Py_Attribute ( a , b -> v . Name . id , Load , EXTRA );
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            else {
+                Token *token = get_last_nonnwhitespace_token(p);
+                if (token == NULL) {
+                    return NULL;
+                }
+                int end_lineno = token->end_lineno;
+                UNUSED(end_lineno); // Only used by EXTRA macro
+                int end_col_offset = token->end_col_offset;
+                UNUSED(end_col_offset); // Only used by EXTRA macro
+                res = _Py_Attribute ( a , b -> v . Name . id , Load , EXTRA );
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -6165,17 +7377,22 @@ primary_raw(Parser *p)
             (b = genexp_rule(p))
         )
         {
-            Token *token = get_last_nonnwhitespace_token(p);
-            if (token == NULL) {
-                return NULL;
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
             }
-            int end_lineno = token->end_lineno;
-            UNUSED(end_lineno); // Only used by EXTRA macro
-            int end_col_offset = token->end_col_offset;
-            UNUSED(end_col_offset); // Only used by EXTRA macro
-            res = _Py_Call ( a , CHECK ( singleton_seq ( p , b ) ) , NULL , EXTRA );
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            else {
+                Token *token = get_last_nonnwhitespace_token(p);
+                if (token == NULL) {
+                    return NULL;
+                }
+                int end_lineno = token->end_lineno;
+                UNUSED(end_lineno); // Only used by EXTRA macro
+                int end_col_offset = token->end_col_offset;
+                UNUSED(end_col_offset); // Only used by EXTRA macro
+                res = _Py_Call ( a , CHECK ( singleton_seq ( p , b ) ) , NULL , EXTRA );
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -6196,17 +7413,22 @@ primary_raw(Parser *p)
             (literal_1 = expect_token(p, 8))
         )
         {
-            Token *token = get_last_nonnwhitespace_token(p);
-            if (token == NULL) {
-                return NULL;
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
             }
-            int end_lineno = token->end_lineno;
-            UNUSED(end_lineno); // Only used by EXTRA macro
-            int end_col_offset = token->end_col_offset;
-            UNUSED(end_col_offset); // Only used by EXTRA macro
-            res = _Py_Call ( a , ( b ) ? ( ( expr_ty ) b ) -> v . Call . args : NULL , ( b ) ? ( ( expr_ty ) b ) -> v . Call . keywords : NULL , EXTRA );
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            else {
+                Token *token = get_last_nonnwhitespace_token(p);
+                if (token == NULL) {
+                    return NULL;
+                }
+                int end_lineno = token->end_lineno;
+                UNUSED(end_lineno); // Only used by EXTRA macro
+                int end_col_offset = token->end_col_offset;
+                UNUSED(end_col_offset); // Only used by EXTRA macro
+                res = _Py_Call ( a , ( b ) ? ( ( expr_ty ) b ) -> v . Call . args : NULL , ( b ) ? ( ( expr_ty ) b ) -> v . Call . keywords : NULL , EXTRA );
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -6221,17 +7443,22 @@ primary_raw(Parser *p)
             (b = slicing_rule(p))
         )
         {
-            Token *token = get_last_nonnwhitespace_token(p);
-            if (token == NULL) {
-                return NULL;
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
             }
-            int end_lineno = token->end_lineno;
-            UNUSED(end_lineno); // Only used by EXTRA macro
-            int end_col_offset = token->end_col_offset;
-            UNUSED(end_col_offset); // Only used by EXTRA macro
-            res = _Py_Subscript ( a , b , Load , EXTRA );
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            else {
+                Token *token = get_last_nonnwhitespace_token(p);
+                if (token == NULL) {
+                    return NULL;
+                }
+                int end_lineno = token->end_lineno;
+                UNUSED(end_lineno); // Only used by EXTRA macro
+                int end_col_offset = token->end_col_offset;
+                UNUSED(end_col_offset); // Only used by EXTRA macro
+                res = _Py_Subscript ( a , b , Load , EXTRA );
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -6271,9 +7498,14 @@ slicing_rule(Parser *p)
             (literal_1 = expect_token(p, 10))
         )
         {
-            res = _Py_Index ( b , p -> arena );
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
+            }
+            else {
+                res = _Py_Index ( b , p -> arena );
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -6291,9 +7523,14 @@ slicing_rule(Parser *p)
             (literal_1 = expect_token(p, 10))
         )
         {
-            res = b;
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
+            }
+            else {
+                res = b;
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -6311,9 +7548,14 @@ slicing_rule(Parser *p)
             (literal_1 = expect_token(p, 10))
         )
         {
-            res = b;
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
+            }
+            else {
+                res = b;
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -6329,34 +7571,41 @@ static slice_ty
 slice_expressions_rule(Parser *p)
 {
     slice_ty res = NULL;
+    if (is_memoized(p, slice_expressions_type, &res))
+        return res;
     int mark = p->mark;
     if (p->mark == p->fill && fill_token(p) < 0) {
         return NULL;
     }
-    int start_lineno = p->tokens[mark]->lineno;
+    int start_lineno = get_token(p, mark)->lineno;
     UNUSED(start_lineno); // Only used by EXTRA macro
-    int start_col_offset = p->tokens[mark]->col_offset;
+    int start_col_offset = get_token(p, mark)->col_offset;
     UNUSED(start_col_offset); // Only used by EXTRA macro
     { // ','.expression+ ','?
         asdl_seq * a;
         void *opt_var;
         if (
-            (a = _gather_89_rule(p))
+            (a = _gather_78_rule(p))
             &&
             (opt_var = expect_token(p, 12), 1)
         )
         {
-            Token *token = get_last_nonnwhitespace_token(p);
-            if (token == NULL) {
-                return NULL;
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
             }
-            int end_lineno = token->end_lineno;
-            UNUSED(end_lineno); // Only used by EXTRA macro
-            int end_col_offset = token->end_col_offset;
-            UNUSED(end_col_offset); // Only used by EXTRA macro
-            res = _Py_Index ( _Py_Tuple ( a , Load , EXTRA ) , p -> arena );
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            else {
+                Token *token = get_last_nonnwhitespace_token(p);
+                if (token == NULL) {
+                    return NULL;
+                }
+                int end_lineno = token->end_lineno;
+                UNUSED(end_lineno); // Only used by EXTRA macro
+                int end_col_offset = token->end_col_offset;
+                UNUSED(end_col_offset); // Only used by EXTRA macro
+                res = _Py_Index ( _Py_Tuple ( a , Load , EXTRA ) , p -> arena );
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -6364,6 +7613,7 @@ slice_expressions_rule(Parser *p)
     }
     res = NULL;
   done:
+    insert_memo(p, mark, slice_expressions_type, res);
     return res;
 }
 
@@ -6381,9 +7631,14 @@ slices_rule(Parser *p)
             lookahead_with_int(0, expect_token, p, 12)
         )
         {
-            res = a;
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
+            }
+            else {
+                res = a;
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -6393,14 +7648,19 @@ slices_rule(Parser *p)
         asdl_seq * a;
         void *opt_var;
         if (
-            (a = _gather_91_rule(p))
+            (a = _gather_79_rule(p))
             &&
             (opt_var = expect_token(p, 12), 1)
         )
         {
-            res = _Py_ExtSlice ( a , p -> arena );
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
+            }
+            else {
+                res = _Py_ExtSlice ( a , p -> arena );
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -6429,12 +7689,17 @@ slice_rule(Parser *p)
             &&
             (b = expression_rule(p), 1)
             &&
-            (c = _tmp_93_rule(p), 1)
+            (c = _tmp_80_rule(p), 1)
         )
         {
-            res = _Py_Slice ( a , b , c , p -> arena );
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
+            }
+            else {
+                res = _Py_Slice ( a , b , c , p -> arena );
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -6446,9 +7711,14 @@ slice_rule(Parser *p)
             (a = expression_rule(p))
         )
         {
-            res = _Py_Index ( a , p -> arena );
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
+            }
+            else {
+                res = _Py_Index ( a , p -> arena );
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -6480,9 +7750,9 @@ atom_rule(Parser *p)
     if (p->mark == p->fill && fill_token(p) < 0) {
         return NULL;
     }
-    int start_lineno = p->tokens[mark]->lineno;
+    int start_lineno = get_token(p, mark)->lineno;
     UNUSED(start_lineno); // Only used by EXTRA macro
-    int start_col_offset = p->tokens[mark]->col_offset;
+    int start_col_offset = get_token(p, mark)->col_offset;
     UNUSED(start_col_offset); // Only used by EXTRA macro
     { // NAME
         expr_ty name_var;
@@ -6501,17 +7771,22 @@ atom_rule(Parser *p)
             (keyword = expect_token(p, 527))
         )
         {
-            Token *token = get_last_nonnwhitespace_token(p);
-            if (token == NULL) {
-                return NULL;
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
             }
-            int end_lineno = token->end_lineno;
-            UNUSED(end_lineno); // Only used by EXTRA macro
-            int end_col_offset = token->end_col_offset;
-            UNUSED(end_col_offset); // Only used by EXTRA macro
-            res = _Py_Constant ( Py_True , NULL , EXTRA );
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            else {
+                Token *token = get_last_nonnwhitespace_token(p);
+                if (token == NULL) {
+                    return NULL;
+                }
+                int end_lineno = token->end_lineno;
+                UNUSED(end_lineno); // Only used by EXTRA macro
+                int end_col_offset = token->end_col_offset;
+                UNUSED(end_col_offset); // Only used by EXTRA macro
+                res = _Py_Constant ( Py_True , NULL , EXTRA );
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -6523,17 +7798,22 @@ atom_rule(Parser *p)
             (keyword = expect_token(p, 528))
         )
         {
-            Token *token = get_last_nonnwhitespace_token(p);
-            if (token == NULL) {
-                return NULL;
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
             }
-            int end_lineno = token->end_lineno;
-            UNUSED(end_lineno); // Only used by EXTRA macro
-            int end_col_offset = token->end_col_offset;
-            UNUSED(end_col_offset); // Only used by EXTRA macro
-            res = _Py_Constant ( Py_False , NULL , EXTRA );
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            else {
+                Token *token = get_last_nonnwhitespace_token(p);
+                if (token == NULL) {
+                    return NULL;
+                }
+                int end_lineno = token->end_lineno;
+                UNUSED(end_lineno); // Only used by EXTRA macro
+                int end_col_offset = token->end_col_offset;
+                UNUSED(end_col_offset); // Only used by EXTRA macro
+                res = _Py_Constant ( Py_False , NULL , EXTRA );
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -6545,17 +7825,22 @@ atom_rule(Parser *p)
             (keyword = expect_token(p, 529))
         )
         {
-            Token *token = get_last_nonnwhitespace_token(p);
-            if (token == NULL) {
-                return NULL;
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
             }
-            int end_lineno = token->end_lineno;
-            UNUSED(end_lineno); // Only used by EXTRA macro
-            int end_col_offset = token->end_col_offset;
-            UNUSED(end_col_offset); // Only used by EXTRA macro
-            res = _Py_Constant ( Py_None , NULL , EXTRA );
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            else {
+                Token *token = get_last_nonnwhitespace_token(p);
+                if (token == NULL) {
+                    return NULL;
+                }
+                int end_lineno = token->end_lineno;
+                UNUSED(end_lineno); // Only used by EXTRA macro
+                int end_col_offset = token->end_col_offset;
+                UNUSED(end_col_offset); // Only used by EXTRA macro
+                res = _Py_Constant ( Py_None , NULL , EXTRA );
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -6566,7 +7851,7 @@ atom_rule(Parser *p)
         if (
             lookahead(1, string_token, p)
             &&
-            (a = _loop1_94_rule(p))
+            (a = _loop1_81_rule(p))
         )
         {
             res = concatenate_strings ( p , a );
@@ -6589,40 +7874,40 @@ atom_rule(Parser *p)
         p->mark = mark;
     }
     { // &'(' (tuple | group | genexp)
-        void *_tmp_95_var;
+        void *_tmp_82_var;
         if (
             lookahead_with_int(1, expect_token, p, 7)
             &&
-            (_tmp_95_var = _tmp_95_rule(p))
+            (_tmp_82_var = _tmp_82_rule(p))
         )
         {
-            res = _tmp_95_var;
+            res = _tmp_82_var;
             goto done;
         }
         p->mark = mark;
     }
     { // &'[' (list | listcomp)
-        void *_tmp_96_var;
+        void *_tmp_83_var;
         if (
             lookahead_with_int(1, expect_token, p, 9)
             &&
-            (_tmp_96_var = _tmp_96_rule(p))
+            (_tmp_83_var = _tmp_83_rule(p))
         )
         {
-            res = _tmp_96_var;
+            res = _tmp_83_var;
             goto done;
         }
         p->mark = mark;
     }
     { // &'{' (dict | set | dictcomp | setcomp)
-        void *_tmp_97_var;
+        void *_tmp_84_var;
         if (
             lookahead_with_int(1, expect_token, p, 25)
             &&
-            (_tmp_97_var = _tmp_97_rule(p))
+            (_tmp_84_var = _tmp_84_rule(p))
         )
         {
-            res = _tmp_97_var;
+            res = _tmp_84_var;
             goto done;
         }
         p->mark = mark;
@@ -6633,17 +7918,22 @@ atom_rule(Parser *p)
             (literal = expect_token(p, 52))
         )
         {
-            Token *token = get_last_nonnwhitespace_token(p);
-            if (token == NULL) {
-                return NULL;
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
             }
-            int end_lineno = token->end_lineno;
-            UNUSED(end_lineno); // Only used by EXTRA macro
-            int end_col_offset = token->end_col_offset;
-            UNUSED(end_col_offset); // Only used by EXTRA macro
-            res = _Py_Constant ( Py_Ellipsis , NULL , EXTRA );
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            else {
+                Token *token = get_last_nonnwhitespace_token(p);
+                if (token == NULL) {
+                    return NULL;
+                }
+                int end_lineno = token->end_lineno;
+                UNUSED(end_lineno); // Only used by EXTRA macro
+                int end_col_offset = token->end_col_offset;
+                UNUSED(end_col_offset); // Only used by EXTRA macro
+                res = _Py_Constant ( Py_Ellipsis , NULL , EXTRA );
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -6664,9 +7954,9 @@ list_rule(Parser *p)
     if (p->mark == p->fill && fill_token(p) < 0) {
         return NULL;
     }
-    int start_lineno = p->tokens[mark]->lineno;
+    int start_lineno = get_token(p, mark)->lineno;
     UNUSED(start_lineno); // Only used by EXTRA macro
-    int start_col_offset = p->tokens[mark]->col_offset;
+    int start_col_offset = get_token(p, mark)->col_offset;
     UNUSED(start_col_offset); // Only used by EXTRA macro
     { // '[' star_named_expressions? ']'
         void *a;
@@ -6680,17 +7970,22 @@ list_rule(Parser *p)
             (literal_1 = expect_token(p, 10))
         )
         {
-            Token *token = get_last_nonnwhitespace_token(p);
-            if (token == NULL) {
-                return NULL;
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
             }
-            int end_lineno = token->end_lineno;
-            UNUSED(end_lineno); // Only used by EXTRA macro
-            int end_col_offset = token->end_col_offset;
-            UNUSED(end_col_offset); // Only used by EXTRA macro
-            res = _Py_List ( a , Load , EXTRA );
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            else {
+                Token *token = get_last_nonnwhitespace_token(p);
+                if (token == NULL) {
+                    return NULL;
+                }
+                int end_lineno = token->end_lineno;
+                UNUSED(end_lineno); // Only used by EXTRA macro
+                int end_col_offset = token->end_col_offset;
+                UNUSED(end_col_offset); // Only used by EXTRA macro
+                res = _Py_List ( a , Load , EXTRA );
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -6710,9 +8005,9 @@ listcomp_rule(Parser *p)
     if (p->mark == p->fill && fill_token(p) < 0) {
         return NULL;
     }
-    int start_lineno = p->tokens[mark]->lineno;
+    int start_lineno = get_token(p, mark)->lineno;
     UNUSED(start_lineno); // Only used by EXTRA macro
-    int start_col_offset = p->tokens[mark]->col_offset;
+    int start_col_offset = get_token(p, mark)->col_offset;
     UNUSED(start_col_offset); // Only used by EXTRA macro
     { // '[' named_expression for_if_clauses ']'
         expr_ty a;
@@ -6729,17 +8024,22 @@ listcomp_rule(Parser *p)
             (literal_1 = expect_token(p, 10))
         )
         {
-            Token *token = get_last_nonnwhitespace_token(p);
-            if (token == NULL) {
-                return NULL;
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
             }
-            int end_lineno = token->end_lineno;
-            UNUSED(end_lineno); // Only used by EXTRA macro
-            int end_col_offset = token->end_col_offset;
-            UNUSED(end_col_offset); // Only used by EXTRA macro
-            res = _Py_ListComp ( a , b , EXTRA );
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            else {
+                Token *token = get_last_nonnwhitespace_token(p);
+                if (token == NULL) {
+                    return NULL;
+                }
+                int end_lineno = token->end_lineno;
+                UNUSED(end_lineno); // Only used by EXTRA macro
+                int end_col_offset = token->end_col_offset;
+                UNUSED(end_col_offset); // Only used by EXTRA macro
+                res = _Py_ListComp ( a , b , EXTRA );
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -6759,9 +8059,9 @@ tuple_rule(Parser *p)
     if (p->mark == p->fill && fill_token(p) < 0) {
         return NULL;
     }
-    int start_lineno = p->tokens[mark]->lineno;
+    int start_lineno = get_token(p, mark)->lineno;
     UNUSED(start_lineno); // Only used by EXTRA macro
-    int start_col_offset = p->tokens[mark]->col_offset;
+    int start_col_offset = get_token(p, mark)->col_offset;
     UNUSED(start_col_offset); // Only used by EXTRA macro
     { // '(' [star_named_expression ',' star_named_expressions?] ')'
         void *a;
@@ -6770,22 +8070,27 @@ tuple_rule(Parser *p)
         if (
             (literal = expect_token(p, 7))
             &&
-            (a = _tmp_98_rule(p), 1)
+            (a = _tmp_85_rule(p), 1)
             &&
             (literal_1 = expect_token(p, 8))
         )
         {
-            Token *token = get_last_nonnwhitespace_token(p);
-            if (token == NULL) {
-                return NULL;
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
             }
-            int end_lineno = token->end_lineno;
-            UNUSED(end_lineno); // Only used by EXTRA macro
-            int end_col_offset = token->end_col_offset;
-            UNUSED(end_col_offset); // Only used by EXTRA macro
-            res = _Py_Tuple ( a , Load , EXTRA );
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            else {
+                Token *token = get_last_nonnwhitespace_token(p);
+                if (token == NULL) {
+                    return NULL;
+                }
+                int end_lineno = token->end_lineno;
+                UNUSED(end_lineno); // Only used by EXTRA macro
+                int end_col_offset = token->end_col_offset;
+                UNUSED(end_col_offset); // Only used by EXTRA macro
+                res = _Py_Tuple ( a , Load , EXTRA );
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -6809,14 +8114,19 @@ group_rule(Parser *p)
         if (
             (literal = expect_token(p, 7))
             &&
-            (a = _tmp_99_rule(p))
+            (a = _tmp_86_rule(p))
             &&
             (literal_1 = expect_token(p, 8))
         )
         {
-            res = a;
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
+            }
+            else {
+                res = a;
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -6836,9 +8146,9 @@ genexp_rule(Parser *p)
     if (p->mark == p->fill && fill_token(p) < 0) {
         return NULL;
     }
-    int start_lineno = p->tokens[mark]->lineno;
+    int start_lineno = get_token(p, mark)->lineno;
     UNUSED(start_lineno); // Only used by EXTRA macro
-    int start_col_offset = p->tokens[mark]->col_offset;
+    int start_col_offset = get_token(p, mark)->col_offset;
     UNUSED(start_col_offset); // Only used by EXTRA macro
     { // '(' expression for_if_clauses ')'
         expr_ty a;
@@ -6855,17 +8165,22 @@ genexp_rule(Parser *p)
             (literal_1 = expect_token(p, 8))
         )
         {
-            Token *token = get_last_nonnwhitespace_token(p);
-            if (token == NULL) {
-                return NULL;
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
             }
-            int end_lineno = token->end_lineno;
-            UNUSED(end_lineno); // Only used by EXTRA macro
-            int end_col_offset = token->end_col_offset;
-            UNUSED(end_col_offset); // Only used by EXTRA macro
-            res = _Py_GeneratorExp ( a , b , EXTRA );
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            else {
+                Token *token = get_last_nonnwhitespace_token(p);
+                if (token == NULL) {
+                    return NULL;
+                }
+                int end_lineno = token->end_lineno;
+                UNUSED(end_lineno); // Only used by EXTRA macro
+                int end_col_offset = token->end_col_offset;
+                UNUSED(end_col_offset); // Only used by EXTRA macro
+                res = _Py_GeneratorExp ( a , b , EXTRA );
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -6885,9 +8200,9 @@ set_rule(Parser *p)
     if (p->mark == p->fill && fill_token(p) < 0) {
         return NULL;
     }
-    int start_lineno = p->tokens[mark]->lineno;
+    int start_lineno = get_token(p, mark)->lineno;
     UNUSED(start_lineno); // Only used by EXTRA macro
-    int start_col_offset = p->tokens[mark]->col_offset;
+    int start_col_offset = get_token(p, mark)->col_offset;
     UNUSED(start_col_offset); // Only used by EXTRA macro
     { // '{' expressions_list '}'
         asdl_seq* a;
@@ -6901,17 +8216,22 @@ set_rule(Parser *p)
             (literal_1 = expect_token(p, 26))
         )
         {
-            Token *token = get_last_nonnwhitespace_token(p);
-            if (token == NULL) {
-                return NULL;
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
             }
-            int end_lineno = token->end_lineno;
-            UNUSED(end_lineno); // Only used by EXTRA macro
-            int end_col_offset = token->end_col_offset;
-            UNUSED(end_col_offset); // Only used by EXTRA macro
-            res = _Py_Set ( a , EXTRA );
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            else {
+                Token *token = get_last_nonnwhitespace_token(p);
+                if (token == NULL) {
+                    return NULL;
+                }
+                int end_lineno = token->end_lineno;
+                UNUSED(end_lineno); // Only used by EXTRA macro
+                int end_col_offset = token->end_col_offset;
+                UNUSED(end_col_offset); // Only used by EXTRA macro
+                res = _Py_Set ( a , EXTRA );
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -6931,9 +8251,9 @@ setcomp_rule(Parser *p)
     if (p->mark == p->fill && fill_token(p) < 0) {
         return NULL;
     }
-    int start_lineno = p->tokens[mark]->lineno;
+    int start_lineno = get_token(p, mark)->lineno;
     UNUSED(start_lineno); // Only used by EXTRA macro
-    int start_col_offset = p->tokens[mark]->col_offset;
+    int start_col_offset = get_token(p, mark)->col_offset;
     UNUSED(start_col_offset); // Only used by EXTRA macro
     { // '{' expression for_if_clauses '}'
         expr_ty a;
@@ -6950,17 +8270,22 @@ setcomp_rule(Parser *p)
             (literal_1 = expect_token(p, 26))
         )
         {
-            Token *token = get_last_nonnwhitespace_token(p);
-            if (token == NULL) {
-                return NULL;
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
             }
-            int end_lineno = token->end_lineno;
-            UNUSED(end_lineno); // Only used by EXTRA macro
-            int end_col_offset = token->end_col_offset;
-            UNUSED(end_col_offset); // Only used by EXTRA macro
-            res = _Py_SetComp ( a , b , EXTRA );
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            else {
+                Token *token = get_last_nonnwhitespace_token(p);
+                if (token == NULL) {
+                    return NULL;
+                }
+                int end_lineno = token->end_lineno;
+                UNUSED(end_lineno); // Only used by EXTRA macro
+                int end_col_offset = token->end_col_offset;
+                UNUSED(end_col_offset); // Only used by EXTRA macro
+                res = _Py_SetComp ( a , b , EXTRA );
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -6980,9 +8305,9 @@ dict_rule(Parser *p)
     if (p->mark == p->fill && fill_token(p) < 0) {
         return NULL;
     }
-    int start_lineno = p->tokens[mark]->lineno;
+    int start_lineno = get_token(p, mark)->lineno;
     UNUSED(start_lineno); // Only used by EXTRA macro
-    int start_col_offset = p->tokens[mark]->col_offset;
+    int start_col_offset = get_token(p, mark)->col_offset;
     UNUSED(start_col_offset); // Only used by EXTRA macro
     { // '{' kvpairs? '}'
         void *a;
@@ -6996,17 +8321,22 @@ dict_rule(Parser *p)
             (literal_1 = expect_token(p, 26))
         )
         {
-            Token *token = get_last_nonnwhitespace_token(p);
-            if (token == NULL) {
-                return NULL;
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
             }
-            int end_lineno = token->end_lineno;
-            UNUSED(end_lineno); // Only used by EXTRA macro
-            int end_col_offset = token->end_col_offset;
-            UNUSED(end_col_offset); // Only used by EXTRA macro
-            res = _Py_Dict ( CHECK ( get_keys ( p , a ) ) , CHECK ( get_values ( p , a ) ) , EXTRA );
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            else {
+                Token *token = get_last_nonnwhitespace_token(p);
+                if (token == NULL) {
+                    return NULL;
+                }
+                int end_lineno = token->end_lineno;
+                UNUSED(end_lineno); // Only used by EXTRA macro
+                int end_col_offset = token->end_col_offset;
+                UNUSED(end_col_offset); // Only used by EXTRA macro
+                res = _Py_Dict ( CHECK ( get_keys ( p , a ) ) , CHECK ( get_values ( p , a ) ) , EXTRA );
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -7026,9 +8356,9 @@ dictcomp_rule(Parser *p)
     if (p->mark == p->fill && fill_token(p) < 0) {
         return NULL;
     }
-    int start_lineno = p->tokens[mark]->lineno;
+    int start_lineno = get_token(p, mark)->lineno;
     UNUSED(start_lineno); // Only used by EXTRA macro
-    int start_col_offset = p->tokens[mark]->col_offset;
+    int start_col_offset = get_token(p, mark)->col_offset;
     UNUSED(start_col_offset); // Only used by EXTRA macro
     { // '{' kvpair for_if_clauses '}'
         KeyValuePair* a;
@@ -7045,17 +8375,22 @@ dictcomp_rule(Parser *p)
             (literal_1 = expect_token(p, 26))
         )
         {
-            Token *token = get_last_nonnwhitespace_token(p);
-            if (token == NULL) {
-                return NULL;
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
             }
-            int end_lineno = token->end_lineno;
-            UNUSED(end_lineno); // Only used by EXTRA macro
-            int end_col_offset = token->end_col_offset;
-            UNUSED(end_col_offset); // Only used by EXTRA macro
-            res = _Py_DictComp ( a -> key , a -> value , b , EXTRA );
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            else {
+                Token *token = get_last_nonnwhitespace_token(p);
+                if (token == NULL) {
+                    return NULL;
+                }
+                int end_lineno = token->end_lineno;
+                UNUSED(end_lineno); // Only used by EXTRA macro
+                int end_col_offset = token->end_col_offset;
+                UNUSED(end_col_offset); // Only used by EXTRA macro
+                res = _Py_DictComp ( a -> key , a -> value , b , EXTRA );
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -7076,14 +8411,19 @@ kvpairs_rule(Parser *p)
         asdl_seq * a;
         void *opt_var;
         if (
-            (a = _gather_100_rule(p))
+            (a = _gather_87_rule(p))
             &&
             (opt_var = expect_token(p, 12), 1)
         )
         {
-            res = a;
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
+            }
+            else {
+                res = a;
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -7109,9 +8449,14 @@ kvpair_rule(Parser *p)
             (a = bitwise_or_rule(p))
         )
         {
-            res = key_value_pair ( p , NULL , a );
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
+            }
+            else {
+                res = key_value_pair ( p , NULL , a );
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -7129,9 +8474,14 @@ kvpair_rule(Parser *p)
             (b = expression_rule(p))
         )
         {
-            res = key_value_pair ( p , a , b );
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
+            }
+            else {
+                res = key_value_pair ( p , a , b );
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -7151,12 +8501,17 @@ for_if_clauses_rule(Parser *p)
     { // ((ASYNC? 'for' star_targets 'in' disjunction (('if' disjunction))*))+
         asdl_seq * a;
         if (
-            (a = _loop1_102_rule(p))
+            (a = _loop1_88_rule(p))
         )
         {
-            res = a;
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
+            }
+            else {
+                res = a;
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -7176,9 +8531,9 @@ yield_expr_rule(Parser *p)
     if (p->mark == p->fill && fill_token(p) < 0) {
         return NULL;
     }
-    int start_lineno = p->tokens[mark]->lineno;
+    int start_lineno = get_token(p, mark)->lineno;
     UNUSED(start_lineno); // Only used by EXTRA macro
-    int start_col_offset = p->tokens[mark]->col_offset;
+    int start_col_offset = get_token(p, mark)->col_offset;
     UNUSED(start_col_offset); // Only used by EXTRA macro
     { // 'yield' 'from' expression
         expr_ty a;
@@ -7192,17 +8547,22 @@ yield_expr_rule(Parser *p)
             (a = expression_rule(p))
         )
         {
-            Token *token = get_last_nonnwhitespace_token(p);
-            if (token == NULL) {
-                return NULL;
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
             }
-            int end_lineno = token->end_lineno;
-            UNUSED(end_lineno); // Only used by EXTRA macro
-            int end_col_offset = token->end_col_offset;
-            UNUSED(end_col_offset); // Only used by EXTRA macro
-            res = _Py_YieldFrom ( a , EXTRA );
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            else {
+                Token *token = get_last_nonnwhitespace_token(p);
+                if (token == NULL) {
+                    return NULL;
+                }
+                int end_lineno = token->end_lineno;
+                UNUSED(end_lineno); // Only used by EXTRA macro
+                int end_col_offset = token->end_col_offset;
+                UNUSED(end_col_offset); // Only used by EXTRA macro
+                res = _Py_YieldFrom ( a , EXTRA );
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -7217,17 +8577,22 @@ yield_expr_rule(Parser *p)
             (a = expressions_rule(p), 1)
         )
         {
-            Token *token = get_last_nonnwhitespace_token(p);
-            if (token == NULL) {
-                return NULL;
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
             }
-            int end_lineno = token->end_lineno;
-            UNUSED(end_lineno); // Only used by EXTRA macro
-            int end_col_offset = token->end_col_offset;
-            UNUSED(end_col_offset); // Only used by EXTRA macro
-            res = _Py_Yield ( a , EXTRA );
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            else {
+                Token *token = get_last_nonnwhitespace_token(p);
+                if (token == NULL) {
+                    return NULL;
+                }
+                int end_lineno = token->end_lineno;
+                UNUSED(end_lineno); // Only used by EXTRA macro
+                int end_col_offset = token->end_col_offset;
+                UNUSED(end_col_offset); // Only used by EXTRA macro
+                res = _Py_Yield ( a , EXTRA );
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -7255,9 +8620,14 @@ arguments_rule(Parser *p)
             (opt_var = expect_token(p, 12), 1)
         )
         {
-            res = a;
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
+            }
+            else {
+                res = a;
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -7278,9 +8648,9 @@ args_rule(Parser *p)
     if (p->mark == p->fill && fill_token(p) < 0) {
         return NULL;
     }
-    int start_lineno = p->tokens[mark]->lineno;
+    int start_lineno = get_token(p, mark)->lineno;
     UNUSED(start_lineno); // Only used by EXTRA macro
-    int start_col_offset = p->tokens[mark]->col_offset;
+    int start_col_offset = get_token(p, mark)->col_offset;
     UNUSED(start_col_offset); // Only used by EXTRA macro
     { // starred_expression [',' args]
         expr_ty a;
@@ -7288,20 +8658,25 @@ args_rule(Parser *p)
         if (
             (a = starred_expression_rule(p))
             &&
-            (b = _tmp_103_rule(p), 1)
+            (b = _tmp_89_rule(p), 1)
         )
         {
-            Token *token = get_last_nonnwhitespace_token(p);
-            if (token == NULL) {
-                return NULL;
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
             }
-            int end_lineno = token->end_lineno;
-            UNUSED(end_lineno); // Only used by EXTRA macro
-            int end_col_offset = token->end_col_offset;
-            UNUSED(end_col_offset); // Only used by EXTRA macro
-            res = _Py_Call ( CONSTRUCTOR ( p ) , ( b ) ? CHECK ( seq_insert_in_front ( p , a , ( ( expr_ty ) b ) -> v . Call . args ) ) : CHECK ( singleton_seq ( p , a ) ) , ( b ) ? ( ( expr_ty ) b ) -> v . Call . keywords : NULL , EXTRA );
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            else {
+                Token *token = get_last_nonnwhitespace_token(p);
+                if (token == NULL) {
+                    return NULL;
+                }
+                int end_lineno = token->end_lineno;
+                UNUSED(end_lineno); // Only used by EXTRA macro
+                int end_col_offset = token->end_col_offset;
+                UNUSED(end_col_offset); // Only used by EXTRA macro
+                res = _Py_Call ( CONSTRUCTOR ( p ) , ( b ) ? CHECK ( seq_insert_in_front ( p , a , ( ( expr_ty ) b ) -> v . Call . args ) ) : CHECK ( singleton_seq ( p , a ) ) , ( b ) ? ( ( expr_ty ) b ) -> v . Call . keywords : NULL , EXTRA );
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -7313,17 +8688,22 @@ args_rule(Parser *p)
             (a = kwargs_rule(p))
         )
         {
-            Token *token = get_last_nonnwhitespace_token(p);
-            if (token == NULL) {
-                return NULL;
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
             }
-            int end_lineno = token->end_lineno;
-            UNUSED(end_lineno); // Only used by EXTRA macro
-            int end_col_offset = token->end_col_offset;
-            UNUSED(end_col_offset); // Only used by EXTRA macro
-            res = _Py_Call ( CONSTRUCTOR ( p ) , CHECK_NULL_ALLOWED ( seq_extract_starred_exprs ( p , a ) ) , CHECK_NULL_ALLOWED ( seq_delete_starred_exprs ( p , a ) ) , EXTRA );
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            else {
+                Token *token = get_last_nonnwhitespace_token(p);
+                if (token == NULL) {
+                    return NULL;
+                }
+                int end_lineno = token->end_lineno;
+                UNUSED(end_lineno); // Only used by EXTRA macro
+                int end_col_offset = token->end_col_offset;
+                UNUSED(end_col_offset); // Only used by EXTRA macro
+                res = _Py_Call ( CONSTRUCTOR ( p ) , CHECK_NULL_ALLOWED ( seq_extract_starred_exprs ( p , a ) ) , CHECK_NULL_ALLOWED ( seq_delete_starred_exprs ( p , a ) ) , EXTRA );
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -7335,20 +8715,25 @@ args_rule(Parser *p)
         if (
             (a = named_expression_rule(p))
             &&
-            (b = _tmp_104_rule(p), 1)
+            (b = _tmp_90_rule(p), 1)
         )
         {
-            Token *token = get_last_nonnwhitespace_token(p);
-            if (token == NULL) {
-                return NULL;
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
             }
-            int end_lineno = token->end_lineno;
-            UNUSED(end_lineno); // Only used by EXTRA macro
-            int end_col_offset = token->end_col_offset;
-            UNUSED(end_col_offset); // Only used by EXTRA macro
-            res = _Py_Call ( CONSTRUCTOR ( p ) , ( b ) ? CHECK ( seq_insert_in_front ( p , a , ( ( expr_ty ) b ) -> v . Call . args ) ) : CHECK ( singleton_seq ( p , a ) ) , ( b ) ? ( ( expr_ty ) b ) -> v . Call . keywords : NULL , EXTRA );
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            else {
+                Token *token = get_last_nonnwhitespace_token(p);
+                if (token == NULL) {
+                    return NULL;
+                }
+                int end_lineno = token->end_lineno;
+                UNUSED(end_lineno); // Only used by EXTRA macro
+                int end_col_offset = token->end_col_offset;
+                UNUSED(end_col_offset); // Only used by EXTRA macro
+                res = _Py_Call ( CONSTRUCTOR ( p ) , ( b ) ? CHECK ( seq_insert_in_front ( p , a , ( ( expr_ty ) b ) -> v . Call . args ) ) : CHECK ( singleton_seq ( p , a ) ) , ( b ) ? ( ( expr_ty ) b ) -> v . Call . keywords : NULL , EXTRA );
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -7368,12 +8753,17 @@ kwargs_rule(Parser *p)
     { // ','.kwarg+
         asdl_seq * a;
         if (
-            (a = _gather_105_rule(p))
+            (a = _gather_91_rule(p))
         )
         {
-            res = a;
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
+            }
+            else {
+                res = a;
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -7393,9 +8783,9 @@ starred_expression_rule(Parser *p)
     if (p->mark == p->fill && fill_token(p) < 0) {
         return NULL;
     }
-    int start_lineno = p->tokens[mark]->lineno;
+    int start_lineno = get_token(p, mark)->lineno;
     UNUSED(start_lineno); // Only used by EXTRA macro
-    int start_col_offset = p->tokens[mark]->col_offset;
+    int start_col_offset = get_token(p, mark)->col_offset;
     UNUSED(start_col_offset); // Only used by EXTRA macro
     { // '*' expression
         expr_ty a;
@@ -7406,17 +8796,22 @@ starred_expression_rule(Parser *p)
             (a = expression_rule(p))
         )
         {
-            Token *token = get_last_nonnwhitespace_token(p);
-            if (token == NULL) {
-                return NULL;
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
             }
-            int end_lineno = token->end_lineno;
-            UNUSED(end_lineno); // Only used by EXTRA macro
-            int end_col_offset = token->end_col_offset;
-            UNUSED(end_col_offset); // Only used by EXTRA macro
-            res = _Py_Starred ( a , Load , EXTRA );
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            else {
+                Token *token = get_last_nonnwhitespace_token(p);
+                if (token == NULL) {
+                    return NULL;
+                }
+                int end_lineno = token->end_lineno;
+                UNUSED(end_lineno); // Only used by EXTRA macro
+                int end_col_offset = token->end_col_offset;
+                UNUSED(end_col_offset); // Only used by EXTRA macro
+                res = _Py_Starred ( a , Load , EXTRA );
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -7445,9 +8840,14 @@ kwarg_rule(Parser *p)
             (b = expression_rule(p))
         )
         {
-            res = keyword_or_starred ( p , CHECK ( _Py_keyword ( a -> v . Name . id , b , p -> arena ) ) , 1 );
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
+            }
+            else {
+                res = keyword_or_starred ( p , CHECK ( _Py_keyword ( a -> v . Name . id , b , p -> arena ) ) , 1 );
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -7459,9 +8859,14 @@ kwarg_rule(Parser *p)
             (a = starred_expression_rule(p))
         )
         {
-            res = keyword_or_starred ( p , a , 0 );
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
+            }
+            else {
+                res = keyword_or_starred ( p , a , 0 );
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -7476,9 +8881,14 @@ kwarg_rule(Parser *p)
             (a = expression_rule(p))
         )
         {
-            res = keyword_or_starred ( p , CHECK ( _Py_keyword ( NULL , a , p -> arena ) ) , 1 );
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
+            }
+            else {
+                res = keyword_or_starred ( p , CHECK ( _Py_keyword ( NULL , a , p -> arena ) ) , 1 );
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -7498,9 +8908,9 @@ star_targets_rule(Parser *p)
     if (p->mark == p->fill && fill_token(p) < 0) {
         return NULL;
     }
-    int start_lineno = p->tokens[mark]->lineno;
+    int start_lineno = get_token(p, mark)->lineno;
     UNUSED(start_lineno); // Only used by EXTRA macro
-    int start_col_offset = p->tokens[mark]->col_offset;
+    int start_col_offset = get_token(p, mark)->col_offset;
     UNUSED(start_col_offset); // Only used by EXTRA macro
     { // star_target !','
         expr_ty a;
@@ -7510,9 +8920,14 @@ star_targets_rule(Parser *p)
             lookahead_with_int(0, expect_token, p, 12)
         )
         {
-            res = a;
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
+            }
+            else {
+                res = a;
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -7525,22 +8940,27 @@ star_targets_rule(Parser *p)
         if (
             (a = star_target_rule(p))
             &&
-            (b = _loop0_107_rule(p))
+            (b = _loop0_92_rule(p))
             &&
             (opt_var = expect_token(p, 12), 1)
         )
         {
-            Token *token = get_last_nonnwhitespace_token(p);
-            if (token == NULL) {
-                return NULL;
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
             }
-            int end_lineno = token->end_lineno;
-            UNUSED(end_lineno); // Only used by EXTRA macro
-            int end_col_offset = token->end_col_offset;
-            UNUSED(end_col_offset); // Only used by EXTRA macro
-            res = _Py_Tuple ( CHECK ( seq_insert_in_front ( p , a , b ) ) , Store , EXTRA );
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            else {
+                Token *token = get_last_nonnwhitespace_token(p);
+                if (token == NULL) {
+                    return NULL;
+                }
+                int end_lineno = token->end_lineno;
+                UNUSED(end_lineno); // Only used by EXTRA macro
+                int end_col_offset = token->end_col_offset;
+                UNUSED(end_col_offset); // Only used by EXTRA macro
+                res = _Py_Tuple ( CHECK ( seq_insert_in_front ( p , a , b ) ) , Store , EXTRA );
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -7561,14 +8981,19 @@ star_targets_seq_rule(Parser *p)
         asdl_seq * a;
         void *opt_var;
         if (
-            (a = _gather_108_rule(p))
+            (a = _gather_93_rule(p))
             &&
             (opt_var = expect_token(p, 12), 1)
         )
         {
-            res = a;
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
+            }
+            else {
+                res = a;
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -7592,9 +9017,9 @@ star_target_rule(Parser *p)
     if (p->mark == p->fill && fill_token(p) < 0) {
         return NULL;
     }
-    int start_lineno = p->tokens[mark]->lineno;
+    int start_lineno = get_token(p, mark)->lineno;
     UNUSED(start_lineno); // Only used by EXTRA macro
-    int start_col_offset = p->tokens[mark]->col_offset;
+    int start_col_offset = get_token(p, mark)->col_offset;
     UNUSED(start_col_offset); // Only used by EXTRA macro
     { // '*' bitwise_or
         expr_ty a;
@@ -7605,17 +9030,22 @@ star_target_rule(Parser *p)
             (a = bitwise_or_rule(p))
         )
         {
-            Token *token = get_last_nonnwhitespace_token(p);
-            if (token == NULL) {
-                return NULL;
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
             }
-            int end_lineno = token->end_lineno;
-            UNUSED(end_lineno); // Only used by EXTRA macro
-            int end_col_offset = token->end_col_offset;
-            UNUSED(end_col_offset); // Only used by EXTRA macro
-            res = _Py_Starred ( CHECK ( set_expr_context ( p , a , Store ) ) , Store , EXTRA );
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            else {
+                Token *token = get_last_nonnwhitespace_token(p);
+                if (token == NULL) {
+                    return NULL;
+                }
+                int end_lineno = token->end_lineno;
+                UNUSED(end_lineno); // Only used by EXTRA macro
+                int end_col_offset = token->end_col_offset;
+                UNUSED(end_col_offset); // Only used by EXTRA macro
+                res = _Py_Starred ( CHECK ( set_expr_context ( p , a , Store ) ) , Store , EXTRA );
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -7635,17 +9065,22 @@ star_target_rule(Parser *p)
             lookahead(0, t_lookahead_rule, p)
         )
         {
-            Token *token = get_last_nonnwhitespace_token(p);
-            if (token == NULL) {
-                return NULL;
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
             }
-            int end_lineno = token->end_lineno;
-            UNUSED(end_lineno); // Only used by EXTRA macro
-            int end_col_offset = token->end_col_offset;
-            UNUSED(end_col_offset); // Only used by EXTRA macro
-            res = _Py_Attribute ( a , b -> v . Name . id , Store , EXTRA );
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            else {
+                Token *token = get_last_nonnwhitespace_token(p);
+                if (token == NULL) {
+                    return NULL;
+                }
+                int end_lineno = token->end_lineno;
+                UNUSED(end_lineno); // Only used by EXTRA macro
+                int end_col_offset = token->end_col_offset;
+                UNUSED(end_col_offset); // Only used by EXTRA macro
+                res = _Py_Attribute ( a , b -> v . Name . id , Store , EXTRA );
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -7662,17 +9097,22 @@ star_target_rule(Parser *p)
             lookahead(0, t_lookahead_rule, p)
         )
         {
-            Token *token = get_last_nonnwhitespace_token(p);
-            if (token == NULL) {
-                return NULL;
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
             }
-            int end_lineno = token->end_lineno;
-            UNUSED(end_lineno); // Only used by EXTRA macro
-            int end_col_offset = token->end_col_offset;
-            UNUSED(end_col_offset); // Only used by EXTRA macro
-            res = _Py_Subscript ( a , b , Store , EXTRA );
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            else {
+                Token *token = get_last_nonnwhitespace_token(p);
+                if (token == NULL) {
+                    return NULL;
+                }
+                int end_lineno = token->end_lineno;
+                UNUSED(end_lineno); // Only used by EXTRA macro
+                int end_col_offset = token->end_col_offset;
+                UNUSED(end_col_offset); // Only used by EXTRA macro
+                res = _Py_Subscript ( a , b , Store , EXTRA );
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -7707,9 +9147,9 @@ star_atom_rule(Parser *p)
     if (p->mark == p->fill && fill_token(p) < 0) {
         return NULL;
     }
-    int start_lineno = p->tokens[mark]->lineno;
+    int start_lineno = get_token(p, mark)->lineno;
     UNUSED(start_lineno); // Only used by EXTRA macro
-    int start_col_offset = p->tokens[mark]->col_offset;
+    int start_col_offset = get_token(p, mark)->col_offset;
     UNUSED(start_col_offset); // Only used by EXTRA macro
     { // NAME
         expr_ty a;
@@ -7717,9 +9157,14 @@ star_atom_rule(Parser *p)
             (a = name_token(p))
         )
         {
-            res = set_expr_context ( p , a , Store );
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
+            }
+            else {
+                res = set_expr_context ( p , a , Store );
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -7737,9 +9182,14 @@ star_atom_rule(Parser *p)
             (literal_1 = expect_token(p, 8))
         )
         {
-            res = set_expr_context ( p , a , Store );
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
+            }
+            else {
+                res = set_expr_context ( p , a , Store );
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -7757,17 +9207,22 @@ star_atom_rule(Parser *p)
             (literal_1 = expect_token(p, 8))
         )
         {
-            Token *token = get_last_nonnwhitespace_token(p);
-            if (token == NULL) {
-                return NULL;
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
             }
-            int end_lineno = token->end_lineno;
-            UNUSED(end_lineno); // Only used by EXTRA macro
-            int end_col_offset = token->end_col_offset;
-            UNUSED(end_col_offset); // Only used by EXTRA macro
-            res = _Py_Tuple ( a , Store , EXTRA );
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            else {
+                Token *token = get_last_nonnwhitespace_token(p);
+                if (token == NULL) {
+                    return NULL;
+                }
+                int end_lineno = token->end_lineno;
+                UNUSED(end_lineno); // Only used by EXTRA macro
+                int end_col_offset = token->end_col_offset;
+                UNUSED(end_col_offset); // Only used by EXTRA macro
+                res = _Py_Tuple ( a , Store , EXTRA );
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -7785,17 +9240,22 @@ star_atom_rule(Parser *p)
             (literal_1 = expect_token(p, 10))
         )
         {
-            Token *token = get_last_nonnwhitespace_token(p);
-            if (token == NULL) {
-                return NULL;
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
             }
-            int end_lineno = token->end_lineno;
-            UNUSED(end_lineno); // Only used by EXTRA macro
-            int end_col_offset = token->end_col_offset;
-            UNUSED(end_col_offset); // Only used by EXTRA macro
-            res = _Py_List ( a , Store , EXTRA );
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            else {
+                Token *token = get_last_nonnwhitespace_token(p);
+                if (token == NULL) {
+                    return NULL;
+                }
+                int end_lineno = token->end_lineno;
+                UNUSED(end_lineno); // Only used by EXTRA macro
+                int end_col_offset = token->end_col_offset;
+                UNUSED(end_col_offset); // Only used by EXTRA macro
+                res = _Py_List ( a , Store , EXTRA );
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -7832,9 +9292,14 @@ inside_paren_ann_assign_target_rule(Parser *p)
             (a = name_token(p))
         )
         {
-            res = set_expr_context ( p , a , Store );
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
+            }
+            else {
+                res = set_expr_context ( p , a , Store );
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -7852,9 +9317,14 @@ inside_paren_ann_assign_target_rule(Parser *p)
             (literal_1 = expect_token(p, 8))
         )
         {
-            res = a;
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
+            }
+            else {
+                res = a;
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -7876,9 +9346,9 @@ ann_assign_subscript_attribute_target_rule(Parser *p)
     if (p->mark == p->fill && fill_token(p) < 0) {
         return NULL;
     }
-    int start_lineno = p->tokens[mark]->lineno;
+    int start_lineno = get_token(p, mark)->lineno;
     UNUSED(start_lineno); // Only used by EXTRA macro
-    int start_col_offset = p->tokens[mark]->col_offset;
+    int start_col_offset = get_token(p, mark)->col_offset;
     UNUSED(start_col_offset); // Only used by EXTRA macro
     { // t_primary '.' NAME !t_lookahead
         expr_ty a;
@@ -7894,17 +9364,22 @@ ann_assign_subscript_attribute_target_rule(Parser *p)
             lookahead(0, t_lookahead_rule, p)
         )
         {
-            Token *token = get_last_nonnwhitespace_token(p);
-            if (token == NULL) {
-                return NULL;
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
             }
-            int end_lineno = token->end_lineno;
-            UNUSED(end_lineno); // Only used by EXTRA macro
-            int end_col_offset = token->end_col_offset;
-            UNUSED(end_col_offset); // Only used by EXTRA macro
-            res = _Py_Attribute ( a , b -> v . Name . id , Store , EXTRA );
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            else {
+                Token *token = get_last_nonnwhitespace_token(p);
+                if (token == NULL) {
+                    return NULL;
+                }
+                int end_lineno = token->end_lineno;
+                UNUSED(end_lineno); // Only used by EXTRA macro
+                int end_col_offset = token->end_col_offset;
+                UNUSED(end_col_offset); // Only used by EXTRA macro
+                res = _Py_Attribute ( a , b -> v . Name . id , Store , EXTRA );
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -7921,17 +9396,22 @@ ann_assign_subscript_attribute_target_rule(Parser *p)
             lookahead(0, t_lookahead_rule, p)
         )
         {
-            Token *token = get_last_nonnwhitespace_token(p);
-            if (token == NULL) {
-                return NULL;
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
             }
-            int end_lineno = token->end_lineno;
-            UNUSED(end_lineno); // Only used by EXTRA macro
-            int end_col_offset = token->end_col_offset;
-            UNUSED(end_col_offset); // Only used by EXTRA macro
-            res = _Py_Subscript ( a , b , Store , EXTRA );
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            else {
+                Token *token = get_last_nonnwhitespace_token(p);
+                if (token == NULL) {
+                    return NULL;
+                }
+                int end_lineno = token->end_lineno;
+                UNUSED(end_lineno); // Only used by EXTRA macro
+                int end_col_offset = token->end_col_offset;
+                UNUSED(end_col_offset); // Only used by EXTRA macro
+                res = _Py_Subscript ( a , b , Store , EXTRA );
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -7952,14 +9432,19 @@ del_targets_rule(Parser *p)
         asdl_seq * a;
         void *opt_var;
         if (
-            (a = _gather_110_rule(p))
+            (a = _gather_94_rule(p))
             &&
             (opt_var = expect_token(p, 12), 1)
         )
         {
-            res = a;
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
+            }
+            else {
+                res = a;
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -7982,9 +9467,9 @@ del_target_rule(Parser *p)
     if (p->mark == p->fill && fill_token(p) < 0) {
         return NULL;
     }
-    int start_lineno = p->tokens[mark]->lineno;
+    int start_lineno = get_token(p, mark)->lineno;
     UNUSED(start_lineno); // Only used by EXTRA macro
-    int start_col_offset = p->tokens[mark]->col_offset;
+    int start_col_offset = get_token(p, mark)->col_offset;
     UNUSED(start_col_offset); // Only used by EXTRA macro
     { // t_primary '.' NAME !t_lookahead
         expr_ty a;
@@ -8000,17 +9485,22 @@ del_target_rule(Parser *p)
             lookahead(0, t_lookahead_rule, p)
         )
         {
-            Token *token = get_last_nonnwhitespace_token(p);
-            if (token == NULL) {
-                return NULL;
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
             }
-            int end_lineno = token->end_lineno;
-            UNUSED(end_lineno); // Only used by EXTRA macro
-            int end_col_offset = token->end_col_offset;
-            UNUSED(end_col_offset); // Only used by EXTRA macro
-            res = _Py_Attribute ( a , b -> v . Name . id , Del , EXTRA );
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            else {
+                Token *token = get_last_nonnwhitespace_token(p);
+                if (token == NULL) {
+                    return NULL;
+                }
+                int end_lineno = token->end_lineno;
+                UNUSED(end_lineno); // Only used by EXTRA macro
+                int end_col_offset = token->end_col_offset;
+                UNUSED(end_col_offset); // Only used by EXTRA macro
+                res = _Py_Attribute ( a , b -> v . Name . id , Del , EXTRA );
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -8027,17 +9517,22 @@ del_target_rule(Parser *p)
             lookahead(0, t_lookahead_rule, p)
         )
         {
-            Token *token = get_last_nonnwhitespace_token(p);
-            if (token == NULL) {
-                return NULL;
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
             }
-            int end_lineno = token->end_lineno;
-            UNUSED(end_lineno); // Only used by EXTRA macro
-            int end_col_offset = token->end_col_offset;
-            UNUSED(end_col_offset); // Only used by EXTRA macro
-            res = _Py_Subscript ( a , b , Del , EXTRA );
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            else {
+                Token *token = get_last_nonnwhitespace_token(p);
+                if (token == NULL) {
+                    return NULL;
+                }
+                int end_lineno = token->end_lineno;
+                UNUSED(end_lineno); // Only used by EXTRA macro
+                int end_col_offset = token->end_col_offset;
+                UNUSED(end_col_offset); // Only used by EXTRA macro
+                res = _Py_Subscript ( a , b , Del , EXTRA );
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -8068,9 +9563,9 @@ del_t_atom_rule(Parser *p)
     if (p->mark == p->fill && fill_token(p) < 0) {
         return NULL;
     }
-    int start_lineno = p->tokens[mark]->lineno;
+    int start_lineno = get_token(p, mark)->lineno;
     UNUSED(start_lineno); // Only used by EXTRA macro
-    int start_col_offset = p->tokens[mark]->col_offset;
+    int start_col_offset = get_token(p, mark)->col_offset;
     UNUSED(start_col_offset); // Only used by EXTRA macro
     { // NAME
         expr_ty a;
@@ -8078,9 +9573,14 @@ del_t_atom_rule(Parser *p)
             (a = name_token(p))
         )
         {
-            res = set_expr_context ( p , a , Del );
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
+            }
+            else {
+                res = set_expr_context ( p , a , Del );
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -8098,9 +9598,14 @@ del_t_atom_rule(Parser *p)
             (literal_1 = expect_token(p, 8))
         )
         {
-            res = set_expr_context ( p , a , Del );
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
+            }
+            else {
+                res = set_expr_context ( p , a , Del );
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -8118,17 +9623,22 @@ del_t_atom_rule(Parser *p)
             (literal_1 = expect_token(p, 8))
         )
         {
-            Token *token = get_last_nonnwhitespace_token(p);
-            if (token == NULL) {
-                return NULL;
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
             }
-            int end_lineno = token->end_lineno;
-            UNUSED(end_lineno); // Only used by EXTRA macro
-            int end_col_offset = token->end_col_offset;
-            UNUSED(end_col_offset); // Only used by EXTRA macro
-            res = _Py_Tuple ( a , Del , EXTRA );
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            else {
+                Token *token = get_last_nonnwhitespace_token(p);
+                if (token == NULL) {
+                    return NULL;
+                }
+                int end_lineno = token->end_lineno;
+                UNUSED(end_lineno); // Only used by EXTRA macro
+                int end_col_offset = token->end_col_offset;
+                UNUSED(end_col_offset); // Only used by EXTRA macro
+                res = _Py_Tuple ( a , Del , EXTRA );
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -8146,17 +9656,22 @@ del_t_atom_rule(Parser *p)
             (literal_1 = expect_token(p, 10))
         )
         {
-            Token *token = get_last_nonnwhitespace_token(p);
-            if (token == NULL) {
-                return NULL;
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
             }
-            int end_lineno = token->end_lineno;
-            UNUSED(end_lineno); // Only used by EXTRA macro
-            int end_col_offset = token->end_col_offset;
-            UNUSED(end_col_offset); // Only used by EXTRA macro
-            res = _Py_List ( a , Del , EXTRA );
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            else {
+                Token *token = get_last_nonnwhitespace_token(p);
+                if (token == NULL) {
+                    return NULL;
+                }
+                int end_lineno = token->end_lineno;
+                UNUSED(end_lineno); // Only used by EXTRA macro
+                int end_col_offset = token->end_col_offset;
+                UNUSED(end_col_offset); // Only used by EXTRA macro
+                res = _Py_List ( a , Del , EXTRA );
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -8177,14 +9692,19 @@ targets_rule(Parser *p)
         asdl_seq * a;
         void *opt_var;
         if (
-            (a = _gather_112_rule(p))
+            (a = _gather_95_rule(p))
             &&
             (opt_var = expect_token(p, 12), 1)
         )
         {
-            res = a;
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
+            }
+            else {
+                res = a;
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -8204,9 +9724,9 @@ target_rule(Parser *p)
     if (p->mark == p->fill && fill_token(p) < 0) {
         return NULL;
     }
-    int start_lineno = p->tokens[mark]->lineno;
+    int start_lineno = get_token(p, mark)->lineno;
     UNUSED(start_lineno); // Only used by EXTRA macro
-    int start_col_offset = p->tokens[mark]->col_offset;
+    int start_col_offset = get_token(p, mark)->col_offset;
     UNUSED(start_col_offset); // Only used by EXTRA macro
     { // t_primary '.' NAME !t_lookahead
         expr_ty a;
@@ -8222,17 +9742,22 @@ target_rule(Parser *p)
             lookahead(0, t_lookahead_rule, p)
         )
         {
-            Token *token = get_last_nonnwhitespace_token(p);
-            if (token == NULL) {
-                return NULL;
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
             }
-            int end_lineno = token->end_lineno;
-            UNUSED(end_lineno); // Only used by EXTRA macro
-            int end_col_offset = token->end_col_offset;
-            UNUSED(end_col_offset); // Only used by EXTRA macro
-            res = _Py_Attribute ( a , b -> v . Name . id , Store , EXTRA );
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            else {
+                Token *token = get_last_nonnwhitespace_token(p);
+                if (token == NULL) {
+                    return NULL;
+                }
+                int end_lineno = token->end_lineno;
+                UNUSED(end_lineno); // Only used by EXTRA macro
+                int end_col_offset = token->end_col_offset;
+                UNUSED(end_col_offset); // Only used by EXTRA macro
+                res = _Py_Attribute ( a , b -> v . Name . id , Store , EXTRA );
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -8249,17 +9774,22 @@ target_rule(Parser *p)
             lookahead(0, t_lookahead_rule, p)
         )
         {
-            Token *token = get_last_nonnwhitespace_token(p);
-            if (token == NULL) {
-                return NULL;
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
             }
-            int end_lineno = token->end_lineno;
-            UNUSED(end_lineno); // Only used by EXTRA macro
-            int end_col_offset = token->end_col_offset;
-            UNUSED(end_col_offset); // Only used by EXTRA macro
-            res = _Py_Subscript ( a , b , Store , EXTRA );
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            else {
+                Token *token = get_last_nonnwhitespace_token(p);
+                if (token == NULL) {
+                    return NULL;
+                }
+                int end_lineno = token->end_lineno;
+                UNUSED(end_lineno); // Only used by EXTRA macro
+                int end_col_offset = token->end_col_offset;
+                UNUSED(end_col_offset); // Only used by EXTRA macro
+                res = _Py_Subscript ( a , b , Store , EXTRA );
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -8320,9 +9850,9 @@ t_primary_raw(Parser *p)
     if (p->mark == p->fill && fill_token(p) < 0) {
         return NULL;
     }
-    int start_lineno = p->tokens[mark]->lineno;
+    int start_lineno = get_token(p, mark)->lineno;
     UNUSED(start_lineno); // Only used by EXTRA macro
-    int start_col_offset = p->tokens[mark]->col_offset;
+    int start_col_offset = get_token(p, mark)->col_offset;
     UNUSED(start_col_offset); // Only used by EXTRA macro
     { // t_primary '.' NAME &t_lookahead
         expr_ty a;
@@ -8338,17 +9868,22 @@ t_primary_raw(Parser *p)
             lookahead(1, t_lookahead_rule, p)
         )
         {
-            Token *token = get_last_nonnwhitespace_token(p);
-            if (token == NULL) {
-                return NULL;
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
             }
-            int end_lineno = token->end_lineno;
-            UNUSED(end_lineno); // Only used by EXTRA macro
-            int end_col_offset = token->end_col_offset;
-            UNUSED(end_col_offset); // Only used by EXTRA macro
-            res = _Py_Attribute ( a , b -> v . Name . id , Load , EXTRA );
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            else {
+                Token *token = get_last_nonnwhitespace_token(p);
+                if (token == NULL) {
+                    return NULL;
+                }
+                int end_lineno = token->end_lineno;
+                UNUSED(end_lineno); // Only used by EXTRA macro
+                int end_col_offset = token->end_col_offset;
+                UNUSED(end_col_offset); // Only used by EXTRA macro
+                res = _Py_Attribute ( a , b -> v . Name . id , Load , EXTRA );
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -8365,19 +9900,24 @@ t_primary_raw(Parser *p)
             lookahead(1, t_lookahead_rule, p)
         )
         {
-            Token *token = get_last_nonnwhitespace_token(p);
-            if (token == NULL) {
-                return NULL;
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
             }
-            int end_lineno = token->end_lineno;
-            UNUSED(end_lineno); // Only used by EXTRA macro
-            int end_col_offset = token->end_col_offset;
-            UNUSED(end_col_offset); // Only used by EXTRA macro
-            res = _Py_Subscript ( a , b , Load , EXTRA );
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
-            }
-            goto done;
+            else {
+                Token *token = get_last_nonnwhitespace_token(p);
+                if (token == NULL) {
+                    return NULL;
+                }
+                int end_lineno = token->end_lineno;
+                UNUSED(end_lineno); // Only used by EXTRA macro
+                int end_col_offset = token->end_col_offset;
+                UNUSED(end_col_offset); // Only used by EXTRA macro
+                res = _Py_Subscript ( a , b , Load , EXTRA );
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
+            }
+            goto done;
         }
         p->mark = mark;
     }
@@ -8392,17 +9932,22 @@ t_primary_raw(Parser *p)
             lookahead(1, t_lookahead_rule, p)
         )
         {
-            Token *token = get_last_nonnwhitespace_token(p);
-            if (token == NULL) {
-                return NULL;
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
             }
-            int end_lineno = token->end_lineno;
-            UNUSED(end_lineno); // Only used by EXTRA macro
-            int end_col_offset = token->end_col_offset;
-            UNUSED(end_col_offset); // Only used by EXTRA macro
-            res = _Py_Call ( a , CHECK ( singleton_seq ( p , b ) ) , NULL , EXTRA );
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            else {
+                Token *token = get_last_nonnwhitespace_token(p);
+                if (token == NULL) {
+                    return NULL;
+                }
+                int end_lineno = token->end_lineno;
+                UNUSED(end_lineno); // Only used by EXTRA macro
+                int end_col_offset = token->end_col_offset;
+                UNUSED(end_col_offset); // Only used by EXTRA macro
+                res = _Py_Call ( a , CHECK ( singleton_seq ( p , b ) ) , NULL , EXTRA );
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -8425,17 +9970,22 @@ t_primary_raw(Parser *p)
             lookahead(1, t_lookahead_rule, p)
         )
         {
-            Token *token = get_last_nonnwhitespace_token(p);
-            if (token == NULL) {
-                return NULL;
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
             }
-            int end_lineno = token->end_lineno;
-            UNUSED(end_lineno); // Only used by EXTRA macro
-            int end_col_offset = token->end_col_offset;
-            UNUSED(end_col_offset); // Only used by EXTRA macro
-            res = _Py_Call ( a , ( b ) ? ( ( expr_ty ) b ) -> v . Call . args : NULL , ( b ) ? ( ( expr_ty ) b ) -> v . Call . keywords : NULL , EXTRA );
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            else {
+                Token *token = get_last_nonnwhitespace_token(p);
+                if (token == NULL) {
+                    return NULL;
+                }
+                int end_lineno = token->end_lineno;
+                UNUSED(end_lineno); // Only used by EXTRA macro
+                int end_col_offset = token->end_col_offset;
+                UNUSED(end_col_offset); // Only used by EXTRA macro
+                res = _Py_Call ( a , ( b ) ? ( ( expr_ty ) b ) -> v . Call . args : NULL , ( b ) ? ( ( expr_ty ) b ) -> v . Call . keywords : NULL , EXTRA );
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -8449,9 +9999,14 @@ t_primary_raw(Parser *p)
             lookahead(1, t_lookahead_rule, p)
         )
         {
-            res = a;
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
+            }
+            else {
+                res = a;
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -8515,9 +10070,9 @@ t_atom_rule(Parser *p)
     if (p->mark == p->fill && fill_token(p) < 0) {
         return NULL;
     }
-    int start_lineno = p->tokens[mark]->lineno;
+    int start_lineno = get_token(p, mark)->lineno;
     UNUSED(start_lineno); // Only used by EXTRA macro
-    int start_col_offset = p->tokens[mark]->col_offset;
+    int start_col_offset = get_token(p, mark)->col_offset;
     UNUSED(start_col_offset); // Only used by EXTRA macro
     { // NAME
         expr_ty a;
@@ -8525,9 +10080,14 @@ t_atom_rule(Parser *p)
             (a = name_token(p))
         )
         {
-            res = set_expr_context ( p , a , Store );
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
+            }
+            else {
+                res = set_expr_context ( p , a , Store );
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -8545,9 +10105,14 @@ t_atom_rule(Parser *p)
             (literal_1 = expect_token(p, 8))
         )
         {
-            res = set_expr_context ( p , a , Store );
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
+            }
+            else {
+                res = set_expr_context ( p , a , Store );
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -8565,17 +10130,22 @@ t_atom_rule(Parser *p)
             (literal_1 = expect_token(p, 8))
         )
         {
-            Token *token = get_last_nonnwhitespace_token(p);
-            if (token == NULL) {
-                return NULL;
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
             }
-            int end_lineno = token->end_lineno;
-            UNUSED(end_lineno); // Only used by EXTRA macro
-            int end_col_offset = token->end_col_offset;
-            UNUSED(end_col_offset); // Only used by EXTRA macro
-            res = _Py_Tuple ( b , Store , EXTRA );
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            else {
+                Token *token = get_last_nonnwhitespace_token(p);
+                if (token == NULL) {
+                    return NULL;
+                }
+                int end_lineno = token->end_lineno;
+                UNUSED(end_lineno); // Only used by EXTRA macro
+                int end_col_offset = token->end_col_offset;
+                UNUSED(end_col_offset); // Only used by EXTRA macro
+                res = _Py_Tuple ( b , Store , EXTRA );
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -8593,17 +10163,22 @@ t_atom_rule(Parser *p)
             (literal_1 = expect_token(p, 10))
         )
         {
-            Token *token = get_last_nonnwhitespace_token(p);
-            if (token == NULL) {
-                return NULL;
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
             }
-            int end_lineno = token->end_lineno;
-            UNUSED(end_lineno); // Only used by EXTRA macro
-            int end_col_offset = token->end_col_offset;
-            UNUSED(end_col_offset); // Only used by EXTRA macro
-            res = _Py_List ( b , Store , EXTRA );
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            else {
+                Token *token = get_last_nonnwhitespace_token(p);
+                if (token == NULL) {
+                    return NULL;
+                }
+                int end_lineno = token->end_lineno;
+                UNUSED(end_lineno); // Only used by EXTRA macro
+                int end_col_offset = token->end_col_offset;
+                UNUSED(end_col_offset); // Only used by EXTRA macro
+                res = _Py_List ( b , Store , EXTRA );
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -8614,9 +10189,55 @@ t_atom_rule(Parser *p)
     return res;
 }
 
-// _loop1_1: statement
+// _loop0_1: statement
+static asdl_seq *
+_loop0_1_rule(Parser *p)
+{
+    void *res = NULL;
+    int mark = p->mark;
+    void **children = PyMem_Malloc(sizeof(void *));
+    if (!children) {
+        PyErr_Format(PyExc_MemoryError, "Parser out of memory");
+        return NULL;
+    }
+    ssize_t children_capacity = 1;
+    ssize_t n = 0;
+    int choice_mark = enter_choice(p, mark);
+    { // statement
+        asdl_seq* statement_var;
+        while (
+            (statement_var = statement_rule(p))
+        )
+        {
+            res = statement_var;
+            if (n == children_capacity) {
+                children_capacity *= 2;
+                children = PyMem_Realloc(children, children_capacity*sizeof(void *));
+                if (!children) {
+                    PyErr_Format(PyExc_MemoryError, "realloc None");
+                    return NULL;
+                }
+            }
+            children[n++] = res;
+            mark = p->mark;
+            p->choice_mark = Py_MIN(choice_mark, mark);
+        }
+        p->mark = mark;
+    }
+    p->choice_mark = choice_mark;
+    asdl_seq *seq = _Py_asdl_seq_new(n, p->arena);
+    if (!seq) {
+        PyErr_Format(PyExc_MemoryError, "asdl_seq_new _loop0_1");
+        return NULL;
+    }
+    for (int i = 0; i < n; i++) asdl_seq_SET(seq, i, children[i]);
+    PyMem_Free(children);
+    return seq;
+}
+
+// _loop1_2: statement
 static asdl_seq *
-_loop1_1_rule(Parser *p)
+_loop1_2_rule(Parser *p)
 {
     void *res = NULL;
     int mark = p->mark;
@@ -8627,6 +10248,7 @@ _loop1_1_rule(Parser *p)
     }
     ssize_t children_capacity = 1;
     ssize_t n = 0;
+    int choice_mark = enter_choice(p, mark);
     { // statement
         asdl_seq* statement_var;
         while (
@@ -8644,25 +10266,26 @@ _loop1_1_rule(Parser *p)
             }
             children[n++] = res;
             mark = p->mark;
+            p->choice_mark = Py_MIN(choice_mark, mark);
         }
         p->mark = mark;
     }
+    p->choice_mark = choice_mark;
     if (n == 0) {
         PyMem_Free(children);
         return NULL;
     }
     asdl_seq *seq = _Py_asdl_seq_new(n, p->arena);
     if (!seq) {
-        PyErr_Format(PyExc_MemoryError, "asdl_seq_new _loop1_1");
+        PyErr_Format(PyExc_MemoryError, "asdl_seq_new _loop1_2");
         return NULL;
     }
     for (int i = 0; i < n; i++) asdl_seq_SET(seq, i, children[i]);
     PyMem_Free(children);
-    insert_memo(p, mark, _loop1_1_type, seq);
     return seq;
 }
 
-// _loop0_3: ';' small_stmt
+// _loop0_3: NEWLINE
 static asdl_seq *
 _loop0_3_rule(Parser *p)
 {
@@ -8675,19 +10298,13 @@ _loop0_3_rule(Parser *p)
     }
     ssize_t children_capacity = 1;
     ssize_t n = 0;
-    { // ';' small_stmt
-        stmt_ty elem;
-        void *literal;
+    { // NEWLINE
+        void *newline_var;
         while (
-            (literal = expect_token(p, 13))
-            &&
-            (elem = small_stmt_rule(p))
+            (newline_var = newline_token(p))
         )
         {
-            res = elem;
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
-            }
+            res = newline_var;
             if (n == children_capacity) {
                 children_capacity *= 2;
                 children = PyMem_Realloc(children, children_capacity*sizeof(void *));
@@ -8708,38 +10325,67 @@ _loop0_3_rule(Parser *p)
     }
     for (int i = 0; i < n; i++) asdl_seq_SET(seq, i, children[i]);
     PyMem_Free(children);
-    insert_memo(p, mark, _loop0_3_type, seq);
     return seq;
 }
 
-// _gather_2: small_stmt _loop0_3
+// _gather_4: ';'.small_stmt+
 static asdl_seq *
-_gather_2_rule(Parser *p)
+_gather_4_rule(Parser *p)
 {
-    asdl_seq * res = NULL;
     int mark = p->mark;
-    { // small_stmt _loop0_3
+    void **children = PyMem_Malloc(sizeof(void *));
+    if (!children) {
+        PyErr_Format(PyExc_MemoryError, "Parser out of memory");
+        return NULL;
+    }
+    ssize_t children_capacity = 1;
+    ssize_t n = 0;
+    { // ';'.small_stmt+
         stmt_ty elem;
-        asdl_seq * seq;
+        void *literal;
         if (
             (elem = small_stmt_rule(p))
-            &&
-            (seq = _loop0_3_rule(p))
         )
         {
-            res = seq_insert_in_front(p, elem, seq);
-            goto done;
+            children[n++] = elem;
+            mark = p->mark;
+            while (
+                (literal = expect_token(p, 13))
+                &&
+                (elem = small_stmt_rule(p))
+            )
+            {
+                if (n == children_capacity) {
+                    children_capacity *= 2;
+                    children = PyMem_Realloc(children, children_capacity*sizeof(void *));
+                    if (!children) {
+                        PyErr_Format(PyExc_MemoryError, "realloc _gather_4");
+                        return NULL;
+                    }
+                }
+                children[n++] = elem;
+                mark = p->mark;
+            }
         }
         p->mark = mark;
     }
-    res = NULL;
-  done:
-    return res;
+    if (n == 0) {
+        PyMem_Free(children);
+        return NULL;
+    }
+    asdl_seq *seq = _Py_asdl_seq_new(n, p->arena);
+    if (!seq) {
+        PyErr_Format(PyExc_MemoryError, "asdl_seq_new _gather_4");
+        return NULL;
+    }
+    for (int i = 0; i < n; i++) asdl_seq_SET(seq, i, children[i]);
+    PyMem_Free(children);
+    return seq;
 }
 
-// _tmp_4: 'import' | 'from'
+// _tmp_5: 'import' | 'from'
 static void *
-_tmp_4_rule(Parser *p)
+_tmp_5_rule(Parser *p)
 {
     void * res = NULL;
     int mark = p->mark;
@@ -8770,9 +10416,9 @@ _tmp_4_rule(Parser *p)
     return res;
 }
 
-// _tmp_5: 'def' | '@' | ASYNC
+// _tmp_6: 'def' | '@' | ASYNC
 static void *
-_tmp_5_rule(Parser *p)
+_tmp_6_rule(Parser *p)
 {
     void * res = NULL;
     int mark = p->mark;
@@ -8814,9 +10460,9 @@ _tmp_5_rule(Parser *p)
     return res;
 }
 
-// _tmp_6: 'class' | '@'
+// _tmp_7: 'class' | '@'
 static void *
-_tmp_6_rule(Parser *p)
+_tmp_7_rule(Parser *p)
 {
     void * res = NULL;
     int mark = p->mark;
@@ -8847,9 +10493,9 @@ _tmp_6_rule(Parser *p)
     return res;
 }
 
-// _tmp_7: 'with' | ASYNC
+// _tmp_8: 'with' | ASYNC
 static void *
-_tmp_7_rule(Parser *p)
+_tmp_8_rule(Parser *p)
 {
     void * res = NULL;
     int mark = p->mark;
@@ -8880,9 +10526,9 @@ _tmp_7_rule(Parser *p)
     return res;
 }
 
-// _tmp_8: 'for' | ASYNC
+// _tmp_9: 'for' | ASYNC
 static void *
-_tmp_8_rule(Parser *p)
+_tmp_9_rule(Parser *p)
 {
     void * res = NULL;
     int mark = p->mark;
@@ -8913,9 +10559,9 @@ _tmp_8_rule(Parser *p)
     return res;
 }
 
-// _tmp_9: '=' annotated_rhs
+// _tmp_10: '=' annotated_rhs
 static void *
-_tmp_9_rule(Parser *p)
+_tmp_10_rule(Parser *p)
 {
     void * res = NULL;
     int mark = p->mark;
@@ -8928,9 +10574,14 @@ _tmp_9_rule(Parser *p)
             (d = annotated_rhs_rule(p))
         )
         {
-            res = d;
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
+            }
+            else {
+                res = d;
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -8941,9 +10592,9 @@ _tmp_9_rule(Parser *p)
     return res;
 }
 
-// _tmp_10: '(' inside_paren_ann_assign_target ')' | ann_assign_subscript_attribute_target
+// _tmp_11: '(' inside_paren_ann_assign_target ')' | ann_assign_subscript_attribute_target
 static void *
-_tmp_10_rule(Parser *p)
+_tmp_11_rule(Parser *p)
 {
     void * res = NULL;
     int mark = p->mark;
@@ -8959,9 +10610,14 @@ _tmp_10_rule(Parser *p)
             (literal_1 = expect_token(p, 8))
         )
         {
-            res = b;
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
+            }
+            else {
+                res = b;
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -8983,9 +10639,9 @@ _tmp_10_rule(Parser *p)
     return res;
 }
 
-// _tmp_11: '=' annotated_rhs
+// _tmp_12: '=' annotated_rhs
 static void *
-_tmp_11_rule(Parser *p)
+_tmp_12_rule(Parser *p)
 {
     void * res = NULL;
     int mark = p->mark;
@@ -8998,9 +10654,14 @@ _tmp_11_rule(Parser *p)
             (d = annotated_rhs_rule(p))
         )
         {
-            res = d;
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
+            }
+            else {
+                res = d;
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -9011,9 +10672,9 @@ _tmp_11_rule(Parser *p)
     return res;
 }
 
-// _loop1_12: (star_targets '=')
+// _loop1_13: (star_targets '=')
 static asdl_seq *
-_loop1_12_rule(Parser *p)
+_loop1_13_rule(Parser *p)
 {
     void *res = NULL;
     int mark = p->mark;
@@ -9025,12 +10686,12 @@ _loop1_12_rule(Parser *p)
     ssize_t children_capacity = 1;
     ssize_t n = 0;
     { // (star_targets '=')
-        void *_tmp_114_var;
+        void *_tmp_96_var;
         while (
-            (_tmp_114_var = _tmp_114_rule(p))
+            (_tmp_96_var = _tmp_96_rule(p))
         )
         {
-            res = _tmp_114_var;
+            res = _tmp_96_var;
             if (n == children_capacity) {
                 children_capacity *= 2;
                 children = PyMem_Realloc(children, children_capacity*sizeof(void *));
@@ -9050,18 +10711,17 @@ _loop1_12_rule(Parser *p)
     }
     asdl_seq *seq = _Py_asdl_seq_new(n, p->arena);
     if (!seq) {
-        PyErr_Format(PyExc_MemoryError, "asdl_seq_new _loop1_12");
+        PyErr_Format(PyExc_MemoryError, "asdl_seq_new _loop1_13");
         return NULL;
     }
     for (int i = 0; i < n; i++) asdl_seq_SET(seq, i, children[i]);
     PyMem_Free(children);
-    insert_memo(p, mark, _loop1_12_type, seq);
     return seq;
 }
 
-// _tmp_13: yield_expr | expressions
+// _tmp_14: yield_expr | expressions
 static void *
-_tmp_13_rule(Parser *p)
+_tmp_14_rule(Parser *p)
 {
     void * res = NULL;
     int mark = p->mark;
@@ -9092,9 +10752,9 @@ _tmp_13_rule(Parser *p)
     return res;
 }
 
-// _tmp_14: yield_expr | expressions
+// _tmp_15: yield_expr | expressions
 static void *
-_tmp_14_rule(Parser *p)
+_tmp_15_rule(Parser *p)
 {
     void * res = NULL;
     int mark = p->mark;
@@ -9125,11 +10785,10 @@ _tmp_14_rule(Parser *p)
     return res;
 }
 
-// _loop0_16: ',' NAME
+// _gather_16: ','.NAME+
 static asdl_seq *
-_loop0_16_rule(Parser *p)
+_gather_16_rule(Parser *p)
 {
-    void *res = NULL;
     int mark = p->mark;
     void **children = PyMem_Malloc(sizeof(void *));
     if (!children) {
@@ -9138,73 +10797,53 @@ _loop0_16_rule(Parser *p)
     }
     ssize_t children_capacity = 1;
     ssize_t n = 0;
-    { // ',' NAME
+    { // ','.NAME+
         expr_ty elem;
         void *literal;
-        while (
-            (literal = expect_token(p, 12))
-            &&
+        if (
             (elem = name_token(p))
         )
         {
-            res = elem;
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
-            }
-            if (n == children_capacity) {
-                children_capacity *= 2;
-                children = PyMem_Realloc(children, children_capacity*sizeof(void *));
-                if (!children) {
-                    PyErr_Format(PyExc_MemoryError, "realloc None");
-                    return NULL;
+            children[n++] = elem;
+            mark = p->mark;
+            while (
+                (literal = expect_token(p, 12))
+                &&
+                (elem = name_token(p))
+            )
+            {
+                if (n == children_capacity) {
+                    children_capacity *= 2;
+                    children = PyMem_Realloc(children, children_capacity*sizeof(void *));
+                    if (!children) {
+                        PyErr_Format(PyExc_MemoryError, "realloc _gather_16");
+                        return NULL;
+                    }
                 }
+                children[n++] = elem;
+                mark = p->mark;
             }
-            children[n++] = res;
-            mark = p->mark;
         }
         p->mark = mark;
     }
+    if (n == 0) {
+        PyMem_Free(children);
+        return NULL;
+    }
     asdl_seq *seq = _Py_asdl_seq_new(n, p->arena);
     if (!seq) {
-        PyErr_Format(PyExc_MemoryError, "asdl_seq_new _loop0_16");
+        PyErr_Format(PyExc_MemoryError, "asdl_seq_new _gather_16");
         return NULL;
     }
     for (int i = 0; i < n; i++) asdl_seq_SET(seq, i, children[i]);
     PyMem_Free(children);
-    insert_memo(p, mark, _loop0_16_type, seq);
     return seq;
 }
 
-// _gather_15: NAME _loop0_16
-static asdl_seq *
-_gather_15_rule(Parser *p)
-{
-    asdl_seq * res = NULL;
-    int mark = p->mark;
-    { // NAME _loop0_16
-        expr_ty elem;
-        asdl_seq * seq;
-        if (
-            (elem = name_token(p))
-            &&
-            (seq = _loop0_16_rule(p))
-        )
-        {
-            res = seq_insert_in_front(p, elem, seq);
-            goto done;
-        }
-        p->mark = mark;
-    }
-    res = NULL;
-  done:
-    return res;
-}
-
-// _loop0_18: ',' NAME
+// _gather_17: ','.NAME+
 static asdl_seq *
-_loop0_18_rule(Parser *p)
+_gather_17_rule(Parser *p)
 {
-    void *res = NULL;
     int mark = p->mark;
     void **children = PyMem_Malloc(sizeof(void *));
     if (!children) {
@@ -9213,71 +10852,52 @@ _loop0_18_rule(Parser *p)
     }
     ssize_t children_capacity = 1;
     ssize_t n = 0;
-    { // ',' NAME
+    { // ','.NAME+
         expr_ty elem;
         void *literal;
-        while (
-            (literal = expect_token(p, 12))
-            &&
+        if (
             (elem = name_token(p))
         )
         {
-            res = elem;
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
-            }
-            if (n == children_capacity) {
-                children_capacity *= 2;
-                children = PyMem_Realloc(children, children_capacity*sizeof(void *));
-                if (!children) {
-                    PyErr_Format(PyExc_MemoryError, "realloc None");
-                    return NULL;
+            children[n++] = elem;
+            mark = p->mark;
+            while (
+                (literal = expect_token(p, 12))
+                &&
+                (elem = name_token(p))
+            )
+            {
+                if (n == children_capacity) {
+                    children_capacity *= 2;
+                    children = PyMem_Realloc(children, children_capacity*sizeof(void *));
+                    if (!children) {
+                        PyErr_Format(PyExc_MemoryError, "realloc _gather_17");
+                        return NULL;
+                    }
                 }
+                children[n++] = elem;
+                mark = p->mark;
             }
-            children[n++] = res;
-            mark = p->mark;
         }
         p->mark = mark;
     }
+    if (n == 0) {
+        PyMem_Free(children);
+        return NULL;
+    }
     asdl_seq *seq = _Py_asdl_seq_new(n, p->arena);
     if (!seq) {
-        PyErr_Format(PyExc_MemoryError, "asdl_seq_new _loop0_18");
+        PyErr_Format(PyExc_MemoryError, "asdl_seq_new _gather_17");
         return NULL;
     }
     for (int i = 0; i < n; i++) asdl_seq_SET(seq, i, children[i]);
     PyMem_Free(children);
-    insert_memo(p, mark, _loop0_18_type, seq);
     return seq;
 }
 
-// _gather_17: NAME _loop0_18
-static asdl_seq *
-_gather_17_rule(Parser *p)
-{
-    asdl_seq * res = NULL;
-    int mark = p->mark;
-    { // NAME _loop0_18
-        expr_ty elem;
-        asdl_seq * seq;
-        if (
-            (elem = name_token(p))
-            &&
-            (seq = _loop0_18_rule(p))
-        )
-        {
-            res = seq_insert_in_front(p, elem, seq);
-            goto done;
-        }
-        p->mark = mark;
-    }
-    res = NULL;
-  done:
-    return res;
-}
-
-// _tmp_19: ',' expression
+// _tmp_18: ',' expression
 static void *
-_tmp_19_rule(Parser *p)
+_tmp_18_rule(Parser *p)
 {
     void * res = NULL;
     int mark = p->mark;
@@ -9290,9 +10910,14 @@ _tmp_19_rule(Parser *p)
             (z = expression_rule(p))
         )
         {
-            res = z;
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
+            }
+            else {
+                res = z;
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -9303,9 +10928,9 @@ _tmp_19_rule(Parser *p)
     return res;
 }
 
-// _loop0_20: ('.' | '...')
+// _loop0_19: ('.' | '...')
 static asdl_seq *
-_loop0_20_rule(Parser *p)
+_loop0_19_rule(Parser *p)
 {
     void *res = NULL;
     int mark = p->mark;
@@ -9317,12 +10942,12 @@ _loop0_20_rule(Parser *p)
     ssize_t children_capacity = 1;
     ssize_t n = 0;
     { // ('.' | '...')
-        void *_tmp_115_var;
+        void *_tmp_97_var;
         while (
-            (_tmp_115_var = _tmp_115_rule(p))
+            (_tmp_97_var = _tmp_97_rule(p))
         )
         {
-            res = _tmp_115_var;
+            res = _tmp_97_var;
             if (n == children_capacity) {
                 children_capacity *= 2;
                 children = PyMem_Realloc(children, children_capacity*sizeof(void *));
@@ -9338,18 +10963,17 @@ _loop0_20_rule(Parser *p)
     }
     asdl_seq *seq = _Py_asdl_seq_new(n, p->arena);
     if (!seq) {
-        PyErr_Format(PyExc_MemoryError, "asdl_seq_new _loop0_20");
+        PyErr_Format(PyExc_MemoryError, "asdl_seq_new _loop0_19");
         return NULL;
     }
     for (int i = 0; i < n; i++) asdl_seq_SET(seq, i, children[i]);
     PyMem_Free(children);
-    insert_memo(p, mark, _loop0_20_type, seq);
     return seq;
 }
 
-// _loop1_21: ('.' | '...')
+// _loop1_20: ('.' | '...')
 static asdl_seq *
-_loop1_21_rule(Parser *p)
+_loop1_20_rule(Parser *p)
 {
     void *res = NULL;
     int mark = p->mark;
@@ -9361,12 +10985,12 @@ _loop1_21_rule(Parser *p)
     ssize_t children_capacity = 1;
     ssize_t n = 0;
     { // ('.' | '...')
-        void *_tmp_116_var;
+        void *_tmp_98_var;
         while (
-            (_tmp_116_var = _tmp_116_rule(p))
+            (_tmp_98_var = _tmp_98_rule(p))
         )
         {
-            res = _tmp_116_var;
+            res = _tmp_98_var;
             if (n == children_capacity) {
                 children_capacity *= 2;
                 children = PyMem_Realloc(children, children_capacity*sizeof(void *));
@@ -9386,20 +11010,18 @@ _loop1_21_rule(Parser *p)
     }
     asdl_seq *seq = _Py_asdl_seq_new(n, p->arena);
     if (!seq) {
-        PyErr_Format(PyExc_MemoryError, "asdl_seq_new _loop1_21");
+        PyErr_Format(PyExc_MemoryError, "asdl_seq_new _loop1_20");
         return NULL;
     }
     for (int i = 0; i < n; i++) asdl_seq_SET(seq, i, children[i]);
     PyMem_Free(children);
-    insert_memo(p, mark, _loop1_21_type, seq);
     return seq;
 }
 
-// _loop0_23: ',' import_from_as_name
+// _gather_21: ','.import_from_as_name+
 static asdl_seq *
-_loop0_23_rule(Parser *p)
+_gather_21_rule(Parser *p)
 {
-    void *res = NULL;
     int mark = p->mark;
     void **children = PyMem_Malloc(sizeof(void *));
     if (!children) {
@@ -9408,71 +11030,52 @@ _loop0_23_rule(Parser *p)
     }
     ssize_t children_capacity = 1;
     ssize_t n = 0;
-    { // ',' import_from_as_name
+    { // ','.import_from_as_name+
         alias_ty elem;
         void *literal;
-        while (
-            (literal = expect_token(p, 12))
-            &&
+        if (
             (elem = import_from_as_name_rule(p))
         )
         {
-            res = elem;
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
-            }
-            if (n == children_capacity) {
-                children_capacity *= 2;
-                children = PyMem_Realloc(children, children_capacity*sizeof(void *));
-                if (!children) {
-                    PyErr_Format(PyExc_MemoryError, "realloc None");
-                    return NULL;
+            children[n++] = elem;
+            mark = p->mark;
+            while (
+                (literal = expect_token(p, 12))
+                &&
+                (elem = import_from_as_name_rule(p))
+            )
+            {
+                if (n == children_capacity) {
+                    children_capacity *= 2;
+                    children = PyMem_Realloc(children, children_capacity*sizeof(void *));
+                    if (!children) {
+                        PyErr_Format(PyExc_MemoryError, "realloc _gather_21");
+                        return NULL;
+                    }
                 }
+                children[n++] = elem;
+                mark = p->mark;
             }
-            children[n++] = res;
-            mark = p->mark;
         }
         p->mark = mark;
     }
+    if (n == 0) {
+        PyMem_Free(children);
+        return NULL;
+    }
     asdl_seq *seq = _Py_asdl_seq_new(n, p->arena);
     if (!seq) {
-        PyErr_Format(PyExc_MemoryError, "asdl_seq_new _loop0_23");
+        PyErr_Format(PyExc_MemoryError, "asdl_seq_new _gather_21");
         return NULL;
     }
     for (int i = 0; i < n; i++) asdl_seq_SET(seq, i, children[i]);
     PyMem_Free(children);
-    insert_memo(p, mark, _loop0_23_type, seq);
     return seq;
 }
 
-// _gather_22: import_from_as_name _loop0_23
-static asdl_seq *
-_gather_22_rule(Parser *p)
-{
-    asdl_seq * res = NULL;
-    int mark = p->mark;
-    { // import_from_as_name _loop0_23
-        alias_ty elem;
-        asdl_seq * seq;
-        if (
-            (elem = import_from_as_name_rule(p))
-            &&
-            (seq = _loop0_23_rule(p))
-        )
-        {
-            res = seq_insert_in_front(p, elem, seq);
-            goto done;
-        }
-        p->mark = mark;
-    }
-    res = NULL;
-  done:
-    return res;
-}
-
-// _tmp_24: 'as' NAME
-static void *
-_tmp_24_rule(Parser *p)
+// _tmp_22: 'as' NAME
+static void *
+_tmp_22_rule(Parser *p)
 {
     void * res = NULL;
     int mark = p->mark;
@@ -9485,9 +11088,14 @@ _tmp_24_rule(Parser *p)
             (z = name_token(p))
         )
         {
-            res = z;
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
+            }
+            else {
+                res = z;
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -9498,11 +11106,10 @@ _tmp_24_rule(Parser *p)
     return res;
 }
 
-// _loop0_26: ',' dotted_as_name
+// _gather_23: ','.dotted_as_name+
 static asdl_seq *
-_loop0_26_rule(Parser *p)
+_gather_23_rule(Parser *p)
 {
-    void *res = NULL;
     int mark = p->mark;
     void **children = PyMem_Malloc(sizeof(void *));
     if (!children) {
@@ -9511,71 +11118,52 @@ _loop0_26_rule(Parser *p)
     }
     ssize_t children_capacity = 1;
     ssize_t n = 0;
-    { // ',' dotted_as_name
+    { // ','.dotted_as_name+
         alias_ty elem;
         void *literal;
-        while (
-            (literal = expect_token(p, 12))
-            &&
+        if (
             (elem = dotted_as_name_rule(p))
         )
         {
-            res = elem;
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
-            }
-            if (n == children_capacity) {
-                children_capacity *= 2;
-                children = PyMem_Realloc(children, children_capacity*sizeof(void *));
-                if (!children) {
-                    PyErr_Format(PyExc_MemoryError, "realloc None");
-                    return NULL;
+            children[n++] = elem;
+            mark = p->mark;
+            while (
+                (literal = expect_token(p, 12))
+                &&
+                (elem = dotted_as_name_rule(p))
+            )
+            {
+                if (n == children_capacity) {
+                    children_capacity *= 2;
+                    children = PyMem_Realloc(children, children_capacity*sizeof(void *));
+                    if (!children) {
+                        PyErr_Format(PyExc_MemoryError, "realloc _gather_23");
+                        return NULL;
+                    }
                 }
+                children[n++] = elem;
+                mark = p->mark;
             }
-            children[n++] = res;
-            mark = p->mark;
         }
         p->mark = mark;
     }
+    if (n == 0) {
+        PyMem_Free(children);
+        return NULL;
+    }
     asdl_seq *seq = _Py_asdl_seq_new(n, p->arena);
     if (!seq) {
-        PyErr_Format(PyExc_MemoryError, "asdl_seq_new _loop0_26");
+        PyErr_Format(PyExc_MemoryError, "asdl_seq_new _gather_23");
         return NULL;
     }
     for (int i = 0; i < n; i++) asdl_seq_SET(seq, i, children[i]);
     PyMem_Free(children);
-    insert_memo(p, mark, _loop0_26_type, seq);
     return seq;
 }
 
-// _gather_25: dotted_as_name _loop0_26
-static asdl_seq *
-_gather_25_rule(Parser *p)
-{
-    asdl_seq * res = NULL;
-    int mark = p->mark;
-    { // dotted_as_name _loop0_26
-        alias_ty elem;
-        asdl_seq * seq;
-        if (
-            (elem = dotted_as_name_rule(p))
-            &&
-            (seq = _loop0_26_rule(p))
-        )
-        {
-            res = seq_insert_in_front(p, elem, seq);
-            goto done;
-        }
-        p->mark = mark;
-    }
-    res = NULL;
-  done:
-    return res;
-}
-
-// _tmp_27: 'as' NAME
+// _tmp_24: 'as' NAME
 static void *
-_tmp_27_rule(Parser *p)
+_tmp_24_rule(Parser *p)
 {
     void * res = NULL;
     int mark = p->mark;
@@ -9588,9 +11176,14 @@ _tmp_27_rule(Parser *p)
             (z = name_token(p))
         )
         {
-            res = z;
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
+            }
+            else {
+                res = z;
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -9601,11 +11194,10 @@ _tmp_27_rule(Parser *p)
     return res;
 }
 
-// _loop0_29: ',' with_item
+// _gather_25: ','.with_item+
 static asdl_seq *
-_loop0_29_rule(Parser *p)
+_gather_25_rule(Parser *p)
 {
-    void *res = NULL;
     int mark = p->mark;
     void **children = PyMem_Malloc(sizeof(void *));
     if (!children) {
@@ -9614,73 +11206,53 @@ _loop0_29_rule(Parser *p)
     }
     ssize_t children_capacity = 1;
     ssize_t n = 0;
-    { // ',' with_item
+    { // ','.with_item+
         withitem_ty elem;
         void *literal;
-        while (
-            (literal = expect_token(p, 12))
-            &&
+        if (
             (elem = with_item_rule(p))
         )
         {
-            res = elem;
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
-            }
-            if (n == children_capacity) {
-                children_capacity *= 2;
-                children = PyMem_Realloc(children, children_capacity*sizeof(void *));
-                if (!children) {
-                    PyErr_Format(PyExc_MemoryError, "realloc None");
-                    return NULL;
+            children[n++] = elem;
+            mark = p->mark;
+            while (
+                (literal = expect_token(p, 12))
+                &&
+                (elem = with_item_rule(p))
+            )
+            {
+                if (n == children_capacity) {
+                    children_capacity *= 2;
+                    children = PyMem_Realloc(children, children_capacity*sizeof(void *));
+                    if (!children) {
+                        PyErr_Format(PyExc_MemoryError, "realloc _gather_25");
+                        return NULL;
+                    }
                 }
+                children[n++] = elem;
+                mark = p->mark;
             }
-            children[n++] = res;
-            mark = p->mark;
         }
         p->mark = mark;
     }
+    if (n == 0) {
+        PyMem_Free(children);
+        return NULL;
+    }
     asdl_seq *seq = _Py_asdl_seq_new(n, p->arena);
     if (!seq) {
-        PyErr_Format(PyExc_MemoryError, "asdl_seq_new _loop0_29");
+        PyErr_Format(PyExc_MemoryError, "asdl_seq_new _gather_25");
         return NULL;
     }
     for (int i = 0; i < n; i++) asdl_seq_SET(seq, i, children[i]);
     PyMem_Free(children);
-    insert_memo(p, mark, _loop0_29_type, seq);
     return seq;
 }
 
-// _gather_28: with_item _loop0_29
+// _gather_26: ','.with_item+
 static asdl_seq *
-_gather_28_rule(Parser *p)
+_gather_26_rule(Parser *p)
 {
-    asdl_seq * res = NULL;
-    int mark = p->mark;
-    { // with_item _loop0_29
-        withitem_ty elem;
-        asdl_seq * seq;
-        if (
-            (elem = with_item_rule(p))
-            &&
-            (seq = _loop0_29_rule(p))
-        )
-        {
-            res = seq_insert_in_front(p, elem, seq);
-            goto done;
-        }
-        p->mark = mark;
-    }
-    res = NULL;
-  done:
-    return res;
-}
-
-// _loop0_31: ',' with_item
-static asdl_seq *
-_loop0_31_rule(Parser *p)
-{
-    void *res = NULL;
     int mark = p->mark;
     void **children = PyMem_Malloc(sizeof(void *));
     if (!children) {
@@ -9689,73 +11261,53 @@ _loop0_31_rule(Parser *p)
     }
     ssize_t children_capacity = 1;
     ssize_t n = 0;
-    { // ',' with_item
+    { // ','.with_item+
         withitem_ty elem;
         void *literal;
-        while (
-            (literal = expect_token(p, 12))
-            &&
+        if (
             (elem = with_item_rule(p))
         )
         {
-            res = elem;
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
-            }
-            if (n == children_capacity) {
-                children_capacity *= 2;
-                children = PyMem_Realloc(children, children_capacity*sizeof(void *));
-                if (!children) {
-                    PyErr_Format(PyExc_MemoryError, "realloc None");
-                    return NULL;
+            children[n++] = elem;
+            mark = p->mark;
+            while (
+                (literal = expect_token(p, 12))
+                &&
+                (elem = with_item_rule(p))
+            )
+            {
+                if (n == children_capacity) {
+                    children_capacity *= 2;
+                    children = PyMem_Realloc(children, children_capacity*sizeof(void *));
+                    if (!children) {
+                        PyErr_Format(PyExc_MemoryError, "realloc _gather_26");
+                        return NULL;
+                    }
                 }
+                children[n++] = elem;
+                mark = p->mark;
             }
-            children[n++] = res;
-            mark = p->mark;
         }
         p->mark = mark;
     }
+    if (n == 0) {
+        PyMem_Free(children);
+        return NULL;
+    }
     asdl_seq *seq = _Py_asdl_seq_new(n, p->arena);
     if (!seq) {
-        PyErr_Format(PyExc_MemoryError, "asdl_seq_new _loop0_31");
+        PyErr_Format(PyExc_MemoryError, "asdl_seq_new _gather_26");
         return NULL;
     }
     for (int i = 0; i < n; i++) asdl_seq_SET(seq, i, children[i]);
     PyMem_Free(children);
-    insert_memo(p, mark, _loop0_31_type, seq);
     return seq;
 }
 
-// _gather_30: with_item _loop0_31
-static asdl_seq *
-_gather_30_rule(Parser *p)
-{
-    asdl_seq * res = NULL;
-    int mark = p->mark;
-    { // with_item _loop0_31
-        withitem_ty elem;
-        asdl_seq * seq;
-        if (
-            (elem = with_item_rule(p))
-            &&
-            (seq = _loop0_31_rule(p))
-        )
-        {
-            res = seq_insert_in_front(p, elem, seq);
-            goto done;
-        }
-        p->mark = mark;
-    }
-    res = NULL;
-  done:
-    return res;
-}
-
-// _loop0_33: ',' with_item
+// _gather_27: ','.with_item+
 static asdl_seq *
-_loop0_33_rule(Parser *p)
+_gather_27_rule(Parser *p)
 {
-    void *res = NULL;
     int mark = p->mark;
     void **children = PyMem_Malloc(sizeof(void *));
     if (!children) {
@@ -9764,73 +11316,53 @@ _loop0_33_rule(Parser *p)
     }
     ssize_t children_capacity = 1;
     ssize_t n = 0;
-    { // ',' with_item
+    { // ','.with_item+
         withitem_ty elem;
         void *literal;
-        while (
-            (literal = expect_token(p, 12))
-            &&
+        if (
             (elem = with_item_rule(p))
         )
         {
-            res = elem;
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
-            }
-            if (n == children_capacity) {
-                children_capacity *= 2;
-                children = PyMem_Realloc(children, children_capacity*sizeof(void *));
-                if (!children) {
-                    PyErr_Format(PyExc_MemoryError, "realloc None");
-                    return NULL;
+            children[n++] = elem;
+            mark = p->mark;
+            while (
+                (literal = expect_token(p, 12))
+                &&
+                (elem = with_item_rule(p))
+            )
+            {
+                if (n == children_capacity) {
+                    children_capacity *= 2;
+                    children = PyMem_Realloc(children, children_capacity*sizeof(void *));
+                    if (!children) {
+                        PyErr_Format(PyExc_MemoryError, "realloc _gather_27");
+                        return NULL;
+                    }
                 }
+                children[n++] = elem;
+                mark = p->mark;
             }
-            children[n++] = res;
-            mark = p->mark;
         }
         p->mark = mark;
     }
+    if (n == 0) {
+        PyMem_Free(children);
+        return NULL;
+    }
     asdl_seq *seq = _Py_asdl_seq_new(n, p->arena);
     if (!seq) {
-        PyErr_Format(PyExc_MemoryError, "asdl_seq_new _loop0_33");
+        PyErr_Format(PyExc_MemoryError, "asdl_seq_new _gather_27");
         return NULL;
     }
     for (int i = 0; i < n; i++) asdl_seq_SET(seq, i, children[i]);
     PyMem_Free(children);
-    insert_memo(p, mark, _loop0_33_type, seq);
     return seq;
 }
 
-// _gather_32: with_item _loop0_33
+// _gather_28: ','.with_item+
 static asdl_seq *
-_gather_32_rule(Parser *p)
-{
-    asdl_seq * res = NULL;
-    int mark = p->mark;
-    { // with_item _loop0_33
-        withitem_ty elem;
-        asdl_seq * seq;
-        if (
-            (elem = with_item_rule(p))
-            &&
-            (seq = _loop0_33_rule(p))
-        )
-        {
-            res = seq_insert_in_front(p, elem, seq);
-            goto done;
-        }
-        p->mark = mark;
-    }
-    res = NULL;
-  done:
-    return res;
-}
-
-// _loop0_35: ',' with_item
-static asdl_seq *
-_loop0_35_rule(Parser *p)
+_gather_28_rule(Parser *p)
 {
-    void *res = NULL;
     int mark = p->mark;
     void **children = PyMem_Malloc(sizeof(void *));
     if (!children) {
@@ -9839,71 +11371,52 @@ _loop0_35_rule(Parser *p)
     }
     ssize_t children_capacity = 1;
     ssize_t n = 0;
-    { // ',' with_item
+    { // ','.with_item+
         withitem_ty elem;
         void *literal;
-        while (
-            (literal = expect_token(p, 12))
-            &&
+        if (
             (elem = with_item_rule(p))
         )
         {
-            res = elem;
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
-            }
-            if (n == children_capacity) {
-                children_capacity *= 2;
-                children = PyMem_Realloc(children, children_capacity*sizeof(void *));
-                if (!children) {
-                    PyErr_Format(PyExc_MemoryError, "realloc None");
-                    return NULL;
+            children[n++] = elem;
+            mark = p->mark;
+            while (
+                (literal = expect_token(p, 12))
+                &&
+                (elem = with_item_rule(p))
+            )
+            {
+                if (n == children_capacity) {
+                    children_capacity *= 2;
+                    children = PyMem_Realloc(children, children_capacity*sizeof(void *));
+                    if (!children) {
+                        PyErr_Format(PyExc_MemoryError, "realloc _gather_28");
+                        return NULL;
+                    }
                 }
+                children[n++] = elem;
+                mark = p->mark;
             }
-            children[n++] = res;
-            mark = p->mark;
         }
         p->mark = mark;
     }
+    if (n == 0) {
+        PyMem_Free(children);
+        return NULL;
+    }
     asdl_seq *seq = _Py_asdl_seq_new(n, p->arena);
     if (!seq) {
-        PyErr_Format(PyExc_MemoryError, "asdl_seq_new _loop0_35");
+        PyErr_Format(PyExc_MemoryError, "asdl_seq_new _gather_28");
         return NULL;
     }
     for (int i = 0; i < n; i++) asdl_seq_SET(seq, i, children[i]);
     PyMem_Free(children);
-    insert_memo(p, mark, _loop0_35_type, seq);
     return seq;
 }
 
-// _gather_34: with_item _loop0_35
-static asdl_seq *
-_gather_34_rule(Parser *p)
-{
-    asdl_seq * res = NULL;
-    int mark = p->mark;
-    { // with_item _loop0_35
-        withitem_ty elem;
-        asdl_seq * seq;
-        if (
-            (elem = with_item_rule(p))
-            &&
-            (seq = _loop0_35_rule(p))
-        )
-        {
-            res = seq_insert_in_front(p, elem, seq);
-            goto done;
-        }
-        p->mark = mark;
-    }
-    res = NULL;
-  done:
-    return res;
-}
-
-// _tmp_36: 'as' target
+// _tmp_29: 'as' target
 static void *
-_tmp_36_rule(Parser *p)
+_tmp_29_rule(Parser *p)
 {
     void * res = NULL;
     int mark = p->mark;
@@ -9916,9 +11429,14 @@ _tmp_36_rule(Parser *p)
             (t = target_rule(p))
         )
         {
-            res = t;
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
+            }
+            else {
+                res = t;
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -9929,9 +11447,9 @@ _tmp_36_rule(Parser *p)
     return res;
 }
 
-// _loop1_37: except_block
+// _loop1_30: except_block
 static asdl_seq *
-_loop1_37_rule(Parser *p)
+_loop1_30_rule(Parser *p)
 {
     void *res = NULL;
     int mark = p->mark;
@@ -9942,6 +11460,7 @@ _loop1_37_rule(Parser *p)
     }
     ssize_t children_capacity = 1;
     ssize_t n = 0;
+    int choice_mark = enter_choice(p, mark);
     { // except_block
         excepthandler_ty except_block_var;
         while (
@@ -9959,27 +11478,28 @@ _loop1_37_rule(Parser *p)
             }
             children[n++] = res;
             mark = p->mark;
+            p->choice_mark = Py_MIN(choice_mark, mark);
         }
         p->mark = mark;
     }
+    p->choice_mark = choice_mark;
     if (n == 0) {
         PyMem_Free(children);
         return NULL;
     }
     asdl_seq *seq = _Py_asdl_seq_new(n, p->arena);
     if (!seq) {
-        PyErr_Format(PyExc_MemoryError, "asdl_seq_new _loop1_37");
+        PyErr_Format(PyExc_MemoryError, "asdl_seq_new _loop1_30");
         return NULL;
     }
     for (int i = 0; i < n; i++) asdl_seq_SET(seq, i, children[i]);
     PyMem_Free(children);
-    insert_memo(p, mark, _loop1_37_type, seq);
     return seq;
 }
 
-// _tmp_38: 'as' target
+// _tmp_31: 'as' target
 static void *
-_tmp_38_rule(Parser *p)
+_tmp_31_rule(Parser *p)
 {
     void * res = NULL;
     int mark = p->mark;
@@ -9992,9 +11512,14 @@ _tmp_38_rule(Parser *p)
             (z = target_rule(p))
         )
         {
-            res = z;
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
+            }
+            else {
+                res = z;
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -10005,9 +11530,9 @@ _tmp_38_rule(Parser *p)
     return res;
 }
 
-// _tmp_39: 'from' expression
+// _tmp_32: 'from' expression
 static void *
-_tmp_39_rule(Parser *p)
+_tmp_32_rule(Parser *p)
 {
     void * res = NULL;
     int mark = p->mark;
@@ -10020,9 +11545,14 @@ _tmp_39_rule(Parser *p)
             (z = expression_rule(p))
         )
         {
-            res = z;
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
+            }
+            else {
+                res = z;
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -10033,9 +11563,9 @@ _tmp_39_rule(Parser *p)
     return res;
 }
 
-// _tmp_40: '->' annotation
+// _tmp_33: '->' annotation
 static void *
-_tmp_40_rule(Parser *p)
+_tmp_33_rule(Parser *p)
 {
     void * res = NULL;
     int mark = p->mark;
@@ -10048,9 +11578,14 @@ _tmp_40_rule(Parser *p)
             (z = annotation_rule(p))
         )
         {
-            res = z;
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
+            }
+            else {
+                res = z;
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -10061,9 +11596,9 @@ _tmp_40_rule(Parser *p)
     return res;
 }
 
-// _tmp_41: '->' annotation
+// _tmp_34: '->' annotation
 static void *
-_tmp_41_rule(Parser *p)
+_tmp_34_rule(Parser *p)
 {
     void * res = NULL;
     int mark = p->mark;
@@ -10076,9 +11611,14 @@ _tmp_41_rule(Parser *p)
             (z = annotation_rule(p))
         )
         {
-            res = z;
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
+            }
+            else {
+                res = z;
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -10089,9 +11629,9 @@ _tmp_41_rule(Parser *p)
     return res;
 }
 
-// _tmp_42: ',' plain_names
+// _tmp_35: ',' plain_names
 static void *
-_tmp_42_rule(Parser *p)
+_tmp_35_rule(Parser *p)
 {
     void * res = NULL;
     int mark = p->mark;
@@ -10104,9 +11644,14 @@ _tmp_42_rule(Parser *p)
             (x = plain_names_rule(p))
         )
         {
-            res = x;
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
+            }
+            else {
+                res = x;
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -10117,9 +11662,9 @@ _tmp_42_rule(Parser *p)
     return res;
 }
 
-// _tmp_43: ',' names_with_default
+// _tmp_36: ',' names_with_default
 static void *
-_tmp_43_rule(Parser *p)
+_tmp_36_rule(Parser *p)
 {
     void * res = NULL;
     int mark = p->mark;
@@ -10132,9 +11677,14 @@ _tmp_43_rule(Parser *p)
             (y = names_with_default_rule(p))
         )
         {
-            res = y;
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
+            }
+            else {
+                res = y;
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -10145,9 +11695,9 @@ _tmp_43_rule(Parser *p)
     return res;
 }
 
-// _tmp_44: ',' star_etc?
+// _tmp_37: ',' star_etc?
 static void *
-_tmp_44_rule(Parser *p)
+_tmp_37_rule(Parser *p)
 {
     void * res = NULL;
     int mark = p->mark;
@@ -10160,9 +11710,14 @@ _tmp_44_rule(Parser *p)
             (z = star_etc_rule(p), 1)
         )
         {
-            res = z;
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
+            }
+            else {
+                res = z;
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -10173,9 +11728,9 @@ _tmp_44_rule(Parser *p)
     return res;
 }
 
-// _tmp_45: ',' names_with_default
+// _tmp_38: ',' names_with_default
 static void *
-_tmp_45_rule(Parser *p)
+_tmp_38_rule(Parser *p)
 {
     void * res = NULL;
     int mark = p->mark;
@@ -10188,9 +11743,14 @@ _tmp_45_rule(Parser *p)
             (y = names_with_default_rule(p))
         )
         {
-            res = y;
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
+            }
+            else {
+                res = y;
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -10201,9 +11761,9 @@ _tmp_45_rule(Parser *p)
     return res;
 }
 
-// _tmp_46: ',' star_etc?
+// _tmp_39: ',' star_etc?
 static void *
-_tmp_46_rule(Parser *p)
+_tmp_39_rule(Parser *p)
 {
     void * res = NULL;
     int mark = p->mark;
@@ -10216,9 +11776,14 @@ _tmp_46_rule(Parser *p)
             (z = star_etc_rule(p), 1)
         )
         {
-            res = z;
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
+            }
+            else {
+                res = z;
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -10229,9 +11794,9 @@ _tmp_46_rule(Parser *p)
     return res;
 }
 
-// _tmp_47: ',' names_with_default
+// _tmp_40: ',' names_with_default
 static void *
-_tmp_47_rule(Parser *p)
+_tmp_40_rule(Parser *p)
 {
     void * res = NULL;
     int mark = p->mark;
@@ -10244,9 +11809,14 @@ _tmp_47_rule(Parser *p)
             (y = names_with_default_rule(p))
         )
         {
-            res = y;
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
+            }
+            else {
+                res = y;
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -10257,9 +11827,9 @@ _tmp_47_rule(Parser *p)
     return res;
 }
 
-// _tmp_48: ',' star_etc?
+// _tmp_41: ',' star_etc?
 static void *
-_tmp_48_rule(Parser *p)
+_tmp_41_rule(Parser *p)
 {
     void * res = NULL;
     int mark = p->mark;
@@ -10272,9 +11842,14 @@ _tmp_48_rule(Parser *p)
             (z = star_etc_rule(p), 1)
         )
         {
-            res = z;
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
+            }
+            else {
+                res = z;
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -10285,9 +11860,9 @@ _tmp_48_rule(Parser *p)
     return res;
 }
 
-// _tmp_49: ',' star_etc?
+// _tmp_42: ',' star_etc?
 static void *
-_tmp_49_rule(Parser *p)
+_tmp_42_rule(Parser *p)
 {
     void * res = NULL;
     int mark = p->mark;
@@ -10300,9 +11875,14 @@ _tmp_49_rule(Parser *p)
             (z = star_etc_rule(p), 1)
         )
         {
-            res = z;
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
+            }
+            else {
+                res = z;
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -10313,9 +11893,9 @@ _tmp_49_rule(Parser *p)
     return res;
 }
 
-// _tmp_50: plain_names ','
+// _tmp_43: plain_names ','
 static void *
-_tmp_50_rule(Parser *p)
+_tmp_43_rule(Parser *p)
 {
     void * res = NULL;
     int mark = p->mark;
@@ -10328,9 +11908,14 @@ _tmp_50_rule(Parser *p)
             (literal = expect_token(p, 12))
         )
         {
-            res = n;
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
+            }
+            else {
+                res = n;
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -10341,9 +11926,9 @@ _tmp_50_rule(Parser *p)
     return res;
 }
 
-// _loop0_51: name_with_optional_default
+// _loop0_44: name_with_optional_default
 static asdl_seq *
-_loop0_51_rule(Parser *p)
+_loop0_44_rule(Parser *p)
 {
     void *res = NULL;
     int mark = p->mark;
@@ -10376,18 +11961,17 @@ _loop0_51_rule(Parser *p)
     }
     asdl_seq *seq = _Py_asdl_seq_new(n, p->arena);
     if (!seq) {
-        PyErr_Format(PyExc_MemoryError, "asdl_seq_new _loop0_51");
+        PyErr_Format(PyExc_MemoryError, "asdl_seq_new _loop0_44");
         return NULL;
     }
     for (int i = 0; i < n; i++) asdl_seq_SET(seq, i, children[i]);
     PyMem_Free(children);
-    insert_memo(p, mark, _loop0_51_type, seq);
     return seq;
 }
 
-// _tmp_52: ',' kwds
+// _tmp_45: ',' kwds
 static void *
-_tmp_52_rule(Parser *p)
+_tmp_45_rule(Parser *p)
 {
     void * res = NULL;
     int mark = p->mark;
@@ -10400,9 +11984,14 @@ _tmp_52_rule(Parser *p)
             (d = kwds_rule(p))
         )
         {
-            res = d;
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
+            }
+            else {
+                res = d;
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -10413,9 +12002,9 @@ _tmp_52_rule(Parser *p)
     return res;
 }
 
-// _loop1_53: name_with_optional_default
+// _loop1_46: name_with_optional_default
 static asdl_seq *
-_loop1_53_rule(Parser *p)
+_loop1_46_rule(Parser *p)
 {
     void *res = NULL;
     int mark = p->mark;
@@ -10452,18 +12041,17 @@ _loop1_53_rule(Parser *p)
     }
     asdl_seq *seq = _Py_asdl_seq_new(n, p->arena);
     if (!seq) {
-        PyErr_Format(PyExc_MemoryError, "asdl_seq_new _loop1_53");
+        PyErr_Format(PyExc_MemoryError, "asdl_seq_new _loop1_46");
         return NULL;
     }
     for (int i = 0; i < n; i++) asdl_seq_SET(seq, i, children[i]);
     PyMem_Free(children);
-    insert_memo(p, mark, _loop1_53_type, seq);
     return seq;
 }
 
-// _tmp_54: ',' kwds
+// _tmp_47: ',' kwds
 static void *
-_tmp_54_rule(Parser *p)
+_tmp_47_rule(Parser *p)
 {
     void * res = NULL;
     int mark = p->mark;
@@ -10476,9 +12064,14 @@ _tmp_54_rule(Parser *p)
             (d = kwds_rule(p))
         )
         {
-            res = d;
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
+            }
+            else {
+                res = d;
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -10489,9 +12082,9 @@ _tmp_54_rule(Parser *p)
     return res;
 }
 
-// _tmp_55: '=' expression
+// _tmp_48: '=' expression
 static void *
-_tmp_55_rule(Parser *p)
+_tmp_48_rule(Parser *p)
 {
     void * res = NULL;
     int mark = p->mark;
@@ -10504,9 +12097,14 @@ _tmp_55_rule(Parser *p)
             (e = expression_rule(p))
         )
         {
-            res = e;
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
+            }
+            else {
+                res = e;
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -10517,11 +12115,10 @@ _tmp_55_rule(Parser *p)
     return res;
 }
 
-// _loop0_57: ',' name_with_default
+// _gather_49: ','.name_with_default+
 static asdl_seq *
-_loop0_57_rule(Parser *p)
+_gather_49_rule(Parser *p)
 {
-    void *res = NULL;
     int mark = p->mark;
     void **children = PyMem_Malloc(sizeof(void *));
     if (!children) {
@@ -10530,73 +12127,53 @@ _loop0_57_rule(Parser *p)
     }
     ssize_t children_capacity = 1;
     ssize_t n = 0;
-    { // ',' name_with_default
+    { // ','.name_with_default+
         NameDefaultPair* elem;
         void *literal;
-        while (
-            (literal = expect_token(p, 12))
-            &&
+        if (
             (elem = name_with_default_rule(p))
         )
         {
-            res = elem;
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
-            }
-            if (n == children_capacity) {
-                children_capacity *= 2;
-                children = PyMem_Realloc(children, children_capacity*sizeof(void *));
-                if (!children) {
-                    PyErr_Format(PyExc_MemoryError, "realloc None");
-                    return NULL;
+            children[n++] = elem;
+            mark = p->mark;
+            while (
+                (literal = expect_token(p, 12))
+                &&
+                (elem = name_with_default_rule(p))
+            )
+            {
+                if (n == children_capacity) {
+                    children_capacity *= 2;
+                    children = PyMem_Realloc(children, children_capacity*sizeof(void *));
+                    if (!children) {
+                        PyErr_Format(PyExc_MemoryError, "realloc _gather_49");
+                        return NULL;
+                    }
                 }
+                children[n++] = elem;
+                mark = p->mark;
             }
-            children[n++] = res;
-            mark = p->mark;
         }
         p->mark = mark;
     }
+    if (n == 0) {
+        PyMem_Free(children);
+        return NULL;
+    }
     asdl_seq *seq = _Py_asdl_seq_new(n, p->arena);
     if (!seq) {
-        PyErr_Format(PyExc_MemoryError, "asdl_seq_new _loop0_57");
+        PyErr_Format(PyExc_MemoryError, "asdl_seq_new _gather_49");
         return NULL;
     }
     for (int i = 0; i < n; i++) asdl_seq_SET(seq, i, children[i]);
     PyMem_Free(children);
-    insert_memo(p, mark, _loop0_57_type, seq);
     return seq;
 }
 
-// _gather_56: name_with_default _loop0_57
+// _gather_50: ','.(plain_name !'=')+
 static asdl_seq *
-_gather_56_rule(Parser *p)
+_gather_50_rule(Parser *p)
 {
-    asdl_seq * res = NULL;
-    int mark = p->mark;
-    { // name_with_default _loop0_57
-        NameDefaultPair* elem;
-        asdl_seq * seq;
-        if (
-            (elem = name_with_default_rule(p))
-            &&
-            (seq = _loop0_57_rule(p))
-        )
-        {
-            res = seq_insert_in_front(p, elem, seq);
-            goto done;
-        }
-        p->mark = mark;
-    }
-    res = NULL;
-  done:
-    return res;
-}
-
-// _loop0_59: ',' (plain_name !'=')
-static asdl_seq *
-_loop0_59_rule(Parser *p)
-{
-    void *res = NULL;
     int mark = p->mark;
     void **children = PyMem_Malloc(sizeof(void *));
     if (!children) {
@@ -10605,59 +12182,64 @@ _loop0_59_rule(Parser *p)
     }
     ssize_t children_capacity = 1;
     ssize_t n = 0;
-    { // ',' (plain_name !'=')
+    { // ','.(plain_name !'=')+
         void *elem;
         void *literal;
-        while (
-            (literal = expect_token(p, 12))
-            &&
-            (elem = _tmp_117_rule(p))
+        if (
+            (elem = _tmp_51_rule(p))
         )
         {
-            res = elem;
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
-            }
-            if (n == children_capacity) {
-                children_capacity *= 2;
-                children = PyMem_Realloc(children, children_capacity*sizeof(void *));
-                if (!children) {
-                    PyErr_Format(PyExc_MemoryError, "realloc None");
-                    return NULL;
+            children[n++] = elem;
+            mark = p->mark;
+            while (
+                (literal = expect_token(p, 12))
+                &&
+                (elem = _tmp_51_rule(p))
+            )
+            {
+                if (n == children_capacity) {
+                    children_capacity *= 2;
+                    children = PyMem_Realloc(children, children_capacity*sizeof(void *));
+                    if (!children) {
+                        PyErr_Format(PyExc_MemoryError, "realloc _gather_50");
+                        return NULL;
+                    }
                 }
+                children[n++] = elem;
+                mark = p->mark;
             }
-            children[n++] = res;
-            mark = p->mark;
         }
         p->mark = mark;
     }
+    if (n == 0) {
+        PyMem_Free(children);
+        return NULL;
+    }
     asdl_seq *seq = _Py_asdl_seq_new(n, p->arena);
     if (!seq) {
-        PyErr_Format(PyExc_MemoryError, "asdl_seq_new _loop0_59");
+        PyErr_Format(PyExc_MemoryError, "asdl_seq_new _gather_50");
         return NULL;
     }
     for (int i = 0; i < n; i++) asdl_seq_SET(seq, i, children[i]);
     PyMem_Free(children);
-    insert_memo(p, mark, _loop0_59_type, seq);
     return seq;
 }
 
-// _gather_58: (plain_name !'=') _loop0_59
-static asdl_seq *
-_gather_58_rule(Parser *p)
+// _tmp_51: plain_name !'='
+static void *
+_tmp_51_rule(Parser *p)
 {
-    asdl_seq * res = NULL;
+    void * res = NULL;
     int mark = p->mark;
-    { // (plain_name !'=') _loop0_59
-        void *elem;
-        asdl_seq * seq;
+    { // plain_name !'='
+        arg_ty plain_name_var;
         if (
-            (elem = _tmp_117_rule(p))
+            (plain_name_var = plain_name_rule(p))
             &&
-            (seq = _loop0_59_rule(p))
+            lookahead_with_int(0, expect_token, p, 22)
         )
         {
-            res = seq_insert_in_front(p, elem, seq);
+            res = plain_name_var;
             goto done;
         }
         p->mark = mark;
@@ -10667,9 +12249,9 @@ _gather_58_rule(Parser *p)
     return res;
 }
 
-// _tmp_60: ':' annotation
+// _tmp_52: ':' annotation
 static void *
-_tmp_60_rule(Parser *p)
+_tmp_52_rule(Parser *p)
 {
     void * res = NULL;
     int mark = p->mark;
@@ -10682,9 +12264,14 @@ _tmp_60_rule(Parser *p)
             (z = annotation_rule(p))
         )
         {
-            res = z;
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
+            }
+            else {
+                res = z;
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -10695,9 +12282,9 @@ _tmp_60_rule(Parser *p)
     return res;
 }
 
-// _loop1_61: ('@' factor NEWLINE)
+// _loop1_53: ('@' factor NEWLINE)
 static asdl_seq *
-_loop1_61_rule(Parser *p)
+_loop1_53_rule(Parser *p)
 {
     void *res = NULL;
     int mark = p->mark;
@@ -10709,12 +12296,12 @@ _loop1_61_rule(Parser *p)
     ssize_t children_capacity = 1;
     ssize_t n = 0;
     { // ('@' factor NEWLINE)
-        void *_tmp_118_var;
+        void *_tmp_99_var;
         while (
-            (_tmp_118_var = _tmp_118_rule(p))
+            (_tmp_99_var = _tmp_99_rule(p))
         )
         {
-            res = _tmp_118_var;
+            res = _tmp_99_var;
             if (n == children_capacity) {
                 children_capacity *= 2;
                 children = PyMem_Realloc(children, children_capacity*sizeof(void *));
@@ -10734,18 +12321,17 @@ _loop1_61_rule(Parser *p)
     }
     asdl_seq *seq = _Py_asdl_seq_new(n, p->arena);
     if (!seq) {
-        PyErr_Format(PyExc_MemoryError, "asdl_seq_new _loop1_61");
+        PyErr_Format(PyExc_MemoryError, "asdl_seq_new _loop1_53");
         return NULL;
     }
     for (int i = 0; i < n; i++) asdl_seq_SET(seq, i, children[i]);
     PyMem_Free(children);
-    insert_memo(p, mark, _loop1_61_type, seq);
     return seq;
 }
 
-// _tmp_62: '(' arguments? ')'
+// _tmp_54: '(' arguments? ')'
 static void *
-_tmp_62_rule(Parser *p)
+_tmp_54_rule(Parser *p)
 {
     void * res = NULL;
     int mark = p->mark;
@@ -10761,9 +12347,14 @@ _tmp_62_rule(Parser *p)
             (literal_1 = expect_token(p, 8))
         )
         {
-            res = z;
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
+            }
+            else {
+                res = z;
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -10774,11 +12365,10 @@ _tmp_62_rule(Parser *p)
     return res;
 }
 
-// _loop0_64: ',' star_expression
+// _gather_55: ','.star_expression+
 static asdl_seq *
-_loop0_64_rule(Parser *p)
+_gather_55_rule(Parser *p)
 {
-    void *res = NULL;
     int mark = p->mark;
     void **children = PyMem_Malloc(sizeof(void *));
     if (!children) {
@@ -10787,71 +12377,52 @@ _loop0_64_rule(Parser *p)
     }
     ssize_t children_capacity = 1;
     ssize_t n = 0;
-    { // ',' star_expression
+    { // ','.star_expression+
         expr_ty elem;
         void *literal;
-        while (
-            (literal = expect_token(p, 12))
-            &&
+        if (
             (elem = star_expression_rule(p))
         )
         {
-            res = elem;
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
-            }
-            if (n == children_capacity) {
-                children_capacity *= 2;
-                children = PyMem_Realloc(children, children_capacity*sizeof(void *));
-                if (!children) {
-                    PyErr_Format(PyExc_MemoryError, "realloc None");
-                    return NULL;
+            children[n++] = elem;
+            mark = p->mark;
+            while (
+                (literal = expect_token(p, 12))
+                &&
+                (elem = star_expression_rule(p))
+            )
+            {
+                if (n == children_capacity) {
+                    children_capacity *= 2;
+                    children = PyMem_Realloc(children, children_capacity*sizeof(void *));
+                    if (!children) {
+                        PyErr_Format(PyExc_MemoryError, "realloc _gather_55");
+                        return NULL;
+                    }
                 }
+                children[n++] = elem;
+                mark = p->mark;
             }
-            children[n++] = res;
-            mark = p->mark;
         }
         p->mark = mark;
     }
+    if (n == 0) {
+        PyMem_Free(children);
+        return NULL;
+    }
     asdl_seq *seq = _Py_asdl_seq_new(n, p->arena);
     if (!seq) {
-        PyErr_Format(PyExc_MemoryError, "asdl_seq_new _loop0_64");
+        PyErr_Format(PyExc_MemoryError, "asdl_seq_new _gather_55");
         return NULL;
     }
     for (int i = 0; i < n; i++) asdl_seq_SET(seq, i, children[i]);
     PyMem_Free(children);
-    insert_memo(p, mark, _loop0_64_type, seq);
     return seq;
 }
 
-// _gather_63: star_expression _loop0_64
+// _loop1_56: (',' star_expression)
 static asdl_seq *
-_gather_63_rule(Parser *p)
-{
-    asdl_seq * res = NULL;
-    int mark = p->mark;
-    { // star_expression _loop0_64
-        expr_ty elem;
-        asdl_seq * seq;
-        if (
-            (elem = star_expression_rule(p))
-            &&
-            (seq = _loop0_64_rule(p))
-        )
-        {
-            res = seq_insert_in_front(p, elem, seq);
-            goto done;
-        }
-        p->mark = mark;
-    }
-    res = NULL;
-  done:
-    return res;
-}
-
-// _loop1_65: (',' star_expression)
-static asdl_seq *
-_loop1_65_rule(Parser *p)
+_loop1_56_rule(Parser *p)
 {
     void *res = NULL;
     int mark = p->mark;
@@ -10863,12 +12434,12 @@ _loop1_65_rule(Parser *p)
     ssize_t children_capacity = 1;
     ssize_t n = 0;
     { // (',' star_expression)
-        void *_tmp_119_var;
+        void *_tmp_100_var;
         while (
-            (_tmp_119_var = _tmp_119_rule(p))
+            (_tmp_100_var = _tmp_100_rule(p))
         )
         {
-            res = _tmp_119_var;
+            res = _tmp_100_var;
             if (n == children_capacity) {
                 children_capacity *= 2;
                 children = PyMem_Realloc(children, children_capacity*sizeof(void *));
@@ -10888,20 +12459,18 @@ _loop1_65_rule(Parser *p)
     }
     asdl_seq *seq = _Py_asdl_seq_new(n, p->arena);
     if (!seq) {
-        PyErr_Format(PyExc_MemoryError, "asdl_seq_new _loop1_65");
+        PyErr_Format(PyExc_MemoryError, "asdl_seq_new _loop1_56");
         return NULL;
     }
     for (int i = 0; i < n; i++) asdl_seq_SET(seq, i, children[i]);
     PyMem_Free(children);
-    insert_memo(p, mark, _loop1_65_type, seq);
     return seq;
 }
 
-// _loop0_67: ',' star_named_expression
+// _gather_57: ','.star_named_expression+
 static asdl_seq *
-_loop0_67_rule(Parser *p)
+_gather_57_rule(Parser *p)
 {
-    void *res = NULL;
     int mark = p->mark;
     void **children = PyMem_Malloc(sizeof(void *));
     if (!children) {
@@ -10910,71 +12479,52 @@ _loop0_67_rule(Parser *p)
     }
     ssize_t children_capacity = 1;
     ssize_t n = 0;
-    { // ',' star_named_expression
+    { // ','.star_named_expression+
         expr_ty elem;
         void *literal;
-        while (
-            (literal = expect_token(p, 12))
-            &&
+        if (
             (elem = star_named_expression_rule(p))
         )
         {
-            res = elem;
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
-            }
-            if (n == children_capacity) {
-                children_capacity *= 2;
-                children = PyMem_Realloc(children, children_capacity*sizeof(void *));
-                if (!children) {
-                    PyErr_Format(PyExc_MemoryError, "realloc None");
-                    return NULL;
+            children[n++] = elem;
+            mark = p->mark;
+            while (
+                (literal = expect_token(p, 12))
+                &&
+                (elem = star_named_expression_rule(p))
+            )
+            {
+                if (n == children_capacity) {
+                    children_capacity *= 2;
+                    children = PyMem_Realloc(children, children_capacity*sizeof(void *));
+                    if (!children) {
+                        PyErr_Format(PyExc_MemoryError, "realloc _gather_57");
+                        return NULL;
+                    }
                 }
+                children[n++] = elem;
+                mark = p->mark;
             }
-            children[n++] = res;
-            mark = p->mark;
         }
         p->mark = mark;
     }
+    if (n == 0) {
+        PyMem_Free(children);
+        return NULL;
+    }
     asdl_seq *seq = _Py_asdl_seq_new(n, p->arena);
     if (!seq) {
-        PyErr_Format(PyExc_MemoryError, "asdl_seq_new _loop0_67");
+        PyErr_Format(PyExc_MemoryError, "asdl_seq_new _gather_57");
         return NULL;
     }
     for (int i = 0; i < n; i++) asdl_seq_SET(seq, i, children[i]);
     PyMem_Free(children);
-    insert_memo(p, mark, _loop0_67_type, seq);
     return seq;
 }
 
-// _gather_66: star_named_expression _loop0_67
-static asdl_seq *
-_gather_66_rule(Parser *p)
-{
-    asdl_seq * res = NULL;
-    int mark = p->mark;
-    { // star_named_expression _loop0_67
-        expr_ty elem;
-        asdl_seq * seq;
-        if (
-            (elem = star_named_expression_rule(p))
-            &&
-            (seq = _loop0_67_rule(p))
-        )
-        {
-            res = seq_insert_in_front(p, elem, seq);
-            goto done;
-        }
-        p->mark = mark;
-    }
-    res = NULL;
-  done:
-    return res;
-}
-
-// _tmp_68: ',' lambda_plain_names
+// _tmp_58: ',' lambda_plain_names
 static void *
-_tmp_68_rule(Parser *p)
+_tmp_58_rule(Parser *p)
 {
     void * res = NULL;
     int mark = p->mark;
@@ -10987,9 +12537,14 @@ _tmp_68_rule(Parser *p)
             (x = lambda_plain_names_rule(p))
         )
         {
-            res = x;
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
+            }
+            else {
+                res = x;
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -11000,9 +12555,9 @@ _tmp_68_rule(Parser *p)
     return res;
 }
 
-// _tmp_69: ',' lambda_names_with_default
+// _tmp_59: ',' lambda_names_with_default
 static void *
-_tmp_69_rule(Parser *p)
+_tmp_59_rule(Parser *p)
 {
     void * res = NULL;
     int mark = p->mark;
@@ -11015,9 +12570,14 @@ _tmp_69_rule(Parser *p)
             (y = lambda_names_with_default_rule(p))
         )
         {
-            res = y;
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
+            }
+            else {
+                res = y;
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -11028,9 +12588,9 @@ _tmp_69_rule(Parser *p)
     return res;
 }
 
-// _tmp_70: ',' lambda_star_etc?
+// _tmp_60: ',' lambda_star_etc?
 static void *
-_tmp_70_rule(Parser *p)
+_tmp_60_rule(Parser *p)
 {
     void * res = NULL;
     int mark = p->mark;
@@ -11042,10 +12602,15 @@ _tmp_70_rule(Parser *p)
             &&
             (z = lambda_star_etc_rule(p), 1)
         )
-        {
-            res = z;
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+        {
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
+            }
+            else {
+                res = z;
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -11056,9 +12621,9 @@ _tmp_70_rule(Parser *p)
     return res;
 }
 
-// _tmp_71: ',' lambda_names_with_default
+// _tmp_61: ',' lambda_names_with_default
 static void *
-_tmp_71_rule(Parser *p)
+_tmp_61_rule(Parser *p)
 {
     void * res = NULL;
     int mark = p->mark;
@@ -11071,9 +12636,14 @@ _tmp_71_rule(Parser *p)
             (y = lambda_names_with_default_rule(p))
         )
         {
-            res = y;
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
+            }
+            else {
+                res = y;
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -11084,9 +12654,9 @@ _tmp_71_rule(Parser *p)
     return res;
 }
 
-// _tmp_72: ',' lambda_star_etc?
+// _tmp_62: ',' lambda_star_etc?
 static void *
-_tmp_72_rule(Parser *p)
+_tmp_62_rule(Parser *p)
 {
     void * res = NULL;
     int mark = p->mark;
@@ -11099,9 +12669,14 @@ _tmp_72_rule(Parser *p)
             (z = lambda_star_etc_rule(p), 1)
         )
         {
-            res = z;
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
+            }
+            else {
+                res = z;
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -11112,9 +12687,9 @@ _tmp_72_rule(Parser *p)
     return res;
 }
 
-// _tmp_73: ',' lambda_names_with_default
+// _tmp_63: ',' lambda_names_with_default
 static void *
-_tmp_73_rule(Parser *p)
+_tmp_63_rule(Parser *p)
 {
     void * res = NULL;
     int mark = p->mark;
@@ -11127,9 +12702,14 @@ _tmp_73_rule(Parser *p)
             (y = lambda_names_with_default_rule(p))
         )
         {
-            res = y;
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
+            }
+            else {
+                res = y;
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -11140,9 +12720,9 @@ _tmp_73_rule(Parser *p)
     return res;
 }
 
-// _tmp_74: ',' lambda_star_etc?
+// _tmp_64: ',' lambda_star_etc?
 static void *
-_tmp_74_rule(Parser *p)
+_tmp_64_rule(Parser *p)
 {
     void * res = NULL;
     int mark = p->mark;
@@ -11155,9 +12735,14 @@ _tmp_74_rule(Parser *p)
             (z = lambda_star_etc_rule(p), 1)
         )
         {
-            res = z;
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
+            }
+            else {
+                res = z;
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -11168,9 +12753,9 @@ _tmp_74_rule(Parser *p)
     return res;
 }
 
-// _tmp_75: ',' lambda_star_etc?
+// _tmp_65: ',' lambda_star_etc?
 static void *
-_tmp_75_rule(Parser *p)
+_tmp_65_rule(Parser *p)
 {
     void * res = NULL;
     int mark = p->mark;
@@ -11183,9 +12768,14 @@ _tmp_75_rule(Parser *p)
             (z = lambda_star_etc_rule(p), 1)
         )
         {
-            res = z;
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
+            }
+            else {
+                res = z;
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -11196,9 +12786,9 @@ _tmp_75_rule(Parser *p)
     return res;
 }
 
-// _tmp_76: lambda_plain_names ','
+// _tmp_66: lambda_plain_names ','
 static void *
-_tmp_76_rule(Parser *p)
+_tmp_66_rule(Parser *p)
 {
     void * res = NULL;
     int mark = p->mark;
@@ -11211,9 +12801,14 @@ _tmp_76_rule(Parser *p)
             (literal = expect_token(p, 12))
         )
         {
-            res = n;
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
+            }
+            else {
+                res = n;
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -11224,9 +12819,9 @@ _tmp_76_rule(Parser *p)
     return res;
 }
 
-// _loop0_77: lambda_name_with_optional_default
+// _loop0_67: lambda_name_with_optional_default
 static asdl_seq *
-_loop0_77_rule(Parser *p)
+_loop0_67_rule(Parser *p)
 {
     void *res = NULL;
     int mark = p->mark;
@@ -11259,18 +12854,17 @@ _loop0_77_rule(Parser *p)
     }
     asdl_seq *seq = _Py_asdl_seq_new(n, p->arena);
     if (!seq) {
-        PyErr_Format(PyExc_MemoryError, "asdl_seq_new _loop0_77");
+        PyErr_Format(PyExc_MemoryError, "asdl_seq_new _loop0_67");
         return NULL;
     }
     for (int i = 0; i < n; i++) asdl_seq_SET(seq, i, children[i]);
     PyMem_Free(children);
-    insert_memo(p, mark, _loop0_77_type, seq);
     return seq;
 }
 
-// _tmp_78: ',' lambda_kwds
+// _tmp_68: ',' lambda_kwds
 static void *
-_tmp_78_rule(Parser *p)
+_tmp_68_rule(Parser *p)
 {
     void * res = NULL;
     int mark = p->mark;
@@ -11283,9 +12877,14 @@ _tmp_78_rule(Parser *p)
             (d = lambda_kwds_rule(p))
         )
         {
-            res = d;
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
+            }
+            else {
+                res = d;
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -11296,9 +12895,9 @@ _tmp_78_rule(Parser *p)
     return res;
 }
 
-// _loop1_79: lambda_name_with_optional_default
+// _loop1_69: lambda_name_with_optional_default
 static asdl_seq *
-_loop1_79_rule(Parser *p)
+_loop1_69_rule(Parser *p)
 {
     void *res = NULL;
     int mark = p->mark;
@@ -11335,18 +12934,17 @@ _loop1_79_rule(Parser *p)
     }
     asdl_seq *seq = _Py_asdl_seq_new(n, p->arena);
     if (!seq) {
-        PyErr_Format(PyExc_MemoryError, "asdl_seq_new _loop1_79");
+        PyErr_Format(PyExc_MemoryError, "asdl_seq_new _loop1_69");
         return NULL;
     }
     for (int i = 0; i < n; i++) asdl_seq_SET(seq, i, children[i]);
     PyMem_Free(children);
-    insert_memo(p, mark, _loop1_79_type, seq);
     return seq;
 }
 
-// _tmp_80: ',' lambda_kwds
+// _tmp_70: ',' lambda_kwds
 static void *
-_tmp_80_rule(Parser *p)
+_tmp_70_rule(Parser *p)
 {
     void * res = NULL;
     int mark = p->mark;
@@ -11359,9 +12957,14 @@ _tmp_80_rule(Parser *p)
             (d = lambda_kwds_rule(p))
         )
         {
-            res = d;
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
+            }
+            else {
+                res = d;
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -11372,9 +12975,9 @@ _tmp_80_rule(Parser *p)
     return res;
 }
 
-// _tmp_81: '=' expression
+// _tmp_71: '=' expression
 static void *
-_tmp_81_rule(Parser *p)
+_tmp_71_rule(Parser *p)
 {
     void * res = NULL;
     int mark = p->mark;
@@ -11387,9 +12990,14 @@ _tmp_81_rule(Parser *p)
             (e = expression_rule(p))
         )
         {
-            res = e;
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
+            }
+            else {
+                res = e;
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -11400,11 +13008,10 @@ _tmp_81_rule(Parser *p)
     return res;
 }
 
-// _loop0_83: ',' lambda_name_with_default
+// _gather_72: ','.lambda_name_with_default+
 static asdl_seq *
-_loop0_83_rule(Parser *p)
+_gather_72_rule(Parser *p)
 {
-    void *res = NULL;
     int mark = p->mark;
     void **children = PyMem_Malloc(sizeof(void *));
     if (!children) {
@@ -11413,73 +13020,53 @@ _loop0_83_rule(Parser *p)
     }
     ssize_t children_capacity = 1;
     ssize_t n = 0;
-    { // ',' lambda_name_with_default
+    { // ','.lambda_name_with_default+
         NameDefaultPair* elem;
         void *literal;
-        while (
-            (literal = expect_token(p, 12))
-            &&
+        if (
             (elem = lambda_name_with_default_rule(p))
         )
         {
-            res = elem;
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
-            }
-            if (n == children_capacity) {
-                children_capacity *= 2;
-                children = PyMem_Realloc(children, children_capacity*sizeof(void *));
-                if (!children) {
-                    PyErr_Format(PyExc_MemoryError, "realloc None");
-                    return NULL;
+            children[n++] = elem;
+            mark = p->mark;
+            while (
+                (literal = expect_token(p, 12))
+                &&
+                (elem = lambda_name_with_default_rule(p))
+            )
+            {
+                if (n == children_capacity) {
+                    children_capacity *= 2;
+                    children = PyMem_Realloc(children, children_capacity*sizeof(void *));
+                    if (!children) {
+                        PyErr_Format(PyExc_MemoryError, "realloc _gather_72");
+                        return NULL;
+                    }
                 }
+                children[n++] = elem;
+                mark = p->mark;
             }
-            children[n++] = res;
-            mark = p->mark;
         }
         p->mark = mark;
     }
+    if (n == 0) {
+        PyMem_Free(children);
+        return NULL;
+    }
     asdl_seq *seq = _Py_asdl_seq_new(n, p->arena);
     if (!seq) {
-        PyErr_Format(PyExc_MemoryError, "asdl_seq_new _loop0_83");
+        PyErr_Format(PyExc_MemoryError, "asdl_seq_new _gather_72");
         return NULL;
     }
     for (int i = 0; i < n; i++) asdl_seq_SET(seq, i, children[i]);
     PyMem_Free(children);
-    insert_memo(p, mark, _loop0_83_type, seq);
     return seq;
 }
 
-// _gather_82: lambda_name_with_default _loop0_83
-static asdl_seq *
-_gather_82_rule(Parser *p)
-{
-    asdl_seq * res = NULL;
-    int mark = p->mark;
-    { // lambda_name_with_default _loop0_83
-        NameDefaultPair* elem;
-        asdl_seq * seq;
-        if (
-            (elem = lambda_name_with_default_rule(p))
-            &&
-            (seq = _loop0_83_rule(p))
-        )
-        {
-            res = seq_insert_in_front(p, elem, seq);
-            goto done;
-        }
-        p->mark = mark;
-    }
-    res = NULL;
-  done:
-    return res;
-}
-
-// _loop0_85: ',' (lambda_plain_name !'=')
+// _gather_73: ','.(lambda_plain_name !'=')+
 static asdl_seq *
-_loop0_85_rule(Parser *p)
+_gather_73_rule(Parser *p)
 {
-    void *res = NULL;
     int mark = p->mark;
     void **children = PyMem_Malloc(sizeof(void *));
     if (!children) {
@@ -11488,59 +13075,64 @@ _loop0_85_rule(Parser *p)
     }
     ssize_t children_capacity = 1;
     ssize_t n = 0;
-    { // ',' (lambda_plain_name !'=')
+    { // ','.(lambda_plain_name !'=')+
         void *elem;
         void *literal;
-        while (
-            (literal = expect_token(p, 12))
-            &&
-            (elem = _tmp_120_rule(p))
+        if (
+            (elem = _tmp_74_rule(p))
         )
         {
-            res = elem;
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
-            }
-            if (n == children_capacity) {
-                children_capacity *= 2;
-                children = PyMem_Realloc(children, children_capacity*sizeof(void *));
-                if (!children) {
-                    PyErr_Format(PyExc_MemoryError, "realloc None");
-                    return NULL;
+            children[n++] = elem;
+            mark = p->mark;
+            while (
+                (literal = expect_token(p, 12))
+                &&
+                (elem = _tmp_74_rule(p))
+            )
+            {
+                if (n == children_capacity) {
+                    children_capacity *= 2;
+                    children = PyMem_Realloc(children, children_capacity*sizeof(void *));
+                    if (!children) {
+                        PyErr_Format(PyExc_MemoryError, "realloc _gather_73");
+                        return NULL;
+                    }
                 }
+                children[n++] = elem;
+                mark = p->mark;
             }
-            children[n++] = res;
-            mark = p->mark;
         }
         p->mark = mark;
     }
+    if (n == 0) {
+        PyMem_Free(children);
+        return NULL;
+    }
     asdl_seq *seq = _Py_asdl_seq_new(n, p->arena);
     if (!seq) {
-        PyErr_Format(PyExc_MemoryError, "asdl_seq_new _loop0_85");
+        PyErr_Format(PyExc_MemoryError, "asdl_seq_new _gather_73");
         return NULL;
     }
     for (int i = 0; i < n; i++) asdl_seq_SET(seq, i, children[i]);
     PyMem_Free(children);
-    insert_memo(p, mark, _loop0_85_type, seq);
     return seq;
 }
 
-// _gather_84: (lambda_plain_name !'=') _loop0_85
-static asdl_seq *
-_gather_84_rule(Parser *p)
+// _tmp_74: lambda_plain_name !'='
+static void *
+_tmp_74_rule(Parser *p)
 {
-    asdl_seq * res = NULL;
+    void * res = NULL;
     int mark = p->mark;
-    { // (lambda_plain_name !'=') _loop0_85
-        void *elem;
-        asdl_seq * seq;
+    { // lambda_plain_name !'='
+        arg_ty lambda_plain_name_var;
         if (
-            (elem = _tmp_120_rule(p))
+            (lambda_plain_name_var = lambda_plain_name_rule(p))
             &&
-            (seq = _loop0_85_rule(p))
+            lookahead_with_int(0, expect_token, p, 22)
         )
         {
-            res = seq_insert_in_front(p, elem, seq);
+            res = lambda_plain_name_var;
             goto done;
         }
         p->mark = mark;
@@ -11550,9 +13142,9 @@ _gather_84_rule(Parser *p)
     return res;
 }
 
-// _loop1_86: ('or' conjunction)
+// _loop1_75: ('or' conjunction)
 static asdl_seq *
-_loop1_86_rule(Parser *p)
+_loop1_75_rule(Parser *p)
 {
     void *res = NULL;
     int mark = p->mark;
@@ -11564,12 +13156,12 @@ _loop1_86_rule(Parser *p)
     ssize_t children_capacity = 1;
     ssize_t n = 0;
     { // ('or' conjunction)
-        void *_tmp_121_var;
+        void *_tmp_101_var;
         while (
-            (_tmp_121_var = _tmp_121_rule(p))
+            (_tmp_101_var = _tmp_101_rule(p))
         )
         {
-            res = _tmp_121_var;
+            res = _tmp_101_var;
             if (n == children_capacity) {
                 children_capacity *= 2;
                 children = PyMem_Realloc(children, children_capacity*sizeof(void *));
@@ -11589,18 +13181,17 @@ _loop1_86_rule(Parser *p)
     }
     asdl_seq *seq = _Py_asdl_seq_new(n, p->arena);
     if (!seq) {
-        PyErr_Format(PyExc_MemoryError, "asdl_seq_new _loop1_86");
+        PyErr_Format(PyExc_MemoryError, "asdl_seq_new _loop1_75");
         return NULL;
     }
     for (int i = 0; i < n; i++) asdl_seq_SET(seq, i, children[i]);
     PyMem_Free(children);
-    insert_memo(p, mark, _loop1_86_type, seq);
     return seq;
 }
 
-// _loop1_87: ('and' inversion)
+// _loop1_76: ('and' inversion)
 static asdl_seq *
-_loop1_87_rule(Parser *p)
+_loop1_76_rule(Parser *p)
 {
     void *res = NULL;
     int mark = p->mark;
@@ -11612,12 +13203,12 @@ _loop1_87_rule(Parser *p)
     ssize_t children_capacity = 1;
     ssize_t n = 0;
     { // ('and' inversion)
-        void *_tmp_122_var;
+        void *_tmp_102_var;
         while (
-            (_tmp_122_var = _tmp_122_rule(p))
+            (_tmp_102_var = _tmp_102_rule(p))
         )
         {
-            res = _tmp_122_var;
+            res = _tmp_102_var;
             if (n == children_capacity) {
                 children_capacity *= 2;
                 children = PyMem_Realloc(children, children_capacity*sizeof(void *));
@@ -11637,18 +13228,17 @@ _loop1_87_rule(Parser *p)
     }
     asdl_seq *seq = _Py_asdl_seq_new(n, p->arena);
     if (!seq) {
-        PyErr_Format(PyExc_MemoryError, "asdl_seq_new _loop1_87");
+        PyErr_Format(PyExc_MemoryError, "asdl_seq_new _loop1_76");
         return NULL;
     }
     for (int i = 0; i < n; i++) asdl_seq_SET(seq, i, children[i]);
     PyMem_Free(children);
-    insert_memo(p, mark, _loop1_87_type, seq);
     return seq;
 }
 
-// _loop1_88: compare_op_bitwise_or_pair
+// _loop1_77: compare_op_bitwise_or_pair
 static asdl_seq *
-_loop1_88_rule(Parser *p)
+_loop1_77_rule(Parser *p)
 {
     void *res = NULL;
     int mark = p->mark;
@@ -11685,20 +13275,18 @@ _loop1_88_rule(Parser *p)
     }
     asdl_seq *seq = _Py_asdl_seq_new(n, p->arena);
     if (!seq) {
-        PyErr_Format(PyExc_MemoryError, "asdl_seq_new _loop1_88");
+        PyErr_Format(PyExc_MemoryError, "asdl_seq_new _loop1_77");
         return NULL;
     }
     for (int i = 0; i < n; i++) asdl_seq_SET(seq, i, children[i]);
     PyMem_Free(children);
-    insert_memo(p, mark, _loop1_88_type, seq);
     return seq;
 }
 
-// _loop0_90: ',' expression
+// _gather_78: ','.expression+
 static asdl_seq *
-_loop0_90_rule(Parser *p)
+_gather_78_rule(Parser *p)
 {
-    void *res = NULL;
     int mark = p->mark;
     void **children = PyMem_Malloc(sizeof(void *));
     if (!children) {
@@ -11707,73 +13295,53 @@ _loop0_90_rule(Parser *p)
     }
     ssize_t children_capacity = 1;
     ssize_t n = 0;
-    { // ',' expression
+    { // ','.expression+
         expr_ty elem;
         void *literal;
-        while (
-            (literal = expect_token(p, 12))
-            &&
+        if (
             (elem = expression_rule(p))
         )
         {
-            res = elem;
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
-            }
-            if (n == children_capacity) {
-                children_capacity *= 2;
-                children = PyMem_Realloc(children, children_capacity*sizeof(void *));
-                if (!children) {
-                    PyErr_Format(PyExc_MemoryError, "realloc None");
-                    return NULL;
+            children[n++] = elem;
+            mark = p->mark;
+            while (
+                (literal = expect_token(p, 12))
+                &&
+                (elem = expression_rule(p))
+            )
+            {
+                if (n == children_capacity) {
+                    children_capacity *= 2;
+                    children = PyMem_Realloc(children, children_capacity*sizeof(void *));
+                    if (!children) {
+                        PyErr_Format(PyExc_MemoryError, "realloc _gather_78");
+                        return NULL;
+                    }
                 }
+                children[n++] = elem;
+                mark = p->mark;
             }
-            children[n++] = res;
-            mark = p->mark;
         }
         p->mark = mark;
     }
+    if (n == 0) {
+        PyMem_Free(children);
+        return NULL;
+    }
     asdl_seq *seq = _Py_asdl_seq_new(n, p->arena);
     if (!seq) {
-        PyErr_Format(PyExc_MemoryError, "asdl_seq_new _loop0_90");
+        PyErr_Format(PyExc_MemoryError, "asdl_seq_new _gather_78");
         return NULL;
     }
     for (int i = 0; i < n; i++) asdl_seq_SET(seq, i, children[i]);
     PyMem_Free(children);
-    insert_memo(p, mark, _loop0_90_type, seq);
     return seq;
 }
 
-// _gather_89: expression _loop0_90
-static asdl_seq *
-_gather_89_rule(Parser *p)
-{
-    asdl_seq * res = NULL;
-    int mark = p->mark;
-    { // expression _loop0_90
-        expr_ty elem;
-        asdl_seq * seq;
-        if (
-            (elem = expression_rule(p))
-            &&
-            (seq = _loop0_90_rule(p))
-        )
-        {
-            res = seq_insert_in_front(p, elem, seq);
-            goto done;
-        }
-        p->mark = mark;
-    }
-    res = NULL;
-  done:
-    return res;
-}
-
-// _loop0_92: ',' slice
+// _gather_79: ','.slice+
 static asdl_seq *
-_loop0_92_rule(Parser *p)
+_gather_79_rule(Parser *p)
 {
-    void *res = NULL;
     int mark = p->mark;
     void **children = PyMem_Malloc(sizeof(void *));
     if (!children) {
@@ -11782,71 +13350,52 @@ _loop0_92_rule(Parser *p)
     }
     ssize_t children_capacity = 1;
     ssize_t n = 0;
-    { // ',' slice
+    { // ','.slice+
         slice_ty elem;
         void *literal;
-        while (
-            (literal = expect_token(p, 12))
-            &&
+        if (
             (elem = slice_rule(p))
         )
         {
-            res = elem;
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
-            }
-            if (n == children_capacity) {
-                children_capacity *= 2;
-                children = PyMem_Realloc(children, children_capacity*sizeof(void *));
-                if (!children) {
-                    PyErr_Format(PyExc_MemoryError, "realloc None");
-                    return NULL;
+            children[n++] = elem;
+            mark = p->mark;
+            while (
+                (literal = expect_token(p, 12))
+                &&
+                (elem = slice_rule(p))
+            )
+            {
+                if (n == children_capacity) {
+                    children_capacity *= 2;
+                    children = PyMem_Realloc(children, children_capacity*sizeof(void *));
+                    if (!children) {
+                        PyErr_Format(PyExc_MemoryError, "realloc _gather_79");
+                        return NULL;
+                    }
                 }
+                children[n++] = elem;
+                mark = p->mark;
             }
-            children[n++] = res;
-            mark = p->mark;
         }
         p->mark = mark;
     }
+    if (n == 0) {
+        PyMem_Free(children);
+        return NULL;
+    }
     asdl_seq *seq = _Py_asdl_seq_new(n, p->arena);
     if (!seq) {
-        PyErr_Format(PyExc_MemoryError, "asdl_seq_new _loop0_92");
+        PyErr_Format(PyExc_MemoryError, "asdl_seq_new _gather_79");
         return NULL;
     }
     for (int i = 0; i < n; i++) asdl_seq_SET(seq, i, children[i]);
     PyMem_Free(children);
-    insert_memo(p, mark, _loop0_92_type, seq);
     return seq;
 }
 
-// _gather_91: slice _loop0_92
-static asdl_seq *
-_gather_91_rule(Parser *p)
-{
-    asdl_seq * res = NULL;
-    int mark = p->mark;
-    { // slice _loop0_92
-        slice_ty elem;
-        asdl_seq * seq;
-        if (
-            (elem = slice_rule(p))
-            &&
-            (seq = _loop0_92_rule(p))
-        )
-        {
-            res = seq_insert_in_front(p, elem, seq);
-            goto done;
-        }
-        p->mark = mark;
-    }
-    res = NULL;
-  done:
-    return res;
-}
-
-// _tmp_93: ':' expression?
+// _tmp_80: ':' expression?
 static void *
-_tmp_93_rule(Parser *p)
+_tmp_80_rule(Parser *p)
 {
     void * res = NULL;
     int mark = p->mark;
@@ -11859,9 +13408,14 @@ _tmp_93_rule(Parser *p)
             (d = expression_rule(p), 1)
         )
         {
-            res = d;
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
+            }
+            else {
+                res = d;
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -11872,9 +13426,9 @@ _tmp_93_rule(Parser *p)
     return res;
 }
 
-// _loop1_94: STRING
+// _loop1_81: STRING
 static asdl_seq *
-_loop1_94_rule(Parser *p)
+_loop1_81_rule(Parser *p)
 {
     void *res = NULL;
     int mark = p->mark;
@@ -11911,18 +13465,17 @@ _loop1_94_rule(Parser *p)
     }
     asdl_seq *seq = _Py_asdl_seq_new(n, p->arena);
     if (!seq) {
-        PyErr_Format(PyExc_MemoryError, "asdl_seq_new _loop1_94");
+        PyErr_Format(PyExc_MemoryError, "asdl_seq_new _loop1_81");
         return NULL;
     }
     for (int i = 0; i < n; i++) asdl_seq_SET(seq, i, children[i]);
     PyMem_Free(children);
-    insert_memo(p, mark, _loop1_94_type, seq);
     return seq;
 }
 
-// _tmp_95: tuple | group | genexp
+// _tmp_82: tuple | group | genexp
 static void *
-_tmp_95_rule(Parser *p)
+_tmp_82_rule(Parser *p)
 {
     void * res = NULL;
     int mark = p->mark;
@@ -11964,9 +13517,9 @@ _tmp_95_rule(Parser *p)
     return res;
 }
 
-// _tmp_96: list | listcomp
+// _tmp_83: list | listcomp
 static void *
-_tmp_96_rule(Parser *p)
+_tmp_83_rule(Parser *p)
 {
     void * res = NULL;
     int mark = p->mark;
@@ -11997,9 +13550,9 @@ _tmp_96_rule(Parser *p)
     return res;
 }
 
-// _tmp_97: dict | set | dictcomp | setcomp
+// _tmp_84: dict | set | dictcomp | setcomp
 static void *
-_tmp_97_rule(Parser *p)
+_tmp_84_rule(Parser *p)
 {
     void * res = NULL;
     int mark = p->mark;
@@ -12052,9 +13605,9 @@ _tmp_97_rule(Parser *p)
     return res;
 }
 
-// _tmp_98: star_named_expression ',' star_named_expressions?
+// _tmp_85: star_named_expression ',' star_named_expressions?
 static void *
-_tmp_98_rule(Parser *p)
+_tmp_85_rule(Parser *p)
 {
     void * res = NULL;
     int mark = p->mark;
@@ -12070,9 +13623,14 @@ _tmp_98_rule(Parser *p)
             (z = star_named_expressions_rule(p), 1)
         )
         {
-            res = seq_insert_in_front ( p , y , z );
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
+            }
+            else {
+                res = seq_insert_in_front ( p , y , z );
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -12083,9 +13641,9 @@ _tmp_98_rule(Parser *p)
     return res;
 }
 
-// _tmp_99: yield_expr | named_expression
+// _tmp_86: yield_expr | named_expression
 static void *
-_tmp_99_rule(Parser *p)
+_tmp_86_rule(Parser *p)
 {
     void * res = NULL;
     int mark = p->mark;
@@ -12116,11 +13674,10 @@ _tmp_99_rule(Parser *p)
     return res;
 }
 
-// _loop0_101: ',' kvpair
+// _gather_87: ','.kvpair+
 static asdl_seq *
-_loop0_101_rule(Parser *p)
+_gather_87_rule(Parser *p)
 {
-    void *res = NULL;
     int mark = p->mark;
     void **children = PyMem_Malloc(sizeof(void *));
     if (!children) {
@@ -12129,71 +13686,52 @@ _loop0_101_rule(Parser *p)
     }
     ssize_t children_capacity = 1;
     ssize_t n = 0;
-    { // ',' kvpair
+    { // ','.kvpair+
         KeyValuePair* elem;
         void *literal;
-        while (
-            (literal = expect_token(p, 12))
-            &&
+        if (
             (elem = kvpair_rule(p))
         )
         {
-            res = elem;
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
-            }
-            if (n == children_capacity) {
-                children_capacity *= 2;
-                children = PyMem_Realloc(children, children_capacity*sizeof(void *));
-                if (!children) {
-                    PyErr_Format(PyExc_MemoryError, "realloc None");
-                    return NULL;
+            children[n++] = elem;
+            mark = p->mark;
+            while (
+                (literal = expect_token(p, 12))
+                &&
+                (elem = kvpair_rule(p))
+            )
+            {
+                if (n == children_capacity) {
+                    children_capacity *= 2;
+                    children = PyMem_Realloc(children, children_capacity*sizeof(void *));
+                    if (!children) {
+                        PyErr_Format(PyExc_MemoryError, "realloc _gather_87");
+                        return NULL;
+                    }
                 }
+                children[n++] = elem;
+                mark = p->mark;
             }
-            children[n++] = res;
-            mark = p->mark;
         }
         p->mark = mark;
     }
+    if (n == 0) {
+        PyMem_Free(children);
+        return NULL;
+    }
     asdl_seq *seq = _Py_asdl_seq_new(n, p->arena);
     if (!seq) {
-        PyErr_Format(PyExc_MemoryError, "asdl_seq_new _loop0_101");
+        PyErr_Format(PyExc_MemoryError, "asdl_seq_new _gather_87");
         return NULL;
     }
     for (int i = 0; i < n; i++) asdl_seq_SET(seq, i, children[i]);
     PyMem_Free(children);
-    insert_memo(p, mark, _loop0_101_type, seq);
     return seq;
 }
 
-// _gather_100: kvpair _loop0_101
-static asdl_seq *
-_gather_100_rule(Parser *p)
-{
-    asdl_seq * res = NULL;
-    int mark = p->mark;
-    { // kvpair _loop0_101
-        KeyValuePair* elem;
-        asdl_seq * seq;
-        if (
-            (elem = kvpair_rule(p))
-            &&
-            (seq = _loop0_101_rule(p))
-        )
-        {
-            res = seq_insert_in_front(p, elem, seq);
-            goto done;
-        }
-        p->mark = mark;
-    }
-    res = NULL;
-  done:
-    return res;
-}
-
-// _loop1_102: (ASYNC? 'for' star_targets 'in' disjunction (('if' disjunction))*)
+// _loop1_88: (ASYNC? 'for' star_targets 'in' disjunction (('if' disjunction))*)
 static asdl_seq *
-_loop1_102_rule(Parser *p)
+_loop1_88_rule(Parser *p)
 {
     void *res = NULL;
     int mark = p->mark;
@@ -12205,12 +13743,12 @@ _loop1_102_rule(Parser *p)
     ssize_t children_capacity = 1;
     ssize_t n = 0;
     { // (ASYNC? 'for' star_targets 'in' disjunction (('if' disjunction))*)
-        void *_tmp_123_var;
+        void *_tmp_103_var;
         while (
-            (_tmp_123_var = _tmp_123_rule(p))
+            (_tmp_103_var = _tmp_103_rule(p))
         )
         {
-            res = _tmp_123_var;
+            res = _tmp_103_var;
             if (n == children_capacity) {
                 children_capacity *= 2;
                 children = PyMem_Realloc(children, children_capacity*sizeof(void *));
@@ -12230,18 +13768,17 @@ _loop1_102_rule(Parser *p)
     }
     asdl_seq *seq = _Py_asdl_seq_new(n, p->arena);
     if (!seq) {
-        PyErr_Format(PyExc_MemoryError, "asdl_seq_new _loop1_102");
+        PyErr_Format(PyExc_MemoryError, "asdl_seq_new _loop1_88");
         return NULL;
     }
     for (int i = 0; i < n; i++) asdl_seq_SET(seq, i, children[i]);
     PyMem_Free(children);
-    insert_memo(p, mark, _loop1_102_type, seq);
     return seq;
 }
 
-// _tmp_103: ',' args
+// _tmp_89: ',' args
 static void *
-_tmp_103_rule(Parser *p)
+_tmp_89_rule(Parser *p)
 {
     void * res = NULL;
     int mark = p->mark;
@@ -12254,9 +13791,14 @@ _tmp_103_rule(Parser *p)
             (c = args_rule(p))
         )
         {
-            res = c;
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
+            }
+            else {
+                res = c;
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -12267,9 +13809,9 @@ _tmp_103_rule(Parser *p)
     return res;
 }
 
-// _tmp_104: ',' args
+// _tmp_90: ',' args
 static void *
-_tmp_104_rule(Parser *p)
+_tmp_90_rule(Parser *p)
 {
     void * res = NULL;
     int mark = p->mark;
@@ -12282,9 +13824,14 @@ _tmp_104_rule(Parser *p)
             (c = args_rule(p))
         )
         {
-            res = c;
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
+            }
+            else {
+                res = c;
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -12295,11 +13842,10 @@ _tmp_104_rule(Parser *p)
     return res;
 }
 
-// _loop0_106: ',' kwarg
+// _gather_91: ','.kwarg+
 static asdl_seq *
-_loop0_106_rule(Parser *p)
+_gather_91_rule(Parser *p)
 {
-    void *res = NULL;
     int mark = p->mark;
     void **children = PyMem_Malloc(sizeof(void *));
     if (!children) {
@@ -12308,71 +13854,52 @@ _loop0_106_rule(Parser *p)
     }
     ssize_t children_capacity = 1;
     ssize_t n = 0;
-    { // ',' kwarg
+    { // ','.kwarg+
         KeywordOrStarred* elem;
         void *literal;
-        while (
-            (literal = expect_token(p, 12))
-            &&
+        if (
             (elem = kwarg_rule(p))
         )
         {
-            res = elem;
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
-            }
-            if (n == children_capacity) {
-                children_capacity *= 2;
-                children = PyMem_Realloc(children, children_capacity*sizeof(void *));
-                if (!children) {
-                    PyErr_Format(PyExc_MemoryError, "realloc None");
-                    return NULL;
+            children[n++] = elem;
+            mark = p->mark;
+            while (
+                (literal = expect_token(p, 12))
+                &&
+                (elem = kwarg_rule(p))
+            )
+            {
+                if (n == children_capacity) {
+                    children_capacity *= 2;
+                    children = PyMem_Realloc(children, children_capacity*sizeof(void *));
+                    if (!children) {
+                        PyErr_Format(PyExc_MemoryError, "realloc _gather_91");
+                        return NULL;
+                    }
                 }
+                children[n++] = elem;
+                mark = p->mark;
             }
-            children[n++] = res;
-            mark = p->mark;
         }
         p->mark = mark;
     }
+    if (n == 0) {
+        PyMem_Free(children);
+        return NULL;
+    }
     asdl_seq *seq = _Py_asdl_seq_new(n, p->arena);
     if (!seq) {
-        PyErr_Format(PyExc_MemoryError, "asdl_seq_new _loop0_106");
+        PyErr_Format(PyExc_MemoryError, "asdl_seq_new _gather_91");
         return NULL;
     }
     for (int i = 0; i < n; i++) asdl_seq_SET(seq, i, children[i]);
     PyMem_Free(children);
-    insert_memo(p, mark, _loop0_106_type, seq);
     return seq;
 }
 
-// _gather_105: kwarg _loop0_106
-static asdl_seq *
-_gather_105_rule(Parser *p)
-{
-    asdl_seq * res = NULL;
-    int mark = p->mark;
-    { // kwarg _loop0_106
-        KeywordOrStarred* elem;
-        asdl_seq * seq;
-        if (
-            (elem = kwarg_rule(p))
-            &&
-            (seq = _loop0_106_rule(p))
-        )
-        {
-            res = seq_insert_in_front(p, elem, seq);
-            goto done;
-        }
-        p->mark = mark;
-    }
-    res = NULL;
-  done:
-    return res;
-}
-
-// _loop0_107: (',' star_target)
+// _loop0_92: (',' star_target)
 static asdl_seq *
-_loop0_107_rule(Parser *p)
+_loop0_92_rule(Parser *p)
 {
     void *res = NULL;
     int mark = p->mark;
@@ -12384,12 +13911,12 @@ _loop0_107_rule(Parser *p)
     ssize_t children_capacity = 1;
     ssize_t n = 0;
     { // (',' star_target)
-        void *_tmp_124_var;
+        void *_tmp_104_var;
         while (
-            (_tmp_124_var = _tmp_124_rule(p))
+            (_tmp_104_var = _tmp_104_rule(p))
         )
         {
-            res = _tmp_124_var;
+            res = _tmp_104_var;
             if (n == children_capacity) {
                 children_capacity *= 2;
                 children = PyMem_Realloc(children, children_capacity*sizeof(void *));
@@ -12405,20 +13932,18 @@ _loop0_107_rule(Parser *p)
     }
     asdl_seq *seq = _Py_asdl_seq_new(n, p->arena);
     if (!seq) {
-        PyErr_Format(PyExc_MemoryError, "asdl_seq_new _loop0_107");
+        PyErr_Format(PyExc_MemoryError, "asdl_seq_new _loop0_92");
         return NULL;
     }
     for (int i = 0; i < n; i++) asdl_seq_SET(seq, i, children[i]);
     PyMem_Free(children);
-    insert_memo(p, mark, _loop0_107_type, seq);
     return seq;
 }
 
-// _loop0_109: ',' star_target
+// _gather_93: ','.star_target+
 static asdl_seq *
-_loop0_109_rule(Parser *p)
+_gather_93_rule(Parser *p)
 {
-    void *res = NULL;
     int mark = p->mark;
     void **children = PyMem_Malloc(sizeof(void *));
     if (!children) {
@@ -12427,73 +13952,53 @@ _loop0_109_rule(Parser *p)
     }
     ssize_t children_capacity = 1;
     ssize_t n = 0;
-    { // ',' star_target
+    { // ','.star_target+
         expr_ty elem;
         void *literal;
-        while (
-            (literal = expect_token(p, 12))
-            &&
+        if (
             (elem = star_target_rule(p))
         )
         {
-            res = elem;
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
-            }
-            if (n == children_capacity) {
-                children_capacity *= 2;
-                children = PyMem_Realloc(children, children_capacity*sizeof(void *));
-                if (!children) {
-                    PyErr_Format(PyExc_MemoryError, "realloc None");
-                    return NULL;
+            children[n++] = elem;
+            mark = p->mark;
+            while (
+                (literal = expect_token(p, 12))
+                &&
+                (elem = star_target_rule(p))
+            )
+            {
+                if (n == children_capacity) {
+                    children_capacity *= 2;
+                    children = PyMem_Realloc(children, children_capacity*sizeof(void *));
+                    if (!children) {
+                        PyErr_Format(PyExc_MemoryError, "realloc _gather_93");
+                        return NULL;
+                    }
                 }
+                children[n++] = elem;
+                mark = p->mark;
             }
-            children[n++] = res;
-            mark = p->mark;
         }
         p->mark = mark;
     }
+    if (n == 0) {
+        PyMem_Free(children);
+        return NULL;
+    }
     asdl_seq *seq = _Py_asdl_seq_new(n, p->arena);
     if (!seq) {
-        PyErr_Format(PyExc_MemoryError, "asdl_seq_new _loop0_109");
+        PyErr_Format(PyExc_MemoryError, "asdl_seq_new _gather_93");
         return NULL;
     }
     for (int i = 0; i < n; i++) asdl_seq_SET(seq, i, children[i]);
     PyMem_Free(children);
-    insert_memo(p, mark, _loop0_109_type, seq);
     return seq;
 }
 
-// _gather_108: star_target _loop0_109
-static asdl_seq *
-_gather_108_rule(Parser *p)
-{
-    asdl_seq * res = NULL;
-    int mark = p->mark;
-    { // star_target _loop0_109
-        expr_ty elem;
-        asdl_seq * seq;
-        if (
-            (elem = star_target_rule(p))
-            &&
-            (seq = _loop0_109_rule(p))
-        )
-        {
-            res = seq_insert_in_front(p, elem, seq);
-            goto done;
-        }
-        p->mark = mark;
-    }
-    res = NULL;
-  done:
-    return res;
-}
-
-// _loop0_111: ',' del_target
+// _gather_94: ','.del_target+
 static asdl_seq *
-_loop0_111_rule(Parser *p)
+_gather_94_rule(Parser *p)
 {
-    void *res = NULL;
     int mark = p->mark;
     void **children = PyMem_Malloc(sizeof(void *));
     if (!children) {
@@ -12502,73 +14007,53 @@ _loop0_111_rule(Parser *p)
     }
     ssize_t children_capacity = 1;
     ssize_t n = 0;
-    { // ',' del_target
+    { // ','.del_target+
         expr_ty elem;
         void *literal;
-        while (
-            (literal = expect_token(p, 12))
-            &&
+        if (
             (elem = del_target_rule(p))
         )
         {
-            res = elem;
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
-            }
-            if (n == children_capacity) {
-                children_capacity *= 2;
-                children = PyMem_Realloc(children, children_capacity*sizeof(void *));
-                if (!children) {
-                    PyErr_Format(PyExc_MemoryError, "realloc None");
-                    return NULL;
+            children[n++] = elem;
+            mark = p->mark;
+            while (
+                (literal = expect_token(p, 12))
+                &&
+                (elem = del_target_rule(p))
+            )
+            {
+                if (n == children_capacity) {
+                    children_capacity *= 2;
+                    children = PyMem_Realloc(children, children_capacity*sizeof(void *));
+                    if (!children) {
+                        PyErr_Format(PyExc_MemoryError, "realloc _gather_94");
+                        return NULL;
+                    }
                 }
+                children[n++] = elem;
+                mark = p->mark;
             }
-            children[n++] = res;
-            mark = p->mark;
         }
         p->mark = mark;
     }
+    if (n == 0) {
+        PyMem_Free(children);
+        return NULL;
+    }
     asdl_seq *seq = _Py_asdl_seq_new(n, p->arena);
     if (!seq) {
-        PyErr_Format(PyExc_MemoryError, "asdl_seq_new _loop0_111");
+        PyErr_Format(PyExc_MemoryError, "asdl_seq_new _gather_94");
         return NULL;
     }
     for (int i = 0; i < n; i++) asdl_seq_SET(seq, i, children[i]);
     PyMem_Free(children);
-    insert_memo(p, mark, _loop0_111_type, seq);
     return seq;
 }
 
-// _gather_110: del_target _loop0_111
-static asdl_seq *
-_gather_110_rule(Parser *p)
-{
-    asdl_seq * res = NULL;
-    int mark = p->mark;
-    { // del_target _loop0_111
-        expr_ty elem;
-        asdl_seq * seq;
-        if (
-            (elem = del_target_rule(p))
-            &&
-            (seq = _loop0_111_rule(p))
-        )
-        {
-            res = seq_insert_in_front(p, elem, seq);
-            goto done;
-        }
-        p->mark = mark;
-    }
-    res = NULL;
-  done:
-    return res;
-}
-
-// _loop0_113: ',' target
+// _gather_95: ','.target+
 static asdl_seq *
-_loop0_113_rule(Parser *p)
+_gather_95_rule(Parser *p)
 {
-    void *res = NULL;
     int mark = p->mark;
     void **children = PyMem_Malloc(sizeof(void *));
     if (!children) {
@@ -12577,71 +14062,52 @@ _loop0_113_rule(Parser *p)
     }
     ssize_t children_capacity = 1;
     ssize_t n = 0;
-    { // ',' target
+    { // ','.target+
         expr_ty elem;
         void *literal;
-        while (
-            (literal = expect_token(p, 12))
-            &&
+        if (
             (elem = target_rule(p))
         )
         {
-            res = elem;
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
-            }
-            if (n == children_capacity) {
-                children_capacity *= 2;
-                children = PyMem_Realloc(children, children_capacity*sizeof(void *));
-                if (!children) {
-                    PyErr_Format(PyExc_MemoryError, "realloc None");
-                    return NULL;
+            children[n++] = elem;
+            mark = p->mark;
+            while (
+                (literal = expect_token(p, 12))
+                &&
+                (elem = target_rule(p))
+            )
+            {
+                if (n == children_capacity) {
+                    children_capacity *= 2;
+                    children = PyMem_Realloc(children, children_capacity*sizeof(void *));
+                    if (!children) {
+                        PyErr_Format(PyExc_MemoryError, "realloc _gather_95");
+                        return NULL;
+                    }
                 }
+                children[n++] = elem;
+                mark = p->mark;
             }
-            children[n++] = res;
-            mark = p->mark;
         }
         p->mark = mark;
     }
+    if (n == 0) {
+        PyMem_Free(children);
+        return NULL;
+    }
     asdl_seq *seq = _Py_asdl_seq_new(n, p->arena);
     if (!seq) {
-        PyErr_Format(PyExc_MemoryError, "asdl_seq_new _loop0_113");
+        PyErr_Format(PyExc_MemoryError, "asdl_seq_new _gather_95");
         return NULL;
     }
     for (int i = 0; i < n; i++) asdl_seq_SET(seq, i, children[i]);
     PyMem_Free(children);
-    insert_memo(p, mark, _loop0_113_type, seq);
     return seq;
 }
 
-// _gather_112: target _loop0_113
-static asdl_seq *
-_gather_112_rule(Parser *p)
-{
-    asdl_seq * res = NULL;
-    int mark = p->mark;
-    { // target _loop0_113
-        expr_ty elem;
-        asdl_seq * seq;
-        if (
-            (elem = target_rule(p))
-            &&
-            (seq = _loop0_113_rule(p))
-        )
-        {
-            res = seq_insert_in_front(p, elem, seq);
-            goto done;
-        }
-        p->mark = mark;
-    }
-    res = NULL;
-  done:
-    return res;
-}
-
-// _tmp_114: star_targets '='
+// _tmp_96: star_targets '='
 static void *
-_tmp_114_rule(Parser *p)
+_tmp_96_rule(Parser *p)
 {
     void * res = NULL;
     int mark = p->mark;
@@ -12654,9 +14120,14 @@ _tmp_114_rule(Parser *p)
             (literal = expect_token(p, 22))
         )
         {
-            res = z;
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
+            }
+            else {
+                res = z;
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -12667,9 +14138,9 @@ _tmp_114_rule(Parser *p)
     return res;
 }
 
-// _tmp_115: '.' | '...'
+// _tmp_97: '.' | '...'
 static void *
-_tmp_115_rule(Parser *p)
+_tmp_97_rule(Parser *p)
 {
     void * res = NULL;
     int mark = p->mark;
@@ -12700,9 +14171,9 @@ _tmp_115_rule(Parser *p)
     return res;
 }
 
-// _tmp_116: '.' | '...'
+// _tmp_98: '.' | '...'
 static void *
-_tmp_116_rule(Parser *p)
+_tmp_98_rule(Parser *p)
 {
     void * res = NULL;
     int mark = p->mark;
@@ -12733,33 +14204,9 @@ _tmp_116_rule(Parser *p)
     return res;
 }
 
-// _tmp_117: plain_name !'='
-static void *
-_tmp_117_rule(Parser *p)
-{
-    void * res = NULL;
-    int mark = p->mark;
-    { // plain_name !'='
-        arg_ty plain_name_var;
-        if (
-            (plain_name_var = plain_name_rule(p))
-            &&
-            lookahead_with_int(0, expect_token, p, 22)
-        )
-        {
-            res = plain_name_var;
-            goto done;
-        }
-        p->mark = mark;
-    }
-    res = NULL;
-  done:
-    return res;
-}
-
-// _tmp_118: '@' factor NEWLINE
+// _tmp_99: '@' factor NEWLINE
 static void *
-_tmp_118_rule(Parser *p)
+_tmp_99_rule(Parser *p)
 {
     void * res = NULL;
     int mark = p->mark;
@@ -12775,9 +14222,14 @@ _tmp_118_rule(Parser *p)
             (newline_var = newline_token(p))
         )
         {
-            res = f;
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
+            }
+            else {
+                res = f;
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -12788,9 +14240,9 @@ _tmp_118_rule(Parser *p)
     return res;
 }
 
-// _tmp_119: ',' star_expression
+// _tmp_100: ',' star_expression
 static void *
-_tmp_119_rule(Parser *p)
+_tmp_100_rule(Parser *p)
 {
     void * res = NULL;
     int mark = p->mark;
@@ -12803,9 +14255,14 @@ _tmp_119_rule(Parser *p)
             (c = star_expression_rule(p))
         )
         {
-            res = c;
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
+            }
+            else {
+                res = c;
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -12816,33 +14273,9 @@ _tmp_119_rule(Parser *p)
     return res;
 }
 
-// _tmp_120: lambda_plain_name !'='
-static void *
-_tmp_120_rule(Parser *p)
-{
-    void * res = NULL;
-    int mark = p->mark;
-    { // lambda_plain_name !'='
-        arg_ty lambda_plain_name_var;
-        if (
-            (lambda_plain_name_var = lambda_plain_name_rule(p))
-            &&
-            lookahead_with_int(0, expect_token, p, 22)
-        )
-        {
-            res = lambda_plain_name_var;
-            goto done;
-        }
-        p->mark = mark;
-    }
-    res = NULL;
-  done:
-    return res;
-}
-
-// _tmp_121: 'or' conjunction
+// _tmp_101: 'or' conjunction
 static void *
-_tmp_121_rule(Parser *p)
+_tmp_101_rule(Parser *p)
 {
     void * res = NULL;
     int mark = p->mark;
@@ -12855,9 +14288,14 @@ _tmp_121_rule(Parser *p)
             (c = conjunction_rule(p))
         )
         {
-            res = c;
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
+            }
+            else {
+                res = c;
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -12868,9 +14306,9 @@ _tmp_121_rule(Parser *p)
     return res;
 }
 
-// _tmp_122: 'and' inversion
+// _tmp_102: 'and' inversion
 static void *
-_tmp_122_rule(Parser *p)
+_tmp_102_rule(Parser *p)
 {
     void * res = NULL;
     int mark = p->mark;
@@ -12883,9 +14321,14 @@ _tmp_122_rule(Parser *p)
             (c = inversion_rule(p))
         )
         {
-            res = c;
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
+            }
+            else {
+                res = c;
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -12896,9 +14339,9 @@ _tmp_122_rule(Parser *p)
     return res;
 }
 
-// _tmp_123: ASYNC? 'for' star_targets 'in' disjunction (('if' disjunction))*
+// _tmp_103: ASYNC? 'for' star_targets 'in' disjunction (('if' disjunction))*
 static void *
-_tmp_123_rule(Parser *p)
+_tmp_103_rule(Parser *p)
 {
     void * res = NULL;
     int mark = p->mark;
@@ -12920,12 +14363,17 @@ _tmp_123_rule(Parser *p)
             &&
             (b = disjunction_rule(p))
             &&
-            (c = _loop0_125_rule(p))
+            (c = _loop0_105_rule(p))
         )
         {
-            res = _Py_comprehension ( a , b , c , ( y == NULL ) ? 0 : 1 , p -> arena );
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
+            }
+            else {
+                res = _Py_comprehension ( a , b , c , ( y == NULL ) ? 0 : 1 , p -> arena );
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -12936,9 +14384,9 @@ _tmp_123_rule(Parser *p)
     return res;
 }
 
-// _tmp_124: ',' star_target
+// _tmp_104: ',' star_target
 static void *
-_tmp_124_rule(Parser *p)
+_tmp_104_rule(Parser *p)
 {
     void * res = NULL;
     int mark = p->mark;
@@ -12951,9 +14399,14 @@ _tmp_124_rule(Parser *p)
             (c = star_target_rule(p))
         )
         {
-            res = c;
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
+            }
+            else {
+                res = c;
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -12964,9 +14417,9 @@ _tmp_124_rule(Parser *p)
     return res;
 }
 
-// _loop0_125: ('if' disjunction)
+// _loop0_105: ('if' disjunction)
 static asdl_seq *
-_loop0_125_rule(Parser *p)
+_loop0_105_rule(Parser *p)
 {
     void *res = NULL;
     int mark = p->mark;
@@ -12978,12 +14431,12 @@ _loop0_125_rule(Parser *p)
     ssize_t children_capacity = 1;
     ssize_t n = 0;
     { // ('if' disjunction)
-        void *_tmp_126_var;
+        void *_tmp_106_var;
         while (
-            (_tmp_126_var = _tmp_126_rule(p))
+            (_tmp_106_var = _tmp_106_rule(p))
         )
         {
-            res = _tmp_126_var;
+            res = _tmp_106_var;
             if (n == children_capacity) {
                 children_capacity *= 2;
                 children = PyMem_Realloc(children, children_capacity*sizeof(void *));
@@ -12999,18 +14452,17 @@ _loop0_125_rule(Parser *p)
     }
     asdl_seq *seq = _Py_asdl_seq_new(n, p->arena);
     if (!seq) {
-        PyErr_Format(PyExc_MemoryError, "asdl_seq_new _loop0_125");
+        PyErr_Format(PyExc_MemoryError, "asdl_seq_new _loop0_105");
         return NULL;
     }
     for (int i = 0; i < n; i++) asdl_seq_SET(seq, i, children[i]);
     PyMem_Free(children);
-    insert_memo(p, mark, _loop0_125_type, seq);
     return seq;
 }
 
-// _tmp_126: 'if' disjunction
+// _tmp_106: 'if' disjunction
 static void *
-_tmp_126_rule(Parser *p)
+_tmp_106_rule(Parser *p)
 {
     void * res = NULL;
     int mark = p->mark;
@@ -13023,9 +14475,14 @@ _tmp_126_rule(Parser *p)
             (z = disjunction_rule(p))
         )
         {
-            res = z;
-            if (res == NULL && PyErr_Occurred()) {
-                longjmp(p->error_env, 1);
+            if (p->skip_actions) {
+                res = CONSTRUCTOR(p);
+            }
+            else {
+                res = z;
+                if (res == NULL && PyErr_Occurred()) {
+                    longjmp(p->error_env, 1);
+                }
             }
             goto done;
         }
@@ -13042,6 +14499,11 @@ parse(Parser *p)
     // Initialize keywords
     p->keywords = reserved_keywords;
     p->n_keyword_lists = n_keyword_lists;
+    p->classify_keyword = classify_keyword;
+
+    // Initialize memo
+    p->memo_backend = memo_backend;
+    p->n_memo_rules = n_memo_rules;
 
     // Run parser
     void *result = NULL;
@@ -13049,6 +14511,8 @@ parse(Parser *p)
         result = start_rule(p);
     } else if (p->start_rule_func == EXPRESSIONS) {
         result = expressions_rule(p);
+    } else if (p->start_rule_func == EVAL) {
+        result = eval_rule(p);
     }
 
     return result;
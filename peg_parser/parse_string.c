@@ -17,8 +17,11 @@ warn_invalid_escape_sequence(Parser *p, unsigned char first_invalid_escape_char)
     if (msg == NULL) {
         return -1;
     }
-    if (PyErr_WarnExplicitObject(PyExc_DeprecationWarning, msg, p->tok->filename,
-                                 p->tok->lineno, NULL, NULL) < 0) {
+    // The line the tokenizer is on.  It may be running ahead in a thread of its
+    // own, so this is the end of the last token that was filled.
+    int lineno = get_token(p, p->fill - 1)->end_lineno;
+    if (PyErr_WarnExplicitObject(PyExc_DeprecationWarning, msg, p->tok->filename, lineno,
+                                 NULL, NULL) < 0) {
         if (PyErr_ExceptionMatches(PyExc_DeprecationWarning)) {
             /* Replace the DeprecationWarning exception with a SyntaxError
                to get a more accurate error report */
@@ -480,18 +483,20 @@ static void fstring_shift_expr_locations(expr_ty n, int lineno, int col_offset)
    `expr_str` is the child node's string representation, including braces.
 */
 static void
-fstring_fix_expr_location(Token *parent, expr_ty n, char *expr_str)
+fstring_fix_expr_location(Parser *p, Token *parent, expr_ty n, char *expr_str)
 {
     char *substr = NULL;
     char *start;
     int lines = parent->lineno - 1;
     int cols = parent->col_offset;
 
-    if (parent && parent->bytes) {
-        char *parent_str = PyBytes_AsString(parent->bytes);
-        if (!parent_str) {
+    if (parent && TOKEN_LENGTH(parent) > 0) {
+        PyObject *parent_bytes = token_bytes(p, parent);
+        if (!parent_bytes) {
+            PyErr_Clear();
             return;
         }
+        char *parent_str = PyBytes_AS_STRING(parent_bytes);
         substr = strstr(parent_str, expr_str);
         if (substr) {
             // The following is needed, in order to correctly shift the column
@@ -524,6 +529,7 @@ fstring_fix_expr_location(Token *parent, expr_ty n, char *expr_str)
                 }
             }
         }
+        Py_DECREF(parent_bytes);
     }
     fstring_shift_expr_locations(n, lines, cols);
 }
@@ -598,7 +604,7 @@ fstring_compile_expr(Parser *p, const char *expr_start, const char *expr_end,
     /* Reuse str to find the correct column offset. */
     str[0] = '{';
     str[len+1] = '}';
-    fstring_fix_expr_location(t, expr, str);
+    fstring_fix_expr_location(p, t, expr, str);
 
     result = expr;
 
@@ -1197,8 +1203,7 @@ make_str_node_and_del(Parser *p, PyObject **str, Token* first_token, Token *last
         Py_DECREF(s);
         return NULL;
     }
-    const char* the_str = PyBytes_AsString(first_token->bytes);
-    if (the_str && the_str[0] == 'u') {
+    if (TOKEN_LENGTH(first_token) > 0 && TOKEN_TEXT(p, first_token)[0] == 'u') {
         kind = new_identifier(p, "u");
     }
 
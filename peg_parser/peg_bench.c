@@ -0,0 +1,586 @@
+// A benchmark of the parser that embeds the interpreter once and times
+// run_parser_from_file() or run_parser_from_string() directly, without the
+// extension module or interpreter startup in the numbers.  `make bench_parser`
+// builds it and runs it on data/*.txt.
+//
+//     peg_bench [-m MODE] [-w WARMUP] [-r REPEAT] [-s] [-t] [-c] FILE...
+//
+// MODE 0 only recognizes the input, 1 (the default) builds the AST.  Each file
+// is parsed WARMUP times (default 3), then timed over REPEAT runs (default
+// 20).  With -s the file is read into memory once and parsed as a string.
+// With -t the tokenizer runs ahead of the parser in a thread of its own, where
+// the input allows it; see fill_token().
+//
+// For each file it prints a line of JSON with the sizes of the input, the
+// minimum, median, mean and standard deviation of the run times in
+// nanoseconds, the rates derived from the median, the bytes left in the arena
+// by a parse and the peak of the bytes allocated during it, and the peak RSS
+// of the process so far.  The allocations are those made with PyMem_Malloc(),
+// which the benchmark counts by wrapping the allocator.
+//
+// With -c (on Linux only) it also counts the cycles, instructions, L1 data
+// cache and last level cache misses and branch mispredictions of the timed
+// runs with perf_event_open(), and adds them to the line under "counters",
+// each per parse, per token and per rule call, with the instructions per
+// cycle.  The counts are of user space only, which perf_event_paranoid up to
+// 2 allows, and are scaled up if the kernel had to multiplex the counters.  If
+// they cannot be opened or the kernel never ran them (as in virtual machines
+// without a PMU), "counters" and "ipc" are null.
+
+#include <Python.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/resource.h>
+#include <unistd.h>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#endif
+
+#include "pegen.h"
+
+// Each block carries its size in a header, keeping the alignment of malloc().
+#define ALLOC_HEADER 16
+
+static PyMemAllocatorEx base_allocator;
+static size_t live_bytes, peak_bytes;
+
+static void *
+_counted(void *block, size_t size)
+{
+    if (block == NULL) {
+        return NULL;
+    }
+    *(size_t *)block = size;
+    live_bytes += size;
+    if (live_bytes > peak_bytes) {
+        peak_bytes = live_bytes;
+    }
+    return (char *)block + ALLOC_HEADER;
+}
+
+static void *
+counting_malloc(void *ctx, size_t size)
+{
+    return _counted(base_allocator.malloc(base_allocator.ctx, size + ALLOC_HEADER), size);
+}
+
+static void *
+counting_calloc(void *ctx, size_t nelem, size_t elsize)
+{
+    if (elsize != 0 && nelem > (SIZE_MAX - ALLOC_HEADER) / elsize) {
+        return NULL;
+    }
+    size_t size = nelem * elsize;
+    return _counted(base_allocator.calloc(base_allocator.ctx, 1, size + ALLOC_HEADER), size);
+}
+
+static void *
+counting_realloc(void *ctx, void *ptr, size_t size)
+{
+    if (ptr == NULL) {
+        return counting_malloc(ctx, size);
+    }
+    char *block = (char *)ptr - ALLOC_HEADER;
+    size_t old_size = *(size_t *)block;
+    block = base_allocator.realloc(base_allocator.ctx, block, size + ALLOC_HEADER);
+    if (block == NULL) {
+        return NULL;
+    }
+    live_bytes -= old_size;
+    return _counted(block, size);
+}
+
+static void
+counting_free(void *ctx, void *ptr)
+{
+    if (ptr == NULL) {
+        return;
+    }
+    char *block = (char *)ptr - ALLOC_HEADER;
+    live_bytes -= *(size_t *)block;
+    base_allocator.free(base_allocator.ctx, block);
+}
+
+#ifdef __linux__
+typedef struct {
+    const char *name;
+    uint32_t type;
+    uint64_t config;
+} CounterEvent;
+
+#define L1D_READ_MISS                                                                  \
+    (PERF_COUNT_HW_CACHE_L1D | PERF_COUNT_HW_CACHE_OP_READ << 8 |                      \
+     PERF_COUNT_HW_CACHE_RESULT_MISS << 16)
+
+static const CounterEvent counter_events[] = {
+    {"cycles", PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+    {"instructions", PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+    {"l1d_misses", PERF_TYPE_HW_CACHE, L1D_READ_MISS},
+    {"llc_misses", PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES},
+    {"branch_misses", PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+};
+#define N_COUNTERS (int)(sizeof(counter_events) / sizeof(counter_events[0]))
+#else
+#define N_COUNTERS 0
+#endif
+
+// A group of hardware counters, read together.  fds[0] leads the group.
+typedef struct {
+    int fds[Py_MAX(N_COUNTERS, 1)];
+    double counts[Py_MAX(N_COUNTERS, 1)];
+    int ran;  // Whether the kernel ran them at all while they were enabled
+} Counters;
+
+#ifdef __linux__
+// Open the counters, disabled.  Returns -1 and prints why if one cannot be
+// opened, and then c->fds[0] is -1.
+static int
+counters_open(Counters *c)
+{
+    c->ran = 0;
+    for (int i = 0; i < N_COUNTERS; i++) {
+        struct perf_event_attr attr;
+        memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = counter_events[i].type;
+        attr.config = counter_events[i].config;
+        attr.disabled = i == 0;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED |
+                           PERF_FORMAT_TOTAL_TIME_RUNNING;
+        c->fds[i] = syscall(SYS_perf_event_open, &attr, 0, -1, i == 0 ? -1 : c->fds[0], 0);
+        if (c->fds[i] < 0) {
+            fprintf(stderr, "perf_event_open(%s): %s\n", counter_events[i].name,
+                    strerror(errno));
+            while (--i >= 0) {
+                close(c->fds[i]);
+            }
+            c->fds[0] = -1;
+            return -1;
+        }
+    }
+    return 0;
+}
+
+// Reset the counters to zero and start them.  Returns -1 with an exception set
+// on failure.
+static int
+counters_start(Counters *c)
+{
+    if (ioctl(c->fds[0], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP) < 0 ||
+        ioctl(c->fds[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP) < 0) {
+        PyErr_SetFromErrno(PyExc_OSError);
+        return -1;
+    }
+    return 0;
+}
+
+static int
+counters_disable(Counters *c)
+{
+    if (ioctl(c->fds[0], PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP) < 0) {
+        PyErr_SetFromErrno(PyExc_OSError);
+        return -1;
+    }
+    return 0;
+}
+
+// Stop the counters and store their counts in c->counts.  Returns -1 with an
+// exception set on failure.
+static int
+counters_stop(Counters *c)
+{
+    if (counters_disable(c) < 0) {
+        return -1;
+    }
+    // nr, time_enabled, time_running, then the values
+    uint64_t data[3 + N_COUNTERS];
+    if (read(c->fds[0], data, sizeof(data)) != (ssize_t)sizeof(data)) {
+        PyErr_SetFromErrno(PyExc_OSError);
+        return -1;
+    }
+    c->ran = data[2] > 0;
+    double scale = c->ran ? (double)data[1] / data[2] : 0;
+    for (int i = 0; i < N_COUNTERS; i++) {
+        c->counts[i] = data[3 + i] * scale;
+    }
+    return 0;
+}
+
+static void
+counters_close(Counters *c)
+{
+    if (c->fds[0] < 0) {
+        return;
+    }
+    for (int i = 0; i < N_COUNTERS; i++) {
+        close(c->fds[i]);
+    }
+}
+#endif
+
+typedef struct {
+    const char *filename;
+    PyObject *filename_ob;
+    char *text;  // The contents of the file, for -s
+    long size;
+    int skip_actions;
+    int from_string;
+    int pipeline;
+} Input;
+
+// Parse the input once.  Returns 0 on success and -1 with an exception set on
+// failure.  If arena_bytes is not NULL, store there the bytes that the parse
+// leaves in the arena.
+static int
+_parse(Input *in, PyObject **stats, size_t *arena_bytes)
+{
+    PyArena *arena = PyArena_New();
+    if (arena == NULL) {
+        return -1;
+    }
+    size_t start_bytes = live_bytes;
+    mod_ty res;
+    if (in->from_string) {
+        res = run_parser_from_string(in->text, in->size, START, in->filename_ob, arena,
+                                     in->skip_actions, stats, NULL, in->pipeline);
+    }
+    else {
+        res = run_parser_from_file(in->filename, START, in->filename_ob, arena,
+                                   in->skip_actions, stats, NULL, in->pipeline);
+    }
+    if (arena_bytes != NULL) {
+        *arena_bytes = live_bytes - start_bytes;
+    }
+    PyArena_Free(arena);
+    return res == NULL ? -1 : 0;
+}
+
+static char *
+_read_file(const char *filename, long *size)
+{
+    FILE *fp = fopen(filename, "rb");
+    if (fp == NULL) {
+        PyErr_SetFromErrnoWithFilename(PyExc_OSError, filename);
+        return NULL;
+    }
+    char *text = NULL;
+    if (fseek(fp, 0, SEEK_END) == 0 && (*size = ftell(fp)) >= 0 &&
+        fseek(fp, 0, SEEK_SET) == 0) {
+        text = PyMem_RawMalloc(*size + 1);
+        if (text == NULL) {
+            PyErr_NoMemory();
+        }
+        else if (fread(text, 1, *size, fp) != (size_t)*size) {
+            PyErr_SetFromErrnoWithFilename(PyExc_OSError, filename);
+            PyMem_RawFree(text);
+            text = NULL;
+        }
+        else {
+            text[*size] = '\0';
+        }
+    }
+    else {
+        PyErr_SetFromErrnoWithFilename(PyExc_OSError, filename);
+    }
+    fclose(fp);
+    return text;
+}
+
+static int
+_compare_times(const void *a, const void *b)
+{
+    _PyTime_t x = *(const _PyTime_t *)a, y = *(const _PyTime_t *)b;
+    return (x > y) - (x < y);
+}
+
+static long
+_peak_rss_bytes(void)
+{
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) < 0) {
+        return -1;
+    }
+#ifdef __APPLE__
+    return usage.ru_maxrss;
+#else
+    return usage.ru_maxrss * 1024L;
+#endif
+}
+
+// The number of rule calls, from the statistics of a parse, or -1 if the parser
+// was not generated to count them
+static long
+_rule_calls(PyObject *stats)
+{
+    PyObject *rules = PyDict_GetItemString(stats, "rules");
+    if (rules == NULL) {
+        return -1;
+    }
+    PyObject *name, *rule_stats;
+    Py_ssize_t pos = 0;
+    long calls = 0;
+    while (PyDict_Next(rules, &pos, &name, &rule_stats)) {
+        calls += PyLong_AsLong(PyDict_GetItemString(rule_stats, "calls"));
+    }
+    return calls;
+}
+
+// Print s as a JSON string, escaping quotes, backslashes and control
+// characters.  Other bytes, such as those of UTF-8 sequences, are printed as
+// they are.
+static void
+_print_json_string(const char *s)
+{
+    putchar('"');
+    for (; *s != '\0'; s++) {
+        unsigned char c = *s;
+        if (c == '"' || c == '\\') {
+            printf("\\%c", c);
+        }
+        else if (c < 0x20) {
+            printf("\\u%04x", c);
+        }
+        else {
+            putchar(c);
+        }
+    }
+    putchar('"');
+}
+
+static int
+bench_file(const char *filename, int mode, int warmup, int repeat, int from_string,
+           int pipeline, Counters *counters)
+{
+    Input in = {filename, NULL, NULL, 0, mode == 0, from_string, pipeline};
+    _PyTime_t *times = NULL;
+    PyObject *stats = NULL;
+    int counting = 0;
+    int ret = -1;
+
+    long size;
+    char *text = _read_file(filename, &size);
+    if (text == NULL) {
+        return -1;
+    }
+    long lines = 0;
+    for (long i = 0; i < size; i++) {
+        lines += text[i] == '\n';
+    }
+    if (size > 0 && text[size - 1] != '\n') {
+        lines++;
+    }
+    if (from_string) {
+        in.text = text;
+        in.size = size;
+    }
+
+    in.filename_ob = PyUnicode_FromString(filename);
+    times = PyMem_RawMalloc(repeat * sizeof(_PyTime_t));
+    if (in.filename_ob == NULL || times == NULL) {
+        goto error;
+    }
+
+    for (int i = 0; i < warmup; i++) {
+        if (_parse(&in, NULL, NULL) < 0) {
+            goto error;
+        }
+    }
+#ifdef __linux__
+    if (counters != NULL && counters->fds[0] >= 0) {
+        if (counters_start(counters) < 0) {
+            goto error;
+        }
+        counting = 1;
+    }
+#endif
+    for (int i = 0; i < repeat; i++) {
+        _PyTime_t start = _PyTime_GetPerfCounter();
+        if (_parse(&in, NULL, NULL) < 0) {
+            goto error;
+        }
+        times[i] = _PyTime_GetPerfCounter() - start;
+    }
+#ifdef __linux__
+    if (counting) {
+        if (counters_stop(counters) < 0) {
+            goto error;
+        }
+        counting = 0;
+    }
+#endif
+
+    // One more parse, untimed, to count the tokens and the memory
+    size_t arena_bytes;
+    peak_bytes = live_bytes;
+    size_t start_bytes = live_bytes;
+    if (_parse(&in, &stats, &arena_bytes) < 0) {
+        goto error;
+    }
+    size_t peak_alloc_bytes = peak_bytes - start_bytes;
+    long tokens = PyLong_AsLong(PyDict_GetItemString(stats, "tokens"));
+
+    qsort(times, repeat, sizeof(_PyTime_t), _compare_times);
+    double mean = 0, variance = 0;
+    for (int i = 0; i < repeat; i++) {
+        mean += (double)times[i] / repeat;
+    }
+    for (int i = 0; i < repeat; i++) {
+        variance += (times[i] - mean) * (times[i] - mean) / Py_MAX(repeat - 1, 1);
+    }
+    double median = repeat % 2 ? times[repeat / 2]
+                               : (times[repeat / 2 - 1] + times[repeat / 2]) / 2.0;
+
+    printf("{\"file\": ");
+    _print_json_string(filename);
+    printf(", \"input\": \"%s\", \"mode\": %d, \"bytes\": %ld, "
+           "\"lines\": %ld, \"tokens\": %ld, \"runs\": %d, \"min_ns\": %lld, "
+           "\"median_ns\": %.0f, \"mean_ns\": %.0f, \"stdev_ns\": %.0f, "
+           "\"tokens_per_sec\": %.0f, \"lines_per_sec\": %.0f, \"ns_per_token\": %.1f, "
+           "\"arena_bytes\": %zu, \"peak_alloc_bytes\": %zu, \"peak_rss_bytes\": %ld",
+           from_string ? "string" : "file", mode, size, lines, tokens, repeat,
+           (long long)times[0], median, mean, sqrt(variance), tokens * 1e9 / median,
+           lines * 1e9 / median, median / Py_MAX(tokens, 1), arena_bytes, peak_alloc_bytes,
+           _peak_rss_bytes());
+#ifdef __linux__
+    long calls = counters != NULL ? _rule_calls(stats) : -1;
+    if (counters != NULL && calls < 0) {
+        printf(", \"rule_calls\": null");
+    }
+    else if (counters != NULL) {
+        printf(", \"rule_calls\": %ld", calls);
+    }
+    if (counters != NULL && !counters->ran) {
+        printf(", \"counters\": null, \"ipc\": null");
+    }
+    else if (counters != NULL) {
+        printf(", \"counters\": {");
+        for (int i = 0; i < N_COUNTERS; i++) {
+            double per_parse = counters->counts[i] / repeat;
+            printf("%s\"%s\": {\"per_parse\": %.0f, \"per_token\": %.2f, \"per_call\": ",
+                   i > 0 ? ", " : "", counter_events[i].name, per_parse,
+                   per_parse / Py_MAX(tokens, 1));
+            if (calls < 0) {
+                printf("null}");
+            }
+            else {
+                printf("%.3f}", per_parse / Py_MAX(calls, 1));
+            }
+        }
+        printf("}, \"ipc\": %.3f", counters->counts[1] / Py_MAX(counters->counts[0], 1));
+    }
+#endif
+    printf("}\n");
+    fflush(stdout);
+    ret = 0;
+
+error:
+#ifdef __linux__
+    if (counting) {
+        // Stop counting, but report why the parse failed
+        PyObject *type, *value, *traceback;
+        PyErr_Fetch(&type, &value, &traceback);
+        if (counters_disable(counters) < 0) {
+            PyErr_Clear();
+        }
+        PyErr_Restore(type, value, traceback);
+    }
+#endif
+    Py_XDECREF(stats);
+    Py_XDECREF(in.filename_ob);
+    PyMem_RawFree(times);
+    PyMem_RawFree(text);
+    return ret;
+}
+
+static void
+usage(const char *prog)
+{
+    fprintf(stderr, "usage: %s [-m MODE] [-w WARMUP] [-r REPEAT] [-s] [-t] [-c] FILE...\n",
+            prog);
+    exit(2);
+}
+
+int
+main(int argc, char **argv)
+{
+    int mode = 1, warmup = 3, repeat = 20, from_string = 0, pipeline = 0, use_counters = 0;
+    int opt;
+    while ((opt = getopt(argc, argv, "m:w:r:stc")) != -1) {
+        switch (opt) {
+            case 'm':
+                mode = atoi(optarg);
+                break;
+            case 'w':
+                warmup = atoi(optarg);
+                break;
+            case 'r':
+                repeat = atoi(optarg);
+                break;
+            case 's':
+                from_string = 1;
+                break;
+            case 't':
+                pipeline = 1;
+                break;
+            case 'c':
+                use_counters = 1;
+                break;
+            default:
+                usage(argv[0]);
+        }
+    }
+    if (optind == argc || mode < 0 || mode > 1 || warmup < 0 || repeat < 1) {
+        usage(argv[0]);
+    }
+
+    Counters *counters_p = NULL;
+#ifdef __linux__
+    Counters counters;
+#endif
+    if (use_counters) {
+#ifdef __linux__
+        if (counters_open(&counters) < 0) {
+            fprintf(stderr, "%s: the counters are unavailable\n", argv[0]);
+        }
+        counters_p = &counters;
+#else
+        fprintf(stderr, "%s: -c needs perf_event_open(), which only Linux has\n", argv[0]);
+        return 2;
+#endif
+    }
+
+    // The allocator has to be wrapped before Python allocates anything with it
+    PyPreConfig preconfig;
+    PyPreConfig_InitPythonConfig(&preconfig);
+    PyStatus status = Py_PreInitialize(&preconfig);
+    if (PyStatus_Exception(status)) {
+        Py_ExitStatusException(status);
+    }
+    PyMemAllocatorEx counting_allocator = {
+        NULL, counting_malloc, counting_calloc, counting_realloc, counting_free};
+    PyMem_GetAllocator(PYMEM_DOMAIN_MEM, &base_allocator);
+    PyMem_SetAllocator(PYMEM_DOMAIN_MEM, &counting_allocator);
+    Py_Initialize();
+
+    int ret = 0;
+    for (int i = optind; i < argc; i++) {
+        if (bench_file(argv[i], mode, warmup, repeat, from_string, pipeline, counters_p) < 0) {
+            PyErr_Print();
+            ret = 1;
+        }
+    }
+#ifdef __linux__
+    if (counters_p != NULL) {
+        counters_close(counters_p);
+    }
+#endif
+    if (Py_FinalizeEx() < 0) {
+        ret = 1;
+    }
+    return ret;
+}
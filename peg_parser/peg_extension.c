@@ -18,10 +18,14 @@ _build_return_object(mod_ty module, int mode, PyObject *filename_ob, PyArena *ar
 static PyObject *
 parse_file(PyObject *self, PyObject *args, PyObject *kwds)
 {
-    static char *keywords[] = {"file", "mode", NULL};
+    static char *keywords[] = {"file", "mode", "stats", "trace", "pipeline", NULL};
     const char *filename;
     int mode = 1;
-    if (!PyArg_ParseTupleAndKeywords(args, kwds, "s|i", keywords, &filename, &mode)) {
+    int stats = 0;
+    const char *trace = NULL;
+    int pipeline = 0;
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "s|ipzp", keywords, &filename, &mode,
+                                     &stats, &trace, &pipeline)) {
         return NULL;
     }
     if (mode < 0 || mode > 2) {
@@ -34,34 +38,35 @@ parse_file(PyObject *self, PyObject *args, PyObject *kwds)
     }
 
     PyObject *result = NULL;
+    PyObject *stats_dict = NULL;
 
     PyObject *filename_ob = PyUnicode_FromString(filename);
     if (filename_ob == NULL) {
         goto error;
     }
 
-    mod_ty res = run_parser_from_file(filename, START, filename_ob, arena);
+    mod_ty res = run_parser_from_file(filename, START, filename_ob, arena, mode == 0,
+                                     stats ? &stats_dict : NULL, trace, pipeline);
     if (res == NULL) {
         goto error;
     }
 
     result = _build_return_object(res, mode, filename_ob, arena);
+    if (result != NULL && stats) {
+        result = Py_BuildValue("(NO)", result, stats_dict);
+    }
 
 error:
+    Py_XDECREF(stats_dict);
     Py_XDECREF(filename_ob);
     PyArena_Free(arena);
     return result;
 }
 
 static PyObject *
-parse_string(PyObject *self, PyObject *args, PyObject *kwds)
+_parse_string(const char *the_string, Py_ssize_t length, int mode, int stats,
+              const char *trace, int pipeline)
 {
-    static char *keywords[] = {"str", "mode", NULL};
-    const char *the_string;
-    int mode = 1;
-    if (!PyArg_ParseTupleAndKeywords(args, kwds, "s|i", keywords, &the_string, &mode)) {
-        return NULL;
-    }
     if (mode < 0 || mode > 2) {
         return PyErr_Format(PyExc_ValueError, "Bad mode, must be 0 <= mode <= 2");
     }
@@ -72,66 +77,352 @@ parse_string(PyObject *self, PyObject *args, PyObject *kwds)
     }
 
     PyObject *result = NULL;
+    PyObject *stats_dict = NULL;
 
     PyObject *filename_ob = PyUnicode_FromString("<string>");
     if (filename_ob == NULL) {
         goto error;
     }
 
-    mod_ty res = run_parser_from_string(the_string, START, filename_ob, arena);
+    mod_ty res = run_parser_from_string(the_string, length, START, filename_ob, arena,
+                                       mode == 0, stats ? &stats_dict : NULL, trace, pipeline);
     if (res == NULL) {
         goto error;
     }
     result = _build_return_object(res, mode, filename_ob, arena);
+    if (result != NULL && stats) {
+        result = Py_BuildValue("(NO)", result, stats_dict);
+    }
 
 error:
+    Py_XDECREF(stats_dict);
     Py_XDECREF(filename_ob);
     PyArena_Free(arena);
     return result;
 }
 
 static PyObject *
-clear_memo_stats()
+parse_string(PyObject *self, PyObject *args, PyObject *kwds)
 {
-    clear_memo_statistics();
-    Py_RETURN_NONE;
+    static char *keywords[] = {"str", "mode", "stats", "trace", "pipeline", NULL};
+    const char *the_string;
+    Py_ssize_t length;
+    int mode = 1;
+    int stats = 0;
+    const char *trace = NULL;
+    int pipeline = 0;
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "s#|ipzp", keywords, &the_string, &length,
+                                     &mode, &stats, &trace, &pipeline)) {
+        return NULL;
+    }
+    return _parse_string(the_string, length, mode, stats, trace, pipeline);
 }
 
+// Parse the UTF-8 source in any object with the buffer protocol, such as
+// bytes or an mmap, where it is, without a copy if it can be tokenized in
+// place.  The source must not change during the parse.
 static PyObject *
-get_memo_stats()
+parse_bytes(PyObject *self, PyObject *args, PyObject *kwds)
 {
-    return get_memo_statistics();
+    static char *keywords[] = {"data", "mode", "stats", "trace", "pipeline", NULL};
+    Py_buffer data;
+    int mode = 1;
+    int stats = 0;
+    const char *trace = NULL;
+    int pipeline = 0;
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "y*|ipzp", keywords, &data, &mode, &stats,
+                                     &trace, &pipeline)) {
+        return NULL;
+    }
+    PyObject *result = _parse_string(data.buf, data.len, mode, stats, trace, pipeline);
+    PyBuffer_Release(&data);
+    return result;
 }
 
-// TODO: Write to Python's sys.stdout instead of C's stdout.
+// The tokens of a string as a list of (type, start, end, lineno, col_offset,
+// end_lineno, end_col_offset, line) tuples, where start and end are the
+// offsets of the text of the token, or -1, and line that of the tokenizer's
+// buf, in the input after its newlines are translated.  The tokens are read
+// as the parser reads them (tokenizer=0), with the scanner of tokenizer.c
+// only, which raises ValueError where it gives up (1), or with CPython's
+// tokenizer only (2).
 static PyObject *
-dump_memo_stats()
+tokenize_string(PyObject *self, PyObject *args, PyObject *kwds)
 {
-    PyObject *list = get_memo_statistics();
-    if (list == NULL) {
+    static char *keywords[] = {"str", "tokenizer", NULL};
+    const char *the_string;
+    int which = 0;
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "s|i", keywords, &the_string, &which)) {
+        return NULL;
+    }
+    if (which < 0 || which > 2) {
+        return PyErr_Format(PyExc_ValueError, "Bad tokenizer, must be 0 <= tokenizer <= 2");
+    }
+
+    // CPython's tokenizer only, also for the translation of the input
+    char *copy = NULL;
+    struct tok_state *tok = which == 2 ? PyTokenizer_FromString(the_string, 1)
+                                       : tok_from_string(the_string, strlen(the_string), &copy);
+    if (tok == NULL) {
+        PyMem_Free(copy);
         return NULL;
     }
-    Py_ssize_t len = PyList_Size(list);
-    for (Py_ssize_t i = 0; i < len; i++) {
-        PyObject *value = PyList_GetItem(list, i);  // Borrowed reference.
-        long count = PyLong_AsLong(value);
-        if (count < 0) {
+    PyObject *result = NULL;
+    Tokenizer *tokenizer = NULL;
+    tok->filename = PyUnicode_FromString("<string>");
+    if (tok->filename == NULL) {
+        goto error;
+    }
+    tokenizer = Tokenizer_New(tok, which != 2);
+    if (tokenizer == NULL) {
+        goto error;
+    }
+    result = PyList_New(0);
+    if (result == NULL) {
+        goto error;
+    }
+    const char *source = tok->buf;
+    for (;;) {
+        RawToken r;
+        if (which != 1) {
+            tokenizer_get(tokenizer, &r);
+        }
+        else if (tokenizer_scan(tokenizer, &r) < 0) {
+            PyErr_Format(PyExc_ValueError, "The scanner gave up at token %zd",
+                         PyList_GET_SIZE(result));
+            goto error;
+        }
+        if (r.type == ERRORTOKEN) {
+            if (!PyErr_Occurred()) {
+                PyErr_Format(PyExc_SyntaxError, "Tokenizer returned error token");
+                PyErr_SyntaxLocationObject(tok->filename, r.end_lineno, 0);
+            }
+            goto error;
+        }
+        PyObject *token = Py_BuildValue(
+            "(innnnnnn)", r.type, r.start != NULL ? r.start - source : -1,
+            r.end != NULL ? r.end - source : -1, (Py_ssize_t)r.lineno, (Py_ssize_t)r.col_offset,
+            (Py_ssize_t)r.end_lineno, (Py_ssize_t)r.end_col_offset, r.buf - source);
+        if (token == NULL || PyList_Append(result, token) < 0) {
+            Py_XDECREF(token);
+            goto error;
+        }
+        Py_DECREF(token);
+        if (r.type == ENDMARKER) {
             break;
         }
-        if (count > 0) {
-            printf("%4ld %9ld\n", i, count);
+    }
+    Tokenizer_Free(tokenizer);
+    PyTokenizer_Free(tok);
+    PyMem_Free(copy);
+    return result;
+
+error:
+    Py_XDECREF(result);
+    if (tokenizer != NULL) {
+        Tokenizer_Free(tokenizer);
+    }
+    PyTokenizer_Free(tok);
+    PyMem_Free(copy);
+    return NULL;
+}
+
+// A parser for many small inputs, which keeps what a parse allocates for the
+// next one: its Parser, with the token store, the memo and the identifier
+// table, its tokenizer and the filename; see run_parser_reusing().  Each
+// parse gets an arena of its own, which is freed with what it made.
+typedef struct {
+    PyObject_HEAD
+    PyObject *filename;
+    Parser *parser;  // NULL before the first parse
+    struct tok_state *tok;
+    char *copy;
+    int busy;  // A parse is running; one that it runs into must not use the Parser
+} ParserObject;
+
+static PyObject *
+ParserObject_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
+{
+    static char *keywords[] = {"filename", NULL};
+    PyObject *filename = NULL;
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "|U", keywords, &filename)) {
+        return NULL;
+    }
+    ParserObject *self = (ParserObject *)type->tp_alloc(type, 0);
+    if (self == NULL) {
+        return NULL;
+    }
+    if (filename != NULL) {
+        Py_INCREF(filename);
+        self->filename = filename;
+    }
+    else {
+        self->filename = PyUnicode_FromString("<string>");
+        if (self->filename == NULL) {
+            Py_DECREF(self);
+            return NULL;
         }
     }
-    Py_DECREF(list);
-    Py_RETURN_NONE;
+    return (PyObject *)self;
+}
+
+static void
+ParserObject_dealloc(ParserObject *self)
+{
+    if (self->parser != NULL) {
+        Parser_Free(self->parser);
+    }
+    if (self->tok != NULL) {
+        PyTokenizer_Free(self->tok);
+    }
+    PyMem_Free(self->copy);
+    Py_XDECREF(self->filename);
+    Py_TYPE(self)->tp_free((PyObject *)self);
 }
 
+// The start rule for the name of a mode of compile(), or -1 with an exception
+// set.
+static int
+_start_rule(const char *start)
+{
+    if (strcmp(start, "file") == 0) {
+        return START;
+    }
+    if (strcmp(start, "eval") == 0) {
+        return EVAL;
+    }
+    PyErr_Format(PyExc_ValueError, "Bad start, must be 'file' or 'eval'");
+    return -1;
+}
+
+// Parse source, a str or a bytes-like object, with self.
+static PyObject *
+_parser_parse(ParserObject *self, PyObject *source, int mode, START_RULE start_rule)
+{
+    if (self->busy) {
+        return PyErr_Format(PyExc_RuntimeError, "The Parser is already parsing");
+    }
+    // What "s*" does for PyArg_ParseTuple()
+    Py_buffer data;
+    if (PyUnicode_Check(source)) {
+        Py_ssize_t length;
+        const char *str = PyUnicode_AsUTF8AndSize(source, &length);
+        if (str == NULL ||
+            PyBuffer_FillInfo(&data, source, (void *)str, length, 1, PyBUF_SIMPLE) < 0) {
+            return NULL;
+        }
+    }
+    else if (PyObject_GetBuffer(source, &data, PyBUF_SIMPLE) < 0) {
+        return NULL;
+    }
+    PyArena *arena = PyArena_New();
+    if (arena == NULL) {
+        PyBuffer_Release(&data);
+        return NULL;
+    }
+    self->busy = 1;
+    mod_ty res = run_parser_reusing(&self->parser, &self->tok, &self->copy, data.buf, data.len,
+                                    start_rule, self->filename, arena, mode == 0);
+    PyObject *result = NULL;
+    if (res != NULL) {
+        result = _build_return_object(res, mode, self->filename, arena);
+    }
+    PyArena_Free(arena);
+    self->busy = 0;
+    PyBuffer_Release(&data);
+    return result;
+}
+
+static PyObject *
+ParserObject_parse(ParserObject *self, PyObject *args, PyObject *kwds)
+{
+    static char *keywords[] = {"source", "mode", "start", NULL};
+    PyObject *source;
+    int mode = 1;
+    const char *start = "file";
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|is", keywords, &source, &mode, &start)) {
+        return NULL;
+    }
+    if (mode < 0 || mode > 2) {
+        return PyErr_Format(PyExc_ValueError, "Bad mode, must be 0 <= mode <= 2");
+    }
+    int start_rule = _start_rule(start);
+    if (start_rule < 0) {
+        return NULL;
+    }
+    return _parser_parse(self, source, mode, start_rule);
+}
+
+static PyObject *
+ParserObject_parse_many(ParserObject *self, PyObject *args, PyObject *kwds)
+{
+    static char *keywords[] = {"sources", "mode", "start", NULL};
+    PyObject *sources;
+    int mode = 1;
+    const char *start = "file";
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|is", keywords, &sources, &mode, &start)) {
+        return NULL;
+    }
+    if (mode < 0 || mode > 2) {
+        return PyErr_Format(PyExc_ValueError, "Bad mode, must be 0 <= mode <= 2");
+    }
+    int start_rule = _start_rule(start);
+    if (start_rule < 0) {
+        return NULL;
+    }
+    PyObject *iterator = PyObject_GetIter(sources);
+    if (iterator == NULL) {
+        return NULL;
+    }
+    PyObject *results = PyList_New(0);
+    if (results == NULL) {
+        Py_DECREF(iterator);
+        return NULL;
+    }
+    PyObject *source;
+    while ((source = PyIter_Next(iterator)) != NULL) {
+        PyObject *result = _parser_parse(self, source, mode, start_rule);
+        Py_DECREF(source);
+        if (result == NULL || PyList_Append(results, result) < 0) {
+            Py_XDECREF(result);
+            goto error;
+        }
+        Py_DECREF(result);
+    }
+    if (PyErr_Occurred()) {
+        goto error;
+    }
+    Py_DECREF(iterator);
+    return results;
+
+error:
+    Py_DECREF(iterator);
+    Py_DECREF(results);
+    return NULL;
+}
+
+static PyMethodDef ParserObject_methods[] = {
+    {"parse", (PyCFunction)(void(*)(void))ParserObject_parse, METH_VARARGS|METH_KEYWORDS, "Parse a str or UTF-8 source in a bytes-like object."},
+    {"parse_many", (PyCFunction)(void(*)(void))ParserObject_parse_many, METH_VARARGS|METH_KEYWORDS, "Parse each source of an iterable, into a list."},
+    {NULL, NULL, 0, NULL}        /* Sentinel */
+};
+
+static PyTypeObject ParserType = {
+    PyVarObject_HEAD_INIT(NULL, 0)
+    .tp_name = "parse.Parser",
+    .tp_doc = "A parser that keeps its memory from one parse to the next.",
+    .tp_basicsize = sizeof(ParserObject),
+    .tp_flags = Py_TPFLAGS_DEFAULT,
+    .tp_new = ParserObject_new,
+    .tp_dealloc = (destructor)ParserObject_dealloc,
+    .tp_methods = ParserObject_methods,
+};
+
 static PyMethodDef ParseMethods[] = {
     {"parse_file", (PyCFunction)(void(*)(void))parse_file, METH_VARARGS|METH_KEYWORDS, "Parse a file."},
     {"parse_string", (PyCFunction)(void(*)(void))parse_string, METH_VARARGS|METH_KEYWORDS, "Parse a string."},
-    {"clear_memo_stats", clear_memo_stats, METH_NOARGS},
-    {"dump_memo_stats", dump_memo_stats, METH_NOARGS},
-    {"get_memo_stats", get_memo_stats, METH_NOARGS},
+    {"parse_bytes", (PyCFunction)(void(*)(void))parse_bytes, METH_VARARGS|METH_KEYWORDS, "Parse UTF-8 source in a bytes-like object."},
+    {"tokenize_string", (PyCFunction)(void(*)(void))tokenize_string, METH_VARARGS|METH_KEYWORDS, "Tokenize a string."},
     {NULL, NULL, 0, NULL}        /* Sentinel */
 };
 
@@ -145,5 +436,18 @@ static struct PyModuleDef parsemodule = {
 PyMODINIT_FUNC
 PyInit_parse(void)
 {
-    return PyModule_Create(&parsemodule);
+    if (PyType_Ready(&ParserType) < 0) {
+        return NULL;
+    }
+    PyObject *module = PyModule_Create(&parsemodule);
+    if (module == NULL) {
+        return NULL;
+    }
+    Py_INCREF(&ParserType);
+    if (PyModule_AddObject(module, "Parser", (PyObject *)&ParserType) < 0) {
+        Py_DECREF(&ParserType);
+        Py_DECREF(module);
+        return NULL;
+    }
+    return module;
 }
@@ -3,6 +3,13 @@
 #include "v38tokenizer.h"
 #include "parse_string.h"
 
+// The tokenizer can run in a thread of its own; see fill_token().
+#if defined(HAVE_PTHREAD_H) && !defined(__STDC_NO_ATOMICS__)
+#include <pthread.h>
+#include <stdatomic.h>
+#define PEGEN_PIPELINE
+#endif
+
 PyObject *
 new_identifier(Parser *p, char *identifier)
 {
@@ -37,7 +44,7 @@ byte_offset_to_character_offset(PyObject *line, int col_offset)
 }
 
 static inline PyObject *
-get_error_line(char *buffer)
+get_error_line(const char *buffer)
 {
     char *newline = strchr(buffer, '\n');
     if (newline) {
@@ -48,6 +55,19 @@ get_error_line(char *buffer)
     }
 }
 
+static const char *
+find_line(const char *buffer, int lineno)
+{
+    for (int i = 1; i < lineno; i++) {
+        const char *newline = strchr(buffer, '\n');
+        if (newline == NULL) {
+            break;
+        }
+        buffer = newline + 1;
+    }
+    return buffer;
+}
+
 int
 raise_syntax_error(Parser *p, const char *errmsg, ...)
 {
@@ -55,7 +75,8 @@ raise_syntax_error(Parser *p, const char *errmsg, ...)
     PyObject *errstr = NULL;
     PyObject *loc = NULL;
     PyObject *tmp = NULL;
-    Token *t = p->tokens[p->fill - 1];
+    // Before any input is read there is only the zeroed first block
+    Token *t = p->fill ? get_token(p, p->fill - 1) : &p->token_blocks[0]->tokens[0];
     va_list va;
 
     va_start(va, errmsg);
@@ -64,16 +85,24 @@ raise_syntax_error(Parser *p, const char *errmsg, ...)
     if (!errstr) {
         goto error;
     }
-    if (p->input_mode == FILE_INPUT) {
+    if (p->tok->fp != NULL) {
+        assert(p->input_mode == FILE_INPUT);
         loc = PyErr_ProgramTextObject(p->tok->filename, t->lineno);
         if (!loc) {
             Py_INCREF(Py_None);
             loc = Py_None;
         }
     }
+    else if (p->input_mode == FILE_INPUT) {
+        // The whole file is in memory, no need to read it again
+        loc = get_error_line(find_line(p->source, t->lineno));
+        if (!loc) {
+            goto error;
+        }
+    }
     else {
         assert(p->input_mode == STRING_INPUT);
-        loc = get_error_line(p->tok->buf);
+        loc = get_error_line(p->tok_buf);
         if (!loc) {
             goto error;
         }
@@ -103,41 +132,196 @@ error:
     return -1;
 }
 
-// Enable this if you uncomment any of the comments calling token_name().
-#if 0
-static const char *
-token_name(int type)
+// Estimate the number of tokens from the length of the input.  Real code
+// averages well over two bytes per token.
+static int
+_estimate_tokens(Parser *p)
 {
-    if (0 <= type && type <= N_TOKENS) {
-        return _PyParser_TokenNames[type];
+    Py_ssize_t length = tokenizer_input_size(p->tokenizer);
+    if (p->tok->fp != NULL) {
+        struct _Py_stat_struct st;
+        if (_Py_fstat_noraise(fileno(p->tok->fp), &st) == 0) {
+            length = st.st_size;
+        }
     }
-    return "<Huh?>";
+    return (int)Py_MIN(length / 2, INT_MAX / 2 - 1) + 16;
 }
-#endif
 
-// Here, mark is the start of the node, while p->mark is the end.
-// If node==NULL, they should be the same.
-int
-insert_memo(Parser *p, int mark, int type, void *node)
+// The MEMO_LIST chain of the token at mark.
+static inline Memo **
+_token_memo(Parser *p, int mark)
 {
-    // Insert in front
-    Memo *m = PyArena_Malloc(p->arena, sizeof(Memo));
-    if (m == NULL) {
+    return &p->token_blocks[mark / TOKEN_BLOCK_SIZE]->memo[mark % TOKEN_BLOCK_SIZE];
+}
+
+// The dense backend keeps one row of n_memo_rules slots per token.  Blocks of
+// rows are allocated as the parse reaches them; calloc() gives us the zeroed
+// end marks without touching memory that is never used.
+static inline int *
+_memo_dense_ends(Parser *p, int block)
+{
+    return (int *)p->memo_blocks[block];
+}
+
+static inline void **
+_memo_dense_nodes(Parser *p, int block)
+{
+    return (void **)(p->memo_blocks[block] +
+                     _Py_SIZE_ROUND_UP(MEMO_BLOCK_ROWS * p->n_memo_rules * sizeof(int),
+                                       sizeof(void *)));
+}
+
+static int
+_memo_dense_reserve(Parser *p, int block)
+{
+    if (block >= p->n_memo_blocks) {
+        int n_blocks = p->n_memo_blocks ? p->n_memo_blocks : 16;
+        while (n_blocks <= block) {
+            n_blocks *= 2;
+        }
+        char **blocks = PyMem_Realloc(p->memo_blocks, n_blocks * sizeof(char *));
+        if (blocks == NULL) {
+            PyErr_NoMemory();
+            return -1;
+        }
+        memset(blocks + p->n_memo_blocks, '\0',
+               (n_blocks - p->n_memo_blocks) * sizeof(char *));
+        p->memo_blocks = blocks;
+        p->n_memo_blocks = n_blocks;
+    }
+    if (p->memo_blocks[block] == NULL) {
+        size_t size = (size_t)MEMO_BLOCK_ROWS * p->n_memo_rules;
+        p->memo_blocks[block] = PyMem_Calloc(
+            1, _Py_SIZE_ROUND_UP(size * sizeof(int), sizeof(void *)) + size * sizeof(void *));
+        if (p->memo_blocks[block] == NULL) {
+            PyErr_NoMemory();
+            return -1;
+        }
+    }
+    return 0;
+}
+
+// Keys for the same mark are adjacent, so the handful of rules the parser
+// tries at one position probe neighbouring slots.  They are 64 bits wide, as
+// mark * n_memo_rules can pass 2**32 on long inputs.
+static inline uint64_t
+_memo_hash_key(Parser *p, int mark, int type)
+{
+    assert(0 <= type - FIRST_RULE_TYPE && type - FIRST_RULE_TYPE < p->n_memo_rules);
+    return (uint64_t)mark * p->n_memo_rules + (type - FIRST_RULE_TYPE) + 1;
+}
+
+static MemoHashEntry *
+_memo_hash_find(MemoHashEntry *table, int size, uint64_t key)
+{
+    uint64_t mask = (uint64_t)size - 1;
+    uint64_t i = key & mask;
+    while (table[i].key != 0 && table[i].key != key) {
+        i = (i + 1) & mask;
+    }
+    return &table[i];
+}
+
+// Keep the load factor of the hash table at or below one half.  The first
+// table is sized from the length of the input, which is a good guess at the
+// number of entries the parse will need.  Entries that commit() has made dead are
+// left behind when the table is rebuilt, and it only grows if the live ones
+// fill more than a quarter of it.
+static int
+_memo_hash_reserve(Parser *p)
+{
+    if (2 * (p->memo_table_used + 1) <= p->memo_table_size) {
+        return 0;
+    }
+    uint64_t committed_key = (uint64_t)p->committed_mark * p->n_memo_rules + 1;
+    int used = 0;
+    for (int i = 0; i < p->memo_table_size; i++) {
+        used += p->memo_table[i].key >= committed_key;
+    }
+    int size = p->memo_table_size;
+    if (size == 0) {
+        size = 1024;
+        while (size < 4 * _estimate_tokens(p)) {
+            size *= 2;
+        }
+    }
+    else if (4 * (used + 1) > size) {
+        size *= 2;
+    }
+    MemoHashEntry *table = PyMem_Calloc(size, sizeof(MemoHashEntry));
+    if (table == NULL) {
+        PyErr_NoMemory();
         return -1;
     }
+    for (int i = 0; i < p->memo_table_size; i++) {
+        MemoHashEntry *e = &p->memo_table[i];
+        if (e->key >= committed_key) {
+            *_memo_hash_find(table, size, e->key) = *e;
+        }
+    }
+    PyMem_Free(p->memo_table);
+    p->memo_table = table;
+    p->memo_table_size = size;
+    p->memo_table_used = used;
+    return 0;
+}
+
+static int
+_memo_list_insert(Parser *p, int mark, int type, void *node)
+{
+    // Insert in front
+    Memo *m = p->memo_free;
+    if (m != NULL) {
+        p->memo_free = m->next;
+    }
+    else {
+        m = PyArena_Malloc(p->arena, sizeof(Memo));
+        if (m == NULL) {
+            return -1;
+        }
+    }
     m->type = type;
     m->node = node;
     m->mark = p->mark;
-    m->next = p->tokens[mark]->memo;
-    p->tokens[mark]->memo = m;
+    Memo **head = _token_memo(p, mark);
+    m->next = *head;
+    *head = m;
     return 0;
 }
 
-// Like insert_memo(), but updates an existing node if found.
-int
-update_memo(Parser *p, int mark, int type, void *node)
-{
-    for (Memo *m = p->tokens[mark]->memo; m != NULL; m = m->next) {
+static int
+_memo_update(Parser *p, int mark, int type, void *node)
+{
+    switch (p->memo_backend) {
+        case MEMO_DENSE: {
+            assert(0 <= type - FIRST_RULE_TYPE && type - FIRST_RULE_TYPE < p->n_memo_rules);
+            int block = mark / MEMO_BLOCK_ROWS;
+            if (_memo_dense_reserve(p, block) < 0) {
+                return -1;
+            }
+            int slot = (mark % MEMO_BLOCK_ROWS) * p->n_memo_rules + (type - FIRST_RULE_TYPE);
+            _memo_dense_nodes(p, block)[slot] = node;
+            _memo_dense_ends(p, block)[slot] = p->mark + 1;
+            return 0;
+        }
+        case MEMO_HASH: {
+            if (_memo_hash_reserve(p) < 0) {
+                return -1;
+            }
+            uint64_t key = _memo_hash_key(p, mark, type);
+            MemoHashEntry *e = _memo_hash_find(p->memo_table, p->memo_table_size, key);
+            if (e->key == 0) {
+                e->key = key;
+                p->memo_table_used++;
+            }
+            e->node = node;
+            e->end = p->mark;
+            return 0;
+        }
+        case MEMO_LIST:
+            break;
+    }
+    for (Memo *m = *_token_memo(p, mark); m != NULL; m = m->next) {
         if (m->type == type) {
             // Update existing node.
             m->node = node;
@@ -146,7 +330,136 @@ update_memo(Parser *p, int mark, int type, void *node)
         }
     }
     // Insert new node.
-    return insert_memo(p, mark, type, node);
+    return _memo_list_insert(p, mark, type, node);
+}
+
+// Here, mark is the start of the node, while p->mark is the end.
+// If node==NULL, they should be the same.
+int
+insert_memo(Parser *p, int mark, int type, void *node)
+{
+    if (UNLIKELY(p->stats != NULL)) {
+        p->stats[type - FIRST_RULE_TYPE].inserts++;
+    }
+    if (p->memo_backend != MEMO_LIST) {
+        return _memo_update(p, mark, type, node);
+    }
+    return _memo_list_insert(p, mark, type, node);
+}
+
+// Like insert_memo(), but updates an existing node if found.
+int
+update_memo(Parser *p, int mark, int type, void *node)
+{
+    if (UNLIKELY(p->stats != NULL)) {
+        p->stats[type - FIRST_RULE_TYPE].inserts++;
+    }
+    return _memo_update(p, mark, type, node);
+}
+
+// Look up the memo for type at mark.  On a hit, store the node and the end
+// mark in *pnode and *pend and return 1; otherwise return 0.
+static int
+_memo_lookup(Parser *p, int mark, int type, void **pnode, int *pend)
+{
+    switch (p->memo_backend) {
+        case MEMO_DENSE: {
+            int block = mark / MEMO_BLOCK_ROWS;
+            if (block >= p->n_memo_blocks || p->memo_blocks[block] == NULL) {
+                return 0;
+            }
+            int slot = (mark % MEMO_BLOCK_ROWS) * p->n_memo_rules + (type - FIRST_RULE_TYPE);
+            int end = _memo_dense_ends(p, block)[slot];
+            if (end == 0) {
+                return 0;
+            }
+            *pnode = _memo_dense_nodes(p, block)[slot];
+            *pend = end - 1;
+            return 1;
+        }
+        case MEMO_HASH: {
+            if (p->memo_table_used == 0) {
+                return 0;
+            }
+            uint64_t key = _memo_hash_key(p, mark, type);
+            MemoHashEntry *e = _memo_hash_find(p->memo_table, p->memo_table_size, key);
+            if (e->key == 0) {
+                return 0;
+            }
+            *pnode = e->node;
+            *pend = e->end;
+            return 1;
+        }
+        case MEMO_LIST:
+            break;
+    }
+    for (Memo *m = *_token_memo(p, mark); m != NULL; m = m->next) {
+        if (m->type == type) {
+            *pnode = m->node;
+            *pend = m->mark;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+// Drop the memo and the tokens below the lowest mark that parsing can still go
+// back to.  That is the mark of the outermost pending choice point, or the
+// current mark if there is none.
+void
+commit(Parser *p)
+{
+    int mark = Py_MIN(p->choice_mark, p->mark);
+    if (mark <= p->committed_mark) {
+        return;
+    }
+    switch (p->memo_backend) {
+        case MEMO_DENSE:
+            // Free the blocks whose rows are all below mark
+            for (int block = p->committed_mark / MEMO_BLOCK_ROWS;
+                 block < mark / MEMO_BLOCK_ROWS && block < p->n_memo_blocks; block++) {
+                PyMem_Free(p->memo_blocks[block]);
+                p->memo_blocks[block] = NULL;
+            }
+            break;
+        case MEMO_HASH:
+            // _memo_hash_reserve() leaves the dead entries behind
+            break;
+        case MEMO_LIST:
+            for (int i = p->committed_mark; i < mark; i++) {
+                Memo **head = _token_memo(p, i);
+                Memo *m = *head;
+                if (m == NULL) {
+                    continue;
+                }
+                while (m->next != NULL) {
+                    m = m->next;
+                }
+                m->next = p->memo_free;
+                p->memo_free = *head;
+                *head = NULL;
+            }
+            break;
+    }
+    // Free the token blocks that are all below mark, except the one holding
+    // the token before it, which get_last_nonnwhitespace_token() may look at.
+    for (int block = Py_MAX(p->committed_mark - 1, 0) / TOKEN_BLOCK_SIZE;
+         block < (mark - 1) / TOKEN_BLOCK_SIZE; block++) {
+        PyMem_Free(p->token_blocks[block]);
+        p->token_blocks[block] = NULL;
+    }
+    p->committed_mark = mark;
+}
+
+// Called when a rule reaches a cut.  The rule will not try its other
+// alternatives, so the choice point it entered is gone; choice_mark is the
+// value enter_choice() returned for it.
+int
+cut(Parser *p, int choice_mark)
+{
+    p->choice_mark = choice_mark;
+    commit(p);
+    return 1;
 }
 
 // Return dummy NAME.
@@ -168,8 +481,11 @@ CONSTRUCTOR(Parser *p, ...)
 }
 
 static int
-_get_keyword_or_name_type(Parser *p, char *name, int name_len)
+_get_keyword_or_name_type(Parser *p, const char *name, int name_len)
 {
+    if (p->classify_keyword != NULL) {
+        return p->classify_keyword(name, name_len);
+    }
     if (name_len >= p->n_keyword_lists || p->keywords[name_len] == NULL) {
         return NAME;
     }
@@ -178,141 +494,735 @@ _get_keyword_or_name_type(Parser *p, char *name, int name_len)
             return k->type;
         }
     }
-    return NAME;
+    return NAME;
+}
+
+// Make sure the token block that holds mark is allocated.
+static int
+_token_block_reserve(Parser *p, int mark)
+{
+    int block = mark / TOKEN_BLOCK_SIZE;
+    if (block >= p->n_token_blocks) {
+        int n_blocks = p->n_token_blocks ? p->n_token_blocks : 16;
+        while (n_blocks <= block) {
+            n_blocks *= 2;
+        }
+        TokenBlock **blocks = PyMem_Realloc(p->token_blocks, n_blocks * sizeof(TokenBlock *));
+        if (blocks == NULL) {
+            goto error;
+        }
+        memset(blocks + p->n_token_blocks, '\0',
+               (n_blocks - p->n_token_blocks) * sizeof(TokenBlock *));
+        p->token_blocks = blocks;
+        p->n_token_blocks = n_blocks;
+    }
+    if (p->token_blocks[block] == NULL) {
+        p->token_blocks[block] = PyMem_Calloc(1, sizeof(TokenBlock));
+        if (p->token_blocks[block] == NULL) {
+            goto error;
+        }
+    }
+    return 0;
+
+error:
+    PyErr_Format(PyExc_MemoryError, "Realloc tokens failed");
+    return -1;
+}
+
+// Record where the text of a token lives.  No Python object is created for
+// it; see token_bytes() and the *_token() helpers for that.
+static int
+_set_token_text(Parser *p, Token *t, const char *start, const char *end)
+{
+    if (start == NULL || end == NULL) {
+        t->start = t->end = 0;
+        return 0;
+    }
+    if (p->tok->fp == NULL) {
+        assert(p->source <= start && start <= end);
+        t->start = (int)(start - p->source);
+        t->end = (int)(end - p->source);
+        return 0;
+    }
+    int len = (int)(end - start);
+    if (p->text_len + len > p->text_size) {
+        int newsize = p->text_size ? p->text_size : 1024;
+        while (p->text_len + len > newsize) {
+            newsize *= 2;
+        }
+        char *buf = PyMem_Realloc(p->text_buf, newsize);
+        if (buf == NULL) {
+            PyErr_NoMemory();
+            return -1;
+        }
+        p->text_buf = buf;
+        p->text_size = newsize;
+        p->source = buf;
+    }
+    memcpy(p->text_buf + p->text_len, start, len);
+    t->start = p->text_len;
+    t->end = p->text_len += len;
+    return 0;
+}
+
+// The PositionStats of mark, or NULL with an exception set if there is no
+// memory for them.
+static PositionStats *
+_position_stats(Parser *p, int mark)
+{
+    if (mark >= p->position_stats_size) {
+        int size = Py_MAX(2 * p->position_stats_size, 256);
+        while (size <= mark) {
+            size *= 2;
+        }
+        PositionStats *stats = PyMem_Realloc(p->position_stats, size * sizeof(PositionStats));
+        if (stats == NULL) {
+            PyErr_NoMemory();
+            return NULL;
+        }
+        memset(stats + p->position_stats_size, 0,
+               (size - p->position_stats_size) * sizeof(PositionStats));
+        p->position_stats = stats;
+        p->position_stats_size = size;
+    }
+    return &p->position_stats[mark];
+}
+
+#ifdef PEGEN_PIPELINE
+
+// Tokens the tokenizer thread may run ahead of the parser; a power of two
+#define PIPELINE_SIZE 4096
+// A side that waits is woken when this many tokens are ready for it
+#define PIPELINE_BATCH 512
+
+// A single-producer, single-consumer ring of the tokens that the tokenizer
+// thread has read and the parser has not taken yet.  Each side only waits on
+// cond when the ring is full or empty, and the other side only signals it
+// when the flag of the waiting side says so, at the end of a batch.
+struct TokenPipeline {
+    Tokenizer *tokenizer;
+    pthread_t thread;
+    int joined;
+    pthread_mutex_t mutex;
+    pthread_cond_t cond;
+    atomic_int producer_waiting, consumer_waiting;  // Sleeping on cond
+    atomic_int stop;  // Set by the parser when it is done with the tokens
+    atomic_int done;  // Set by the tokenizer thread after its last token
+    // Tokens written, by the tokenizer thread
+    _Alignas(64) atomic_size_t head;
+    // Tokens taken, by the parser, which also keeps the last head it read
+    _Alignas(64) atomic_size_t tail;
+    size_t known_head;
+    _Alignas(64) RawToken tokens[PIPELINE_SIZE];
+};
+
+static void
+_pipeline_wake(TokenPipeline *pl, atomic_int *waiting)
+{
+    if (atomic_load(waiting)) {
+        pthread_mutex_lock(&pl->mutex);
+        pthread_cond_broadcast(&pl->cond);
+        pthread_mutex_unlock(&pl->mutex);
+    }
+}
+
+// The tokenizer thread.  It runs without the GIL, so it only scans, and stops
+// where the scanner gives up; see tokenizer_scan().
+static void *
+_pipeline_run(void *arg)
+{
+    TokenPipeline *pl = arg;
+    size_t head = 0, tail = 0;
+    for (;;) {
+        if (head - tail == PIPELINE_SIZE) {
+            tail = atomic_load(&pl->tail);
+        }
+        if (head - tail == PIPELINE_SIZE) {
+            pthread_mutex_lock(&pl->mutex);
+            atomic_store(&pl->producer_waiting, 1);
+            while (head - (tail = atomic_load(&pl->tail)) == PIPELINE_SIZE &&
+                   !atomic_load(&pl->stop)) {
+                pthread_cond_wait(&pl->cond, &pl->mutex);
+            }
+            atomic_store(&pl->producer_waiting, 0);
+            pthread_mutex_unlock(&pl->mutex);
+        }
+        if (atomic_load_explicit(&pl->stop, memory_order_relaxed)) {
+            break;
+        }
+        RawToken *r = &pl->tokens[head % PIPELINE_SIZE];
+        if (tokenizer_scan(pl->tokenizer, r) < 0) {
+            break;
+        }
+        atomic_store(&pl->head, ++head);
+        if (r->type == ENDMARKER) {
+            break;
+        }
+        if (head % PIPELINE_BATCH == 0) {
+            _pipeline_wake(pl, &pl->consumer_waiting);
+        }
+    }
+    atomic_store(&pl->done, 1);
+    _pipeline_wake(pl, &pl->consumer_waiting);
+    return NULL;
+}
+
+static void
+_pipeline_join(TokenPipeline *pl)
+{
+    if (!pl->joined) {
+        pthread_join(pl->thread, NULL);
+        pl->joined = 1;
+    }
+}
+
+// Take the next token from the ring, waiting for the tokenizer thread if it
+// is empty.  Once the thread has stopped the parser reads the tokens itself:
+// those after the ENDMARKER, and the rest of them if the scanner gave up.
+static void
+_pipeline_get(TokenPipeline *pl, RawToken *r)
+{
+    size_t tail = atomic_load_explicit(&pl->tail, memory_order_relaxed);
+    if (tail == pl->known_head) {
+        pl->known_head = atomic_load(&pl->head);
+    }
+    if (tail == pl->known_head && !atomic_load(&pl->done)) {
+        // Other Python threads can run while the parser waits
+        Py_BEGIN_ALLOW_THREADS
+        pthread_mutex_lock(&pl->mutex);
+        atomic_store(&pl->consumer_waiting, 1);
+        while ((pl->known_head = atomic_load(&pl->head)) == tail && !atomic_load(&pl->done)) {
+            pthread_cond_wait(&pl->cond, &pl->mutex);
+        }
+        atomic_store(&pl->consumer_waiting, 0);
+        pthread_mutex_unlock(&pl->mutex);
+        Py_END_ALLOW_THREADS
+        pl->known_head = atomic_load(&pl->head);
+    }
+    if (tail == pl->known_head) {
+        _pipeline_join(pl);
+        tokenizer_get(pl->tokenizer, r);
+    }
+    else {
+        *r = pl->tokens[tail % PIPELINE_SIZE];
+        atomic_store(&pl->tail, tail + 1);
+        if ((tail + 1) % PIPELINE_BATCH == 0) {
+            _pipeline_wake(pl, &pl->producer_waiting);
+        }
+    }
+}
+
+static void
+_pipeline_free(TokenPipeline *pl)
+{
+    atomic_store(&pl->stop, 1);
+    pthread_mutex_lock(&pl->mutex);
+    pthread_cond_broadcast(&pl->cond);
+    pthread_mutex_unlock(&pl->mutex);
+    _pipeline_join(pl);
+    pthread_cond_destroy(&pl->cond);
+    pthread_mutex_destroy(&pl->mutex);
+    PyMem_Free(pl);
+}
+
+#endif
+
+// Tokenize the input in a thread of its own, ahead of the parser, if that is
+// possible: the input is tokenized as a string, by the scanner of
+// tokenizer.c, and the platform has threads.  Otherwise, and if the thread
+// cannot be started, fill_token() calls the tokenizer itself.
+// Returns -1 with an exception set if there is no memory.
+static int
+_start_pipeline(Parser *p)
+{
+#ifdef PEGEN_PIPELINE
+    if (p->tok->fp != NULL) {
+        return 0;
+    }
+    TokenPipeline *pl = PyMem_Malloc(sizeof(TokenPipeline));
+    if (pl == NULL) {
+        PyErr_NoMemory();
+        return -1;
+    }
+    pl->tokenizer = p->tokenizer;
+    pl->joined = 0;
+    atomic_init(&pl->producer_waiting, 0);
+    atomic_init(&pl->consumer_waiting, 0);
+    atomic_init(&pl->stop, 0);
+    atomic_init(&pl->done, 0);
+    atomic_init(&pl->head, 0);
+    atomic_init(&pl->tail, 0);
+    pl->known_head = 0;
+    if (pthread_mutex_init(&pl->mutex, NULL) != 0) {
+        PyMem_Free(pl);
+        return 0;
+    }
+    if (pthread_cond_init(&pl->cond, NULL) != 0) {
+        pthread_mutex_destroy(&pl->mutex);
+        PyMem_Free(pl);
+        return 0;
+    }
+    if (pthread_create(&pl->thread, NULL, _pipeline_run, pl) != 0) {
+        pthread_cond_destroy(&pl->cond);
+        pthread_mutex_destroy(&pl->mutex);
+        PyMem_Free(pl);
+        return 0;
+    }
+    p->pipeline = pl;
+#endif
+    return 0;
+}
+
+// Read the next token into the token store.  The tokenizer runs ahead of the
+// parser in a thread of its own if the parse asked for a pipeline and it
+// could be started; see _start_pipeline().
+int
+fill_token(Parser *p)
+{
+    RawToken r;
+#ifdef PEGEN_PIPELINE
+    if (p->pipeline != NULL) {
+        _pipeline_get(p->pipeline, &r);
+    }
+    else
+#endif
+    {
+        tokenizer_get(p->tokenizer, &r);
+    }
+    p->tok_buf = r.buf;
+    if (r.type == ERRORTOKEN) {
+        if (!PyErr_Occurred()) {
+            PyErr_Format(PyExc_SyntaxError, "Tokenizer returned error token");
+            // There is no reliable column information for this error
+            PyErr_SyntaxLocationObject(p->tok->filename, r.end_lineno, 0);
+        }
+        return -1;
+    }
+
+    if (p->fill % TOKEN_BLOCK_SIZE == 0 && _token_block_reserve(p, p->fill) < 0) {
+        return -1;
+    }
+
+    TokenBlock *block = p->token_blocks[p->fill / TOKEN_BLOCK_SIZE];
+    Token *t = &block->tokens[p->fill % TOKEN_BLOCK_SIZE];
+    t->type = (r.type == NAME) ? _get_keyword_or_name_type(p, r.start, (int)(r.end - r.start))
+                               : r.type;
+    block->types[p->fill % TOKEN_BLOCK_SIZE] = t->type;
+    if (_set_token_text(p, t, r.start, r.end) < 0) {
+        return -1;
+    }
+
+    t->lineno = r.lineno;
+    t->col_offset = r.col_offset;
+    t->end_lineno = r.end_lineno;
+    t->end_col_offset = r.end_col_offset;
+
+    if (UNLIKELY(p->stats != NULL)) {
+        PositionStats *s = _position_stats(p, p->fill);
+        if (s == NULL) {
+            return -1;
+        }
+        s->lineno = r.lineno;
+        s->col_offset = r.col_offset;
+        s->end_lineno = r.end_lineno;
+        s->end_col_offset = r.end_col_offset;
+    }
+
+    p->fill += 1;
+    return 0;
+}
+
+// Return a dict of the statistics that p kept, or NULL with an exception set.
+// It maps "tokens" to the number of tokens read, "rules" to a dict that maps
+// the name of each rule that was called to a dict of its RuleStats, and
+// "positions" to a list of a tuple of the PositionStats of each token: lineno,
+// col_offset, end_lineno, end_col_offset, calls and backtracked.  Parsers that
+// do not count rule calls only report the tokens.
+PyObject *
+parse_statistics(Parser *p)
+{
+    assert(p->stats != NULL);
+    if (!counts_rule_calls) {
+        return Py_BuildValue("{si}", "tokens", p->fill);
+    }
+    PyObject *rules = PyDict_New();
+    if (rules == NULL) {
+        return NULL;
+    }
+    for (int i = 0; i < n_rules; i++) {
+        RuleStats *s = &p->stats[i];
+        if (s->calls == 0) {
+            continue;
+        }
+        PyObject *value = Py_BuildValue("{sl,sl,sl,sl,sl,sl,sL,sL}",
+                                        "calls", s->calls,
+                                        "hits", s->hits,
+                                        "misses", s->misses,
+                                        "inserts", s->inserts,
+                                        "backtracked", s->backtracked,
+                                        "saved", s->saved,
+                                        "self_time", (long long)s->self_time,
+                                        "inclusive_time", (long long)s->inclusive_time);
+        if (value == NULL || PyDict_SetItemString(rules, rule_names[i], value) < 0) {
+            Py_XDECREF(value);
+            Py_DECREF(rules);
+            return NULL;
+        }
+        Py_DECREF(value);
+    }
+    PyObject *positions = PyList_New(p->fill);
+    if (positions == NULL) {
+        Py_DECREF(rules);
+        return NULL;
+    }
+    for (int i = 0; i < p->fill; i++) {
+        PositionStats *s = &p->position_stats[i];
+        PyObject *value = Py_BuildValue("(iiiill)", s->lineno, s->col_offset, s->end_lineno,
+                                        s->end_col_offset, s->calls, s->backtracked);
+        if (value == NULL) {
+            Py_DECREF(rules);
+            Py_DECREF(positions);
+            return NULL;
+        }
+        PyList_SET_ITEM(positions, i, value);
+    }
+    return Py_BuildValue("{si,sN,sN}", "tokens", p->fill, "rules", rules, "positions",
+                         positions);
+}
+
+// Record an event in the ring of a traced parse, at time now.
+static void
+_trace(Parser *p, _PyTime_t now, TRACE_KIND kind, int type, int mark, int end)
+{
+    TraceEvent *e = &p->trace[p->trace_count++ % TRACE_EVENTS];
+    e->time = now;
+    e->kind = kind;
+    e->type = type;
+    e->mark = mark;
+    e->end = end;
+    int at = kind == TRACE_EXIT ? end : mark;
+    if (at >= p->committed_mark && at < p->fill) {
+        Token *t = get_token(p, at);
+        e->lineno = t->lineno;
+        e->col_offset = t->col_offset;
+    }
+    else {
+        e->lineno = e->col_offset = -1;
+    }
+}
+
+void
+count_call_cold(Parser *p, int type)
+{
+    p->stats[type - FIRST_RULE_TYPE].calls++;
+    p->profile_work++;
+    PositionStats *s = _position_stats(p, p->mark);
+    if (s == NULL) {
+        longjmp(p->error_env, 1);
+    }
+    s->calls++;
+}
+
+void
+count_backtrack_cold(Parser *p, int type, int mark)
+{
+    p->stats[type - FIRST_RULE_TYPE].backtracked += p->mark - mark;
+    p->profile_work += 1 + p->mark - mark;
+    for (int i = mark; i < p->mark; i++) {
+        p->position_stats[i].backtracked++;
+    }
+    if (p->trace != NULL && mark != p->mark) {
+        _trace(p, _PyTime_GetPerfCounter(), TRACE_BACKTRACK, type, mark, p->mark);
+    }
+}
+
+static int
+_profile_push(Parser *p, int type, int hit, int counted, int rerun)
+{
+    if (p->profile_depth == p->profile_stack_size) {
+        int size = p->profile_stack_size ? 2 * p->profile_stack_size : 256;
+        void *stack = PyMem_Realloc(p->profile_stack, size * sizeof(MemoProfileFrame));
+        if (stack == NULL) {
+            PyErr_NoMemory();
+            return -1;
+        }
+        p->profile_stack = stack;
+        p->profile_stack_size = size;
+    }
+    MemoProfileFrame *frame = &p->profile_stack[p->profile_depth++];
+    frame->type = type;
+    frame->hit = hit;
+    frame->counted = counted;
+    frame->rerun = rerun;
+    p->profile_rerun += rerun;
+    frame->mark = p->mark;
+    frame->work = p->profile_work;
+    return 0;
+}
+
+// A parser generated for profiling looks up the rules that can be memoized
+// with these instead of is_memoized() and insert_memo().  Whether the rule is
+// memoized in the parser that the profile is made for is passed as memoized.
+//
+// When the parse keeps statistics, they count the lookups and the hits of
+// each such rule and the work its hits would save: the rule calls, the failed
+// alternatives and the tokens of parsing the rule again, where the tokens are
+// those it reads and those that its failed alternatives give back.  The work
+// is counted rather than timed, so the same input always gives the same
+// profile.  Every rule that can be memoized is looked up and parsed even on a
+// hit, but inside a rule that is parsed again although memoized, the parser
+// behaves as it is configured and nothing is counted.
+int  // bool
+profile_memo_lookup(Parser *p, int type, int memoized, void *pres)
+{
+    if (p->stats == NULL) {
+        return memoized ? is_memoized(p, type, pres) : 0;
+    }
+    if (p->mark == p->fill) {
+        if (fill_token(p) < 0) {
+            return -1;
+        }
+    }
+    void *node;
+    int end;
+    int hit = _memo_lookup(p, p->mark, type, &node, &end);
+    if (p->profile_rerun > 0) {
+        if (hit && memoized) {
+            p->mark = end;
+            *(void **)(pres) = node;
+            return 1;
+        }
+        return _profile_push(p, type, hit, 0, 0);
+    }
+    if (hit) {
+        p->stats[type - FIRST_RULE_TYPE].hits++;
+    }
+    else {
+        p->stats[type - FIRST_RULE_TYPE].misses++;
+    }
+    return _profile_push(p, type, hit, 1, hit && memoized);
+}
+
+int
+profile_memo_insert(Parser *p, int mark, int type, int memoized, void *node)
+{
+    if (p->stats == NULL) {
+        return memoized ? insert_memo(p, mark, type, node) : 0;
+    }
+    // A repetition that fails may return without inserting, so its lookup is
+    // skipped here.
+    while (p->profile_depth > 0) {
+        MemoProfileFrame *frame = &p->profile_stack[--p->profile_depth];
+        p->profile_rerun -= frame->rerun;
+        if (frame->type != type) {
+            continue;
+        }
+        if (!frame->hit) {
+            return insert_memo(p, mark, type, node);
+        }
+        if (frame->counted) {
+            p->stats[type - FIRST_RULE_TYPE].saved +=
+                p->profile_work - frame->work + p->mark - frame->mark;
+        }
+        return 0;
+    }
+    return 0;
 }
 
-int
-fill_token(Parser *p)
+int  // bool
+is_memoized(Parser *p, int type, void *pres)
 {
-    char *start, *end;
-    int type = PyTokenizer_Get(p->tok, &start, &end);
-    if (type == ERRORTOKEN) {
-        if (!PyErr_Occurred()) {
-            PyErr_Format(PyExc_SyntaxError, "Tokenizer returned error token");
-            // There is no reliable column information for this error
-            PyErr_SyntaxLocationObject(p->tok->filename, p->tok->lineno, 0);
+    if (p->mark == p->fill) {
+        if (fill_token(p) < 0) {
+            return -1;
         }
-        return -1;
     }
 
-    if (p->fill == p->size) {
-        int newsize = p->size * 2;
-        p->tokens = PyMem_Realloc(p->tokens, newsize * sizeof(Token *));
-        if (p->tokens == NULL) {
-            PyErr_Format(PyExc_MemoryError, "Realloc tokens failed");
-            return -1;
+    void *node;
+    int end;
+    if (_memo_lookup(p, p->mark, type, &node, &end)) {
+        if (UNLIKELY(p->stats != NULL)) {
+            p->stats[type - FIRST_RULE_TYPE].hits++;
+            if (p->trace != NULL) {
+                _trace(p, _PyTime_GetPerfCounter(), TRACE_MEMO_HIT, type, p->mark, end);
+            }
         }
-        for (int i = p->size; i < newsize; i++) {
-            p->tokens[i] = PyMem_Malloc(sizeof(Token));
-            memset(p->tokens[i], '\0', sizeof(Token));
+        p->mark = end;
+        *(void **)(pres) = node;
+        return 1;
+    }
+    if (UNLIKELY(p->stats != NULL)) {
+        p->stats[type - FIRST_RULE_TYPE].misses++;
+        if (p->trace != NULL) {
+            _trace(p, _PyTime_GetPerfCounter(), TRACE_MEMO_MISS, type, p->mark, -1);
         }
-        p->size = newsize;
     }
+    return 0;
+}
 
-    Token *t = p->tokens[p->fill];
-    t->type = (type == NAME) ? _get_keyword_or_name_type(p, start, (int)(end - start)) : type;
-    t->bytes = PyBytes_FromStringAndSize(start, end - start);
-    if (t->bytes == NULL) {
-        return -1;
+// A parser generated with rule timing calls every rule through a wrapper that
+// calls these around it.  When the parse keeps statistics, they add up the
+// time spent in each rule, leaving out the rules it calls (self time) or
+// including them (inclusive time, counted once for recursive calls).  The
+// self times add up to the inclusive time of the start rule.  Each timed call
+// reads the clock twice, which is counted in its own self time and in that
+// of its caller.  When the parse is traced, they also record the calls.
+void
+enter_rule(Parser *p, int type)
+{
+    if (p->stats == NULL) {
+        return;
     }
-    PyArena_AddPyObject(p->arena, t->bytes);
-
-    int lineno = type == STRING ? p->tok->first_lineno : p->tok->lineno;
-    const char *line_start = type == STRING ? p->tok->multi_line_start : p->tok->line_start;
-    int end_lineno = p->tok->lineno;
-    int col_offset = -1, end_col_offset = -1;
-    if (start != NULL && start >= line_start) {
-        col_offset = start - line_start;
+    if (p->timing_depth == p->timing_stack_size) {
+        int size = p->timing_stack_size ? 2 * p->timing_stack_size : 256;
+        void *stack = PyMem_Realloc(p->timing_stack, size * sizeof(RuleTimingFrame));
+        if (stack == NULL) {
+            PyErr_NoMemory();
+            longjmp(p->error_env, 1);
+        }
+        p->timing_stack = stack;
+        p->timing_stack_size = size;
     }
-    if (end != NULL && end >= p->tok->line_start) {
-        end_col_offset = end - p->tok->line_start;
+    RuleTimingFrame *frame = &p->timing_stack[p->timing_depth++];
+    frame->type = type;
+    frame->children = 0;
+    p->stats[type - FIRST_RULE_TYPE].active++;
+    frame->start = _PyTime_GetPerfCounter();
+    if (p->trace != NULL) {
+        _trace(p, frame->start, TRACE_ENTER, type, p->mark, -1);
     }
-
-    t->lineno = lineno;
-    t->col_offset = col_offset;
-    t->end_lineno = end_lineno;
-    t->end_col_offset = end_col_offset;
-
-    // if (p->fill % 100 == 0) fprintf(stderr, "Filled at %d: %s \"%s\"\n", p->fill,
-    // token_name(type), PyBytes_AsString(t->bytes));
-    p->fill += 1;
-    return 0;
 }
 
-// Instrumentation to count the effectiveness of memoization.
-// The array counts the number of tokens skipped by memoization,
-// indexed by type.
-
-#define NSTATISTICS 2000
-static long memo_statistics[NSTATISTICS];
-
 void
-clear_memo_statistics()
+exit_rule(Parser *p, int type, int success)
 {
-    for (int i = 0; i < NSTATISTICS; i++) {
-        memo_statistics[i] = 0;
+    if (p->stats == NULL) {
+        return;
+    }
+    _PyTime_t span = _PyTime_GetPerfCounter();
+    if (p->trace != NULL) {
+        _trace(p, span, TRACE_EXIT, type, p->mark, success ? p->mark : -1);
+    }
+    RuleTimingFrame *frame = &p->timing_stack[--p->timing_depth];
+    assert(frame->type == type);
+    span -= frame->start;
+    RuleStats *s = &p->stats[type - FIRST_RULE_TYPE];
+    s->self_time += span - frame->children;
+    if (--s->active == 0) {
+        s->inclusive_time += span;
+    }
+    if (p->timing_depth > 0) {
+        frame[-1].children += span;
     }
 }
 
-PyObject *
-get_memo_statistics()
+static void
+_write_position(FILE *fp, TraceEvent *e)
 {
-    PyObject *ret = PyList_New(NSTATISTICS);
-    if (ret == NULL) {
-        return NULL;
-    }
-    for (int i = 0; i < NSTATISTICS; i++) {
-        PyObject *value = PyLong_FromLong(memo_statistics[i]);
-        if (value == NULL) {
-            Py_DECREF(ret);
-            return NULL;
-        }
-        // PyList_SetItem borrows a reference to value.
-        if (PyList_SetItem(ret, i, value) < 0) {
-            Py_DECREF(ret);
-            return NULL;
-        }
+    if (e->lineno >= 0) {
+        fprintf(fp, ", \"line\": %d, \"col\": %d", e->lineno, e->col_offset);
     }
-    return ret;
 }
 
-int  // bool
-is_memoized(Parser *p, int type, void *pres)
+// Write the events that a traced parse kept to filename as Chrome trace event
+// JSON, which chrome://tracing and https://ui.perfetto.dev show on a
+// timeline: each rule call as a slice, with the marks where it started and
+// ended and whether it succeeded, and the memo lookups and the backtracking
+// as instant events.  Times are in microseconds from the first event kept.
+// If the ring has wrapped, the exits of the calls that started before the
+// first event kept are left out; calls still in progress when the parse
+// stopped (on an error) are closed at its last event.  Returns -1 with an
+// exception set on failure.
+int
+write_trace(Parser *p, const char *filename)
 {
-    if (p->mark == p->fill) {
-        if (fill_token(p) < 0) {
-            return -1;
-        }
+    FILE *fp = fopen(filename, "w");
+    if (fp == NULL) {
+        PyErr_SetFromErrnoWithFilename(PyExc_OSError, filename);
+        return -1;
     }
-
-    Token *t = p->tokens[p->mark];
-
-    for (Memo *m = t->memo; m != NULL; m = m->next) {
-        if (m->type == type) {
-            if (0 <= type && type < NSTATISTICS) {
-                long count = m->mark - p->mark;
-                // A memoized negative result counts for one.
-                if (count <= 0) {
-                    count = 1;
+    long first = Py_MAX(p->trace_count - TRACE_EVENTS, 0);
+    _PyTime_t start = p->trace_count > 0 ? p->trace[first % TRACE_EVENTS].time : 0;
+    double ts = 0;
+    int depth = 0;
+    const char *sep = "\n";
+    fprintf(fp, "{\"displayTimeUnit\": \"ns\", \"traceEvents\": [");
+    for (long i = first; i < p->trace_count; i++) {
+        TraceEvent *e = &p->trace[i % TRACE_EVENTS];
+        const char *rule = rule_names[e->type - FIRST_RULE_TYPE];
+        ts = (e->time - start) / 1e3;
+        if (e->kind == TRACE_EXIT && depth == 0) {
+            continue;
+        }
+        fprintf(fp, "%s", sep);
+        sep = ",\n";
+        switch (e->kind) {
+            case TRACE_ENTER:
+                depth++;
+                fprintf(fp, "{\"ph\": \"B\", \"name\": \"%s\", \"cat\": \"rule\", ", rule);
+                fprintf(fp, "\"ts\": %.3f, \"pid\": 1, \"tid\": 1, \"args\": {\"mark\": %d",
+                        ts, e->mark);
+                _write_position(fp, e);
+                fprintf(fp, "}}");
+                break;
+            case TRACE_EXIT:
+                depth--;
+                fprintf(fp, "{\"ph\": \"E\", \"ts\": %.3f, \"pid\": 1, \"tid\": 1, ", ts);
+                fprintf(fp, "\"args\": {\"result\": %s", e->end >= 0 ? "true" : "false");
+                if (e->end >= 0) {
+                    fprintf(fp, ", \"end\": %d", e->end);
                 }
-                memo_statistics[type] += count;
-            }
-            p->mark = m->mark;
-            *(void **)(pres) = m->node;
-            // fprintf(stderr, "%d < %d: memoized!\n", p->mark, p->fill);
-            return 1;
+                fprintf(fp, "}}");
+                break;
+            case TRACE_MEMO_HIT:
+            case TRACE_MEMO_MISS:
+                fprintf(fp, "{\"ph\": \"i\", \"s\": \"t\", \"name\": \"memo %s\", ",
+                        e->kind == TRACE_MEMO_HIT ? "hit" : "miss");
+                fprintf(fp, "\"cat\": \"memo\", \"ts\": %.3f, \"pid\": 1, \"tid\": 1, ", ts);
+                fprintf(fp, "\"args\": {\"rule\": \"%s\", \"mark\": %d", rule, e->mark);
+                if (e->kind == TRACE_MEMO_HIT) {
+                    fprintf(fp, ", \"end\": %d", e->end);
+                }
+                _write_position(fp, e);
+                fprintf(fp, "}}");
+                break;
+            case TRACE_BACKTRACK:
+                fprintf(fp, "{\"ph\": \"i\", \"s\": \"t\", \"name\": \"backtrack\", ");
+                fprintf(fp, "\"cat\": \"backtrack\", \"ts\": %.3f, ", ts);
+                fprintf(fp, "\"pid\": 1, \"tid\": 1, ");
+                fprintf(fp, "\"args\": {\"rule\": \"%s\", \"from\": %d, \"to\": %d", rule,
+                        e->end, e->mark);
+                _write_position(fp, e);
+                fprintf(fp, "}}");
+                break;
         }
     }
-    // fprintf(stderr, "%d < %d: not memoized\n", p->mark, p->fill);
+    for (; depth > 0; depth--) {
+        fprintf(fp, "%s{\"ph\": \"E\", \"ts\": %.3f, \"pid\": 1, \"tid\": 1}", sep, ts);
+        sep = ",\n";
+    }
+    fprintf(fp, "\n]}\n");
+    if (ferror(fp)) {
+        PyErr_SetFromErrnoWithFilename(PyExc_OSError, filename);
+        fclose(fp);
+        return -1;
+    }
+    if (fclose(fp) != 0) {
+        PyErr_SetFromErrnoWithFilename(PyExc_OSError, filename);
+        return -1;
+    }
     return 0;
 }
 
+// A lookahead always goes back to where it started, so it is a choice point.
 int
 lookahead_with_string(int positive, void *(func)(Parser *, const char *), Parser *p,
                       const char *arg)
 {
     int mark = p->mark;
+    int choice_mark = enter_choice(p, mark);
     void *res = func(p, arg);
+    p->choice_mark = choice_mark;
     p->mark = mark;
     return (res != NULL) == positive;
 }
@@ -321,7 +1231,9 @@ int
 lookahead_with_int(int positive, Token *(func)(Parser *, int), Parser *p, int arg)
 {
     int mark = p->mark;
+    int choice_mark = enter_choice(p, mark);
     void *res = func(p, arg);
+    p->choice_mark = choice_mark;
     p->mark = mark;
     return (res != NULL) == positive;
 }
@@ -330,7 +1242,9 @@ int
 lookahead(int positive, void *(func)(Parser *), Parser *p)
 {
     int mark = p->mark;
+    int choice_mark = enter_choice(p, mark);
     void *res = func(p);
+    p->choice_mark = choice_mark;
     p->mark = mark;
     return (res != NULL) == positive;
 }
@@ -343,30 +1257,37 @@ expect_token(Parser *p, int type)
             return NULL;
         }
     }
-    Token *t = p->tokens[p->mark];
-    if (t->type != type) {
-        // fprintf(stderr, "No %s at %d\n", token_name(type), p->mark);
+    if (get_token_type(p, p->mark) != type) {
         return NULL;
     }
+    Token *t = get_token(p, p->mark);
     p->mark += 1;
-    // fprintf(stderr, "Got %s at %d: %s\n", token_name(type), p->mark,
-    // PyBytes_AsString(t->bytes));
-
     return t;
 }
 
+// Return a new reference to a bytes object holding the text of a token.  It
+// is not added to the arena, so that callers can release it once they are
+// done with it rather than keep it alive for the life of the AST.
+PyObject *
+token_bytes(Parser *p, Token *t)
+{
+    return PyBytes_FromStringAndSize(TOKEN_TEXT(p, t), TOKEN_LENGTH(t));
+}
+
 Token *
 get_last_nonnwhitespace_token(Parser *p)
 {
     assert(p->mark >= 0);
-    Token *token = NULL;
-    for (int m = p->mark - 1; m >= 0; m--) {
-        token = p->tokens[m];
-        if (token->type != ENDMARKER && (token->type < NEWLINE || token->type > DEDENT)) {
+    int m = p->mark - 1;
+    // The tokens below committed_mark - 1 may have been freed.
+    while (m > 0 && m >= p->committed_mark) {
+        int type = get_token_type(p, m);
+        if (type != ENDMARKER && (type < NEWLINE || type > DEDENT)) {
             break;
         }
+        m--;
     }
-    return token;
+    return m >= 0 ? get_token(p, m) : NULL;
 }
 
 void *
@@ -387,19 +1308,119 @@ endmarker_token(Parser *p)
     return expect_token(p, ENDMARKER);
 }
 
-expr_ty
-name_token(Parser *p)
+static unsigned int
+_identifier_hash(const char *s, int length)
 {
-    Token *t = expect_token(p, NAME);
-    if (t == NULL) {
-        return NULL;
+    unsigned int hash = 2166136261u;  // FNV-1a
+    for (int i = 0; i < length; i++) {
+        hash = (hash ^ (unsigned char)s[i]) * 16777619u;
+    }
+    return hash;
+}
+
+static int
+_identifiers_reserve(Parser *p)
+{
+    if (2 * (p->identifiers_used + 1) <= p->identifiers_size) {
+        return 0;
+    }
+    int size = p->identifiers_size ? 2 * p->identifiers_size : 256;
+    IdentifierEntry *table = PyMem_Calloc(size, sizeof(IdentifierEntry));
+    if (table == NULL) {
+        PyErr_NoMemory();
+        return -1;
+    }
+    for (int i = 0; i < p->identifiers_size; i++) {
+        IdentifierEntry *e = &p->identifiers[i];
+        if (e->id != NULL) {
+            int j = e->hash & (size - 1);
+            while (table[j].id != NULL) {
+                j = (j + 1) & (size - 1);
+            }
+            table[j] = *e;
+        }
+    }
+    PyMem_Free(p->identifiers);
+    p->identifiers = table;
+    p->identifiers_size = size;
+    return 0;
+}
+
+// Create the identifier for a name the way CPython's new_identifier() does:
+// ASCII names are copied straight into a str, others are decoded and
+// NFKC-normalized (PEP 3131).  The result is interned.
+static PyObject *
+_new_identifier_from_span(const char *s, int length)
+{
+    int ascii = 1;
+    for (int i = 0; i < length; i++) {
+        if ((unsigned char)s[i] >= 128) {
+            ascii = 0;
+            break;
+        }
+    }
+    PyObject *id;
+    if (ascii) {
+        id = PyUnicode_New(length, 127);
+        if (id == NULL) {
+            return NULL;
+        }
+        memcpy(PyUnicode_1BYTE_DATA(id), s, length);
+    }
+    else {
+        id = PyUnicode_DecodeUTF8(s, length, NULL);
+        if (id == NULL) {
+            return NULL;
+        }
+        if (!PyUnicode_IS_ASCII(id)) {
+            PyObject *unicodedata = PyImport_ImportModuleNoBlock("unicodedata");
+            if (unicodedata == NULL) {
+                Py_DECREF(id);
+                return NULL;
+            }
+            PyObject *normalized =
+                PyObject_CallMethod(unicodedata, "normalize", "sO", "NFKC", id);
+            Py_DECREF(unicodedata);
+            Py_DECREF(id);
+            if (normalized == NULL) {
+                return NULL;
+            }
+            if (!PyUnicode_Check(normalized)) {
+                PyErr_Format(PyExc_TypeError,
+                             "unicodedata.normalize() must return a string, not %.200s",
+                             Py_TYPE(normalized)->tp_name);
+                Py_DECREF(normalized);
+                return NULL;
+            }
+            id = normalized;
+        }
     }
-    char *s;
-    Py_ssize_t n;
-    if (PyBytes_AsStringAndSize(t->bytes, &s, &n) < 0) {
+    PyUnicode_InternInPlace(&id);
+    return id;
+}
+
+// Return the shared identifier for the text of a NAME token, creating it on
+// first sight.  The table is keyed by the token's bytes, so repeated names
+// cost a hash and a memcmp() instead of a decode and an arena entry.
+static PyObject *
+_get_identifier(Parser *p, Token *t)
+{
+    const char *s = TOKEN_TEXT(p, t);
+    int length = TOKEN_LENGTH(t);
+    unsigned int hash = _identifier_hash(s, length);
+    if (_identifiers_reserve(p) < 0) {
         return NULL;
     }
-    PyObject *id = PyUnicode_DecodeUTF8(s, n, NULL);
+    int mask = p->identifiers_size - 1;
+    int i = hash & mask;
+    for (; p->identifiers[i].id != NULL; i = (i + 1) & mask) {
+        IdentifierEntry *e = &p->identifiers[i];
+        if (e->hash == hash && e->length == length &&
+            memcmp(p->source + e->start, s, length) == 0) {
+            return e->id;
+        }
+    }
+    PyObject *id = _new_identifier_from_span(s, length);
     if (id == NULL) {
         return NULL;
     }
@@ -407,7 +1428,29 @@ name_token(Parser *p)
         Py_DECREF(id);
         return NULL;
     }
-    // TODO: What new_identifier() does.
+    IdentifierEntry *e = &p->identifiers[i];
+    e->start = t->start;
+    e->length = length;
+    e->hash = hash;
+    e->id = id;
+    p->identifiers_used++;
+    return id;
+}
+
+expr_ty
+name_token(Parser *p)
+{
+    Token *t = expect_token(p, NAME);
+    if (t == NULL) {
+        return NULL;
+    }
+    if (p->skip_actions) {
+        return CONSTRUCTOR(p);
+    }
+    PyObject *id = _get_identifier(p, t);
+    if (id == NULL) {
+        return NULL;
+    }
     return Name(id, Load, t->lineno, t->col_offset, t->end_lineno, t->end_col_offset,
                 p->arena);
 }
@@ -478,31 +1521,36 @@ parsenumber_raw(const char *s)
     }
 }
 
+// Parse the len bytes at s, which need not be NUL-terminated, as a number.
 static PyObject *
-parsenumber(const char *s)
+parsenumber(const char *s, Py_ssize_t len)
 {
-    char *dup, *end;
+    char buf[64], *dup, *end;
     PyObject *res = NULL;
 
     assert(s != NULL);
 
-    if (strchr(s, '_') == NULL) {
-        return parsenumber_raw(s);
+    /* Create a NUL-terminated copy without underscores. */
+    if (len < (Py_ssize_t)sizeof(buf)) {
+        dup = buf;
     }
-    /* Create a duplicate without underscores. */
-    dup = PyMem_Malloc(strlen(s) + 1);
-    if (dup == NULL) {
-        return PyErr_NoMemory();
+    else {
+        dup = PyMem_Malloc(len + 1);
+        if (dup == NULL) {
+            return PyErr_NoMemory();
+        }
     }
     end = dup;
-    for (; *s; s++) {
-        if (*s != '_') {
-            *end++ = *s;
+    for (const char *c = s; c < s + len; c++) {
+        if (*c != '_') {
+            *end++ = *c;
         }
     }
     *end = '\0';
     res = parsenumber_raw(dup);
-    PyMem_Free(dup);
+    if (dup != buf) {
+        PyMem_Free(dup);
+    }
     return res;
 }
 
@@ -513,14 +1561,11 @@ number_token(Parser *p)
     if (t == NULL) {
         return NULL;
     }
-
-    char *num_raw = PyBytes_AsString(t->bytes);
-
-    if (num_raw == NULL) {
-        return NULL;
+    if (p->skip_actions) {
+        return CONSTRUCTOR(p);
     }
 
-    PyObject *c = parsenumber(num_raw);
+    PyObject *c = parsenumber(TOKEN_TEXT(p, t), TOKEN_LENGTH(t));
 
     if (c == NULL) {
         return NULL;
@@ -538,10 +1583,30 @@ number_token(Parser *p)
 void
 Parser_Free(Parser *p)
 {
-    for (int i = 0; i < p->size; i++) {
-        PyMem_Free(p->tokens[i]);
+#ifdef PEGEN_PIPELINE
+    if (p->pipeline != NULL) {
+        _pipeline_free(p->pipeline);
     }
-    PyMem_Free(p->tokens);
+#endif
+    if (p->tokenizer != NULL) {
+        Tokenizer_Free(p->tokenizer);
+    }
+    for (int i = 0; i < p->n_token_blocks; i++) {
+        PyMem_Free(p->token_blocks[i]);
+    }
+    PyMem_Free(p->token_blocks);
+    PyMem_Free(p->text_buf);
+    for (int i = 0; i < p->n_memo_blocks; i++) {
+        PyMem_Free(p->memo_blocks[i]);
+    }
+    PyMem_Free(p->memo_blocks);
+    PyMem_Free(p->memo_table);
+    PyMem_Free(p->identifiers);
+    PyMem_Free(p->stats);
+    PyMem_Free(p->position_stats);
+    PyMem_Free(p->profile_stack);
+    PyMem_Free(p->timing_stack);
+    PyMem_Free(p->trace);
     PyMem_Free(p);
 }
 
@@ -559,16 +1624,54 @@ Parser_New(struct tok_state *tok, START_RULE start_rule_func, int input_mode,
     p->input_mode = input_mode;
     p->keywords = NULL;
     p->n_keyword_lists = -1;
-    p->tokens = PyMem_Malloc(sizeof(Token *));
-    if (!p->tokens) {
-        PyErr_Format(PyExc_MemoryError, "Out of memory for tokens");
-        return NULL;
-    }
-    p->tokens[0] = PyMem_Malloc(sizeof(Token));
-    memset(p->tokens[0], '\0', sizeof(Token));
+    p->classify_keyword = NULL;
+    p->skip_actions = 0;
+    p->stats = NULL;
+    p->position_stats = NULL;
+    p->position_stats_size = 0;
+    p->profile_stack = NULL;
+    p->profile_depth = 0;
+    p->profile_stack_size = 0;
+    p->profile_rerun = 0;
+    p->profile_work = 0;
+    p->timing_stack = NULL;
+    p->timing_depth = 0;
+    p->timing_stack_size = 0;
+    p->trace = NULL;
+    p->trace_count = 0;
+    p->tokenizer = NULL;
+    p->tok_buf = tok->buf;
+    p->pipeline = NULL;
+    p->memo_backend = MEMO_LIST;
+    p->n_memo_rules = 0;
+    p->memo_blocks = NULL;
+    p->n_memo_blocks = 0;
+    p->memo_table = NULL;
+    p->memo_table_size = 0;
+    p->memo_table_used = 0;
+    p->choice_mark = INT_MAX;
+    p->committed_mark = 0;
+    p->memo_free = NULL;
+    p->identifiers = NULL;
+    p->identifiers_size = 0;
+    p->identifiers_used = 0;
+    p->token_blocks = NULL;
+    p->n_token_blocks = 0;
     p->mark = 0;
     p->fill = 0;
-    p->size = 1;
+    p->source = tok->fp == NULL ? tok->buf : NULL;
+    p->text_buf = NULL;
+    p->text_len = 0;
+    p->text_size = 0;
+    if (_token_block_reserve(p, 0) < 0) {
+        Parser_Free(p);
+        return NULL;
+    }
+    p->tokenizer = Tokenizer_New(tok, 1);
+    if (p->tokenizer == NULL) {
+        Parser_Free(p);
+        return NULL;
+    }
 
     p->arena = arena;
     p->start_rule_func = start_rule_func;
@@ -576,6 +1679,77 @@ Parser_New(struct tok_state *tok, START_RULE start_rule_func, int input_mode,
     return p;
 }
 
+// Make p, which may have run a parse, ready to parse the input of tok into
+// arena, as a new Parser would, but keep the memory it has allocated: the
+// token store, the memo and the identifier table are emptied, not freed.
+// Whatever p took from its arena must be gone, so arena is either a new one or
+// the old one emptied.  tok is either a new one or p's own, which
+// tokenizer_restart() has pointed at new input.  Returns -1 with an exception
+// set if there is no memory.
+int
+Parser_Reset(Parser *p, struct tok_state *tok, START_RULE start_rule_func, PyArena *arena)
+{
+    assert(p->pipeline == NULL && p->stats == NULL && p->trace == NULL);
+    if (tok != p->tok) {
+        tokenizer_reset(p->tokenizer, tok);
+        p->tok = tok;
+    }
+    // The marks that the parse filled or memoized at, whose tokens commit()
+    // has not dropped
+    int end = Py_MIN(p->fill, p->n_token_blocks * TOKEN_BLOCK_SIZE - 1);
+    switch (p->memo_backend) {
+        case MEMO_DENSE:
+            // commit() keeps the block that holds committed_mark whole, with
+            // the rows below it
+            for (int mark = p->committed_mark / MEMO_BLOCK_ROWS * MEMO_BLOCK_ROWS; mark <= end;
+                 mark++) {
+                int block = mark / MEMO_BLOCK_ROWS;
+                if (block < p->n_memo_blocks && p->memo_blocks[block] != NULL) {
+                    int row = (mark % MEMO_BLOCK_ROWS) * p->n_memo_rules;
+                    memset(_memo_dense_ends(p, block) + row, 0, p->n_memo_rules * sizeof(int));
+                }
+            }
+            break;
+        case MEMO_HASH:
+            if (p->memo_table_used > 0) {
+                memset(p->memo_table, 0, p->memo_table_size * sizeof(MemoHashEntry));
+                p->memo_table_used = 0;
+            }
+            break;
+        case MEMO_LIST:
+            for (int mark = p->committed_mark; mark <= end; mark++) {
+                if (p->token_blocks[mark / TOKEN_BLOCK_SIZE] != NULL) {
+                    *_token_memo(p, mark) = NULL;
+                }
+            }
+            break;
+    }
+    p->memo_free = NULL;
+    if (p->identifiers_used > 0) {
+        memset(p->identifiers, 0, p->identifiers_size * sizeof(IdentifierEntry));
+        p->identifiers_used = 0;
+    }
+    // raise_syntax_error() expects a zeroed first block before any input is read
+    if (_token_block_reserve(p, 0) < 0) {
+        return -1;
+    }
+    memset(&p->token_blocks[0]->tokens[0], 0, sizeof(Token));
+    p->mark = 0;
+    p->fill = 0;
+    p->choice_mark = INT_MAX;
+    p->committed_mark = 0;
+    p->source = tok->fp == NULL ? tok->buf : NULL;
+    p->text_len = 0;
+    p->tok_buf = tok->buf;
+    p->profile_depth = 0;
+    p->profile_rerun = 0;
+    p->profile_work = 0;
+    p->timing_depth = 0;
+    p->arena = arena;
+    p->start_rule_func = start_rule_func;
+    return 0;
+}
+
 mod_ty
 run_parser(Parser *p)
 {
@@ -601,9 +1775,175 @@ run_parser(Parser *p)
     return res;
 }
 
+// Run the parser, and if stats is not NULL, keep its statistics and store
+// them in *stats.  If trace is not NULL, trace the parse and write the trace
+// there, also when it fails.
+static mod_ty
+_run_parser_with_stats(Parser *p, PyObject **stats, const char *trace)
+{
+    if (stats != NULL || trace != NULL) {
+        p->stats = PyMem_Calloc(n_rules, sizeof(RuleStats));
+        if (p->stats == NULL) {
+            PyErr_NoMemory();
+            return NULL;
+        }
+    }
+    if (trace != NULL) {
+        p->trace = PyMem_Malloc(TRACE_EVENTS * sizeof(TraceEvent));
+        if (p->trace == NULL) {
+            PyErr_NoMemory();
+            return NULL;
+        }
+    }
+    mod_ty res = run_parser(p);
+    if (trace != NULL) {
+        // Keep the exception of a failed parse
+        PyObject *type, *value, *traceback;
+        PyErr_Fetch(&type, &value, &traceback);
+        if (write_trace(p, trace) < 0) {
+            Py_XDECREF(type);
+            Py_XDECREF(value);
+            Py_XDECREF(traceback);
+            return NULL;
+        }
+        PyErr_Restore(type, value, traceback);
+    }
+    if (res != NULL && stats != NULL) {
+        *stats = parse_statistics(p);
+        if (*stats == NULL) {
+            return NULL;
+        }
+    }
+    return res;
+}
+
+// Read the rest of fp into a NUL-terminated buffer.  Returns NULL with an
+// exception set on failure.
+static char *
+_read_file(FILE *fp, Py_ssize_t *length)
+{
+    Py_ssize_t size = 0;
+    struct _Py_stat_struct st;
+    if (_Py_fstat_noraise(fileno(fp), &st) == 0 && st.st_size > 0) {
+        size = st.st_size;
+    }
+    size = Py_MAX(size, 1024);
+    char *buffer = PyMem_Malloc(size + 1);
+    if (buffer == NULL) {
+        PyErr_NoMemory();
+        return NULL;
+    }
+    Py_ssize_t len = 0;
+    for (;;) {
+        len += fread(buffer + len, 1, size - len, fp);
+        if (len < size) {
+            break;
+        }
+        // The file grew since fstat(), or it is not a regular file
+        char *new_buffer = PyMem_Realloc(buffer, 2 * size + 1);
+        if (new_buffer == NULL) {
+            PyMem_Free(buffer);
+            PyErr_NoMemory();
+            return NULL;
+        }
+        buffer = new_buffer;
+        size *= 2;
+    }
+    if (ferror(fp)) {
+        PyMem_Free(buffer);
+        PyErr_SetFromErrno(PyExc_OSError);
+        return NULL;
+    }
+    buffer[len] = '\0';
+    *length = len;
+    return buffer;
+}
+
+// Mirrors valid_utf8() in CPython's tokenizer: the length of the UTF-8
+// sequence at s, or 0 if it is not valid.
+static int
+_valid_utf8(const unsigned char *s, const unsigned char *end)
+{
+    int expected = 0;
+    if (*s < 0x80) {
+        return 1;
+    }
+    if (*s < 0xc0) {
+        return 0;
+    }
+    if (*s < 0xE0) {
+        expected = 1;
+    }
+    else if (*s < 0xF0) {
+        expected = 2;
+    }
+    else if (*s < 0xF8) {
+        expected = 3;
+    }
+    else {
+        return 0;
+    }
+    if (end - s <= expected) {
+        return 0;
+    }
+    for (int i = 1; i <= expected; i++) {
+        if (s[i] < 0x80 || s[i] >= 0xC0) {
+            return 0;
+        }
+    }
+    return expected + 1;
+}
+
+// Input must be UTF-8 unless it declares another encoding, which the string
+// tokenizer has decoded it from.  The file tokenizer checks this line by line
+// for undeclared input, the string tokenizer does not check it at all.  A BOM
+// or a utf-8 declaration leave the input as it is, so it is checked too.
+static int
+_check_utf8(struct tok_state *tok)
+{
+    int declared = tok->encoding != NULL;
+    if (declared && strcmp(tok->encoding, "utf-8") != 0) {
+        return 0;
+    }
+    const unsigned char *c = (const unsigned char *)tok->buf;
+    const unsigned char *end = (const unsigned char *)tok_input_end(tok);
+    while (c < end) {
+        // ASCII, eight bytes at a time
+        uint64_t word;
+        if (end - c >= 8 && (memcpy(&word, c, 8), (word & 0x8080808080808080ULL) == 0)) {
+            c += 8;
+            continue;
+        }
+        int length = _valid_utf8(c, end);
+        if (length == 0) {
+            int lineno = 1;
+            for (const char *s = tok->buf; s < (const char *)c; s++) {
+                lineno += *s == '\n';
+            }
+            if (declared) {
+                PyErr_Format(PyExc_SyntaxError,
+                             "Non-UTF-8 code starting with '\\x%.2x' in file %U on line %i, "
+                             "but its encoding is utf-8",
+                             *c, tok->filename, lineno);
+            }
+            else {
+                PyErr_Format(PyExc_SyntaxError,
+                             "Non-UTF-8 code starting with '\\x%.2x' in file %U on line %i, "
+                             "but no encoding declared; "
+                             "see http://python.org/dev/peps/pep-0263/ for details",
+                             *c, tok->filename, lineno);
+            }
+            return -1;
+        }
+        c += length;
+    }
+    return 0;
+}
+
 mod_ty
 run_parser_from_file(const char *filename, START_RULE start_rule_func,
-                     PyObject *filename_ob, PyArena *arena)
+                     PyObject *filename_ob, PyArena *arena, int skip_actions,
+                     PyObject **stats, const char *trace, int pipeline)
 {
     FILE *fp = fopen(filename, "rb");
     if (fp == NULL) {
@@ -613,8 +1953,25 @@ run_parser_from_file(const char *filename, START_RULE start_rule_func,
 
     // From here on we need to clean up even if there's an error
     mod_ty result = NULL;
-
-    struct tok_state *tok = PyTokenizer_FromFile(fp, NULL, NULL, NULL);
+    struct tok_state *tok = NULL;
+    char *copy = NULL;
+
+    // Read the whole file once and tokenize it as a string, so that the
+    // tokenizer does not copy it line by line and tokens can refer to their
+    // text in place.  The string tokenizer stops at a NUL byte, so files
+    // that contain one are still read with the file tokenizer.
+    Py_ssize_t length;
+    char *buffer = _read_file(fp, &length);
+    if (buffer == NULL) {
+        goto error;
+    }
+    if (memchr(buffer, '\0', length) == NULL) {
+        tok = tok_from_string(buffer, length, &copy);
+    }
+    else {
+        rewind(fp);
+        tok = PyTokenizer_FromFile(fp, NULL, NULL, NULL);
+    }
     if (tok == NULL) {
         goto error;
     }
@@ -622,27 +1979,47 @@ run_parser_from_file(const char *filename, START_RULE start_rule_func,
     tok->filename = filename_ob;
     Py_INCREF(filename_ob);
 
+    if (tok->fp == NULL && _check_utf8(tok) < 0) {
+        goto after_tok_error;
+    }
+
     Parser *p = Parser_New(tok, start_rule_func, FILE_INPUT, arena);
     if (p == NULL) {
         goto after_tok_error;
     }
+    p->skip_actions = skip_actions;
 
-    result = run_parser(p);
+    if (!pipeline || _start_pipeline(p) == 0) {
+        result = _run_parser_with_stats(p, stats, trace);
+    }
     Parser_Free(p);
 
 after_tok_error:
     PyTokenizer_Free(tok);
 error:
+    // The tokenizer may have read it in place
+    PyMem_Free(buffer);
+    PyMem_Free(copy);
     fclose(fp);
     return result;
 }
 
+// Parse the length bytes at str, which need not end with a NUL byte, but must
+// not contain one.  The input is tokenized in place if it can be (see
+// tok_from_string()), so it must not change during the parse.
 mod_ty
-run_parser_from_string(const char *str, START_RULE start_rule_func, PyObject *filename_ob,
-                       PyArena *arena)
+run_parser_from_string(const char *str, Py_ssize_t length, START_RULE start_rule_func,
+                       PyObject *filename_ob, PyArena *arena, int skip_actions,
+                       PyObject **stats, const char *trace, int pipeline)
 {
-    struct tok_state *tok = PyTokenizer_FromString(str, 1);
+    if (memchr(str, '\0', length) != NULL) {
+        PyErr_SetString(PyExc_ValueError, "source code string cannot contain null bytes");
+        return NULL;
+    }
+    char *copy;
+    struct tok_state *tok = tok_from_string(str, length, &copy);
     if (tok == NULL) {
+        PyMem_Free(copy);
         return NULL;
     }
     // This transfers the ownership to the tokenizer
@@ -652,19 +2029,83 @@ run_parser_from_string(const char *str, START_RULE start_rule_func, PyObject *fi
     // We need to clear up from here on
     mod_ty result = NULL;
 
+    if (_check_utf8(tok) < 0) {
+        goto error;
+    }
+
     Parser *p = Parser_New(tok, start_rule_func, STRING_INPUT, arena);
     if (p == NULL) {
         goto error;
     }
+    p->skip_actions = skip_actions;
 
-    result = run_parser(p);
+    if (!pipeline || _start_pipeline(p) == 0) {
+        result = _run_parser_with_stats(p, stats, trace);
+    }
     Parser_Free(p);
 
 error:
     PyTokenizer_Free(tok);
+    PyMem_Free(copy);
     return result;
 }
 
+// Parse the length bytes at str like run_parser_from_string(), but with the
+// Parser that an earlier call left in *pp, if it is not NULL, and leave it
+// there for the next call, which reuses its tokenizer, its token store, its
+// memo and its identifier table.  The tokenizer state that it reads, *ptok,
+// is pointed at str if it can read it in place and has not had to read any
+// tokens; otherwise it is replaced by a new one, with filename_ob, and *copy
+// by the copy of the input that the new one needs, if any.  Once done with
+// them, free *pp, then *ptok, then *copy.
+mod_ty
+run_parser_reusing(Parser **pp, struct tok_state **ptok, char **copy, const char *str,
+                   Py_ssize_t length, START_RULE start_rule_func, PyObject *filename_ob,
+                   PyArena *arena, int skip_actions)
+{
+    if (memchr(str, '\0', length) != NULL) {
+        PyErr_SetString(PyExc_ValueError, "source code string cannot contain null bytes");
+        return NULL;
+    }
+    Parser *p = *pp;
+    if (p == NULL || tokenizer_restart(p->tokenizer, str, length) < 0) {
+        char *new_copy;
+        struct tok_state *tok = tok_from_string(str, length, &new_copy);
+        if (tok == NULL) {
+            PyMem_Free(new_copy);
+            return NULL;
+        }
+        // This transfers the ownership to the tokenizer
+        tok->filename = filename_ob;
+        Py_INCREF(filename_ob);
+        if (p == NULL) {
+            p = Parser_New(tok, start_rule_func, STRING_INPUT, arena);
+            if (p == NULL) {
+                PyTokenizer_Free(tok);
+                PyMem_Free(new_copy);
+                return NULL;
+            }
+            *pp = p;
+        }
+        else {
+            // The new tok takes over before the old one goes
+            tokenizer_reset(p->tokenizer, tok);
+            p->tok = tok;
+        }
+        if (*ptok != NULL) {
+            PyTokenizer_Free(*ptok);
+        }
+        PyMem_Free(*copy);
+        *ptok = tok;
+        *copy = new_copy;
+    }
+    if (Parser_Reset(p, p->tok, start_rule_func, arena) < 0 || _check_utf8(p->tok) < 0) {
+        return NULL;
+    }
+    p->skip_actions = skip_actions;
+    return run_parser(p);
+}
+
 /* Creates a single-element asdl_seq* that contains a */
 asdl_seq *
 singleton_seq(Parser *p, void *a)
@@ -715,7 +2156,6 @@ asdl_seq *
 seq_flatten(Parser *p, asdl_seq *seqs)
 {
     int flattened_seq_size = _get_flattened_seq_size(seqs);
-    assert(flattened_seq_size > 0);
 
     asdl_seq *flattened_seq = _Py_asdl_seq_new(flattened_seq_size, p->arena);
     if (!flattened_seq) {
@@ -1408,6 +2848,7 @@ concatenate_strings(Parser *p, asdl_seq *strings)
 
     int bytesmode = 0;
     PyObject *bytes_str = NULL;
+    PyObject *this_bytes = NULL;
 
     FstringParser state;
     FstringParser_Init(&state);
@@ -1421,10 +2862,11 @@ concatenate_strings(Parser *p, asdl_seq *strings)
         const char *fstr;
         Py_ssize_t fstrlen = -1;
 
-        char *this_str = PyBytes_AsString(t->bytes);
-        if (!this_str) {
+        this_bytes = token_bytes(p, t);
+        if (!this_bytes) {
             goto error;
         }
+        char *this_str = PyBytes_AS_STRING(this_bytes);
 
         if (parsestr(p, this_str, &this_bytesmode, &this_rawmode, &s, &fstr, &fstrlen) != 0) {
             goto error;
@@ -1470,6 +2912,7 @@ concatenate_strings(Parser *p, asdl_seq *strings)
                 }
             }
         }
+        Py_CLEAR(this_bytes);
     }
 
     if (bytesmode) {
@@ -1483,6 +2926,7 @@ concatenate_strings(Parser *p, asdl_seq *strings)
     return FstringParser_Finish(p, &state, first, last);
 
 error:
+    Py_XDECREF(this_bytes);
     Py_XDECREF(bytes_str);
     FstringParser_Dealloc(&state);
     return NULL;
@@ -7,6 +7,7 @@
 #include <Python-ast.h>
 #include <pyarena.h>
 #include <setjmp.h>
+#include "tokenizer.h"
 
 enum INPUT_MODE {
     FILE_INPUT,
@@ -16,10 +17,26 @@ typedef enum INPUT_MODE INPUT_MODE;
 
 enum START_RULE {
     START,
-    EXPRESSIONS
+    EXPRESSIONS,
+    EVAL,
 };
 typedef enum START_RULE START_RULE;
 
+enum MEMO_BACKEND {
+    MEMO_LIST,
+    MEMO_DENSE,
+    MEMO_HASH,
+};
+typedef enum MEMO_BACKEND MEMO_BACKEND;
+
+// Rule types are numbered from FIRST_RULE_TYPE.  The generator gives the
+// rules that touch the memo the lowest numbers, so type - FIRST_RULE_TYPE
+// is a compact index below n_memo_rules for the dense and hash backends.
+#define FIRST_RULE_TYPE 1000
+#define MEMO_BLOCK_ROWS 1024
+// Keyword types are numbered from FIRST_KEYWORD_TYPE.
+#define FIRST_KEYWORD_TYPE 500
+
 typedef struct _memo {
     int type;
     void *node;
@@ -29,26 +46,181 @@ typedef struct _memo {
 
 typedef struct {
     int type;
-    PyObject *bytes;
+    int start, end;  // Offsets of the token's text in the parser's source
     int lineno, col_offset, end_lineno, end_col_offset;
-    Memo *memo;
 } Token;
 
+// The token store is kept in blocks of TOKEN_BLOCK_SIZE tokens, each holding
+// parallel arrays: a packed copy of the types for the hot type checks, the
+// MEMO_LIST chains and the full records.  Blocks never move, so Token
+// pointers stay valid until commit() frees the block.
+#define TOKEN_BLOCK_SIZE 1024
+
+typedef struct {
+    int types[TOKEN_BLOCK_SIZE];
+    Memo *memo[TOKEN_BLOCK_SIZE];
+    Token tokens[TOKEN_BLOCK_SIZE];
+} TokenBlock;
+
 typedef struct {
     char *str;
     int type;
 } KeywordToken;
 
+typedef struct {
+    uint64_t key;  // mark * n_memo_rules + memo index + 1, or 0 if empty
+    int end;       // Value of p->mark after the node
+    void *node;
+} MemoHashEntry;
+
+typedef struct {
+    int start, length;  // Span of the name in the Parser's source
+    unsigned int hash;
+    PyObject *id;  // NULL if the slot is empty; owned by the arena
+} IdentifierEntry;
+
+// What a parse did in one rule, kept when its statistics are asked for.
+typedef struct {
+    long calls;
+    long hits, misses, inserts;  // Of the memo
+    long backtracked;  // Tokens given back by alternatives that failed
+    long saved;  // Parsers generated for profiling; see profile_memo_lookup()
+    // Parsers generated with rule timing; see enter_rule()
+    _PyTime_t self_time, inclusive_time;
+    int active;  // Timed calls in progress
+} RuleStats;
+
+// What a parse did at one token, kept with the statistics.
+typedef struct {
+    int lineno, col_offset, end_lineno, end_col_offset;  // Of the token
+    long calls;  // Rule calls that started at the token
+    long backtracked;  // Times the token was given back
+} PositionStats;
+
+typedef struct {
+    int type;
+    int hit;
+    int counted;
+    int rerun;
+    int mark;   // Where the rule was looked up
+    long work;  // p->profile_work when it was looked up
+} MemoProfileFrame;
+
+typedef struct {
+    int type;
+    _PyTime_t start;
+    _PyTime_t children;  // Time spent in the timed calls it made
+} RuleTimingFrame;
+
+// What a TraceEvent records
+enum TRACE_KIND {
+    TRACE_ENTER,
+    TRACE_EXIT,
+    TRACE_MEMO_HIT,
+    TRACE_MEMO_MISS,
+    TRACE_BACKTRACK,
+};
+typedef enum TRACE_KIND TRACE_KIND;
+
+// The traced parse keeps the last TRACE_EVENTS events; see write_trace().
+#define TRACE_EVENTS (1 << 20)
+
+typedef struct {
+    _PyTime_t time;
+    TRACE_KIND kind;
+    int type;  // Of the rule
+    int mark;  // TRACE_BACKTRACK: the mark given back to
+    // TRACE_EXIT: the mark after the rule, or -1 if it failed; TRACE_MEMO_HIT:
+    // the mark after the node; TRACE_BACKTRACK: the mark before backtracking
+    int end;
+    // Of the token at end for TRACE_EXIT, else at mark; -1 if it is not read
+    int lineno, col_offset;
+} TraceEvent;
+
+// The thread that tokenizes the input ahead of the parser; see fill_token().
+typedef struct TokenPipeline TokenPipeline;
+
 typedef struct {
     struct tok_state *tok;
-    Token **tokens;
+    // Token mark is in token_blocks[mark / TOKEN_BLOCK_SIZE].  Records never
+    // change once filled; the blocks below committed_mark are freed.
+    TokenBlock **token_blocks;
+    int n_token_blocks;
     int mark;
-    int fill, size;
+    int fill;
+    // The statistics of the parse, indexed by type - FIRST_RULE_TYPE, or NULL
+    // if they were not asked for.  See parse_statistics().
+    RuleStats *stats;
+    // With the statistics, those of each token position, indexed by mark.
+    PositionStats *position_stats;
+    int position_stats_size;
+    // Tokens refer to their text by offset into source.  Usually that is the
+    // tokenizer's copy of the whole input.  When a file is tokenized line by
+    // line the tokenizer recycles its line buffer, so fill_token() appends
+    // the text of each token to text_buf, which source then points to.
+    const char *source;
+    char *text_buf;
+    int text_len, text_size;
     PyArena *arena;
     KeywordToken **keywords;
     int n_keyword_lists;
+    // Generated classifier for NAME tokens; if it is NULL, the keywords
+    // lists are scanned instead.
+    int (*classify_keyword)(const char *, int);
+    MEMO_BACKEND memo_backend;
+    int n_memo_rules;
+    // MEMO_DENSE: a [token][memo index] slab, allocated in blocks of
+    // MEMO_BLOCK_ROWS tokens.  Each block holds the end marks (+1, so that 0
+    // means "not memoized") followed by the nodes.
+    char **memo_blocks;
+    int n_memo_blocks;
+    // MEMO_HASH: an open-addressed table keyed by (mark, memo index).
+    MemoHashEntry *memo_table;
+    int memo_table_size, memo_table_used;
+    // The lowest mark at which a pending choice point can resume parsing, or
+    // INT_MAX if there is none.  Only maintained by rules that can reach a
+    // cut; see enter_choice() and commit().
+    int choice_mark;
+    // commit() has dropped the memo and the tokens below this mark.
+    int committed_mark;
+    // MEMO_LIST nodes dropped by commit(), for insert_memo() to reuse.
+    Memo *memo_free;
+    // Identifiers of the NAME tokens seen so far, so that every occurrence of
+    // a name shares one str object.
+    IdentifierEntry *identifiers;
+    int identifiers_size, identifiers_used;
     START_RULE start_rule_func;
     INPUT_MODE input_mode;
+    // Only recognize the input: actions other than the grammar's
+    // @recognizer_actions are skipped and NAME and NUMBER tokens are not
+    // converted, so no AST is built.
+    int skip_actions;
+    // Parsers generated for profiling keep the memo lookups whose nodes are
+    // not inserted yet, innermost last, and the number of memoized rules
+    // being parsed again.
+    MemoProfileFrame *profile_stack;
+    int profile_depth, profile_stack_size, profile_rerun;
+    // The work of the parse so far, in rule calls, failed alternatives and the
+    // tokens they give back, for parsers generated for profiling that keep
+    // statistics.
+    long profile_work;
+    // Parsers generated with rule timing keep the rule calls in progress,
+    // innermost last.
+    RuleTimingFrame *timing_stack;
+    int timing_depth, timing_stack_size;
+    // A ring of the last TRACE_EVENTS events of the parse, or NULL if it is
+    // not traced.  A traced parse also keeps statistics.
+    TraceEvent *trace;
+    long trace_count;  // Events recorded, including those overwritten
+    // Reads the tokens from tok; see tokenizer.c.
+    Tokenizer *tokenizer;
+    // tok->buf as it was after the last token filled, where
+    // raise_syntax_error() finds the line of an error in a string.
+    const char *tok_buf;
+    // The thread that runs the tokenizer ahead of the parser, or NULL if
+    // fill_token() calls the tokenizer itself.  While it runs, only it may
+    // use tokenizer.
+    TokenPipeline *pipeline;
     jmp_buf error_env;
 } Parser;
 
@@ -87,18 +259,25 @@ typedef struct {
     int is_keyword;
 } KeywordOrStarred;
 
-void clear_memo_statistics(void);
-PyObject *get_memo_statistics(void);
+PyObject *parse_statistics(Parser *p);
 
 int insert_memo(Parser *p, int mark, int type, void *node);
 int update_memo(Parser *p, int mark, int type, void *node);
+int profile_memo_lookup(Parser *p, int type, int memoized, void *pres);
+int profile_memo_insert(Parser *p, int mark, int type, int memoized, void *node);
 int is_memoized(Parser *p, int type, void *pres);
+void enter_rule(Parser *p, int type);
+void exit_rule(Parser *p, int type, int success);
+int write_trace(Parser *p, const char *filename);
+void commit(Parser *p);
+int cut(Parser *p, int choice_mark);
 
 int lookahead_with_string(int, void *(func)(Parser *, const char *), Parser *, const char *);
 int lookahead_with_int(int, Token *(func)(Parser *, int), Parser *, int);
 int lookahead(int, void *(func)(Parser *), Parser *);
 
 Token *expect_token(Parser *p, int type);
+PyObject *token_bytes(Parser *p, Token *t);
 Token *get_last_nonnwhitespace_token(Parser *);
 int fill_token(Parser *p);
 void *async_token(Parser *p);
@@ -114,6 +293,13 @@ int raise_syntax_error(Parser *p, const char *errmsg, ...);
 void *CONSTRUCTOR(Parser *p, ...);
 
 #define UNUSED(expr) do { (void)(expr); } while (0)
+#if defined(__GNUC__) || defined(__clang__)
+#define UNLIKELY(cond) __builtin_expect(!!(cond), 0)
+#define COLD __attribute__((cold))
+#else
+#define UNLIKELY(cond) (cond)
+#define COLD
+#endif
 #define EXTRA_EXPR(head, tail) head->lineno, head->col_offset, tail->end_lineno, tail->end_col_offset, p->arena
 #define EXTRA start_lineno, start_col_offset, end_lineno, end_col_offset, p->arena
 
@@ -139,13 +325,99 @@ CHECK_CALL_NULL_ALLOWED(Parser *p, void *result)
 }
 
 #define CHECK(result) CHECK_CALL(p, result)
+
+// The text of a token.  It is not NUL-terminated; use token_bytes() for that.
+Py_LOCAL_INLINE(const char *)
+TOKEN_TEXT(Parser *p, Token *t)
+{
+    return p->source + t->start;
+}
+
+#define TOKEN_LENGTH(t) ((t)->end - (t)->start)
+
+// The record of the token at mark, which must have been filled.
+Py_LOCAL_INLINE(Token *)
+get_token(Parser *p, int mark)
+{
+    assert(0 <= mark && mark < p->fill);
+    return &p->token_blocks[mark / TOKEN_BLOCK_SIZE]->tokens[mark % TOKEN_BLOCK_SIZE];
+}
+
+Py_LOCAL_INLINE(int)
+get_token_type(Parser *p, int mark)
+{
+    assert(0 <= mark && mark < p->fill);
+    return p->token_blocks[mark / TOKEN_BLOCK_SIZE]->types[mark % TOKEN_BLOCK_SIZE];
+}
+
+// The counting is out of line, so that rules that do not keep statistics
+// only pay for the test.
+void count_call_cold(Parser *p, int type) COLD;
+void count_backtrack_cold(Parser *p, int type, int mark) COLD;
+
+// Count a call of the rule of the given type, if the parse keeps statistics.
+Py_LOCAL_INLINE(void)
+count_call(Parser *p, int type)
+{
+    if (UNLIKELY(p->stats != NULL)) {
+        count_call_cold(p, type);
+    }
+}
+
+// Go back to mark, where an alternative of the rule of the given type that
+// failed started.
+Py_LOCAL_INLINE(void)
+backtrack(Parser *p, int type, int mark)
+{
+    if (UNLIKELY(p->stats != NULL)) {
+        count_backtrack_cold(p, type, mark);
+    }
+    p->mark = mark;
+}
+
+// Whether the next token can start an alternative.  Used by parsers generated
+// with FIRST set guards, which pass the set of tokens that can start it as a
+// mask of token types (all below 64) and a mask of keyword types.
+Py_LOCAL_INLINE(int)
+next_token_in(Parser *p, uint64_t tokens, uint64_t keywords)
+{
+    if (p->mark == p->fill && fill_token(p) < 0) {
+        return 0;
+    }
+    unsigned int type = get_token_type(p, p->mark);
+    if (type < 64) {
+        return (tokens >> type) & 1;
+    }
+    type -= FIRST_KEYWORD_TYPE;
+    return type < 64 && ((keywords >> type) & 1);
+}
+
+// Note a choice point that resumes parsing at mark if what follows fails.
+// Choice points nest, and one that is entered later never resumes below an
+// earlier one, so only the outermost one's mark needs to be kept.  Returns
+// the previous choice_mark, which the caller restores once the choice point
+// is gone.
+Py_LOCAL_INLINE(int)
+enter_choice(Parser *p, int mark)
+{
+    int choice_mark = p->choice_mark;
+    if (mark < choice_mark) {
+        p->choice_mark = mark;
+    }
+    return choice_mark;
+}
 #define CHECK_NULL_ALLOWED(result) CHECK_CALL_NULL_ALLOWED(p, result)
 
 PyObject *new_identifier(Parser *, char *);
 Parser *Parser_New(struct tok_state *, START_RULE, int, PyArena *);
 void Parser_Free(Parser *);
-mod_ty run_parser_from_file(const char *, START_RULE, PyObject *, PyArena *);
-mod_ty run_parser_from_string(const char *, START_RULE, PyObject *, PyArena *);
+int Parser_Reset(Parser *, struct tok_state *, START_RULE, PyArena *);
+mod_ty run_parser_from_file(const char *, START_RULE, PyObject *, PyArena *, int,
+                            PyObject **, const char *, int);
+mod_ty run_parser_from_string(const char *, Py_ssize_t, START_RULE, PyObject *, PyArena *,
+                              int, PyObject **, const char *, int);
+mod_ty run_parser_reusing(Parser **, struct tok_state **, char **, const char *, Py_ssize_t,
+                          START_RULE, PyObject *, PyArena *, int);
 asdl_seq *singleton_seq(Parser *, void *);
 asdl_seq *seq_insert_in_front(Parser *, void *, asdl_seq *);
 asdl_seq *seq_flatten(Parser *, asdl_seq *);
@@ -175,5 +447,11 @@ asdl_seq *seq_delete_starred_exprs(Parser *, asdl_seq *);
 expr_ty concatenate_strings(Parser *p, asdl_seq *);
 
 void *parse(Parser *);
+// The number of rules and their names, indexed by type - FIRST_RULE_TYPE
+extern const int n_rules;
+extern const char *const rule_names[];
+// Whether the rules call count_call() and backtrack(); only parsers generated
+// with --parse-stats, for profiling or with rule timing do
+extern const int counts_rule_calls;
 
 #endif
@@ -0,0 +1,930 @@
+// A scanner for the input that CPython's tokenizer reads as a string.  It
+// returns the tokens that PyTokenizer_Get() returns, with the same positions,
+// but reads the input in place, skips whitespace, names, comments and the
+// bodies of strings a vector at a time, and never calls into Python, so it can
+// run without the GIL.  It gives up on what it does not handle the same way,
+// which is mostly errors and names that are not ASCII, and the CPython
+// tokenizer then takes over from there; see tokenizer_get().
+//
+// The scanner follows tok_get() and tok_nextc() of CPython 3.8 closely, down
+// to the order in which they read and back up characters, since the lines
+// the tokenizer has read decide the positions of the tokens.
+
+#include "tokenizer.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#define TABSIZE 8
+#define ALTTABSIZE 1
+
+enum TOKENIZER_STATE {
+    SCANNING,  // tokenizer_scan() reads the tokens
+    GAVE_UP,  // It gave up, or is not used, and tok has to catch up with it
+    CPYTHON,  // tok reads the tokens
+};
+typedef enum TOKENIZER_STATE TOKENIZER_STATE;
+
+struct Tokenizer {
+    struct tok_state *tok;
+    TOKENIZER_STATE state;
+    int count;  // Tokens that tokenizer_scan() returned
+    // The input of a string tokenizer.  If tok reads it in place, it need not
+    // end with a NUL byte, and tok reads a copy of it when it takes over,
+    // whose pointers are mapped back to the input.
+    const char *input, *end;
+    int in_place;
+    char *copy;
+    // The fields of tok that the scanner keeps for itself.  The input has been
+    // read up to inp, the end of the current line.
+    const char *cur, *inp;
+    const char *start;  // Of the current token, or NULL between tokens
+    const char *buf, *line_start, *multi_line_start;
+    int lineno, first_lineno;
+    int eof;
+    int atbol, pendin;
+    int indent, indstack[MAXINDENT], altindstack[MAXINDENT];
+    int level;
+    char parenstack[MAXLEVEL];
+};
+
+#define IS_NAME_START(c) (Py_ISALPHA(c) || (c) == '_' || (c) >= 128)
+#define IS_NAME_CHAR(c) (Py_ISALNUM(c) || (c) == '_')
+
+// The first byte in [s, end) that cannot be part of an ASCII name, or end.
+static inline const char *
+_span_name(const char *s, const char *end)
+{
+#if defined(__AVX2__)
+    for (; end - s >= 32; s += 32) {
+        __m256i v = _mm256_loadu_si256((const __m256i *)s);
+        // Letters are in 'a'..'z' once lower-cased, digits in '0'..'9'
+        __m256i lower = _mm256_or_si256(v, _mm256_set1_epi8(0x20));
+        __m256i alpha = _mm256_cmpgt_epi8(_mm256_set1_epi8(-128 + 26),
+                                          _mm256_add_epi8(lower, _mm256_set1_epi8(128 - 'a')));
+        __m256i digit = _mm256_cmpgt_epi8(_mm256_set1_epi8(-128 + 10),
+                                          _mm256_add_epi8(v, _mm256_set1_epi8(128 - '0')));
+        __m256i under = _mm256_cmpeq_epi8(v, _mm256_set1_epi8('_'));
+        unsigned int mask = ~(unsigned int)_mm256_movemask_epi8(
+            _mm256_or_si256(_mm256_or_si256(alpha, digit), under));
+        if (mask != 0) {
+            return s + __builtin_ctz(mask);
+        }
+    }
+#elif defined(__SSE2__)
+    for (; end - s >= 16; s += 16) {
+        __m128i v = _mm_loadu_si128((const __m128i *)s);
+        __m128i lower = _mm_or_si128(v, _mm_set1_epi8(0x20));
+        __m128i alpha = _mm_cmplt_epi8(_mm_add_epi8(lower, _mm_set1_epi8(128 - 'a')),
+                                       _mm_set1_epi8(-128 + 26));
+        __m128i digit = _mm_cmplt_epi8(_mm_add_epi8(v, _mm_set1_epi8(128 - '0')),
+                                       _mm_set1_epi8(-128 + 10));
+        __m128i under = _mm_cmpeq_epi8(v, _mm_set1_epi8('_'));
+        unsigned int mask =
+            ~_mm_movemask_epi8(_mm_or_si128(_mm_or_si128(alpha, digit), under)) & 0xffff;
+        if (mask != 0) {
+            return s + __builtin_ctz(mask);
+        }
+    }
+#endif
+    while (s < end && IS_NAME_CHAR(Py_CHARMASK(*s))) {
+        s++;
+    }
+    return s;
+}
+
+// The first byte in [s, end) that is not a space, or end.
+static inline const char *
+_span_spaces(const char *s, const char *end)
+{
+#if defined(__AVX2__)
+    for (; end - s >= 32; s += 32) {
+        __m256i v = _mm256_loadu_si256((const __m256i *)s);
+        unsigned int mask =
+            ~(unsigned int)_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, _mm256_set1_epi8(' ')));
+        if (mask != 0) {
+            return s + __builtin_ctz(mask);
+        }
+    }
+#elif defined(__SSE2__)
+    for (; end - s >= 16; s += 16) {
+        __m128i v = _mm_loadu_si128((const __m128i *)s);
+        unsigned int mask = ~_mm_movemask_epi8(_mm_cmpeq_epi8(v, _mm_set1_epi8(' '))) & 0xffff;
+        if (mask != 0) {
+            return s + __builtin_ctz(mask);
+        }
+    }
+#endif
+    while (s < end && *s == ' ') {
+        s++;
+    }
+    return s;
+}
+
+// The first quote, backslash or newline in [s, end), or end: the characters
+// of the body of a string that need a look.
+static inline const char *
+_find_string_special(const char *s, const char *end, char quote)
+{
+#if defined(__AVX2__)
+    for (; end - s >= 32; s += 32) {
+        __m256i v = _mm256_loadu_si256((const __m256i *)s);
+        __m256i special = _mm256_or_si256(
+            _mm256_or_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8(quote)),
+                            _mm256_cmpeq_epi8(v, _mm256_set1_epi8('\\'))),
+            _mm256_cmpeq_epi8(v, _mm256_set1_epi8('\n')));
+        unsigned int mask = (unsigned int)_mm256_movemask_epi8(special);
+        if (mask != 0) {
+            return s + __builtin_ctz(mask);
+        }
+    }
+#elif defined(__SSE2__)
+    for (; end - s >= 16; s += 16) {
+        __m128i v = _mm_loadu_si128((const __m128i *)s);
+        __m128i special =
+            _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8(quote)),
+                                      _mm_cmpeq_epi8(v, _mm_set1_epi8('\\'))),
+                         _mm_cmpeq_epi8(v, _mm_set1_epi8('\n')));
+        unsigned int mask = _mm_movemask_epi8(special);
+        if (mask != 0) {
+            return s + __builtin_ctz(mask);
+        }
+    }
+#endif
+    while (s < end && *s != quote && *s != '\\' && *s != '\n') {
+        s++;
+    }
+    return s;
+}
+
+// tok_nextc(): the next character, reading the next line if the current one
+// is used up.
+static inline int
+_nextc(Tokenizer *t)
+{
+    if (t->cur != t->inp) {
+        return Py_CHARMASK(*t->cur++);
+    }
+    if (t->eof || t->inp == t->end) {
+        t->eof = 1;
+        return EOF;
+    }
+    const char *newline = memchr(t->inp, '\n', t->end - t->inp);
+    if (t->start == NULL) {
+        t->buf = t->cur;
+    }
+    t->line_start = t->cur;
+    t->lineno++;
+    t->inp = newline != NULL ? newline + 1 : t->end;
+    return Py_CHARMASK(*t->cur++);
+}
+
+static inline void
+_backup(Tokenizer *t, int c)
+{
+    if (c != EOF) {
+        t->cur--;
+    }
+}
+
+// tok_decimal_tail(): the character after the digits, or 0 for an
+// underscore that is not followed by a digit.
+static int
+_decimal_tail(Tokenizer *t)
+{
+    int c;
+    while (1) {
+        do {
+            c = _nextc(t);
+        } while (Py_ISDIGIT(c));
+        if (c != '_') {
+            break;
+        }
+        c = _nextc(t);
+        if (!Py_ISDIGIT(c)) {
+            return 0;
+        }
+    }
+    return c;
+}
+
+// tok_get(): the type of the next token, or -1 to give up.  Where the CPython
+// tokenizer reports an error, this gives up, and so does it for names that
+// are not ASCII, which CPython checks with Python's unicodedata.
+static int
+_scan(Tokenizer *t, const char **p_start, const char **p_end)
+{
+    int c, blankline;
+    *p_start = *p_end = NULL;
+
+nextline:
+    t->start = NULL;
+    blankline = 0;
+
+    // The indentation of a new line
+    if (t->atbol) {
+        int col = 0, altcol = 0;
+        t->atbol = 0;
+        for (;;) {
+            c = _nextc(t);
+            if (c == ' ') {
+                const char *s = _span_spaces(t->cur, t->inp);
+                col += 1 + (int)(s - t->cur);
+                altcol += 1 + (int)(s - t->cur);
+                t->cur = s;
+            }
+            else if (c == '\t') {
+                col = (col / TABSIZE + 1) * TABSIZE;
+                altcol = (altcol / ALTTABSIZE + 1) * ALTTABSIZE;
+            }
+            else if (c == '\014') {
+                col = altcol = 0;
+            }
+            else {
+                break;
+            }
+        }
+        _backup(t, c);
+        if (c == '#' || c == '\n') {
+            blankline = 1;
+        }
+        else if (c == '\\') {
+            // Whether a continuation line counts as blank changed after 3.8
+            return -1;
+        }
+        if (!blankline && t->level == 0) {
+            if (col == t->indstack[t->indent]) {
+                if (altcol != t->altindstack[t->indent]) {
+                    return -1;
+                }
+            }
+            else if (col > t->indstack[t->indent]) {
+                if (t->indent + 1 >= MAXINDENT || altcol <= t->altindstack[t->indent]) {
+                    return -1;
+                }
+                t->pendin++;
+                t->indstack[++t->indent] = col;
+                t->altindstack[t->indent] = altcol;
+            }
+            else {
+                while (t->indent > 0 && col < t->indstack[t->indent]) {
+                    t->pendin--;
+                    t->indent--;
+                }
+                if (col != t->indstack[t->indent] || altcol != t->altindstack[t->indent]) {
+                    return -1;
+                }
+            }
+        }
+    }
+
+    t->start = t->cur;
+    if (t->pendin != 0) {
+        if (t->pendin < 0) {
+            t->pendin++;
+            return DEDENT;
+        }
+        t->pendin--;
+        return INDENT;
+    }
+
+    // tok_get() peeks at the next character here, for async/await
+    c = _nextc(t);
+    _backup(t, c);
+
+again:
+    t->start = NULL;
+    do {
+        c = _nextc(t);
+    } while (c == ' ' || c == '\t' || c == '\014');
+    t->start = t->cur - 1;
+
+    if (c == '#') {
+        while (c != EOF && c != '\n') {
+            const char *newline = memchr(t->cur, '\n', t->inp - t->cur);
+            if (newline != NULL) {
+                t->cur = newline + 1;
+                c = '\n';
+            }
+            else {
+                t->cur = t->inp;
+                c = _nextc(t);
+            }
+        }
+    }
+
+    if (c == EOF) {
+        return t->eof ? ENDMARKER : -1;
+    }
+
+    if (IS_NAME_START(c)) {
+        // The prefixes of strings: b, r, u, f and their combinations
+        int saw_b = 0, saw_r = 0, saw_u = 0, saw_f = 0;
+        while (1) {
+            if (!(saw_b || saw_u || saw_f) && (c == 'b' || c == 'B')) {
+                saw_b = 1;
+            }
+            else if (!(saw_b || saw_u || saw_r || saw_f) && (c == 'u' || c == 'U')) {
+                saw_u = 1;
+            }
+            else if (!(saw_r || saw_u) && (c == 'r' || c == 'R')) {
+                saw_r = 1;
+            }
+            else if (!(saw_f || saw_b || saw_u) && (c == 'f' || c == 'F')) {
+                saw_f = 1;
+            }
+            else {
+                break;
+            }
+            c = _nextc(t);
+            if (c == '"' || c == '\'') {
+                goto letter_quote;
+            }
+        }
+        if (c < 128 && IS_NAME_CHAR(c)) {
+            t->cur = _span_name(t->cur, t->inp);
+            c = _nextc(t);
+        }
+        if (c >= 128) {
+            return -1;
+        }
+        _backup(t, c);
+        *p_start = t->start;
+        *p_end = t->cur;
+        // Without async_hacks, the tokenizer always tells these apart
+        if (t->cur - t->start == 5 && t->start[0] == 'a') {
+            if (memcmp(t->start, "async", 5) == 0) {
+                return ASYNC;
+            }
+            if (memcmp(t->start, "await", 5) == 0) {
+                return AWAIT;
+            }
+        }
+        return NAME;
+    }
+
+    if (c == '\n') {
+        t->atbol = 1;
+        if (blankline || t->level > 0) {
+            goto nextline;
+        }
+        *p_start = t->start;
+        *p_end = t->cur - 1;  // Without the newline
+        return NEWLINE;
+    }
+
+    if (c == '.') {
+        c = _nextc(t);
+        if (Py_ISDIGIT(c)) {
+            goto fraction;
+        }
+        else if (c == '.') {
+            c = _nextc(t);
+            if (c == '.') {
+                *p_start = t->start;
+                *p_end = t->cur;
+                return ELLIPSIS;
+            }
+            _backup(t, c);
+            _backup(t, '.');
+        }
+        else {
+            _backup(t, c);
+        }
+        *p_start = t->start;
+        *p_end = t->cur;
+        return DOT;
+    }
+
+    if (Py_ISDIGIT(c)) {
+        if (c == '0') {
+            c = _nextc(t);
+            if (c == 'x' || c == 'X') {
+                c = _nextc(t);
+                do {
+                    if (c == '_') {
+                        c = _nextc(t);
+                    }
+                    if (!Py_ISXDIGIT(c)) {
+                        return -1;
+                    }
+                    do {
+                        c = _nextc(t);
+                    } while (Py_ISXDIGIT(c));
+                } while (c == '_');
+            }
+            else if (c == 'o' || c == 'O') {
+                c = _nextc(t);
+                do {
+                    if (c == '_') {
+                        c = _nextc(t);
+                    }
+                    if (c < '0' || c >= '8') {
+                        return -1;
+                    }
+                    do {
+                        c = _nextc(t);
+                    } while ('0' <= c && c < '8');
+                } while (c == '_');
+                if (Py_ISDIGIT(c)) {
+                    return -1;
+                }
+            }
+            else if (c == 'b' || c == 'B') {
+                c = _nextc(t);
+                do {
+                    if (c == '_') {
+                        c = _nextc(t);
+                    }
+                    if (c != '0' && c != '1') {
+                        return -1;
+                    }
+                    do {
+                        c = _nextc(t);
+                    } while (c == '0' || c == '1');
+                } while (c == '_');
+                if (Py_ISDIGIT(c)) {
+                    return -1;
+                }
+            }
+            else {
+                int nonzero = 0;
+                // Zeros, then digits that are only allowed before a fraction
+                while (1) {
+                    if (c == '_') {
+                        c = _nextc(t);
+                        if (!Py_ISDIGIT(c)) {
+                            return -1;
+                        }
+                    }
+                    if (c != '0') {
+                        break;
+                    }
+                    c = _nextc(t);
+                }
+                if (Py_ISDIGIT(c)) {
+                    nonzero = 1;
+                    c = _decimal_tail(t);
+                    if (c == 0) {
+                        return -1;
+                    }
+                }
+                if (c == '.') {
+                    c = _nextc(t);
+                    goto fraction;
+                }
+                else if (c == 'e' || c == 'E') {
+                    goto exponent;
+                }
+                else if (c == 'j' || c == 'J') {
+                    goto imaginary;
+                }
+                else if (nonzero) {
+                    return -1;
+                }
+            }
+        }
+        else {
+            c = _decimal_tail(t);
+            if (c == 0) {
+                return -1;
+            }
+            if (c == '.') {
+                c = _nextc(t);
+            fraction:
+                if (Py_ISDIGIT(c)) {
+                    c = _decimal_tail(t);
+                    if (c == 0) {
+                        return -1;
+                    }
+                }
+            }
+            if (c == 'e' || c == 'E') {
+                int e;
+            exponent:
+                e = c;
+                c = _nextc(t);
+                if (c == '+' || c == '-') {
+                    c = _nextc(t);
+                    if (!Py_ISDIGIT(c)) {
+                        return -1;
+                    }
+                }
+                else if (!Py_ISDIGIT(c)) {
+                    _backup(t, c);
+                    _backup(t, e);
+                    *p_start = t->start;
+                    *p_end = t->cur;
+                    return NUMBER;
+                }
+                c = _decimal_tail(t);
+                if (c == 0) {
+                    return -1;
+                }
+            }
+            if (c == 'j' || c == 'J') {
+            imaginary:
+                c = _nextc(t);
+            }
+        }
+        _backup(t, c);
+        *p_start = t->start;
+        *p_end = t->cur;
+        return NUMBER;
+    }
+
+letter_quote:
+    if (c == '\'' || c == '"') {
+        int quote = c;
+        int quote_size = 1;
+        int end_quote_size = 0;
+        t->first_lineno = t->lineno;
+        t->multi_line_start = t->line_start;
+
+        c = _nextc(t);
+        if (c == quote) {
+            c = _nextc(t);
+            if (c == quote) {
+                quote_size = 3;
+            }
+            else {
+                end_quote_size = 1;  // An empty string
+            }
+        }
+        if (c != quote) {
+            _backup(t, c);
+        }
+
+        while (end_quote_size != quote_size) {
+            // Skip to the next character that matters, within the line
+            if (t->cur != t->inp) {
+                const char *s = _find_string_special(t->cur, t->inp, quote);
+                if (s != t->cur) {
+                    end_quote_size = 0;
+                    t->cur = s;
+                }
+            }
+            c = _nextc(t);
+            if (c == EOF || (quote_size == 1 && c == '\n')) {
+                return -1;
+            }
+            if (c == quote) {
+                end_quote_size += 1;
+            }
+            else {
+                end_quote_size = 0;
+                if (c == '\\') {
+                    _nextc(t);
+                }
+            }
+        }
+        *p_start = t->start;
+        *p_end = t->cur;
+        return STRING;
+    }
+
+    if (c == '\\') {
+        c = _nextc(t);
+        if (c != '\n') {
+            return -1;
+        }
+        c = _nextc(t);
+        if (c == EOF) {
+            return -1;
+        }
+        _backup(t, c);
+        goto again;
+    }
+
+    {
+        int c2 = _nextc(t);
+        int token = PyToken_TwoChars(c, c2);
+        if (token != OP) {
+            int c3 = _nextc(t);
+            int token3 = PyToken_ThreeChars(c, c2, c3);
+            if (token3 != OP) {
+                token = token3;
+            }
+            else {
+                _backup(t, c3);
+            }
+            *p_start = t->start;
+            *p_end = t->cur;
+            return token;
+        }
+        _backup(t, c2);
+    }
+
+    switch (c) {
+        case '(':
+        case '[':
+        case '{':
+            if (t->level >= MAXLEVEL) {
+                return -1;
+            }
+            t->parenstack[t->level++] = c;
+            break;
+        case ')':
+        case ']':
+        case '}':
+            if (t->level == 0) {
+                return -1;
+            }
+            t->level--;
+            int opening = t->parenstack[t->level];
+            if (!((opening == '(' && c == ')') || (opening == '[' && c == ']') ||
+                  (opening == '{' && c == '}'))) {
+                return -1;
+            }
+            break;
+    }
+
+    *p_start = t->start;
+    *p_end = t->cur;
+    return PyToken_OneChar(c);
+}
+
+// The pointer into the input for a pointer p into tok's copy of it, or NULL.
+static inline const char *
+_from_copy(Tokenizer *t, const char *p)
+{
+    if (t->copy == NULL || p == NULL) {
+        return p;
+    }
+    return t->input + (p - t->copy);
+}
+
+// Fill r from what the CPython tokenizer returns.
+static void
+_get_cpython_token(Tokenizer *t, RawToken *r)
+{
+    struct tok_state *tok = t->tok;
+    char *start, *end;
+    r->type = PyTokenizer_Get(tok, &start, &end);
+    r->start = _from_copy(t, start);
+    r->end = _from_copy(t, end);
+    r->lineno = r->type == STRING ? tok->first_lineno : tok->lineno;
+    const char *line_start = r->type == STRING ? tok->multi_line_start : tok->line_start;
+    r->end_lineno = tok->lineno;
+    r->col_offset = -1;
+    r->end_col_offset = -1;
+    if (start != NULL && start >= line_start) {
+        r->col_offset = start - line_start;
+    }
+    if (end != NULL && end >= tok->line_start) {
+        r->end_col_offset = end - tok->line_start;
+    }
+    r->buf = _from_copy(t, tok->buf);
+}
+
+// Whether the first two lines of str, where CPython looks for a coding
+// cookie, contain "coding".  A cookie needs that, and more.
+static int
+_may_have_cookie(const char *str, Py_ssize_t length)
+{
+    const char *end = str + length;
+    for (int line = 0; line < 2 && str < end; line++) {
+        const char *newline = memchr(str, '\n', end - str);
+        const char *line_end = newline != NULL ? newline : end;
+        for (const char *c = str; (c = memchr(c, 'c', line_end - c)) != NULL; c++) {
+            if (line_end - c >= 6 && memcmp(c, "coding", 6) == 0) {
+                return 1;
+            }
+        }
+        str = line_end + 1;
+    }
+    return 0;
+}
+
+// Whether the string tokenizer translates or decodes str, or adds a newline
+// to it, so that it cannot read str in place.
+static int
+_must_translate(const char *str, Py_ssize_t length)
+{
+    int bom = length >= 3 && memcmp(str, "\xef\xbb\xbf", 3) == 0;
+    return length == 0 || str[length - 1] != '\n' || memchr(str, '\r', length) != NULL ||
+           bom || _may_have_cookie(str, length);
+}
+
+// A CPython tokenizer for the length bytes at str, which must not contain a
+// NUL byte but need not end with one, as PyTokenizer_FromString(str, 1)
+// returns it.  That one decodes str and translates its newlines into a copy
+// of it, but if there is nothing to translate or decode -- str has no '\r',
+// BOM or coding cookie, and ends with the newline that the tokenizer adds to
+// input for exec -- the tokenizer reads str in place instead, which it does
+// not write to, so str must outlive it.  Otherwise str is copied first, to
+// end it with a NUL byte, and *copy is set to the copy, which must be freed
+// after the tokenizer; else it is set to NULL.  Returns NULL with an
+// exception set on failure.
+struct tok_state *
+tok_from_string(const char *str, Py_ssize_t length, char **copy)
+{
+    *copy = NULL;
+    if (_must_translate(str, length)) {
+        *copy = PyMem_Malloc(length + 1);
+        if (*copy == NULL) {
+            PyErr_NoMemory();
+            return NULL;
+        }
+        memcpy(*copy, str, length);
+        (*copy)[length] = '\0';
+        return PyTokenizer_FromString(*copy, 1);
+    }
+    // A tokenizer for a string with nothing to translate, pointed at str.
+    // Its end, which the string tokenizer does not use otherwise, marks the
+    // end of the input; see tok_input_end().
+    struct tok_state *tok = PyTokenizer_FromString("\n", 1);
+    if (tok == NULL) {
+        return NULL;
+    }
+    tok->buf = tok->cur = tok->inp = (char *)str;
+    tok->end = (char *)str + length;
+    tok->str = str;
+    return tok;
+}
+
+// The end of the input of a string tokenizer that has not read any of it.
+// PyTokenizer_FromString() leaves end at the start of its NUL-terminated
+// copy, tok_from_string() sets it to the end of the input that it reads in
+// place.
+const char *
+tok_input_end(struct tok_state *tok)
+{
+    assert(tok->fp == NULL);
+    return tok->end > tok->buf ? tok->end : tok->buf + strlen(tok->buf);
+}
+
+static void
+_tokenizer_init(Tokenizer *t, struct tok_state *tok, int own)
+{
+    t->tok = tok;
+    t->count = 0;
+    t->input = t->end = NULL;
+    t->in_place = 0;
+    t->copy = NULL;
+    if (tok->fp != NULL) {
+        t->state = CPYTHON;
+        return;
+    }
+    t->input = tok->buf;
+    t->end = tok_input_end(tok);
+    t->in_place = tok->end > tok->buf;
+    if (!own || tok->prompt != NULL || tok->type_comments || tok->async_hacks) {
+        t->state = GAVE_UP;
+        return;
+    }
+    t->state = SCANNING;
+    t->cur = t->inp = t->buf = tok->buf;
+    t->start = NULL;
+    t->line_start = tok->line_start;
+    t->multi_line_start = tok->multi_line_start;
+    t->lineno = tok->lineno;
+    t->first_lineno = tok->first_lineno;
+    t->eof = 0;
+    t->atbol = tok->atbol;
+    t->pendin = 0;
+    t->indent = 0;
+    t->indstack[0] = 0;
+    t->altindstack[0] = 0;
+    t->level = 0;
+}
+
+// Read the tokens of tok's input, with the scanner if own is set and the
+// input is tokenized as a string.  Returns NULL with an exception set if
+// there is no memory.
+Tokenizer *
+Tokenizer_New(struct tok_state *tok, int own)
+{
+    Tokenizer *t = PyMem_Malloc(sizeof(Tokenizer));
+    if (t == NULL) {
+        PyErr_NoMemory();
+        return NULL;
+    }
+    _tokenizer_init(t, tok, own);
+    return t;
+}
+
+void
+Tokenizer_Free(Tokenizer *t)
+{
+    PyMem_Free(t->copy);
+    PyMem_Free(t);
+}
+
+// Read the tokens of tok instead, with the scanner, as a new Tokenizer would.
+void
+tokenizer_reset(Tokenizer *t, struct tok_state *tok)
+{
+    PyMem_Free(t->copy);
+    _tokenizer_init(t, tok, 1);
+}
+
+// Point the tok of t, which tok_from_string() made to read its input in
+// place, at the length bytes at str, as tok_from_string() would make a new
+// one, and reset t to read them.  That is only possible if tok can read str
+// in place too, and if it has not read any tokens, as it has not while the
+// scanner read them all.  Returns 0, or -1 if a new tok is needed.
+int
+tokenizer_restart(Tokenizer *t, const char *str, Py_ssize_t length)
+{
+    if (!t->in_place || t->state == CPYTHON || _must_translate(str, length)) {
+        return -1;
+    }
+    struct tok_state *tok = t->tok;
+    tok->buf = tok->cur = tok->inp = (char *)str;
+    tok->end = (char *)str + length;
+    tok->str = str;
+    tokenizer_reset(t, tok);
+    return 0;
+}
+
+// The bytes of the input, or 0 if it is read from a file.
+Py_ssize_t
+tokenizer_input_size(Tokenizer *t)
+{
+    return t->end - t->input;
+}
+
+// Let tok read a NUL-terminated copy of the input that it reads in place,
+// since it reads one byte past the end of its input.  Returns -1 with an
+// exception set if there is no memory.
+static int
+_copy_input(Tokenizer *t)
+{
+    Py_ssize_t length = t->end - t->input;
+    t->copy = PyMem_Malloc(length + 1);
+    if (t->copy == NULL) {
+        PyErr_NoMemory();
+        return -1;
+    }
+    memcpy(t->copy, t->input, length);
+    t->copy[length] = '\0';
+    struct tok_state *tok = t->tok;
+    tok->buf = tok->cur = tok->inp = t->copy;
+    tok->end = t->copy + length;
+    tok->str = t->copy;
+    return 0;
+}
+
+// Read the next token with the scanner.  Returns 0, or -1 if the scanner
+// gave up, now or before, or is not used.  This does not need the GIL.
+int
+tokenizer_scan(Tokenizer *t, RawToken *r)
+{
+    if (t->state != SCANNING) {
+        return -1;
+    }
+    const char *start, *end;
+    int type = _scan(t, &start, &end);
+    if (type < 0) {
+        t->state = GAVE_UP;
+        return -1;
+    }
+    t->count++;
+    r->type = type;
+    r->start = start;
+    r->end = end;
+    r->lineno = type == STRING ? t->first_lineno : t->lineno;
+    const char *line_start = type == STRING ? t->multi_line_start : t->line_start;
+    r->end_lineno = t->lineno;
+    r->col_offset = -1;
+    r->end_col_offset = -1;
+    if (start != NULL && start >= line_start) {
+        r->col_offset = start - line_start;
+    }
+    if (end != NULL && end >= t->line_start) {
+        r->end_col_offset = end - t->line_start;
+    }
+    r->buf = t->buf;
+    return 0;
+}
+
+// Read the next token.  If the scanner gives up, the CPython tokenizer reads
+// the tokens that the scanner returned again, to get to the same state, and
+// the rest of them.
+void
+tokenizer_get(Tokenizer *t, RawToken *r)
+{
+    if (t->state == SCANNING && tokenizer_scan(t, r) == 0) {
+        return;
+    }
+    if (t->state == GAVE_UP) {
+        if (t->in_place && _copy_input(t) < 0) {
+            r->type = ERRORTOKEN;
+            r->start = r->end = NULL;
+            r->lineno = r->end_lineno = t->tok->lineno;
+            r->col_offset = r->end_col_offset = -1;
+            r->buf = t->input;
+            return;
+        }
+        char *start, *end;
+        for (int i = 0; i < t->count; i++) {
+            PyTokenizer_Get(t->tok, &start, &end);
+        }
+        t->state = CPYTHON;
+    }
+    _get_cpython_token(t, r);
+}
@@ -0,0 +1,32 @@
+#ifndef PEGEN_TOKENIZER_H
+#define PEGEN_TOKENIZER_H
+
+#define PY_SSIZE_T_CLEAN
+#include <Python.h>
+#include <token.h>
+#include "v38tokenizer.h"
+
+// A token as a tokenizer returned it, before NAME tokens are told apart from
+// keywords.  The positions are those that CPython's tokenizer gives it.
+typedef struct {
+    int type;
+    const char *start, *end;  // The text, or NULL for INDENT, DEDENT and ENDMARKER
+    int lineno, col_offset, end_lineno, end_col_offset;
+    const char *buf;  // tok->buf after the token; see raise_syntax_error()
+} RawToken;
+
+// Reads the tokens of the input of a CPython tokenizer, either with a scanner
+// of its own or with the CPython tokenizer itself; see tokenizer_scan().
+typedef struct Tokenizer Tokenizer;
+
+struct tok_state *tok_from_string(const char *str, Py_ssize_t length, char **copy);
+const char *tok_input_end(struct tok_state *tok);
+Tokenizer *Tokenizer_New(struct tok_state *tok, int own);
+void Tokenizer_Free(Tokenizer *t);
+void tokenizer_reset(Tokenizer *t, struct tok_state *tok);
+int tokenizer_restart(Tokenizer *t, const char *str, Py_ssize_t length);
+Py_ssize_t tokenizer_input_size(Tokenizer *t);
+int tokenizer_scan(Tokenizer *t, RawToken *r);
+void tokenizer_get(Tokenizer *t, RawToken *r);
+
+#endif
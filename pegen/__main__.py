@@ -49,6 +49,32 @@ argparser.add_argument(
 argparser.add_argument(
     "--skip-actions", action="store_true", help="Suppress code emission for rule actions",
 )
+argparser.add_argument(
+    "--memo-backend",
+    choices=["list", "dense", "hash"],
+    default="list",
+    help="How the C parser stores memoized results (default list)",
+)
+argparser.add_argument(
+    "--first-set-guards",
+    action="store_true",
+    help="Skip rules and alternatives of the C parser that cannot start with the next token",
+)
+argparser.add_argument(
+    "--memo-profile",
+    metavar="PROFILE",
+    help="Memoize the rules of the C parser for which the profile shows that it pays off",
+)
+argparser.add_argument(
+    "--rule-timing",
+    action="store_true",
+    help="Time and trace the rule calls of the C parser when a parse is asked to",
+)
+argparser.add_argument(
+    "--parse-stats",
+    action="store_true",
+    help="Count the rule calls of the C parser when a parse is asked for its statistics",
+)
 
 
 def main() -> None:
@@ -75,6 +101,11 @@ def main() -> None:
             args.verbose,
             keep_asserts_in_extension=False if args.optimized else True,
             skip_actions=args.skip_actions,
+            memo_backend=args.memo_backend,
+            first_set_guards=args.first_set_guards,
+            memo_profile=args.memo_profile,
+            rule_timing=args.rule_timing,
+            parse_stats=args.parse_stats,
         )
     except Exception as err:
         if args.verbose:
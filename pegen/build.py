@@ -12,6 +12,7 @@ from distutils.command.build_ext import build_ext  # type: ignore
 from pegen.c_generator import CParserGenerator
 from pegen.grammar import Grammar
 from pegen.grammar_parser import GeneratedParser as GrammarParser
+from pegen.memo_profile import read_memo_profile
 from pegen.parser import Parser
 from pegen.parser_generator import ParserGenerator
 from pegen.python_generator import PythonParserGenerator
@@ -50,6 +51,7 @@ def compile_c_extension(
             sources=[
                 str(MOD_DIR.parent / "peg_parser" / "pegen.c"),
                 str(MOD_DIR.parent / "peg_parser" / "parse_string.c"),
+                str(MOD_DIR.parent / "peg_parser" / "tokenizer.c"),
                 str(MOD_DIR.parent / "peg_parser" / "peg_extension.c"),
                 generated_source_path,
             ],
@@ -98,14 +100,32 @@ def build_generator(
     verbose_c_extension: bool = False,
     keep_asserts_in_extension: bool = True,
     skip_actions: bool = False,
+    memo_backend: str = "list",
+    first_set_guards: bool = False,
+    memo_profile: Optional[str] = None,
+    rule_timing: bool = False,
+    parse_stats: bool = False,
 ) -> ParserGenerator:
     # TODO: Allow other extensions; pass the output type as an argument.
     if not output_file.endswith((".c", ".py")):
         raise RuntimeError("Your output file must either be a .c or .py file")
+    profile = None
+    if memo_profile:
+        with open(memo_profile) as file:
+            profile = read_memo_profile(file)
     with open(output_file, "w") as file:
         gen: ParserGenerator
         if output_file.endswith(".c"):
-            gen = CParserGenerator(grammar, file, skip_actions=skip_actions)
+            gen = CParserGenerator(
+                grammar,
+                file,
+                skip_actions=skip_actions,
+                memo_backend=memo_backend,
+                first_set_guards=first_set_guards,
+                memo_profile=profile,
+                rule_timing=rule_timing,
+                parse_stats=parse_stats,
+            )
         elif output_file.endswith(".py"):
             gen = PythonParserGenerator(grammar, file)  # TODO: skip_actions
         else:
@@ -129,6 +149,11 @@ def build_parser_and_generator(
     verbose_c_extension: bool = False,
     keep_asserts_in_extension: bool = True,
     skip_actions: bool = False,
+    memo_backend: str = "list",
+    first_set_guards: bool = False,
+    memo_profile: Optional[str] = None,
+    rule_timing: bool = False,
+    parse_stats: bool = False,
 ) -> Tuple[Grammar, Parser, Tokenizer, ParserGenerator]:
     """Generate rules, parser, tokenizer, parser generator for a given grammar
 
@@ -146,6 +171,20 @@ def build_parser_and_generator(
         keep_asserts_in_extension (bool, optional): Whether to keep the assert statements
           when compiling the extension module. Defaults to True.
         skip_actions (bool, optional): Whether to pretend no rule has any actions.
+        memo_backend (string, optional): How the generated C parser stores memoized
+          results: "list", "dense" or "hash". Defaults to "list".
+        first_set_guards (bool, optional): Whether the generated C parser checks the
+          next token against the FIRST set of a rule or alternative before trying it.
+          Defaults to False.
+        memo_profile (string, optional): Path of a profile written by
+          scripts/memo_profile.py, which decides which rules the generated C parser
+          memoizes instead of the grammar's (memo) markers, for the rules it covers.
+        rule_timing (bool, optional): Whether the generated C parser times each rule
+          when it is asked for the statistics of a parse, and records the rule calls
+          when it is asked for a trace. Defaults to False.
+        parse_stats (bool, optional): Whether the generated C parser counts the rule
+          calls and backtracking of a parse that is asked for its statistics. Parsers
+          generated with rule_timing always do. Defaults to False.
     """
     grammar, parser, tokenizer = build_parser(grammar_file, verbose_tokenizer, verbose_parser)
     gen = build_generator(
@@ -157,6 +196,11 @@ def build_parser_and_generator(
         verbose_c_extension,
         keep_asserts_in_extension,
         skip_actions=skip_actions,
+        memo_backend=memo_backend,
+        first_set_guards=first_set_guards,
+        memo_profile=memo_profile,
+        rule_timing=rule_timing,
+        parse_stats=parse_stats,
     )
 
     return grammar, parser, tokenizer, gen
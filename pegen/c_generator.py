@@ -1,6 +1,7 @@
 import ast
 import re
-from typing import Any, cast, Dict, IO, Optional, List, Text, Tuple
+import token
+from typing import Any, cast, Dict, IO, Optional, List, Sequence, Set, Text, Tuple
 
 from pegen.grammar import (
     Cut,
@@ -23,6 +24,12 @@ from pegen.grammar import (
 from pegen import grammar
 from pegen.parser_generator import dedupe, ParserGenerator
 from pegen.tokenizer import exact_token_types
+from pegen.first_sets import FirstSetCalculator
+from pegen.memo_profile import RuleProfile
+
+FIRST_KEYWORD_TYPE = 500
+
+MEMO_BACKENDS = {"list": "MEMO_LIST", "dense": "MEMO_DENSE", "hash": "MEMO_HASH"}
 
 EXTENSION_PREFIX = """\
 #include "pegen.h"
@@ -36,6 +43,11 @@ parse(Parser *p)
     // Initialize keywords
     p->keywords = reserved_keywords;
     p->n_keyword_lists = n_keyword_lists;
+    p->classify_keyword = classify_keyword;
+
+    // Initialize memo
+    p->memo_backend = memo_backend;
+    p->n_memo_rules = n_memo_rules;
 
     // Run parser
     return start_rule(p);
@@ -148,12 +160,42 @@ class CParserGenerator(ParserGenerator, GrammarVisitor):
         file: Optional[IO[Text]],
         debug: bool = False,
         skip_actions: bool = False,
+        memo_backend: str = "list",
+        first_set_guards: bool = False,
+        memo_profile: Optional[Dict[str, RuleProfile]] = None,
+        memo_profiling: bool = False,
+        rule_timing: bool = False,
+        parse_stats: bool = False,
     ):
         super().__init__(grammar, file)
+        if memo_backend not in MEMO_BACKENDS:
+            raise ValueError(f"Unknown memo backend {memo_backend!r}")
         self.callmakervisitor: CCallMakerVisitor = CCallMakerVisitor(self)
         self._varname_counter = 0
         self.debug = debug
         self.skip_actions = skip_actions
+        self.memo_backend = memo_backend
+        self.first_set_guards = first_set_guards
+        # Which rules are memoized comes from the profile, for the rules it
+        # has, or else from the grammar.  A parser that makes a profile looks
+        # up every rule that can be memoized, to count what memoizing it saves.
+        self.memo_profile = memo_profile or {}
+        self.memo_profiling = memo_profiling
+        # Call each rule through a wrapper that times it
+        self.rule_timing = rule_timing
+        # Count the rule calls and backtracking of a parse that keeps
+        # statistics.  A profile measures its work in them and rule timing
+        # reports them, so those parsers always count.
+        self.parse_stats = parse_stats or memo_profiling or rule_timing
+        self.first_sets: Optional[FirstSetCalculator] = None
+        self._current_rule = ""
+        self._current_rule_has_choice = False
+        self.guarded_rules: Set[str] = set()
+        self.commit_rules: Set[str] = set()
+        self.holding_rules: Set[str] = set()
+        # Helpers whose calls in actions still run when the parser only
+        # recognizes its input, because they check the input further.
+        self.recognizer_actions = self.grammar.metas.get("recognizer_actions", "").split()
 
     def unique_varname(self, name: str = "tmpvar") -> str:
         new_var = name + "_" + str(self._varname_counter)
@@ -196,6 +238,12 @@ class CParserGenerator(ParserGenerator, GrammarVisitor):
 
     def generate(self, filename: str) -> None:
         self.collect_todo()
+        self.commit_rules = self._find_commit_rules()
+        self.holding_rules = self._find_holding_rules()
+        if self.first_set_guards:
+            self.first_sets = FirstSetCalculator(self.todo.copy())
+            self.first_sets.calculate()
+            self.guarded_rules = self._find_guarded_rules()
         self.print(f"// @generated by pegen.py from {filename}")
         header = self.grammar.metas.get("header", EXTENSION_PREFIX)
         if header:
@@ -204,10 +252,16 @@ class CParserGenerator(ParserGenerator, GrammarVisitor):
         if subheader:
             self.print(subheader)
         self._setup_keywords()
-        for i, (rulename, rule) in enumerate(self.todo.items(), 1000):
-            comment = "  // Left-recursive" if rule.left_recursive else ""
+        # Rules that use the memo come first, so that their types minus 1000
+        # form the compact index used by the dense memo backend.
+        memo_rules = [name for name, rule in self.todo.items() if self._uses_memo(rule)]
+        other_rules = [name for name in self.todo if name not in memo_rules]
+        self._setup_memo(len(memo_rules))
+        for i, rulename in enumerate(memo_rules + other_rules, 1000):
+            comment = "  // Left-recursive" if self.todo[rulename].left_recursive else ""
             self.print(f"#define {rulename}_type {i}{comment}")
         self.print()
+        self._setup_rule_names(memo_rules + other_rules)
         for rulename, rule in self.todo.items():
             if rule.is_loop() or rule.is_gather():
                 type = "asdl_seq *"
@@ -267,15 +321,74 @@ class CParserGenerator(ParserGenerator, GrammarVisitor):
                         self.print("{NULL, -1},")
                     self.print("},")
         self.print("};")
+        self._setup_keyword_classifier()
+
+    def _setup_keyword_classifier(self) -> None:
+        # Switch on the length, then on as many characters as it takes to
+        # single out a keyword, and finish with one memcmp() of the rest.
+        groups = self._group_keywords_by_length()
+        self.print("static int")
+        self.print("classify_keyword(const char *s, int len)")
+        self.print("{")
+        with self.indent():
+            self.print("switch (len) {")
+            with self.indent():
+                for length in sorted(groups):
+                    self.print(f"case {length}:")
+                    with self.indent():
+                        self._classify_keywords_at(sorted(groups[length]), 0)
+            self.print("}")
+            self.print("return NAME;")
+        self.print("}")
+
+    def _classify_keywords_at(self, keywords: List[Tuple[str, int]], pos: int) -> None:
+        if len(keywords) == 1:
+            keyword_str, keyword_type = keywords[0]
+            rest = keyword_str[pos:]
+            if rest:
+                self.print(f'if (memcmp(s + {pos}, "{rest}", {len(rest)}) == 0) {{')
+                with self.indent():
+                    self.print(f"return {keyword_type};")
+                self.print("}")
+                self.print("break;")
+            else:
+                self.print(f"return {keyword_type};")
+            return
+        by_char: Dict[str, List[Tuple[str, int]]] = {}
+        for keyword in keywords:
+            by_char.setdefault(keyword[0][pos], []).append(keyword)
+        self.print(f"switch (s[{pos}]) {{")
+        with self.indent():
+            for char, group in by_char.items():
+                self.print(f"case '{char}':")
+                with self.indent():
+                    self._classify_keywords_at(group, pos + 1)
+        self.print("}")
+        self.print("break;")
+
+    def _setup_memo(self, n_memo_rules: int) -> None:
+        self.print(f"const int n_memo_rules = {n_memo_rules};")
+        self.print(f"const MEMO_BACKEND memo_backend = {MEMO_BACKENDS[self.memo_backend]};")
+
+    def _setup_rule_names(self, rulenames: List[str]) -> None:
+        # For the statistics of a parse, which are keyed by rule name
+        self.print(f"const int n_rules = {len(rulenames)};")
+        self.print(f"const int counts_rule_calls = {int(self.parse_stats)};")
+        self.print("const char *const rule_names[] = {")
+        with self.indent():
+            for rulename in rulenames:
+                self.print(f'"{rulename}",')
+        self.print("};")
+        self.print()
 
     def _set_up_token_start_metadata_extraction(self) -> None:
         self.print("if (p->mark == p->fill && fill_token(p) < 0) {")
         with self.indent():
             self.print("return NULL;")
         self.print("}")
-        self.print("int start_lineno = p->tokens[mark]->lineno;")
+        self.print("int start_lineno = get_token(p, mark)->lineno;")
         self.print("UNUSED(start_lineno); // Only used by EXTRA macro")
-        self.print("int start_col_offset = p->tokens[mark]->col_offset;")
+        self.print("int start_col_offset = get_token(p, mark)->col_offset;")
         self.print("UNUSED(start_col_offset); // Only used by EXTRA macro")
 
     def _set_up_token_end_metadata_extraction(self) -> None:
@@ -289,14 +402,29 @@ class CParserGenerator(ParserGenerator, GrammarVisitor):
         self.print(f"int end_col_offset = token->end_col_offset;")
         self.print("UNUSED(end_col_offset); // Only used by EXTRA macro")
 
+    def _count_call(self, rulename: str) -> None:
+        if self.parse_stats:
+            self.print(f"count_call(p, {rulename}_type);")
+
+    def _backtrack(self, rulename: str) -> None:
+        if self.parse_stats:
+            self.print(f"backtrack(p, {rulename}_type, mark);")
+        else:
+            self.print("p->mark = mark;")
+
     def _set_up_rule_memoization(self, node: Rule, result_type: str) -> None:
         self.print("{")
         with self.indent():
+            self._count_call(node.name)
+            self._rule_guard(node)
             self.print(f"{result_type} res = NULL;")
             self.print(f"if (is_memoized(p, {node.name}_type, &res))")
             with self.indent():
                 self.print("return res;")
             self.print("int mark = p->mark;")
+            if node.name in self.commit_rules:
+                # Every round of growing the seed starts again at mark.
+                self.print("int choice_mark = enter_choice(p, mark);")
             self.print("int resmark = p->mark;")
             self.print("while (1) {")
             with self.indent():
@@ -312,30 +440,70 @@ class CParserGenerator(ParserGenerator, GrammarVisitor):
                 self.print("res = raw;")
             self.print("}")
             self.print("p->mark = resmark;")
+            if node.name in self.commit_rules:
+                self.print("p->choice_mark = choice_mark;")
             self.print("return res;")
         self.print("}")
         self.print(f"static {result_type}")
         self.print(f"{node.name}_raw(Parser *p)")
 
     def _should_memoize(self, node: Rule) -> bool:
-        return node.memo and not node.left_recursive
+        if node.left_recursive:
+            return False
+        if node.is_loop() and node.name in self.commit_rules:
+            # Holding on to the start of such a loop would hold the whole file
+            return False
+        if node.name in self.memo_profile:
+            return self.memo_profile[node.name].pays_off()
+        return node.memo
+
+    def _should_profile_memo(self, node: Rule) -> bool:
+        return (
+            self.memo_profiling
+            and not node.left_recursive
+            and not node.is_gather()
+            and not (node.is_loop() and node.name in self.commit_rules)
+        )
+
+    def _memo_lookup(self, node: Rule) -> None:
+        if self._should_profile_memo(node):
+            memoized = int(self._should_memoize(node))
+            self.print(f"if (profile_memo_lookup(p, {node.name}_type, {memoized}, &res))")
+        elif self._should_memoize(node):
+            self.print(f"if (is_memoized(p, {node.name}_type, &res))")
+        else:
+            return
+        with self.indent():
+            self.print("return res;")
+
+    def _memo_insert(self, node: Rule, mark: str, res: str) -> None:
+        if self._should_profile_memo(node):
+            memoized = int(self._should_memoize(node))
+            self.print(f"profile_memo_insert(p, {mark}, {node.name}_type, {memoized}, {res});")
+        elif self._should_memoize(node):
+            self.print(f"insert_memo(p, {mark}, {node.name}_type, {res});")
+
+    def _uses_memo(self, node: Rule) -> bool:
+        return (
+            self._should_memoize(node)
+            or self._should_profile_memo(node)
+            or (node.left_recursive and node.leader)
+        )
 
     def _handle_default_rule_body(self, node: Rule, rhs: Rhs, result_type: str) -> None:
         memoize = self._should_memoize(node)
 
         with self.indent():
             self.print(f"{result_type} res = NULL;")
-            if memoize:
-                self.print(f"if (is_memoized(p, {node.name}_type, &res))")
-                with self.indent():
-                    self.print("return res;")
+            self._memo_lookup(node)
             self.print("int mark = p->mark;")
+            if self._has_choice(node):
+                self.print("int choice_mark = enter_choice(p, mark);")
             if any(alt.action and "EXTRA" in alt.action for alt in rhs.alts):
                 self._set_up_token_start_metadata_extraction()
             self.visit(
                 rhs,
                 is_loop=False,
-                is_gather=node.is_gather(),
                 rulename=node.name if memoize else None,
             )
             if self.debug:
@@ -343,8 +511,9 @@ class CParserGenerator(ParserGenerator, GrammarVisitor):
             self.print("res = NULL;")
         self.print("  done:")
         with self.indent():
-            if memoize:
-                self.print(f"insert_memo(p, mark, {node.name}_type, res);")
+            if self._has_choice(node):
+                self.print("p->choice_mark = choice_mark;")
+            self._memo_insert(node, "mark", "res")
             self.print("return res;")
 
     def _handle_loop_rule_body(self, node: Rule, rhs: Rhs) -> None:
@@ -353,23 +522,26 @@ class CParserGenerator(ParserGenerator, GrammarVisitor):
 
         with self.indent():
             self.print(f"void *res = NULL;")
-            if memoize:
-                self.print(f"if (is_memoized(p, {node.name}_type, &res))")
-                with self.indent():
-                    self.print("return res;")
+            self._memo_lookup(node)
             self.print("int mark = p->mark;")
+            if self._uses_memo(node):
+                self.print("int start_mark = p->mark;")
             self.print("void **children = PyMem_Malloc(sizeof(void *));")
             self.out_of_memory_return(f"!children", "NULL")
             self.print("ssize_t children_capacity = 1;")
             self.print("ssize_t n = 0;")
+            if node.name in self.commit_rules:
+                # Each repetition that fails resumes at its start.
+                self.print("int choice_mark = enter_choice(p, mark);")
             if any(alt.action and "EXTRA" in alt.action for alt in rhs.alts):
                 self._set_up_token_start_metadata_extraction()
             self.visit(
                 rhs,
                 is_loop=True,
-                is_gather=node.is_gather(),
                 rulename=node.name if memoize else None,
             )
+            if node.name in self.commit_rules:
+                self.print("p->choice_mark = choice_mark;")
             if is_repeat1:
                 self.print("if (n == 0) {")
                 with self.indent():
@@ -380,11 +552,95 @@ class CParserGenerator(ParserGenerator, GrammarVisitor):
             self.out_of_memory_return(f"!seq", "NULL", message=f"asdl_seq_new {node.name}")
             self.print("for (int i = 0; i < n; i++) asdl_seq_SET(seq, i, children[i]);")
             self.print("PyMem_Free(children);")
-            if node.name:
-                self.print(f"insert_memo(p, mark, {node.name}_type, seq);")
+            self._memo_insert(node, "start_mark", "seq")
+            self.print("return seq;")
+
+    def name_gather(self, node: Gather) -> str:
+        # A gather is generated as a single loop that collects its elements
+        # into one buffer, rather than as an element followed by a _loop0
+        # rule whose sequence would then be copied again to prepend it.
+        self.counter += 1
+        name = f"_gather_{self.counter}"
+        self.todo[name] = Rule(name, None, Rhs([Alt([NamedItem(None, node)])]))
+        for alt in self._gather_alts(node):
+            alt.collect_todo(self)
+        return name
+
+    def _gather_alts(self, node: Gather) -> Tuple[Alt, Alt]:
+        # The first element, and the separator and element of each repetition.
+        return (
+            Alt([NamedItem("elem", node.node)]),
+            Alt([NamedItem(None, node.separator), NamedItem("elem", node.node)]),
+        )
+
+    def _gather_of(self, node: Rule) -> Gather:
+        gather = node.rhs.alts[0].items[0].item
+        assert isinstance(gather, Gather)
+        return gather
+
+    def _handle_gather_rule_body(self, node: Rule) -> None:
+        gather = self._gather_of(node)
+        first, rest = self._gather_alts(gather)
+
+        with self.indent():
+            self.print("int mark = p->mark;")
+            self.print("void **children = PyMem_Malloc(sizeof(void *));")
+            self.out_of_memory_return(f"!children", "NULL")
+            self.print("ssize_t children_capacity = 1;")
+            self.print("ssize_t n = 0;")
+            if node.name in self.commit_rules:
+                self.print("int choice_mark = enter_choice(p, mark);")
+            self.print(f"{{ // {gather}")
+            with self.indent():
+                vars = {**self.collect_vars(first), **self.collect_vars(rest)}
+                for v, var_type in sorted(item for item in vars.items() if item[0] is not None):
+                    if not var_type:
+                        var_type = "void *"
+                    else:
+                        var_type += " "
+                    self.print(f"{var_type}{v};")
+                self.join_conditions(keyword="if", node=first, names=[])
+                self.print("{")
+                with self.indent():
+                    self.print("children[n++] = elem;")
+                    self.print("mark = p->mark;")
+                    self._move_choice(node.name)
+                    self.join_conditions(keyword="while", node=rest, names=[])
+                    self.print("{")
+                    with self.indent():
+                        self.print("if (n == children_capacity) {")
+                        with self.indent():
+                            self.print("children_capacity *= 2;")
+                            self.print(
+                                "children = PyMem_Realloc(children, children_capacity*sizeof(void *));"
+                            )
+                            self.out_of_memory_return(
+                                f"!children", "NULL", message=f"realloc {node.name}"
+                            )
+                        self.print("}")
+                        self.print("children[n++] = elem;")
+                        self.print("mark = p->mark;")
+                        self._move_choice(node.name)
+                    self.print("}")
+                self.print("}")
+                self._backtrack(node.name)
+            self.print("}")
+            if node.name in self.commit_rules:
+                self.print("p->choice_mark = choice_mark;")
+            self.print("if (n == 0) {")
+            with self.indent():
+                self.print("PyMem_Free(children);")
+                self.print("return NULL;")
+            self.print("}")
+            self.print("asdl_seq *seq = _Py_asdl_seq_new(n, p->arena);")
+            self.out_of_memory_return(f"!seq", "NULL", message=f"asdl_seq_new {node.name}")
+            self.print("for (int i = 0; i < n; i++) asdl_seq_SET(seq, i, children[i]);")
+            self.print("PyMem_Free(children);")
             self.print("return seq;")
 
     def visit_Rule(self, node: Rule) -> None:
+        self._current_rule = node.name
+        self._current_rule_has_choice = self._has_choice(node)
         is_loop = node.is_loop()
         is_gather = node.is_gather()
         rhs = node.flatten()
@@ -400,39 +656,251 @@ class CParserGenerator(ParserGenerator, GrammarVisitor):
         if node.left_recursive and node.leader:
             self.print(f"static {result_type} {node.name}_raw(Parser *);")
 
-        self.print(f"static {result_type}")
-        self.print(f"{node.name}_rule(Parser *p)")
+        if self.rule_timing:
+            self._timed_rule_wrapper(node, result_type)
+            self.print(f"static {result_type}")
+            self.print(f"{node.name}_rule_body(Parser *p)")
+        else:
+            self.print(f"static {result_type}")
+            self.print(f"{node.name}_rule(Parser *p)")
 
         if node.left_recursive and node.leader:
             self._set_up_rule_memoization(node, result_type)
 
         self.print("{")
+        if not (node.left_recursive and node.leader):
+            with self.indent():
+                self._count_call(node.name)
+                self._rule_guard(node)
         if is_loop:
             self._handle_loop_rule_body(node, rhs)
+        elif is_gather:
+            self._handle_gather_rule_body(node)
         else:
             self._handle_default_rule_body(node, rhs, result_type)
         self.print("}")
 
+    def _timed_rule_wrapper(self, node: Rule, result_type: str) -> None:
+        self.print(f"static {result_type} {node.name}_rule_body(Parser *);")
+        self.print(f"static {result_type}")
+        self.print(f"{node.name}_rule(Parser *p)")
+        self.print("{")
+        with self.indent():
+            self.print(f"enter_rule(p, {node.name}_type);")
+            self.print(f"{result_type} res = {node.name}_rule_body(p);")
+            self.print(f"exit_rule(p, {node.name}_type, res != NULL);")
+            self.print("return res;")
+        self.print("}")
+
     def visit_NamedItem(self, node: NamedItem, names: List[str]) -> None:
         name, call = self.callmakervisitor.visit(node)
+        prefix = ""
+        if isinstance(node.item, Cut) and self._current_rule in self.commit_rules:
+            # A rule that holds on to its tokens keeps its choice point
+            if self._current_rule_has_choice and self._current_rule not in self.holding_rules:
+                call = "cut(p, choice_mark)"
+            else:
+                call = "cut(p, p->choice_mark)"
+        elif self._is_committing_opt(node.item):
+            # An optional item resumes at its start if it fails
+            assert call.endswith(", 1")
+            prefix = "opt_choice_mark = enter_choice(p, p->mark), "
+            call = call[: -len(", 1")] + ", p->choice_mark = opt_choice_mark, 1"
         if not name:
             self.print(call)
         else:
             name = dedupe(name, names)
-            self.print(f"({name} = {call})")
+            self.print(f"({prefix}{name} = {call})")
 
-    def visit_Rhs(
-        self, node: Rhs, is_loop: bool, is_gather: bool, rulename: Optional[str]
-    ) -> None:
+    def visit_Rhs(self, node: Rhs, is_loop: bool, rulename: Optional[str]) -> None:
         if is_loop:
             assert len(node.alts) == 1
         for alt in node.alts:
-            self.visit(alt, is_loop=is_loop, is_gather=is_gather, rulename=rulename)
+            if (
+                alt is node.alts[-1]
+                and self._current_rule_has_choice
+                and self._current_rule not in self.holding_rules
+                and not is_loop
+            ):
+                # No choice is left once the last alternative is tried
+                self.print("p->choice_mark = choice_mark;")
+            self.visit(alt, is_loop=is_loop, rulename=rulename)
+
+    def _find_commit_rules(self) -> Set[str]:
+        # The rules with a cut commit when it is reached, and so do the rules
+        # that call them.  Only these need to track their choice points.
+        callers: Dict[str, Set[str]] = {name: set() for name in self.todo}
+        todo = []
+        for name, rule in self.todo.items():
+            for alt in self._alts_of(rule):
+                for item in alt.items:
+                    if isinstance(item.item, Cut) and name not in todo:
+                        todo.append(name)
+                    _, call = self.callmakervisitor.visit(item)
+                    for callee in re.findall(r"\b(\w+)_rule\b", call):
+                        if callee in callers:
+                            callers[callee].add(name)
+        commit_rules = set(todo)
+        while todo:
+            for caller in callers[todo.pop()]:
+                if caller not in commit_rules:
+                    commit_rules.add(caller)
+                    todo.append(caller)
+        return commit_rules
+
+    def _find_holding_rules(self) -> Set[str]:
+        # A rule whose action reads tokens from before a commit point below it
+        # keeps them from being freed by holding a choice point at its start
+        # until it returns.  That is the case if the action uses EXTRA, whose
+        # end is the last token the alternative parsed, or an item parsed
+        # before a later one that can commit.  Loops only keep the values of
+        # their items, which are not expected to refer to tokens.  A memoized
+        # rule holds on to its start, where its result goes in the memo.
+        holding_rules = set()
+        for name in self.commit_rules:
+            rule = self.todo[name]
+            if rule.is_loop() or rule.is_gather():
+                continue
+            if self._should_memoize(rule) or self._should_profile_memo(rule):
+                holding_rules.add(name)
+                continue
+            for alt in rule.flatten().alts:
+                commits = [i for i, item in enumerate(alt.items) if self._can_commit(item)]
+                if not commits or not alt.action:
+                    continue
+                if "EXTRA" in alt.action or any(
+                    item.name and re.search(rf"\b{item.name}\b", alt.action)
+                    for item in alt.items[: commits[-1]]
+                ):
+                    holding_rules.add(name)
+        return holding_rules
+
+    def _can_commit(self, item: NamedItem) -> bool:
+        if isinstance(item.item, Cut):
+            return True
+        _, call = self.callmakervisitor.visit(item)
+        return any(name in self.commit_rules for name in re.findall(r"\b(\w+)_rule\b", call))
+
+    def _alts_of(self, rule: Rule) -> Sequence[Alt]:
+        if rule.is_gather():
+            return self._gather_alts(self._gather_of(rule))
+        return rule.flatten().alts
+
+    def _has_choice(self, node: Rule) -> bool:
+        # Whether the rule resumes at its start when an alternative fails, or
+        # holds on to the tokens from its start
+        return node.name in self.commit_rules and (
+            len(node.flatten().alts) > 1 or node.name in self.holding_rules
+        )
+
+    def _is_committing_opt(self, item: Any) -> bool:
+        if not isinstance(item, Opt) or self._current_rule not in self.commit_rules:
+            return False
+        _, call = self.callmakervisitor.visit(item)
+        return any(name in self.commit_rules for name in re.findall(r"\b(\w+)_rule\b", call))
+
+    def _move_choice(self, rulename: str) -> None:
+        # A loop resumes at the start of the repetition it is trying.
+        if rulename in self.commit_rules:
+            self.print("p->choice_mark = Py_MIN(choice_mark, mark);")
+
+    def _first_set_guard(self, node: Alt) -> Optional[str]:
+        assert self.first_sets is not None
+        # An alternative that starts with a token checks it first anyway.
+        if self.first_sets.is_token(node.items[0].item):
+            return None
+        terminals = self.first_sets.visit(node)
+        # The rule checks its own FIRST set on entry.
+        if terminals == self.first_sets.first_sets[self._current_rule]:
+            return None
+        return self._next_token_in(terminals)
+
+    def _find_guarded_rules(self) -> Set[str]:
+        # A rule needs to check its FIRST set on entry unless every call to it
+        # is the first item of an alternative of a rule that has made sure that
+        # the next token is in a subset of it.
+        assert self.first_sets is not None
+        first_sets = self.first_sets.first_sets
+        callers: Dict[str, List[Optional[str]]] = {name: [] for name in first_sets}
+        for name, rule in self.first_sets.rules.items():
+            for alt in self._alts_of(rule):
+                for i, item in enumerate(alt.items):
+                    _, call = self.callmakervisitor.visit(item)
+                    at_start = i == 0 and not rule.is_loop() and "lookahead" not in call
+                    for callee in re.findall(r"\b(\w+)_rule\b", call):
+                        if callee in callers:
+                            callers[callee].append(name if at_start else None)
+        guarded: Set[str] = set()
+        checked = set(first_sets)
+        changed = True
+        while changed:
+            changed = False
+            for name in first_sets:
+                if name in guarded or name not in checked:
+                    continue
+                if callers[name] and all(
+                    caller is not None
+                    and caller in checked
+                    and "" not in first_sets[caller]
+                    and first_sets[caller] <= first_sets[name]
+                    for caller in callers[name]
+                ):
+                    continue
+                changed = True
+                rule = self.first_sets.rules[name]
+                # A _loop0 rule succeeds with an empty sequence instead of failing.
+                if (not rule.is_loop() or name.startswith("_loop1")) and self._next_token_in(
+                    first_sets[name]
+                ):
+                    guarded.add(name)
+                else:
+                    checked.remove(name)
+        return guarded
+
+    def _rule_guard(self, node: Rule) -> None:
+        if node.name not in self.guarded_rules:
+            return
+        assert self.first_sets is not None
+        check = self._next_token_in(self.first_sets.first_sets[node.name])
+        if check:
+            self.print(f"if (!{check}) {{")
+            with self.indent():
+                self.print("return NULL;")
+            self.print("}")
+
+    def _next_token_in(self, terminals: Set[str]) -> Optional[str]:
+        tokens = keywords = 0
+        for terminal in terminals:
+            type = self._token_type(terminal)
+            if type is None:
+                return None  # Nullable, or not a token we know of
+            if type < 64:
+                tokens |= 1 << type
+            elif 0 <= type - FIRST_KEYWORD_TYPE < 64:
+                keywords |= 1 << (type - FIRST_KEYWORD_TYPE)
+            else:
+                return None
+        return f"next_token_in(p, {tokens:#x}ULL, {keywords:#x}ULL)"
+
+    def _token_type(self, terminal: str) -> Optional[int]:
+        if terminal.startswith(("'", '"')):
+            val = ast.literal_eval(terminal)
+            if val in self.callmakervisitor.keyword_cache:
+                return self.callmakervisitor.keyword_cache[val]
+            return exact_token_types.get(val)
+        if terminal in token.tok_name.values():
+            return cast(int, getattr(token, terminal))
+        return None
 
     def join_conditions(self, keyword: str, node: Any, names: List[str]) -> None:
         self.print(f"{keyword} (")
         with self.indent():
             first = True
+            if self.first_set_guards:
+                guard = self._first_set_guard(node)
+                if guard:
+                    self.print(guard)
+                    first = False
             for item in node.items:
                 if first:
                     first = False
@@ -454,17 +922,13 @@ class CParserGenerator(ParserGenerator, GrammarVisitor):
                 f'fprintf(stderr, "Hit with action [%d-%d]: %s\\n", mark, p->mark, "{node}");'
             )
 
-    def emit_default_action(self, is_gather: bool, names: List[str], node: Alt) -> None:
+    def emit_default_action(self, names: List[str], node: Alt) -> None:
         if len(names) > 1:
-            if is_gather:
-                assert len(names) == 2
-                self.print(f"res = seq_insert_in_front(p, {names[0]}, {names[1]});")
-            else:
-                if self.debug:
-                    self.print(
-                        f'fprintf(stderr, "Hit without action [%d:%d]: %s\\n", mark, p->mark, "{node}");'
-                    )
-                self.print(f"res = CONSTRUCTOR(p, {', '.join(names)});")
+            if self.debug:
+                self.print(
+                    f'fprintf(stderr, "Hit without action [%d:%d]: %s\\n", mark, p->mark, "{node}");'
+                )
+            self.print(f"res = CONSTRUCTOR(p, {', '.join(names)});")
         else:
             if self.debug:
                 self.print(
@@ -475,42 +939,52 @@ class CParserGenerator(ParserGenerator, GrammarVisitor):
     def emit_dummy_action(self) -> None:
         self.print(f"res = CONSTRUCTOR(p);")
 
-    def handle_alt_normal(self, node: Alt, is_gather: bool, names: List[str]) -> None:
+    def _is_recognizer_action(self, action: str) -> bool:
+        return any(re.search(rf"\b{name}\s*\(", action) for name in self.recognizer_actions)
+
+    def emit_alt_action(self, node: Alt, names: List[str]) -> None:
+        if self.skip_actions:
+            self.emit_dummy_action()
+        elif not node.action:
+            self.emit_default_action(names, node)
+        elif self._is_recognizer_action(node.action):
+            if "EXTRA" in node.action:
+                self._set_up_token_end_metadata_extraction()
+            self.emit_action(node)
+        else:
+            # A Parser with skip_actions set only recognizes its input, so
+            # the action is replaced by a dummy value at run time.
+            self.print("if (p->skip_actions) {")
+            with self.indent():
+                self.emit_dummy_action()
+            self.print("}")
+            self.print("else {")
+            with self.indent():
+                if "EXTRA" in node.action:
+                    self._set_up_token_end_metadata_extraction()
+                self.emit_action(node)
+            self.print("}")
+
+    def handle_alt_normal(self, node: Alt, names: List[str]) -> None:
         self.join_conditions(keyword="if", node=node, names=names)
         self.print("{")
         # We have parsed successfully all the conditions for the option.
         with self.indent():
             # Prepare to emmit the rule action and do so
-            if node.action and "EXTRA" in node.action:
-                self._set_up_token_end_metadata_extraction()
-            if self.skip_actions:
-                self.emit_dummy_action()
-            elif node.action:
-                self.emit_action(node)
-            else:
-                self.emit_default_action(is_gather, names, node)
+            self.emit_alt_action(node, names)
 
             # As the current option has parsed correctly, do not continue with the rest.
             self.print(f"goto done;")
         self.print("}")
 
-    def handle_alt_loop(
-        self, node: Alt, is_gather: bool, rulename: Optional[str], names: List[str]
-    ) -> None:
+    def handle_alt_loop(self, node: Alt, rulename: Optional[str], names: List[str]) -> None:
         # Condition of the main body of the alternative
         self.join_conditions(keyword="while", node=node, names=names)
         self.print("{")
         # We have parsed successfully one item!
         with self.indent():
             # Prepare to emit the rule action and do so
-            if node.action and "EXTRA" in node.action:
-                self._set_up_token_end_metadata_extraction()
-            if self.skip_actions:
-                self.emit_dummy_action()
-            elif node.action:
-                self.emit_action(node)
-            else:
-                self.emit_default_action(is_gather, names, node)
+            self.emit_alt_action(node, names)
 
             # Add the result of rule to the temporary buffer of children. This buffer
             # will populate later an asdl_seq with all elements to return.
@@ -522,11 +996,10 @@ class CParserGenerator(ParserGenerator, GrammarVisitor):
             self.print("}")
             self.print(f"children[n++] = res;")
             self.print("mark = p->mark;")
+            self._move_choice(self._current_rule)
         self.print("}")
 
-    def visit_Alt(
-        self, node: Alt, is_loop: bool, is_gather: bool, rulename: Optional[str]
-    ) -> None:
+    def visit_Alt(self, node: Alt, is_loop: bool, rulename: Optional[str]) -> None:
         self.print(f"{{ // {node}")
         with self.indent():
             # Prepare variable declarations for the alternative
@@ -539,16 +1012,26 @@ class CParserGenerator(ParserGenerator, GrammarVisitor):
                 if v == "cut_var":
                     v += " = 0"  # cut_var must be initialized
                 self.print(f"{var_type}{v};")
+            if any(self._is_committing_opt(item.item) for item in node.items):
+                self.print("int opt_choice_mark;")
 
             names: List[str] = []
             if is_loop:
-                self.handle_alt_loop(node, is_gather, rulename, names)
+                self.handle_alt_loop(node, rulename, names)
             else:
-                self.handle_alt_normal(node, is_gather, names)
+                self.handle_alt_normal(node, names)
 
-            self.print("p->mark = mark;")
+            self._backtrack(self._current_rule)
             if "cut_var" in names:
-                self.print("if (cut_var) return NULL;")
+                if is_loop:
+                    self.print("if (cut_var) return NULL;")
+                else:
+                    # The rule has committed to this alternative
+                    self.print("if (cut_var) {")
+                    with self.indent():
+                        self.print("res = NULL;")
+                        self.print("goto done;")
+                    self.print("}")
         self.print("}")
 
     def collect_vars(self, node: Alt) -> Dict[str, Optional[str]]:
@@ -4,9 +4,8 @@ import argparse
 import collections
 import pprint
 import sys
-from typing import Optional, Set, Dict
+from typing import Any, Optional, Set, Dict
 
-from pegen.build import build_parser
 from pegen.grammar import (
     Alt,
     Cut,
@@ -36,47 +35,58 @@ argparser.add_argument("grammar_file", help="The grammar file")
 
 
 class FirstSetCalculator(GrammarVisitor):
+    """Compute the set of tokens each rule can start with.
+
+    The empty string in a set means that the rule (or item) can match without
+    consuming any token.  The sets never leave out a token that can start a
+    match, so that generated parsers can use them to rule out alternatives.
+    """
+
     def __init__(self, rules: Dict[str, Rule]) -> None:
         self.rules = rules
-        for rule in rules.values():
-            rule.nullable_visit(rules)
-        self.first_sets: Dict[str, Set[str]] = dict()
-        self.in_process: Set[str] = set()
+        self.first_sets: Dict[str, Set[str]] = {name: set() for name in rules}
 
     def calculate(self) -> Dict[str, Set[str]]:
-        for name, rule in self.rules.items():
-            self.visit(rule)
+        # Recursive rules depend on each other's sets, so start from empty
+        # sets and recompute all of them until nothing changes.
+        changed = True
+        while changed:
+            changed = False
+            for name, rule in self.rules.items():
+                terminals = self.visit(rule)
+                if terminals != self.first_sets[name]:
+                    self.first_sets[name] = terminals
+                    changed = True
         return self.first_sets
 
+    def is_token(self, item: Any) -> bool:
+        return isinstance(item, StringLeaf) or (
+            isinstance(item, NameLeaf) and item.value not in self.rules
+        )
+
     def visit_Alt(self, item: Alt) -> Set[str]:
         result: Set[str] = set()
-        to_remove: Set[str] = set()
+        excluded: Set[str] = set()
         for other in item.items:
             new_terminals = self.visit(other)
             if isinstance(other.item, NegativeLookahead):
-                to_remove |= new_terminals
-            result |= new_terminals
-            if to_remove:
-                result -= to_remove
-
-            # If the set of new terminals can start with the empty string,
-            # it means that the item is completelly nullable and we should
-            # also considering at least the next item in case the current
-            # one fails to parse.
-
-            if "" in new_terminals:
+                # Only a single token is sure to be ruled out as the next one.
+                if self.is_token(other.item.node):
+                    excluded |= new_terminals
                 continue
+            result |= new_terminals - excluded
 
-            if not isinstance(other.item, (Opt, NegativeLookahead, Repeat0)):
-                break
-
-        # Do not allow the empty string to propagate.
-        result.discard("")
+            # If the item can match the empty string, the next item can
+            # provide the first token as well.
+            if "" not in new_terminals:
+                result.discard("")
+                return result
 
+        result.add("")
         return result
 
     def visit_Cut(self, item: Cut) -> Set[str]:
-        return set()
+        return {""}
 
     def visit_Group(self, item: Group) -> Set[str]:
         return self.visit(item.rhs)
@@ -91,13 +101,13 @@ class FirstSetCalculator(GrammarVisitor):
         return self.visit(item.item)
 
     def visit_Opt(self, item: Opt) -> Set[str]:
-        return self.visit(item.node)
+        return self.visit(item.node) | {""}
 
     def visit_Gather(self, item: Gather) -> Set[str]:
         return self.visit(item.node)
 
     def visit_Repeat0(self, item: Repeat0) -> Set[str]:
-        return self.visit(item.node)
+        return self.visit(item.node) | {""}
 
     def visit_Repeat1(self, item: Repeat1) -> Set[str]:
         return self.visit(item.node)
@@ -105,14 +115,7 @@ class FirstSetCalculator(GrammarVisitor):
     def visit_NameLeaf(self, item: NameLeaf) -> Set[str]:
         if item.value not in self.rules:
             return {item.value}
-
-        if item.value not in self.first_sets:
-            self.first_sets[item.value] = self.visit(self.rules[item.value])
-            return self.first_sets[item.value]
-        elif item.value in self.in_process:
-            return set()
-
-        return self.first_sets[item.value]
+        return set(self.first_sets[item.value])
 
     def visit_StringLeaf(self, item: StringLeaf) -> Set[str]:
         return {item.value}
@@ -124,19 +127,12 @@ class FirstSetCalculator(GrammarVisitor):
         return result
 
     def visit_Rule(self, item: Rule) -> Set[str]:
-        if item.name in self.in_process:
-            return set()
-        elif item.name not in self.first_sets:
-            self.in_process.add(item.name)
-            terminals = self.visit(item.rhs)
-            if item.nullable:
-                terminals.add("")
-            self.first_sets[item.name] = terminals
-            self.in_process.remove(item.name)
-        return self.first_sets[item.name]
+        return self.visit(item.rhs)
 
 
 def main() -> None:
+    from pegen.build import build_parser
+
     args = argparser.parse_args()
 
     try:
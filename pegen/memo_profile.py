@@ -0,0 +1,49 @@
+"""Profiles of how well memoizing each rule of a C parser pays off.
+
+A profile is made by scripts/memo_profile.py, which runs a parser generated
+for profiling over a training corpus and records, for each rule, how often it
+was looked up, how many of those lookups found the rule in the memo, and the
+work those hits saved: the rule calls, failed alternatives and tokens of
+parsing the rule again, as the parser would do if the rule were not memoized.
+The work is counted rather than timed, so the same corpus always gives the
+same profile.  Given a profile, CParserGenerator memoizes the rules for which
+it pays off.
+"""
+
+from typing import Dict, NamedTuple, TextIO
+
+# The costs of looking a rule up in the memo and of inserting a node into it,
+# in units of work.  Most of the rule calls and alternatives that a hit saves
+# stop at a memo or at their first token, so a unit is cheap.  These costs make
+# the profile memoize the rules that timing the parser over the standard
+# library found worth memoizing.
+LOOKUP_COST = 2
+INSERT_COST = 4
+
+
+class RuleProfile(NamedTuple):
+    lookups: int
+    hits: int
+    saved: int
+
+    def pays_off(self) -> bool:
+        """Whether the work a memo saves is worth more than it costs."""
+        misses = self.lookups - self.hits
+        return self.saved > LOOKUP_COST * self.lookups + INSERT_COST * misses
+
+
+def read_memo_profile(file: TextIO) -> Dict[str, RuleProfile]:
+    profile = {}
+    for line in file:
+        line = line.split("#", 1)[0].strip()
+        if not line:
+            continue
+        name, *counts = line.split()
+        profile[name] = RuleProfile(*map(int, counts))
+    return profile
+
+
+def write_memo_profile(file: TextIO, profile: Dict[str, RuleProfile]) -> None:
+    file.write(f"# {'rule':<30} {'lookups':>10} {'hits':>10} {'saved':>12}\n")
+    for name, rule in profile.items():
+        file.write(f"{name:<32} {rule.lookups:>10} {rule.hits:>10} {rule.saved:>12}\n")
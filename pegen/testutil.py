@@ -6,12 +6,13 @@ import sys
 import textwrap
 import tokenize
 
-from typing import Any, cast, Dict, IO, Type, Final
+from typing import Any, cast, Dict, IO, Optional, Type, Final
 
 from pegen.build import compile_c_extension
 from pegen.c_generator import CParserGenerator
 from pegen.grammar import Grammar
 from pegen.grammar_parser import GeneratedParser as GrammarParser
+from pegen.memo_profile import RuleProfile
 from pegen.parser import Parser
 from pegen.python_generator import PythonParserGenerator
 from pegen.tokenizer import Tokenizer
@@ -68,15 +69,34 @@ def import_file(full_name: str, path: str) -> Any:
     return mod
 
 
-def generate_c_parser_source(grammar: Grammar) -> str:
+def generate_c_parser_source(
+    grammar: Grammar,
+    first_set_guards: bool = False,
+    memo_profile: Optional[Dict[str, RuleProfile]] = None,
+    parse_stats: bool = False,
+) -> str:
     out = io.StringIO()
-    genr = CParserGenerator(grammar, out)
+    genr = CParserGenerator(
+        grammar,
+        out,
+        first_set_guards=first_set_guards,
+        memo_profile=memo_profile,
+        parse_stats=parse_stats,
+    )
     genr.generate("<string>")
     return out.getvalue()
 
 
 def generate_parser_c_extension(
-    grammar: Grammar, path: pathlib.PurePath, debug: bool = False
+    grammar: Grammar,
+    path: pathlib.PurePath,
+    debug: bool = False,
+    memo_backend: str = "list",
+    first_set_guards: bool = False,
+    memo_profile: Optional[Dict[str, RuleProfile]] = None,
+    memo_profiling: bool = False,
+    rule_timing: bool = False,
+    parse_stats: bool = False,
 ) -> Any:
     """Generate a parser c extension for the given grammar in the given path
 
@@ -90,7 +110,17 @@ def generate_parser_c_extension(
     assert not os.listdir(path)
     source = path / "parse.c"
     with open(source, "w") as file:
-        genr = CParserGenerator(grammar, file, debug=debug)
+        genr = CParserGenerator(
+            grammar,
+            file,
+            debug=debug,
+            memo_backend=memo_backend,
+            first_set_guards=first_set_guards,
+            memo_profile=memo_profile,
+            memo_profiling=memo_profiling,
+            rule_timing=rule_timing,
+            parse_stats=parse_stats,
+        )
         genr.generate("parse.c")
     extension_path = compile_c_extension(str(source), build_dir=str(path / "build"))
     extension = import_file("parse", extension_path)
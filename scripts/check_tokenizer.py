@@ -0,0 +1,80 @@
+#!/usr/bin/env python3.8
+
+"""Check that the scanner of peg_parser/tokenizer.c tokenizes like CPython.
+
+Tokenizes each file, and each .py file under each directory, with the
+tokenizer that the C parser uses and with CPython's tokenizer only (see
+peg_parser.parse.tokenize_string()), and reports the files whose tokens,
+positions or errors differ, and how many files the scanner gave up on and
+left to CPython's tokenizer.
+"""
+
+import argparse
+import os
+import sys
+import tokenize
+
+from typing import Iterator, List, Tuple, Union
+
+sys.path.insert(0, os.getcwd())
+from peg_parser import parse
+
+argparser = argparse.ArgumentParser(
+    prog="check_tokenizer", description="Compare the C parser's tokenizer with CPython's"
+)
+argparser.add_argument("-v", "--verbose", action="store_true", help="List the files given up on")
+argparser.add_argument("paths", nargs="+", help="Files and directories to tokenize")
+
+
+def source_files(paths: List[str]) -> Iterator[str]:
+    for path in paths:
+        if not os.path.isdir(path):
+            yield path
+            continue
+        for root, dirs, files in os.walk(path):
+            dirs.sort()
+            for name in sorted(files):
+                if name.endswith(".py"):
+                    yield os.path.join(root, name)
+
+
+def tokens(source: str, tokenizer: int) -> Union[List[Tuple[int, ...]], Tuple[str, ...]]:
+    try:
+        return parse.tokenize_string(source, tokenizer=tokenizer)
+    except SyntaxError as err:
+        return ("SyntaxError", str(err.msg), str(err.lineno), str(err.offset))
+
+
+def main() -> None:
+    args = argparser.parse_args()
+    files = tokens_read = gave_up = problems = 0
+    for filename in source_files(args.paths):
+        try:
+            with open(filename, "rb") as file:
+                encoding, _ = tokenize.detect_encoding(file.readline)
+                file.seek(0)
+                source = file.read().decode(encoding)
+        except (SyntaxError, UnicodeDecodeError) as err:
+            print(f"{filename}: cannot decode: {err}", file=sys.stderr)
+            continue
+        if "\0" in source:
+            continue
+        files += 1
+        expected = tokens(source, 2)
+        if tokens(source, 0) != expected:
+            problems += 1
+            print(f"{filename}: the tokens differ from CPython's")
+            continue
+        tokens_read += len(expected) if isinstance(expected, list) else 0
+        try:
+            parse.tokenize_string(source, tokenizer=1)
+        except (ValueError, SyntaxError) as err:
+            gave_up += 1
+            if args.verbose:
+                print(f"{filename}: {err}")
+    print(f"{files} files, {tokens_read} tokens, {problems} problems, gave up on {gave_up}")
+    sys.exit(1 if problems else 0)
+
+
+if __name__ == "__main__":
+    main()
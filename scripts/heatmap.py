@@ -0,0 +1,276 @@
+#!/usr/bin/env python3.8
+
+"""Show where in its input the C parser does the most work.
+
+Generates a C parser that counts its rule calls (as --parse-stats does) from
+the grammar, memoizing the rules that the memo profile chooses, and parses
+the given files with its statistics (see parse_file(..., stats=True)), which
+count for each token the rule calls that started at it and the times it
+was given back by an alternative that failed, and adds the two up as the
+cost of the token.  For a single file it prints the source with each token
+coloured by its cost and each line preceded by the cost of its tokens.
+For several files, or with --summary, it lists the lines that cost the
+most, and the constructs (the AST node types, and decorators) whose code
+costs the most over its share of the tokens, to find the code that the
+parser handles badly.  --html writes the coloured sources of all the files
+to an HTML page instead.
+"""
+
+import argparse
+import ast
+import bisect
+import html
+import math
+import os
+import sys
+from collections import defaultdict
+from tempfile import TemporaryDirectory
+from pathlib import Path
+
+from typing import Any, Dict, FrozenSet, List, NamedTuple, Tuple
+
+sys.path.insert(0, os.getcwd())
+from pegen.build import build_parser
+from pegen.memo_profile import read_memo_profile
+from pegen.testutil import generate_parser_c_extension
+
+# Background colours of the terminal's 256-colour palette, from cheap to costly
+LEVELS = [None, 230, 229, 228, 221, 214, 208, 202, 196]
+
+argparser = argparse.ArgumentParser(
+    prog="heatmap", description="Show the parse cost of each token of the input"
+)
+argparser.add_argument("-g", "--grammar-file", default="data/simpy.gram", help="Grammar file")
+argparser.add_argument(
+    "-p", "--memo-profile", default="data/simpy.memo-profile", help="Memo profile of the grammar"
+)
+argparser.add_argument("-m", "--mode", type=int, default=0, help="Parse mode (default 0)")
+argparser.add_argument("-s", "--summary", action="store_true", help="Only list the hotspots")
+argparser.add_argument("-n", "--top", type=int, default=20, help="Hotspots to list")
+argparser.add_argument("--html", help="Write the coloured sources to this HTML file")
+argparser.add_argument("files", nargs="+", help="Files to parse")
+
+
+class Position(NamedTuple):
+    lineno: int
+    col_offset: int
+    end_lineno: int
+    end_col_offset: int
+    calls: int
+    backtracked: int
+
+    @property
+    def cost(self) -> int:
+        return self.calls + self.backtracked
+
+
+class FileCost(NamedTuple):
+    filename: str
+    lines: List[bytes]  # Token columns are byte offsets
+    positions: List[Position]
+
+
+def parse_costs(extension: Any, filename: str, mode: int) -> FileCost:
+    with open(filename, "rb") as file:
+        lines = file.read().splitlines()
+    result, stats = extension.parse_file(filename, mode=mode, stats=True)
+    return FileCost(filename, lines, [Position(*position) for position in stats["positions"]])
+
+
+def level(cost: int, max_cost: int) -> int:
+    """Map a cost to an index in LEVELS, on a log scale up to max_cost."""
+    if cost <= 0:
+        return 0
+    scale = math.log(cost + 1) / math.log(max_cost + 1)
+    return max(1, min(len(LEVELS) - 1, math.ceil(scale * (len(LEVELS) - 1))))
+
+
+def line_segments(file_cost: FileCost) -> Dict[int, List[Tuple[int, int, int]]]:
+    """Map each line number to the (start, end, cost) byte spans of its tokens."""
+    segments: Dict[int, List[Tuple[int, int, int]]] = defaultdict(list)
+    for pos in file_cost.positions:
+        if pos.col_offset < 0 or pos.end_col_offset < 0 or pos.lineno > len(file_cost.lines):
+            continue
+        for lineno in range(pos.lineno, pos.end_lineno + 1):
+            start = pos.col_offset if lineno == pos.lineno else 0
+            end = (
+                pos.end_col_offset
+                if lineno == pos.end_lineno
+                else len(file_cost.lines[lineno - 1])
+            )
+            if end > start:
+                segments[lineno].append((start, end, pos.cost))
+    return segments
+
+
+def line_costs(file_cost: FileCost) -> Dict[int, int]:
+    costs: Dict[int, int] = defaultdict(int)
+    for pos in file_cost.positions:
+        costs[pos.lineno] += pos.cost
+    return costs
+
+
+def render_line(line: bytes, segments: List[Tuple[int, int, int]], colour: "Colour") -> str:
+    parts = []
+    col = 0
+    for start, end, cost in segments:
+        parts.append(colour.plain(line[col:start]))
+        parts.append(colour.token(line[start:end], cost))
+        col = end
+    parts.append(colour.plain(line[col:]))
+    return "".join(parts)
+
+
+class Colour:
+    """Colours tokens for the terminal."""
+
+    def __init__(self, max_cost: int) -> None:
+        self.max_cost = max_cost
+
+    def plain(self, text: bytes) -> str:
+        return text.decode(errors="replace")
+
+    def token(self, text: bytes, cost: int) -> str:
+        colour = LEVELS[level(cost, self.max_cost)]
+        if colour is None:
+            return self.plain(text)
+        return f"\033[30;48;5;{colour}m{self.plain(text)}\033[0m"
+
+
+class HTMLColour(Colour):
+    def plain(self, text: bytes) -> str:
+        return html.escape(text.decode(errors="replace"))
+
+    def token(self, text: bytes, cost: int) -> str:
+        alpha = level(cost, self.max_cost) / (len(LEVELS) - 1)
+        return (
+            f'<span style="background: rgba(255, 64, 0, {alpha:.2f})" title="cost {cost}">'
+            f"{self.plain(text)}</span>"
+        )
+
+
+def render_file(file_cost: FileCost, colour: Colour) -> List[str]:
+    segments = line_segments(file_cost)
+    costs = line_costs(file_cost)
+    return [
+        f"{lineno:5d} {costs.get(lineno, 0):7d}  "
+        + render_line(line, segments.get(lineno, []), colour)
+        for lineno, line in enumerate(file_cost.lines, 1)
+    ]
+
+
+def construct_costs(file_cost: FileCost) -> Dict[str, List[int]]:
+    """Add up the tokens and the cost of the code in each kind of construct.
+
+    The constructs are the AST node types, and "decorator" for the
+    expressions of decorators.  Code in nested constructs of one kind counts
+    once, towards the outermost one.
+    """
+    try:
+        tree = ast.parse(b"\n".join(file_cost.lines))
+    except (SyntaxError, ValueError):
+        return {}
+    keys = [(pos.lineno, pos.col_offset) for pos in file_cost.positions]
+    prefix = [0]
+    for pos in file_cost.positions:
+        prefix.append(prefix[-1] + pos.cost)
+    costs: Dict[str, List[int]] = defaultdict(lambda: [0, 0])
+
+    def add(name: str, node: ast.AST) -> None:
+        start = bisect.bisect_left(keys, (node.lineno, node.col_offset))  # type: ignore
+        end = bisect.bisect_left(keys, (node.end_lineno, node.end_col_offset))  # type: ignore
+        costs[name][0] += end - start
+        costs[name][1] += prefix[end] - prefix[start]
+
+    def visit(node: ast.AST, outer: FrozenSet[str]) -> None:
+        name = type(node).__name__
+        if getattr(node, "end_lineno", None) is not None and name not in outer:
+            add(name, node)
+            outer |= {name}
+        for field, value in ast.iter_fields(node):
+            for child in value if isinstance(value, list) else [value]:
+                if not isinstance(child, ast.AST):
+                    continue
+                if field == "decorator_list" and "decorator" not in outer:
+                    add("decorator", child)
+                    visit(child, outer | {"decorator"})
+                else:
+                    visit(child, outer)
+
+    visit(tree, frozenset())
+    return costs
+
+
+def print_summary(file_costs: List[FileCost], top: int) -> None:
+    lines = []
+    constructs: Dict[str, List[int]] = defaultdict(lambda: [0, 0])
+    for file_cost in file_costs:
+        for lineno, cost in line_costs(file_cost).items():
+            if 0 < lineno <= len(file_cost.lines):
+                text = file_cost.lines[lineno - 1].decode(errors="replace").strip()
+                lines.append((cost, f"{file_cost.filename}:{lineno}: {text}"))
+        for name, (tokens, cost) in construct_costs(file_cost).items():
+            constructs[name][0] += tokens
+            constructs[name][1] += cost
+
+    tokens = sum(len(file_cost.positions) for file_cost in file_costs)
+    cost = sum(pos.cost for file_cost in file_costs for pos in file_cost.positions)
+    average = cost / tokens
+    print(f"{tokens} tokens, {cost} rule calls and tokens given back, {average:.1f} a token")
+    print()
+    print(f"{'cost':>10}  line")
+    for line_cost, line in sorted(lines, reverse=True)[:top]:
+        print(f"{line_cost:10d}  {line}")
+    print()
+    # Sorted by how much more than their share of the tokens they cost
+    print(f"{'construct':<20} {'tokens':>10} {'cost':>12} {'a token':>8} {'excess':>12}")
+    excess = {name: cost - tokens * average for name, (tokens, cost) in constructs.items()}
+    for name in sorted(excess, key=lambda name: -excess[name])[:top]:
+        tokens, cost = constructs[name]
+        print(f"{name:<20} {tokens:10d} {cost:12d} {cost / tokens:8.1f} {excess[name]:12.0f}")
+
+
+def write_html(file_costs: List[FileCost], filename: str) -> None:
+    with open(filename, "w") as file:
+        file.write("<!DOCTYPE html>\n<html><head><meta charset='utf-8'>")
+        file.write("<title>Parse cost</title></head><body>\n")
+        for file_cost in file_costs:
+            max_cost = max((pos.cost for pos in file_cost.positions), default=0)
+            file.write(f"<h2>{html.escape(file_cost.filename)}</h2>\n<pre>")
+            file.write("\n".join(render_file(file_cost, HTMLColour(max_cost))))
+            file.write("</pre>\n")
+        file.write("</body></html>\n")
+
+
+def main() -> None:
+    args = argparser.parse_args()
+    grammar, parser, tokenizer = build_parser(args.grammar_file)
+    with open(args.memo_profile) as file:
+        memo_profile = read_memo_profile(file)
+    file_costs = []
+    with TemporaryDirectory() as tmp_dir:
+        extension = generate_parser_c_extension(
+            grammar, Path(tmp_dir), memo_profile=memo_profile, parse_stats=True
+        )
+        for filename in args.files:
+            try:
+                file_costs.append(parse_costs(extension, filename, args.mode))
+            except (SyntaxError, ValueError) as err:
+                print(f"{filename}: {err}", file=sys.stderr)
+    if not file_costs:
+        sys.exit(1)
+
+    if args.html:
+        write_html(file_costs, args.html)
+    elif len(file_costs) == 1 and not args.summary:
+        file_cost = file_costs[0]
+        max_cost = max((pos.cost for pos in file_cost.positions), default=0)
+        print(f"{'line':>5} {'cost':>7}  {file_cost.filename}")
+        for line in render_file(file_cost, Colour(max_cost)):
+            print(line)
+    else:
+        print_summary(file_costs, args.top)
+
+
+if __name__ == "__main__":
+    main()
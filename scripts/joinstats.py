@@ -1,65 +1,77 @@
 #!/usr/bin/env python3.8
 
-"""Produce a report about the most-memoable types.
+"""Produce a report about the work the parser does in each rule.
 
-Reads a list of statistics from stdin.  Each line must be two numbers,
-being a type and a count.  We then read some other files and produce a
-list sorted by most frequent type.
-
-There should also be something to recognize left-recursive rules.
+Generates a C parser that counts its rule calls (as --parse-stats does) from
+the grammar, memoizing the rules that the memo profile chooses, parses the
+given files with its statistics (see parse_file(..., stats=True)), adds them
+up, and lists the rules sorted by the number of calls, or by another column
+given with --sort.  With --rule-timing the parser also times each rule, and
+the times are shown in nanoseconds.
 """
 
+import argparse
 import os
-import re
 import sys
+from tempfile import TemporaryDirectory
+from pathlib import Path
 
 from typing import Dict
 
-reporoot = os.path.dirname(os.path.dirname(__file__))
-parse_c = os.path.join(reporoot, "peg_parser", "parse.c")
-
-
-class TypeMapper:
-    """State used to map types to names."""
+sys.path.insert(0, os.getcwd())
+from pegen.build import build_parser
+from pegen.memo_profile import read_memo_profile
+from pegen.testutil import generate_parser_c_extension
 
-    def __init__(self, filename: str) -> None:
-        self.table: Dict[int, str] = {}
-        with open(filename) as f:
-            for line in f:
-                match = re.match(r"#define (\w+)_type (\d+)", line)
-                if match:
-                    name, type = match.groups()
-                    if "left" in line.lower():
-                        name += " // Left-recursive"
-                    self.table[int(type)] = name
+COUNTS = ["calls", "hits", "misses", "inserts", "backtracked"]
+TIMES = ["self_time", "inclusive_time"]
+COLUMNS = COUNTS + TIMES
 
-    def lookup(self, type: int) -> str:
-        return self.table.get(type, str(type))
+argparser = argparse.ArgumentParser(
+    prog="joinstats", description="Report the parse statistics of each rule"
+)
+argparser.add_argument("-g", "--grammar-file", default="data/simpy.gram", help="Grammar file")
+argparser.add_argument(
+    "-p", "--memo-profile", default="data/simpy.memo-profile", help="Memo profile of the grammar"
+)
+argparser.add_argument("--rule-timing", action="store_true", help="Time the rules too")
+argparser.add_argument("-m", "--mode", type=int, default=0, help="Parse mode (default 0)")
+argparser.add_argument("-s", "--sort", choices=COLUMNS, default="calls", help="Sort column")
+argparser.add_argument("files", nargs="+", help="Files to parse")
 
 
 def main() -> None:
-    mapper = TypeMapper(parse_c)
-    table = []
-    filename = sys.argv[1]
-    with open(filename) as f:
-        for lineno, line in enumerate(f, 1):
-            line = line.strip()
-            if not line or line.startswith("#"):
-                continue
-            parts = line.split()
-            # Extra fields ignored
-            if len(parts) < 2:
-                print(f"{lineno}: bad input ({line!r})")
-                continue
+    args = argparser.parse_args()
+    grammar, parser, tokenizer = build_parser(args.grammar_file)
+    with open(args.memo_profile) as file:
+        memo_profile = read_memo_profile(file)
+    tokens = 0
+    table: Dict[str, Dict[str, int]] = {}
+    with TemporaryDirectory() as tmp_dir:
+        extension = generate_parser_c_extension(
+            grammar,
+            Path(tmp_dir),
+            memo_profile=memo_profile,
+            rule_timing=args.rule_timing,
+            parse_stats=True,
+        )
+        for filename in args.files:
             try:
-                type, count = map(int, parts[:2])
-            except ValueError as err:
-                print(f"{lineno}: non-integer input ({line!r})")
+                result, stats = extension.parse_file(filename, mode=args.mode, stats=True)
+            except (SyntaxError, ValueError) as err:
+                print(f"{filename}: {err}", file=sys.stderr)
                 continue
-            table.append((type, count))
-    table.sort(key=lambda values: -values[1])
-    for type, count in table:
-        print(f"{type:4d} {count:9d} {mapper.lookup(type)}")
+            tokens += stats["tokens"]
+            for name, rule_stats in stats["rules"].items():
+                row = table.setdefault(name, dict.fromkeys(COLUMNS, 0))
+                for column in COLUMNS:
+                    row[column] += rule_stats[column]
+
+    columns = COUNTS + [column for column in TIMES if any(row[column] for row in table.values())]
+    print(f"{tokens} tokens")
+    print(f"{'rule':<40}", *(f"{column:>14}" for column in columns))
+    for name, row in sorted(table.items(), key=lambda item: -item[1][args.sort]):
+        print(f"{name:<40}", *(f"{row[column]:14d}" for column in columns))
 
 
 if __name__ == "__main__":
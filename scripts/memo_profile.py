@@ -0,0 +1,91 @@
+#!/usr/bin/env python3.8
+
+"""Profile which rules of a grammar are worth memoizing in the C parser.
+
+Generates a C parser for profiling from the grammar, parses the training
+files with it, and writes the lookups, hits and saved work of each rule (see
+pegen/memo_profile.py) to the profile.  Pass the profile to pegen with
+--memo-profile; `make memo-profile` does both for data/simpy.gram.
+
+What memoizing a rule saves depends on which of the rules it calls are
+memoized, so the decisions that the grammar's profile suggests are profiled
+again, and only the rules whose decision holds up are written out.  The
+others keep their (memo) markers.
+
+Files that do not parse are left out; their number is reported.
+"""
+
+import argparse
+import os
+import sys
+from tempfile import TemporaryDirectory
+from pathlib import Path
+
+from typing import Dict, List, Optional, Tuple
+
+sys.path.insert(0, os.getcwd())
+from pegen.build import build_parser
+from pegen.memo_profile import RuleProfile, write_memo_profile
+from pegen.testutil import generate_parser_c_extension
+
+argparser = argparse.ArgumentParser(
+    prog="memo_profile", description="Profile the memoization of the rules of a C parser",
+)
+argparser.add_argument("-g", "--grammar-file", default="data/simpy.gram", help="Grammar file")
+argparser.add_argument("-o", "--output", required=True, help="Where to write the profile")
+argparser.add_argument("files", nargs="+", help="Training files")
+
+
+def profile_rules(
+    grammar_file: str, files: List[str], memo_profile: Optional[Dict[str, RuleProfile]]
+) -> Tuple[Dict[str, RuleProfile], int]:
+    grammar, parser, tokenizer = build_parser(grammar_file)
+    with TemporaryDirectory() as tmp_dir:
+        extension = generate_parser_c_extension(
+            grammar, Path(tmp_dir), memo_profile=memo_profile, memo_profiling=True
+        )
+        failures = 0
+        counts: Dict[str, List[int]] = {}
+        for filename in sorted(files):
+            try:
+                result, stats = extension.parse_file(filename, mode=0, stats=True)
+            except (SyntaxError, ValueError):
+                failures += 1
+                continue
+            for name, rule_stats in stats["rules"].items():
+                lookups = rule_stats["hits"] + rule_stats["misses"]
+                if lookups:
+                    total = counts.setdefault(name, [0, 0, 0])
+                    total[0] += lookups
+                    total[1] += rule_stats["hits"]
+                    total[2] += rule_stats["saved"]
+
+    profile = {name: RuleProfile(*total) for name, total in counts.items()}
+    return profile, failures
+
+
+def main() -> None:
+    args = argparser.parse_args()
+    grammar, parser, tokenizer = build_parser(args.grammar_file)
+
+    suggested, failures = profile_rules(args.grammar_file, args.files, None)
+    checked, failures = profile_rules(args.grammar_file, args.files, suggested)
+    profile = {
+        name: rule_profile
+        for name, rule_profile in checked.items()
+        if name in suggested and rule_profile.pays_off() == suggested[name].pays_off()
+    }
+    with open(args.output, "w") as file:
+        file.write(f"# Memoization profile of {args.grammar_file}, made by {argparser.prog}\n")
+        file.write(f"# from {len(args.files)} files ({failures} did not parse)\n")
+        write_memo_profile(file, profile)
+
+    # Generated rules are never marked (memo) in the grammar
+    for name, rule_profile in profile.items():
+        memo = name in grammar.rules and grammar.rules[name].memo
+        if rule_profile.pays_off() != memo:
+            print(f"{name}: {'memo' if rule_profile.pays_off() else 'no memo'}")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,217 @@
+#!/usr/bin/env python3.8
+
+"""Check that the time and memory of the C parser grow linearly with its input.
+
+Builds inputs of growing size, times them with peg_parser/peg_bench (`make
+peg_parser/peg_bench`), and fits a power law, time ~ bytes ** k, to each
+series.  The series are data/small.txt to data/xl.txt repeated 1 to 100 times
+(up to --max-bytes), and inputs shaped to stress single rules:
+
+    chain      x = a + a + ... + a               (left recursion)
+    compare    x = a < a < ... < a
+    calls      x = a.b(c)[d].b(c)[d]...          (left-recursive primary)
+    list       x = [0, 1, 2, ...]
+    dict       x = {0: 0, 1: 1, ...}
+    strings    x = ("ab" "ab" ...)               (implicit concatenation)
+    semicolons x = 1; x = 1; ...                 (one long line)
+    parens     x = ((((0))))                     (nesting depth)
+    brackets   x = [[[[0]]]]
+
+A series is flagged if the exponent of its time, or of the peak memory
+allocated during a parse, is above 1 + --tolerance.  An input whose first
+parse takes longer than --timeout ends its series, and is fitted as if it
+had taken --timeout, which understates the exponent.  The exit status is 1
+if any series is flagged, except those in EXPECTED_NONLINEAR, which are known
+not to scale and are reported as expected (or as fixed, if they do scale);
+--strict counts them too.
+"""
+
+import argparse
+import json
+import math
+import os
+import subprocess
+import sys
+from tempfile import TemporaryDirectory
+
+from typing import Any, Callable, Dict, Iterator, List, Optional, Tuple
+
+CORPUS = ["data/small.txt", "data/medium.txt", "data/large.txt", "data/xl.txt"]
+FACTORS = [1, 2, 5, 10, 20, 50, 100]
+LENGTHS = [1000, 2000, 5000, 10000, 20000, 50000, 100000]
+# The tokenizer allows at most 200 open brackets
+DEPTHS = [10, 20, 40, 80, 160]
+
+SHAPES: Dict[str, Tuple[Callable[[int], str], List[int]]] = {
+    "chain": (lambda n: "x = " + " + ".join(["a"] * n) + "\n", LENGTHS),
+    "compare": (lambda n: "x = " + " < ".join(["a"] * n) + "\n", LENGTHS),
+    "calls": (lambda n: "x = a" + ".b(c)[d]" * n + "\n", LENGTHS),
+    "list": (lambda n: "x = [" + ", ".join(map(str, range(n))) + "]\n", LENGTHS),
+    "dict": (lambda n: "x = {" + ", ".join(f"{i}: {i}" for i in range(n)) + "}\n", LENGTHS),
+    "strings": (lambda n: "x = (" + " ".join(['"ab"'] * n) + ")\n", LENGTHS),
+    "semicolons": (lambda n: "; ".join(["x = 1"] * n) + "\n", LENGTHS),
+    "parens": (lambda n: "x = " + "(" * n + "0" + ")" * n + "\n", DEPTHS),
+    "brackets": (lambda n: "x = " + "[" * n + "0" + "]" * n + "\n", DEPTHS),
+}
+
+# The series known not to scale linearly, and why
+EXPECTED_NONLINEAR = {
+    # star_atom tries '(' star_target ')' and then '(' [star_targets_seq] ')',
+    # which both look for a target inside the parentheses, and neither rule is
+    # memoized, so looking for an assignment target doubles with each level.
+    "parens": "exponential in the nesting depth (star_atom)",
+}
+
+argparser = argparse.ArgumentParser(
+    prog="scaling_benchmark", description="Check that parsing scales linearly with the input"
+)
+argparser.add_argument("-m", "--mode", type=int, default=1, help="Parse mode (default 1)")
+argparser.add_argument("-r", "--repeat", type=int, default=3, help="Timed runs per input")
+argparser.add_argument(
+    "--max-bytes", type=int, default=10_000_000, help="Largest corpus input (default 10 MB)"
+)
+argparser.add_argument(
+    "--timeout", type=float, default=10.0, help="Longest a parse may take, in seconds"
+)
+argparser.add_argument(
+    "--tolerance", type=float, default=0.2, help="How far above 1 an exponent may be"
+)
+argparser.add_argument(
+    "--strict", action="store_true", help="Also fail on the series expected not to scale"
+)
+argparser.add_argument("--bench", default="peg_parser/peg_bench", help="The benchmark driver")
+argparser.add_argument("--json", help="Also write the measurements and fits to this file")
+argparser.add_argument("series", nargs="*", help="Series to run (default all)")
+
+
+def generate_series(max_bytes: int) -> Iterator[Tuple[str, List[Tuple[int, str]]]]:
+    """Yield the name of each series and its inputs, as (size, text) pairs."""
+    for filename in CORPUS:
+        with open(filename) as file:
+            text = file.read()
+        if not text.endswith("\n"):
+            text += "\n"
+        name = os.path.splitext(os.path.basename(filename))[0]
+        yield name, [
+            (factor, text * factor) for factor in FACTORS if len(text) * factor <= max_bytes
+        ]
+    for name, (make_input, sizes) in SHAPES.items():
+        yield name, [(size, make_input(size)) for size in sizes]
+
+
+def run_bench(
+    bench: str, filename: str, mode: int, warmup: int, repeat: int, timeout: float
+) -> Optional[Dict[str, Any]]:
+    """Run the benchmark driver on a file; None if it took longer than timeout."""
+    command = [bench, "-m", str(mode), "-w", str(warmup), "-r", str(repeat), filename]
+    try:
+        output = subprocess.run(
+            command, check=True, stdout=subprocess.PIPE, universal_newlines=True, timeout=timeout
+        ).stdout
+    except subprocess.TimeoutExpired:
+        return None
+    result: Dict[str, Any] = json.loads(output)
+    return result
+
+
+def fit_exponent(xs: List[float], ys: List[float]) -> float:
+    """The slope of the least squares line through the points on a log-log scale."""
+    log_xs = [math.log(x) for x in xs]
+    log_ys = [math.log(max(y, 1)) for y in ys]
+    mean_x = sum(log_xs) / len(log_xs)
+    mean_y = sum(log_ys) / len(log_ys)
+    variance = sum((x - mean_x) ** 2 for x in log_xs)
+    if variance == 0:
+        return 0.0
+    return sum((x - mean_x) * (y - mean_y) for x, y in zip(log_xs, log_ys)) / variance
+
+
+def measure_series(
+    args: argparse.Namespace, tmp_dir: str, name: str, inputs: List[Tuple[int, str]]
+) -> Dict[str, Any]:
+    points: List[Dict[str, Any]] = []
+    timed_out = None
+    for size, text in inputs:
+        filename = os.path.join(tmp_dir, f"{name}-{size}.txt")
+        with open(filename, "w") as file:
+            file.write(text)
+        # A single parse first, so that an input that blows up costs one timeout
+        probe = run_bench(args.bench, filename, args.mode, 0, 1, args.timeout)
+        if probe is None:
+            timed_out = {"size": size, "bytes": len(text.encode())}
+            break
+        timeout = args.timeout * (args.repeat + 1) + 5
+        point = run_bench(args.bench, filename, args.mode, 1, args.repeat, timeout) or probe
+        point["size"] = size
+        points.append(point)
+        os.unlink(filename)
+
+    xs = [point["bytes"] for point in points]
+    times = [point["median_ns"] for point in points]
+    memory = [point["peak_alloc_bytes"] for point in points]
+    if timed_out is not None:
+        xs.append(timed_out["bytes"])
+        times.append(args.timeout * 1e9)
+    time_exponent = fit_exponent(xs, times) if len(xs) > 1 else 0.0
+    memory_exponent = fit_exponent(xs[: len(memory)], memory) if len(memory) > 1 else 0.0
+    limit = 1 + args.tolerance
+    return {
+        "series": name,
+        "points": points,
+        "timed_out": timed_out,
+        "time_exponent": time_exponent,
+        "memory_exponent": memory_exponent,
+        "nonlinear": time_exponent > limit or memory_exponent > limit,
+        "expected_nonlinear": name in EXPECTED_NONLINEAR,
+    }
+
+
+def main() -> None:
+    args = argparser.parse_args()
+    if not os.path.exists(args.bench):
+        sys.exit(f"{args.bench} not found; run `make peg_parser/peg_bench` first")
+
+    results = []
+    print(f"{'series':<12} {'sizes':>14} {'ns/token':>17} {'time k':>7} {'memory k':>9}")
+    with TemporaryDirectory() as tmp_dir:
+        for name, inputs in generate_series(args.max_bytes):
+            if args.series and name not in args.series:
+                continue
+            result = measure_series(args, tmp_dir, name, inputs)
+            results.append(result)
+            points = result["points"]
+            sizes = f"{points[0]['size']}-{points[-1]['size']}" if points else "-"
+            ns_per_token = (
+                f"{points[0]['ns_per_token']:.0f}-{points[-1]['ns_per_token']:.0f}"
+                if points
+                else "-"
+            )
+            notes = []
+            if result["timed_out"] is not None:
+                notes.append(f"timed out at {result['timed_out']['size']}")
+            if result["nonlinear"] and result["expected_nonlinear"]:
+                notes.append(f"non-linear as expected: {EXPECTED_NONLINEAR[name]}")
+            elif result["nonlinear"]:
+                notes.append("NON-LINEAR")
+            elif result["expected_nonlinear"]:
+                notes.append("linear, though expected not to be: update EXPECTED_NONLINEAR")
+            print(
+                f"{name:<12} {sizes:>14} {ns_per_token:>17}",
+                f"{result['time_exponent']:7.2f} {result['memory_exponent']:9.2f}",
+                *notes,
+                flush=True,
+            )
+
+    if args.json:
+        with open(args.json, "w") as file:
+            json.dump({"mode": args.mode, "series": results}, file, indent=2)
+    failed = [
+        result
+        for result in results
+        if result["nonlinear"] and (args.strict or not result["expected_nonlinear"])
+    ]
+    sys.exit(1 if failed else 0)
+
+
+if __name__ == "__main__":
+    main()
@@ -218,12 +218,6 @@ def parse_directory(
             f"or {total_bytes / total_seconds :,.0f} bytes/sec.",
         )
 
-    # Dump memo stats to @data.
-    with open("@data", "w") as datafile:
-        for i, count in enumerate(parse.get_memo_stats()):
-            if count:
-                datafile.write(f"{i:4d} {count:9d}\n")
-
     if short:
         print_memstats()
 
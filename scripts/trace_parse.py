@@ -0,0 +1,43 @@
+#!/usr/bin/env python3.8
+
+"""Trace how the C parser parses a file, to see where it backtracks.
+
+Generates a C parser with rule timing from the grammar, which can trace its
+rule calls, and parses the file with parse_file(..., trace=OUTPUT).  That
+writes the last million rule calls, memo lookups and backtracking events of
+the parse as Chrome trace event JSON; open it in https://ui.perfetto.dev or
+chrome://tracing.  The trace is written even if the file does not parse.
+"""
+
+import argparse
+import os
+import sys
+from tempfile import TemporaryDirectory
+from pathlib import Path
+
+sys.path.insert(0, os.getcwd())
+from pegen.build import build_parser
+from pegen.testutil import generate_parser_c_extension
+
+argparser = argparse.ArgumentParser(
+    prog="trace_parse", description="Trace the rule calls of the C parser on a file"
+)
+argparser.add_argument("-g", "--grammar-file", default="data/simpy.gram", help="Grammar file")
+argparser.add_argument("-m", "--mode", type=int, default=0, help="Parse mode (default 0)")
+argparser.add_argument("-o", "--output", required=True, help="Where to write the trace")
+argparser.add_argument("file", help="File to parse")
+
+
+def main() -> None:
+    args = argparser.parse_args()
+    grammar, parser, tokenizer = build_parser(args.grammar_file)
+    with TemporaryDirectory() as tmp_dir:
+        extension = generate_parser_c_extension(grammar, Path(tmp_dir), rule_timing=True)
+        try:
+            extension.parse_file(args.file, mode=args.mode, trace=args.output)
+        except SyntaxError as err:
+            print(f"{args.file}: {err}", file=sys.stderr)
+
+
+if __name__ == "__main__":
+    main()
@@ -330,6 +330,7 @@ TEST_CASES = [
         pass; pass
         pass
      '''),
+    ('name_non_ascii', 'ﬁ = ℌ + ñ'),
     ('namedexpr', '(x := [1, 2, 3])'),
     ('namedexpr_false', '(x := False)'),
     ('namedexpr_none', '(x := None)'),
@@ -339,6 +340,7 @@ TEST_CASES = [
     ('number_float', '-34.2333'),
     ('number_imaginary_literal', '1.1234j'),
     ('number_integer', '-234'),
+    ('number_long', '123456789_123456789_123456789_123456789_123456789_123456789_123456789'),
     ('number_underscores', '1_234_567'),
     ('pass', 'pass'),
     ('pos_args',
@@ -664,3 +666,93 @@ def test_correct_ast_generation_without_pos_info(parser_extension: Any, source:
     assert ast.dump(actual_ast) == ast.dump(
         expected_ast
     ), f"Wrong AST generation for source: {source}"
+
+
+def test_names_share_identifiers(parser_extension: Any) -> None:
+    tree = parser_extension.parse_string("self.x = self\nself.y = self.x", mode=1)
+    names = [node.id for node in ast.walk(tree) if isinstance(node, ast.Name)]
+    assert names == ["self"] * 4
+    assert all(name is names[0] for name in names)
+
+
+def test_reusable_parser(parser_extension: Any) -> None:
+    def parse(method: Any, source: Any, **kwargs: Any) -> Any:
+        try:
+            return ast.dump(method(source, **kwargs), include_attributes=True)
+        except SyntaxError as err:
+            return err.msg, err.filename, err.lineno, err.offset, err.text
+
+    # One Parser for all, also for inputs that need a tokenizer of their own,
+    # that are bytes, or that do not parse
+    parser = parser_extension.Parser()
+    sources = [*TEST_SOURCES, "x = 1\r\ny = 2\r\n", "a + é\n", "x = (1,\n", "1 +"]
+    expected = [parse(parser_extension.parse_string, source) for source in sources]
+    assert [parse(parser.parse, source) for source in sources] == expected
+    assert [parse(parser.parse, source.encode()) for source in sources] == expected
+    trees = parser.parse_many(TEST_SOURCES)
+    assert [ast.dump(tree, include_attributes=True) for tree in trees] == expected[: len(trees)]
+    assert parser.parse_many([b"x\n", "y"], mode=0) == [None, None]
+
+    # The input of compile() in "eval" mode
+    for source in ["a + 1", "a, b\n\n", "f(x) if y else z\n"]:
+        expected = ast.dump(ast.parse(source, mode="eval"), include_attributes=True)
+        assert parse(parser.parse, source, start="eval") == expected
+    assert eval(parser.parse("6 * 7", mode=2, start="eval")) == 42
+    with pytest.raises(SyntaxError):
+        parser.parse("x = 1", start="eval")
+    with pytest.raises(SyntaxError):
+        parser.parse("a b", start="eval")
+
+    assert parse(parser_extension.Parser(filename="cfg.py").parse, "x +") == (
+        "invalid syntax",
+        "cfg.py",
+        1,
+        4,
+        "x +",
+    )
+    with pytest.raises(ValueError):
+        parser.parse("x", start="single")
+    with pytest.raises(ValueError):
+        parser.parse("x\0")
+
+
+@pytest.mark.parametrize(
+    "source",
+    [
+        b"x = 1\ny = 2",
+        b"x = 1\r\ny = '\xc3\xa9'\r\n",
+        b"\xef\xbb\xbfx = 1\n",
+        b"# -*- coding: latin-1 -*-\nx = '\xe9'\n",
+    ],
+    ids=["no_trailing_newline", "crlf", "bom", "coding_declaration"],
+)
+def test_parse_file_decoding(parser_extension: Any, tmp_path: PurePath, source: bytes) -> None:
+    the_file = tmp_path / "source.py"
+    with open(the_file, "wb") as fd:
+        fd.write(source)
+    actual_ast = parser_extension.parse_file(str(the_file))
+    expected_ast = ast.parse(source)
+    assert ast.dump(actual_ast, include_attributes=True) == ast.dump(
+        expected_ast, include_attributes=True
+    )
+
+
+def test_parse_file_errors(parser_extension: Any, tmp_path: PurePath) -> None:
+    the_file = tmp_path / "source.py"
+    with open(the_file, "wb") as fd:
+        fd.write(b"x = 1\n# caf\xe9\n")
+    with pytest.raises(SyntaxError, match="Non-UTF-8 code .* on line 2"):
+        parser_extension.parse_file(str(the_file))
+    # A BOM or a utf-8 declaration do not turn the check off
+    for start in [b"\xef\xbb\xbf", b"# coding: utf-8\n"]:
+        with open(the_file, "wb") as fd:
+            fd.write(start + b"x = 1\n# caf\xe9\n")
+        with pytest.raises(SyntaxError, match="Non-UTF-8 code .* its encoding is utf-8"):
+            parser_extension.parse_file(str(the_file))
+
+    with open(the_file, "wb") as fd:
+        fd.write(b"x = 1\ny = 2 +\nz = 3\n")
+    with pytest.raises(SyntaxError) as excinfo:
+        parser_extension.parse_file(str(the_file))
+    assert excinfo.value.lineno == 2
+    assert excinfo.value.text == "y = 2 +"
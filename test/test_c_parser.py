@@ -1,12 +1,14 @@
 import ast
+import json
 from pathlib import PurePath
 import textwrap
-from typing import Optional, Sequence
+from typing import Any, Optional, Sequence
 import traceback
 
 import pytest  # type: ignore
 
 from pegen.grammar_parser import GeneratedParser as GrammarParser
+from pegen.memo_profile import RuleProfile
 from pegen.testutil import parse_string, generate_parser_c_extension, generate_c_parser_source
 
 
@@ -80,6 +82,364 @@ def test_c_parser(tmp_path: PurePath) -> None:
         assert ast.dump(the_ast) == ast.dump(expected_ast)
 
 
+@pytest.mark.parametrize("memo_backend", ["list", "dense", "hash"])
+def test_memo_backends(memo_backend: str, tmp_path: PurePath) -> None:
+    grammar_source = """
+    start[mod_ty]: a=stmt* $ { Module(a, NULL, p->arena) }
+    stmt[stmt_ty]: a=expression NEWLINE ~ { _Py_Expr(a, EXTRA) }
+    expression[expr_ty] (memo): ( l=expression '+' r=term { _Py_BinOp(l, Add, r, EXTRA) }
+                                | l=expression '-' r=term { _Py_BinOp(l, Sub, r, EXTRA) }
+                                | t=term { t }
+                                )
+    term[expr_ty] (memo): ( l=term '*' r=factor { _Py_BinOp(l, Mult, r, EXTRA) }
+                          | f=factor { f }
+                          )
+    factor[expr_ty] (memo): '(' e=expression ')' { e } | a=atom { a }
+    atom[expr_ty] (memo): NAME | NUMBER
+    """
+    grammar = parse_string(grammar_source, GrammarParser)
+    extension = generate_parser_c_extension(grammar, tmp_path, memo_backend=memo_backend)
+
+    source = "\n".join(["1+2*(a-b)*c", "((x))", "a*b*c+d-e"] * 500) + "\n"
+    assert ast.dump(extension.parse_string(source)) == ast.dump(ast.parse(source))
+    with pytest.raises(SyntaxError):
+        extension.parse_string("1+2*(a-\n")
+
+    # A Parser empties the memo between parses, which memoize at the same marks,
+    # also the rows of the block that holds the mark of the last commit
+    parser = extension.Parser()
+    longer = "\n".join(["(a-b)*(c+d)", "x*y-z*w", "f"] * 800) + "\n"
+    for text in [source, longer, "a*b\n", "(x)-y\n", "a*b+c\n", source]:
+        assert ast.dump(parser.parse(text)) == ast.dump(ast.parse(text))
+        with pytest.raises(SyntaxError):
+            parser.parse("1+2*(a-\n")
+
+
+@pytest.mark.parametrize("memo_backend", ["list", "dense", "hash"])
+def test_commit_after_cut(memo_backend: str, tmp_path: PurePath) -> None:
+    grammar_source = """
+    start[mod_ty]: a=stmt* $ { Module(a, NULL, p->arena) }
+    stmt[stmt_ty]: a=if_stmt ~ { a } | a=expression NEWLINE ~ { _Py_Expr(a, EXTRA) }
+    if_stmt[stmt_ty]:
+        | 'if' c=expression ':' b=block 'else' ':' e=block { _Py_If(c, b, e, EXTRA) }
+        | 'if' c=expression ':' b=block e=['elif' ':' e=block { e }] { _Py_If(c, b, e, EXTRA) }
+    block[asdl_seq*] (memo): NEWLINE INDENT a=stmt+ DEDENT { a }
+    expression[expr_ty] (memo): ( l=expression '+' r=atom { _Py_BinOp(l, Add, r, EXTRA) }
+                                | &(NAME | NUMBER) a=atom { a }
+                                )
+    atom[expr_ty]: NAME | NUMBER
+    """
+    grammar = parse_string(grammar_source, GrammarParser)
+    parser_source = generate_c_parser_source(grammar)
+    # stmt uses the tokens before its cuts, so it holds on to them
+    assert "cut(p, p->choice_mark)" in parser_source
+    assert "opt_choice_mark = enter_choice(p, p->mark)" in parser_source
+    # block is memoized, so it holds on to its start until its result is in the memo
+    block = parser_source[parser_source.index("\nblock_rule(Parser *p)") :]
+    assert "int choice_mark = enter_choice(p, mark);" in block[: block.index("\n}\n")]
+    extension = generate_parser_c_extension(grammar, tmp_path, memo_backend=memo_backend)
+
+    # Long enough for commit() to free token blocks behind the parser
+    nested = "if a:\n if b:\n  c+1\n else:\n  d\n e\nelif:\n f\n"
+    source = "x+1\n" + (nested + "if a:\n b\n") * 300
+    expected = ast.parse(source.replace("elif:", "else:"))
+    result = extension.parse_string(source)
+    assert ast.dump(result, include_attributes=True) == ast.dump(expected, include_attributes=True)
+    with pytest.raises(SyntaxError):
+        extension.parse_string(nested * 300 + "if a:\nb\n")
+
+
+def test_memo_profile(tmp_path: PurePath) -> None:
+    grammar_source = """
+    start[mod_ty]: a=stmt* $ { Module(a, NULL, p->arena) }
+    stmt[stmt_ty]: a=expr NEWLINE { _Py_Expr(a, EXTRA) }
+    expr[expr_ty]: a=term '+' b=term { _Py_BinOp(a, Add, b, EXTRA) } | term
+    term[expr_ty] (memo): a=atom '*' b=atom { _Py_BinOp(a, Mult, b, EXTRA) } | atom
+    atom[expr_ty]: NAME | NUMBER | '(' a=expr ')' { a }
+    """
+    grammar = parse_string(grammar_source, GrammarParser)
+    extension = generate_parser_c_extension(grammar, tmp_path, memo_profiling=True)
+
+    source = "((((a+1)*b)))+c\n" * 10
+    result, stats = extension.parse_string(source, stats=True)
+    assert ast.dump(result) == ast.dump(ast.parse(source))
+    profile = {
+        name: RuleProfile(counts["hits"] + counts["misses"], counts["hits"], counts["saved"])
+        for name, counts in stats["rules"].items()
+    }
+    # atom is parsed again where term backtracks, and term where expr does
+    assert profile["atom"].hits > 0 and profile["atom"].saved > 0
+    assert profile["term"].hits > 0 and profile["term"].saved > 0
+    # The work is counted, not timed
+    assert extension.parse_string(source, stats=True)[1]["rules"] == stats["rules"]
+
+    memo_profile = {"atom": RuleProfile(10, 9, 10 ** 6), "term": RuleProfile(10, 0, 0)}
+    parser_source = generate_c_parser_source(grammar, memo_profile=memo_profile)
+    assert "is_memoized(p, atom_type, &res)" in parser_source
+    assert "is_memoized(p, term_type, &res)" not in parser_source
+
+
+def test_parse_statistics(tmp_path: PurePath) -> None:
+    grammar_source = """
+    start[mod_ty]: a=stmt* $ { Module(a, NULL, p->arena) }
+    stmt[stmt_ty]: a=expr NEWLINE { _Py_Expr(a, EXTRA) }
+    expr[expr_ty]: a=term '+' b=term { _Py_BinOp(a, Add, b, EXTRA) } | term
+    term[expr_ty] (memo): a=atom '*' b=atom { _Py_BinOp(a, Mult, b, EXTRA) } | atom
+    atom[expr_ty]: NAME | NUMBER | '(' a=expr ')' { a }
+    """
+    grammar = parse_string(grammar_source, GrammarParser)
+    # Only a parser generated with parse_stats counts its rule calls
+    assert "count_call" not in generate_c_parser_source(grammar)
+    for name in ["plain", "stats"]:
+        (tmp_path / name).mkdir()
+    extension = generate_parser_c_extension(grammar, tmp_path / "plain")
+    assert extension.parse_string("a*b\nc\n", mode=0, stats=True) == (None, {"tokens": 7})
+    extension = generate_parser_c_extension(grammar, tmp_path / "stats", parse_stats=True)
+
+    source = "a*b\nc\n"
+    assert extension.parse_string(source, mode=0) is None
+    result, stats = extension.parse_string(source, mode=0, stats=True)
+    assert result is None
+    # The tokens are a * b NEWLINE c NEWLINE ENDMARKER
+    assert stats["tokens"] == 7
+    assert stats["rules"]["stmt"]["calls"] == 3
+    # expr tries term twice on each line and at the end, the second time
+    # from the memo
+    term = stats["rules"]["term"]
+    assert (term["calls"], term["hits"], term["misses"], term["inserts"]) == (6, 3, 3, 3)
+    # c is an atom that is not followed by '*'
+    assert stats["rules"]["term"]["backtracked"] == 1
+    # expr gives back a term that is not followed by '+' on each line
+    assert stats["rules"]["expr"]["backtracked"] == 4
+    positions = stats["positions"]
+    assert [position[:4] for position in positions[:2]] == [(1, 0, 1, 1), (1, 1, 1, 2)]
+    # expr gives back a * b, and term and then expr give back c
+    assert [position[5] for position in positions] == [1, 1, 1, 0, 2, 0, 0]
+    calls = sum(rule["calls"] for rule in stats["rules"].values())
+    assert sum(position[4] for position in positions) == calls
+
+    file = tmp_path / "source.py"
+    with open(file, "w") as f:
+        f.write(source)
+    result, file_stats = extension.parse_file(str(file), stats=True)
+    assert ast.dump(result) == ast.dump(ast.parse(source))
+    assert file_stats == stats
+    # Rules are only timed in a parser generated with rule_timing
+    assert all(rule["self_time"] == 0 for rule in stats["rules"].values())
+
+
+def test_rule_timing(tmp_path: PurePath) -> None:
+    grammar_source = """
+    start[mod_ty]: a=stmt* $ { Module(a, NULL, p->arena) }
+    stmt[stmt_ty]: a=expr NEWLINE { _Py_Expr(a, EXTRA) }
+    expr[expr_ty]: l=expr '+' r=term { _Py_BinOp(l, Add, r, EXTRA) } | term
+    term[expr_ty]: NAME | NUMBER | '(' a=expr ')' { a }
+    """
+    grammar = parse_string(grammar_source, GrammarParser)
+    assert "enter_rule" not in generate_c_parser_source(grammar)
+    extension = generate_parser_c_extension(grammar, tmp_path, rule_timing=True)
+
+    source = "(((a + 1) + b) + c) + d\n" * 20
+    result, stats = extension.parse_string(source, stats=True)
+    assert ast.dump(result) == ast.dump(ast.parse(source))
+    rules = stats["rules"]
+    # Recursive calls count once towards the inclusive time
+    assert 0 < rules["term"]["inclusive_time"] < rules["expr"]["inclusive_time"]
+    assert rules["stmt"]["inclusive_time"] <= rules["start"]["inclusive_time"]
+    assert sum(rule["self_time"] for rule in rules.values()) == rules["start"]["inclusive_time"]
+
+
+def test_trace(tmp_path: PurePath) -> None:
+    grammar_source = """
+    start[mod_ty]: a=stmt* $ { Module(a, NULL, p->arena) }
+    stmt[stmt_ty]: a=expr NEWLINE { _Py_Expr(a, EXTRA) }
+    expr[expr_ty] (memo): l=term '+' r=expr { _Py_BinOp(l, Add, r, EXTRA) } | term
+    term[expr_ty]: NAME | NUMBER
+    """
+    grammar = parse_string(grammar_source, GrammarParser)
+    extension = generate_parser_c_extension(grammar, tmp_path, rule_timing=True)
+    trace_file = tmp_path / "trace.json"
+
+    extension.parse_string("a + 1\n", trace=str(trace_file))
+    with open(trace_file) as file:
+        events = json.load(file)["traceEvents"]
+    calls = [e["name"] for e in events if e["ph"] == "B" and not e["name"].startswith("_")]
+    assert calls[:4] == ["start", "stmt", "expr", "term"]
+    assert [e["ph"] for e in events].count("B") == [e["ph"] for e in events].count("E")
+    lookups = [(e["name"], e["args"]["mark"]) for e in events if e.get("cat") == "memo"]
+    assert ("memo miss", 0) in lookups
+    # The first alternative of expr fails on the NEWLINE after 1
+    backtracks = [e["args"] for e in events if e.get("name") == "backtrack"]
+    assert {"rule": "expr", "from": 3, "to": 2, "line": 1, "col": 4} in backtracks
+    ends = [e["args"] for e in events if e["ph"] == "E"]
+    assert ends[-1] == {"result": True, "end": 5}
+
+    # The trace of a parse that fails is written too
+    with pytest.raises(SyntaxError):
+        extension.parse_string("a +\n", trace=str(trace_file))
+    with open(trace_file) as file:
+        events = json.load(file)["traceEvents"]
+    assert [e["ph"] for e in events].count("B") == [e["ph"] for e in events].count("E")
+
+
+def test_pipeline(tmp_path: PurePath) -> None:
+    grammar_source = """
+    start[mod_ty]: a=stmt* $ { Module(a, NULL, p->arena) }
+    stmt[stmt_ty]: a=expr NEWLINE { _Py_Expr(a, EXTRA) }
+    expr[expr_ty]: l=term '+' r=expr { _Py_BinOp(l, Add, r, EXTRA) } | term
+    term[expr_ty]: NAME | NUMBER
+    """
+    grammar = parse_string(grammar_source, GrammarParser)
+    extension = generate_parser_c_extension(grammar, tmp_path)
+
+    def parse(text: str, pipeline: bool) -> Any:
+        try:
+            return ast.dump(extension.parse_string(text, pipeline=pipeline))
+        except SyntaxError as err:
+            return err.msg, err.lineno, err.offset, err.text
+
+    # More tokens than the ring holds, so that the tokenizer thread waits for
+    # the parser, followed by errors of the parser and of the tokenizer, and by
+    # code that the scanner gives up on, whose tokens the parser reads itself
+    lines = "a + 1 + b  # (]\n" * 2000
+    ends = ["", "a +\n", "'''\n", "名 + 0x1f\n", "1_\n", "1e+y\n", "1.e-x\n", "(]\n"]
+    ends += ['(")["]\n', "(" * 200 + "\n", "a + 1\n))\n"]
+    for end in ends:
+        assert parse(lines + end, True) == parse(lines + end, False)
+    path = tmp_path / "lines.txt"
+    with open(path, "w") as file:
+        file.write(lines)
+    module = extension.parse_file(str(path), pipeline=True)
+    assert ast.dump(module) == parse(lines, False)
+
+
+def test_parse_bytes(tmp_path: PurePath) -> None:
+    grammar_source = """
+    start[mod_ty]: a=stmt* $ { Module(a, NULL, p->arena) }
+    stmt[stmt_ty]: a=expr NEWLINE { _Py_Expr(a, EXTRA) }
+    expr[expr_ty]: l=term '+' r=expr { _Py_BinOp(l, Add, r, EXTRA) } | term
+    term[expr_ty]: NAME | NUMBER
+    """
+    grammar = parse_string(grammar_source, GrammarParser)
+    extension = generate_parser_c_extension(grammar, tmp_path)
+
+    def parse(parser: Any, source: Any) -> Any:
+        try:
+            return ast.dump(parser(source), include_attributes=True)
+        except SyntaxError as err:
+            return err.msg, err.lineno, err.offset, err.text
+
+    # The views do not end with a NUL byte, and what follows them is not
+    # parsed, also where CPython's tokenizer takes over from the scanner
+    for source in ["a + 1\nb\n", "a + 名\n", "a +\n", "a\n  b\n", "0777\n", "a + 1"]:
+        data = source.encode()
+        view = memoryview(data + b"+\n")[: len(data)]
+        expected = parse(extension.parse_string, source)
+        assert parse(extension.parse_bytes, view) == expected
+        assert parse(extension.parse_bytes, bytearray(data)) == expected
+    # NUL bytes are an error rather than the end of the input
+    with pytest.raises(ValueError):
+        extension.parse_bytes(b"a\0 + 1\n")
+    with pytest.raises(ValueError):
+        extension.parse_string("a\0 + 1\n")
+    with pytest.raises(SyntaxError):
+        extension.parse_bytes(b"a + \xff\n")
+
+
+def test_tokenizer(tmp_path: PurePath) -> None:
+    grammar = parse_string("start: NAME", GrammarParser)
+    extension = generate_parser_c_extension(grammar, tmp_path)
+
+    def tokenize(text: str, tokenizer: int) -> Any:
+        try:
+            return extension.tokenize_string(text, tokenizer=tokenizer)
+        except SyntaxError as err:
+            return err.msg, err.lineno, err.offset, err.text
+
+    # The scanner reads these itself, with the positions of CPython's tokenizer
+    sources = [
+        "x = 0 + 0x1F + 0o17 + 0b1_0 + 1_000.5e-3j + .5 + 1. + 1e5 + 0e0 + 00 + 1if 1else 2\n",
+        r"""s = b'a' rb"b\"" f'{x}' Rb'''
+''' u'\
+' + ''
+""",
+        'def f(a, *b, **c) -> None:\n    """Doc\n\n    string"""\n    return a@b\n',
+        "if x:\n\tif y:  # comment\n\t\tpass\n\n  # more\n\telse:\n\t\tz = [\n1,\n  2]\n",
+        "x = 1 + \\\n    2\nasync def f():\n    await x...\n\x0cy <<= 3 != 4 ** -5",
+        "class C:\n    def f(self):\n        pass\n",
+    ]
+    for source in sources:
+        assert tokenize(source, 1) == tokenize(source, 2)
+    # These are tokenized from the tokenizer's translated copy, the rest in place
+    for source in ["x = 1\r\ny = 2\r\n", "\ufeffx = 1\n", "# coding: latin-1\nx = 1\n", "x = 1"]:
+        assert tokenize(source, 0) == tokenize(source, 2)
+    # It gives up on errors and on names that are not ASCII, and CPython's
+    # tokenizer takes over from there
+    errors = ["x = 1_\n", "0777", "x = '\n", "if x:\n    y\n  z\n", "(]", "\\ x", "1 +\\"]
+    for source in errors + ["a = 名\n"]:
+        with pytest.raises(ValueError):
+            extension.tokenize_string(source, tokenizer=1)
+        assert tokenize(source, 0) == tokenize(source, 2)
+
+
+def test_keywords(tmp_path: PurePath) -> None:
+    grammar = """
+    start: item+ NEWLINE? ENDMARKER
+    item: 'if' 'in' | 'is' 'import' | 'from' 'for' | NAME
+    """
+    valid_cases = ["if in", "is import from for", "i iff ifs im imports fro form f", "In If _if"]
+    invalid_cases = ["if", "in", "is", "import", "from", "for", "if is", "from if"]
+    check_input_strings_for_grammar(grammar, tmp_path, valid_cases, invalid_cases)
+
+
+def test_first_set_guards(tmp_path: PurePath) -> None:
+    grammar_source = """
+    start[mod_ty]: a=stmt* $ { Module(a, NULL, p->arena) }
+    stmt[stmt_ty]: assign | a=expression NEWLINE { _Py_Expr(a, EXTRA) }
+    assign[stmt_ty]: !(NAME '=' '=') a=target '=' b=expression NEWLINE {
+                         _Py_Assign(CHECK(singleton_seq(p, a)), b, NULL, EXTRA) }
+    target[expr_ty]: a=NAME { set_expr_context(p, a, Store) }
+    expression[expr_ty]: ( l=expression '+' r=term { _Py_BinOp(l, Add, r, EXTRA) }
+                         | sign? t=term { t }
+                         )
+    sign: '-' | '~'
+    term[expr_ty]: ( l=term '*' r=factor { _Py_BinOp(l, Mult, r, EXTRA) }
+                   | f=factor { f }
+                   )
+    factor[expr_ty]: &'(' '(' e=expression ')' { e } | a=NAME { a } | a=NUMBER { a }
+    """
+    grammar = parse_string(grammar_source, GrammarParser)
+    extension = generate_parser_c_extension(grammar, tmp_path, first_set_guards=True)
+
+    source = "a = 1+2*(a+b)*c\nx\n((x))*y\n"
+    assert ast.dump(extension.parse_string(source)) == ast.dump(ast.parse(source))
+    for valid in ["b = -b\n", "~(a)+1\n", "x\n"]:
+        extension.parse_string(valid, mode=0)
+    for invalid in ["1 +\n", "a = = 1\n", ")\n", "--a\n"]:
+        with pytest.raises(SyntaxError):
+            extension.parse_string(invalid, mode=0)
+
+
+def test_first_set_guards_on_rule_entry() -> None:
+    grammar_source = """
+    start: stmt* $
+    stmt: expr NEWLINE | 'pass' NEWLINE
+    expr: term '+' expr | term
+    term: NAME | '(' expr ')'
+    """
+    grammar = parse_string(grammar_source, GrammarParser)
+    parser_source = generate_c_parser_source(grammar, first_set_guards=True)
+
+    def is_guarded(rule: str) -> bool:
+        return f"{rule}_rule(Parser *p)\n{{\n    if (!next_token_in(p," in parser_source
+
+    # expr is also called after '+', but term is only ever called first in
+    # an alternative of expr, which already checked a subset of its FIRST set.
+    assert is_guarded("stmt")
+    assert is_guarded("expr")
+    assert not is_guarded("term")
+
+
 def test_lookahead(tmp_path: PurePath) -> None:
     grammar = """
     start: NAME &NAME expr NEWLINE? ENDMARKER
@@ -124,6 +484,25 @@ def test_gather(tmp_path: PurePath) -> None:
     check_input_strings_for_grammar(grammar, tmp_path, valid_cases, invalid_cases)
 
 
+def test_gather_of_groups(tmp_path: PurePath) -> None:
+    grammar_source = """
+    start[mod_ty]: a=(';' | ',').(NAME '=' b=NUMBER { b })+ NEWLINE $ {
+                       Module(CHECK(singleton_seq(p, _Py_Expr(_Py_Tuple(a, Load, EXTRA), EXTRA))),
+                              NULL, p->arena) }
+    """
+    grammar = parse_string(grammar_source, GrammarParser)
+    parser_source = generate_c_parser_source(grammar)
+    assert "_loop0" not in parser_source
+    assert "seq_insert_in_front" not in parser_source
+
+    extension = generate_parser_c_extension(grammar, tmp_path)
+    tree = extension.parse_string("a = 1, b = 2; c = 3\n")
+    assert ast.dump(tree) == ast.dump(ast.parse("1, 2, 3"))
+    for invalid in ["a = 1,\n", "a = 1 b = 2\n", "\n"]:
+        with pytest.raises(SyntaxError):
+            extension.parse_string(invalid, mode=0)
+
+
 def test_left_recursion(tmp_path: PurePath) -> None:
     grammar = """
     start: expr NEWLINE
@@ -343,3 +722,34 @@ def test_error_in_rules(tmp_path: PurePath) -> None:
     # PyTuple_New raises SystemError if an invalid argument was passed.
     with pytest.raises(SystemError):
         extension.parse_string("a")
+
+
+def test_recognizer_mode_skips_actions(tmp_path: PurePath) -> None:
+    grammar_source = """
+    @subheader '''
+    static void *
+    fail(Parser *p)
+    {
+        PyErr_SetString(PyExc_ValueError, "action ran");
+        return NULL;
+    }
+    #define check fail
+    '''
+    @recognizer_actions check
+    start[mod_ty]: a=stmt* $ { Module(a, NULL, p->arena) }
+    stmt[stmt_ty]: a=expr NEWLINE { _Py_Expr(a, EXTRA) }
+    expr[expr_ty]: '-' NAME { fail(p) } | '~' NAME { check(p) } | NAME | NUMBER
+    """
+    grammar = parse_string(grammar_source, GrammarParser)
+    extension = generate_parser_c_extension(grammar, tmp_path)
+
+    assert extension.parse_string("a\n-b\n1\n", mode=0) is None
+    with pytest.raises(ValueError, match="action ran"):
+        extension.parse_string("a\n-b\n1\n", mode=1)
+    for mode in (0, 1):
+        with pytest.raises(ValueError, match="action ran"):
+            extension.parse_string("~b\n", mode=mode)
+    with pytest.raises(SyntaxError):
+        extension.parse_string("-\n", mode=0)
+    source = "a\n1\n"
+    assert ast.dump(extension.parse_string(source)) == ast.dump(ast.parse(source))
@@ -153,6 +153,26 @@ def test_negative_lookahead() -> None:
     }
 
 
+def test_negative_lookahead_of_several_tokens() -> None:
+    grammar = """
+    start: expr NEWLINE
+    expr: !('a' 'b') opt
+    opt: 'a' | 'b' | 'c'
+    """
+    assert calculate_first_sets(grammar) == {
+        "opt": {"'b'", "'a'", "'c'"},
+        "expr": {"'b'", "'a'", "'c'"},
+        "start": {"'b'", "'a'", "'c'"},
+    }
+
+
+def test_nullable_group() -> None:
+    grammar = """
+    start: (['-']) NUMBER
+    """
+    assert calculate_first_sets(grammar) == {"start": {"'-'", "NUMBER"}}
+
+
 def test_left_recursion() -> None:
     grammar = """
     start: expr NEWLINE
@@ -188,19 +208,22 @@ def test_mutual_left_recursion() -> None:
     """
     assert calculate_first_sets(grammar) == {
         "foo": {"'D'", "'B'"},
-        "bar": {"'D'"},
+        "bar": {"'D'", "'B'"},
         "start": {"'D'", "'B'"},
     }
 
 
 def test_nasty_left_recursion() -> None:
-    # TODO: Validate this
     grammar = """
     start: target '='
     target: maybe '+' | NAME
     maybe: maybe '-' | target
     """
-    assert calculate_first_sets(grammar) == {"maybe": set(), "target": {"NAME"}, "start": {"NAME"}}
+    assert calculate_first_sets(grammar) == {
+        "maybe": {"NAME"},
+        "target": {"NAME"},
+        "start": {"NAME"},
+    }
 
 
 def test_nullable_rule() -> None: